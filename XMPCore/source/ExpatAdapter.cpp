@@ -122,6 +122,14 @@ ExpatAdapter::~ExpatAdapter()
 	if ( this->registeredNamespaces != sRegisteredNamespaces ) delete ( this->registeredNamespaces );
 	this->registeredNamespaces = 0;
 
+	if ( this->eventSink != 0 ) {
+		// The open elements are not in the XML tree, delete them along with the recycled nodes.
+		for ( size_t i = 1, limit = this->parseStack.size(); i < limit; ++i ) delete this->parseStack[i];
+		this->parseStack.resize ( 1 );
+	}
+	for ( size_t i = 0, limit = this->freeNodes.size(); i < limit; ++i ) delete this->freeNodes[i];
+	this->freeNodes.clear();
+
 }	// ExpatAdapter::~ExpatAdapter
 
 // =================================================================================================
@@ -144,6 +152,12 @@ void ExpatAdapter::ParseBuffer ( const void * buffer, size_t length, bool last /
 	
 	status = XML_Parse ( this->parser, (const char *)buffer, static_cast< XMP_StringLen >( length ), last );
 	
+	if ( (this->eventSink != 0) && (status != XML_STATUS_OK) ) {
+		// Leave the reporting to the parse that the client does without the sink.
+		this->eventSink->aborted = true;
+		return;
+	}
+
 	#if BanAllEntityUsage
 		if ( this->isAborted ) {
 			XMP_Error error(kXMPErr_BadXML, "DOCTYPE is not allowed" );
@@ -197,6 +211,48 @@ void ExpatAdapter::ParseBuffer ( const void * buffer, size_t length, bool last /
 
 // =================================================================================================
 
+static XML_Node * NewSinkNode ( ExpatAdapter * thiz, XML_Node * parent, XMP_Uns8 kind )
+{
+	// With an event sink only the open elements exist, their nodes are recycled when they end.
+
+	if ( thiz->freeNodes.empty() ) return new XML_Node ( parent, "", kind );
+
+	XML_Node * node = thiz->freeNodes.back();
+	thiz->freeNodes.pop_back();
+
+	node->kind = kind;
+	node->parent = parent;
+	node->nsPrefixLen = 0;
+	node->ns.erase();
+	node->name.erase();
+	node->value.erase();
+	return node;
+
+}	// NewSinkNode
+
+// =================================================================================================
+
+static void RecycleSinkNode ( ExpatAdapter * thiz, XML_Node * node )
+{
+
+	for ( size_t i = 0, limit = node->attrs.size(); i < limit; ++i ) thiz->freeNodes.push_back ( node->attrs[i] );
+	node->attrs.clear();
+	XMP_Assert ( node->content.empty() );
+	thiz->freeNodes.push_back ( node );
+
+}	// RecycleSinkNode
+
+// =================================================================================================
+
+static void CheckSinkAborted ( ExpatAdapter * thiz )
+{
+
+	if ( thiz->eventSink->aborted ) (void) XML_StopParser ( thiz->parser, XML_FALSE /* not resumable */ );
+
+}	// CheckSinkAborted
+
+// =================================================================================================
+
 static void SetQualName ( ExpatAdapter * thiz, XMP_StringPtr fullName, XML_Node * node )
 {
 	// Expat delivers the full name as a catenation of namespace URI, separator, and local name.
@@ -335,8 +391,17 @@ static void StartElementHandler ( void * userData, XMP_StringPtr name, XMP_Strin
 		}
 	#endif
 
+	if ( (thiz->eventSink != 0) && thiz->eventSink->aborted ) return;
+
 	XML_Node * parentNode = thiz->parseStack.back();
-	XML_Node * elemNode   = new XML_Node ( parentNode, "", kElemNode );
+	XML_Node * elemNode   = 0;
+	
+	if ( thiz->eventSink == 0 ) {
+		elemNode = new XML_Node ( parentNode, "", kElemNode );
+	} else {
+		elemNode = NewSinkNode ( thiz, parentNode, kElemNode );
+		thiz->parseStack.push_back ( elemNode );	// ! Push first, the node is not owned by the XML tree.
+	}
 	
 	SetQualName ( thiz, name, elemNode );
 	
@@ -344,7 +409,12 @@ static void StartElementHandler ( void * userData, XMP_StringPtr name, XMP_Strin
 
 		XMP_StringPtr attrName = *attr;
 		XMP_StringPtr attrValue = *(attr+1);
-		XML_Node * attrNode = new XML_Node ( elemNode, "", kAttrNode );
+		XML_Node * attrNode = 0;
+		if ( thiz->eventSink == 0 ) {
+			attrNode = new XML_Node ( elemNode, "", kAttrNode );
+		} else {
+			attrNode = NewSinkNode ( thiz, elemNode, kAttrNode );
+		}
 
 		SetQualName ( thiz, attrName, attrNode );
 		attrNode->value = attrValue;
@@ -353,6 +423,16 @@ static void StartElementHandler ( void * userData, XMP_StringPtr name, XMP_Strin
 
 	}
 	
+	#if XMP_DebugBuild
+		++thiz->elemNesting;
+	#endif
+
+	if ( thiz->eventSink != 0 ) {
+		thiz->eventSink->StartElement ( *elemNode );
+		CheckSinkAborted ( thiz );
+		return;
+	}
+
 	parentNode->content.push_back ( elemNode );
 	thiz->parseStack.push_back ( elemNode );
 	
@@ -360,9 +440,6 @@ static void StartElementHandler ( void * userData, XMP_StringPtr name, XMP_Strin
 		thiz->rootNode = elemNode;
 		++thiz->rootCount;
 	}
-	#if XMP_DebugBuild
-		++thiz->elemNesting;
-	#endif
 
 }	// StartElementHandler
 
@@ -377,6 +454,17 @@ static void EndElementHandler ( void * userData, XMP_StringPtr name )
 	#if XMP_DebugBuild
 		--thiz->elemNesting;
 	#endif
+
+	if ( thiz->eventSink != 0 ) {
+		if ( thiz->eventSink->aborted ) return;
+		XML_Node * elemNode = thiz->parseStack.back();
+		thiz->eventSink->EndElement ( *elemNode );
+		CheckSinkAborted ( thiz );
+		thiz->parseStack.pop_back();
+		RecycleSinkNode ( thiz, elemNode );
+		return;
+	}
+
 	(void) thiz->parseStack.pop_back();
 	
 	#if XMP_DebugBuild & DumpXMLParseEvents
@@ -405,6 +493,13 @@ static void CharacterDataHandler ( void * userData, XMP_StringPtr cData, int len
 		}
 	#endif
 	
+	if ( thiz->eventSink != 0 ) {
+		if ( thiz->eventSink->aborted ) return;
+		thiz->eventSink->CharacterData ( cData, len );
+		CheckSinkAborted ( thiz );
+		return;
+	}
+
 	XML_Node * parentNode = thiz->parseStack.back();
 	XML_Node * cDataNode  = new XML_Node ( parentNode, "", kCDataNode );
 	
@@ -470,6 +565,13 @@ static void ProcessingInstructionHandler ( void * userData, XMP_StringPtr target
 		}
 	#endif
 	
+	if ( thiz->eventSink != 0 ) {
+		if ( thiz->eventSink->aborted ) return;
+		thiz->eventSink->ProcessingInstruction ( target, data );
+		CheckSinkAborted ( thiz );
+		return;
+	}
+
 	XML_Node * parentNode = thiz->parseStack.back();
 	XML_Node * piNode  = new XML_Node ( parentNode, target, kPINode );
 	
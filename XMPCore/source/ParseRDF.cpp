@@ -191,17 +191,31 @@ public:
 
 	void EmptyPropertyElement ( XMP_Node * xmpParent, const XML_Node & xmlNode, bool isTopLevel );
 
-	RDF_Parser ( XMPMeta::ErrorCallbackInfo * ec ) : errorCallback(ec) {};
+	RDF_Parser ( XMPMeta::ErrorCallbackInfo * ec ) : errorCallback(ec), abortOnError(false), sawError(false) {};
 
 private:
 
 	RDF_Parser() { 
 
 		errorCallback = NULL;
+		abortOnError = sawError = false;
 
 	};	// Hidden on purpose.
+
+protected:
 	
 	XMPMeta::ErrorCallbackInfo * errorCallback;
+	bool abortOnError;	// Set by the single pass parser, errors are left to the two pass parser.
+	bool sawError;
+
+	void NotifyError ( XMP_ErrorSeverity severity, XMP_Error & error )
+	{
+		if ( this->abortOnError ) {
+			this->sawError = true;
+		} else {
+			this->errorCallback->NotifyClient ( severity, error );
+		}
+	}
 
 	XMP_Node * AddChildNode ( XMP_Node * xmpParent, const XML_Node & xmlNode, const XMP_StringPtr value, bool isTopLevel );
 
@@ -400,7 +414,7 @@ XMP_Node * RDF_Parser::AddChildNode ( XMP_Node * xmpParent, const XML_Node & xml
 	
 	if ( xmlNode.ns.empty() ) {
 		XMP_Error error ( kXMPErr_BadRDF, "XML namespace required for all elements and attributes" );
-		this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+		this->NotifyError ( kXMPErrSev_Recoverable, error );
 		return 0;
 	}
 		
@@ -433,7 +447,7 @@ XMP_Node * RDF_Parser::AddChildNode ( XMP_Node * xmpParent, const XML_Node & xml
 		// rdf:li can only be used for array children.
 		if ( ! isArrayParent ) {
 			XMP_Error error ( kXMPErr_BadRDF, "Misplaced rdf:li element" );
-			this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+			this->NotifyError ( kXMPErrSev_Recoverable, error );
 			return 0;
 		}
 		childName = kXMP_ArrayItemName;
@@ -446,7 +460,7 @@ XMP_Node * RDF_Parser::AddChildNode ( XMP_Node * xmpParent, const XML_Node & xml
 			isArrayItem = true;
 		} else {
 			XMP_Error error ( kXMPErr_BadRDF, "Array items cannot have arbitrary child names" );
-			this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+			this->NotifyError ( kXMPErrSev_Recoverable, error );
 			return 0;
 		}
 
@@ -456,7 +470,7 @@ XMP_Node * RDF_Parser::AddChildNode ( XMP_Node * xmpParent, const XML_Node & xml
 	if ( ! (isArrayItem | isValueNode) ) {
 		if ( FindChildNode ( xmpParent, childName, kXMP_ExistingOnly ) != 0 ) {
 			XMP_Error error ( kXMPErr_BadXMP, "Duplicate property or field node" );
-			this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+			this->NotifyError ( kXMPErrSev_Recoverable, error );
 			return 0;
 		}
 	}
@@ -465,14 +479,14 @@ XMP_Node * RDF_Parser::AddChildNode ( XMP_Node * xmpParent, const XML_Node & xml
 	if ( isValueNode ) {
 		if ( isTopLevel || (! (xmpParent->options & kXMP_PropValueIsStruct)) ) {
 			XMP_Error error ( kXMPErr_BadRDF, "Misplaced rdf:value element" );
-			this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+			this->NotifyError ( kXMPErrSev_Recoverable, error );
 			return 0;
 		}
 		xmpParent->options |= kRDF_HasValueElem;
 	}
 	
 	// Add the new child to the XMP parent node.
-	XMP_Node * newChild = new XMP_Node ( xmpParent, childName, value, childOptions );
+	XMP_Node * newChild = new ( xmpParent ) XMP_Node ( xmpParent, childName, value, childOptions );
 	if ( (! isValueNode) || xmpParent->children.empty() ) {
 		 xmpParent->children.push_back ( newChild );
 	} else {
@@ -495,7 +509,7 @@ XMP_Node * RDF_Parser::AddQualifierNode ( XMP_Node * xmpParent, const XMP_VarStr
 
 	XMP_Node * newQual = 0;
 
-	newQual = new XMP_Node ( xmpParent, name, value, kXMP_PropIsQualifier );
+	newQual = new ( xmpParent ) XMP_Node ( xmpParent, name, value, kXMP_PropIsQualifier );
 
 	if ( ! (isLang | isType) ) {
 		xmpParent->qualifiers.push_back ( newQual );
@@ -532,7 +546,7 @@ XMP_Node * RDF_Parser::AddQualifierNode ( XMP_Node * xmpParent, const XML_Node &
 {
 	if ( attr.ns.empty() ) {
 		XMP_Error error ( kXMPErr_BadRDF, "XML namespace required for all elements and attributes" );
-		this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+		this->NotifyError ( kXMPErrSev_Recoverable, error );
 		return 0;
 	}
 	
@@ -571,7 +585,7 @@ void RDF_Parser::FixupQualifiedNode ( XMP_Node * xmpParent )
 
 		if ( xmpParent->options & kXMP_PropHasLang ) {
 			XMP_Error error ( kXMPErr_BadXMP, "Duplicate xml:lang for rdf:value element" );
-			this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+			this->NotifyError ( kXMPErrSev_Recoverable, error );
 			XMP_Assert ( xmpParent->qualifiers[0]->name == "xml:lang" );
 			RemoveQualifier ( xmpParent, 0 );	// Use the rdf:value node's language.
 		}
@@ -579,6 +593,7 @@ void RDF_Parser::FixupQualifiedNode ( XMP_Node * xmpParent )
 		XMP_Node * langQual = valueNode->qualifiers[0];
 		
 		XMP_Assert ( langQual->name == "xml:lang" );
+		XMP_Assert ( langQual->FitsParent ( xmpParent ) );
 		langQual->parent = xmpParent;
 		xmpParent->options |= kXMP_PropHasLang;
 		XMP_ClearOption ( valueNode->options, kXMP_PropHasLang );
@@ -602,10 +617,11 @@ void RDF_Parser::FixupQualifiedNode ( XMP_Node * xmpParent )
 
 		if ( existingQual != 0 ) {
 			XMP_Error error ( kXMPErr_BadXMP, "Duplicate qualifier node" );
-			this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+			this->NotifyError ( kXMPErrSev_Recoverable, error );
 			RemoveQualifier ( xmpParent, existingPos );	// Use the rdf:value node's qualifier.
 		}
 
+		XMP_Assert ( currQual->FitsParent ( xmpParent ) );
 		currQual->parent = xmpParent;
 		xmpParent->qualifiers.push_back ( currQual );
 		valueNode->qualifiers[qualNum] = 0;	// We just moved it to the parent.
@@ -624,11 +640,12 @@ void RDF_Parser::FixupQualifiedNode ( XMP_Node * xmpParent )
 		
 		if ( FindQualifierNode ( xmpParent, currQual->name.c_str(), kXMP_ExistingOnly ) != 0 ) {
 			XMP_Error error ( kXMPErr_BadXMP, "Duplicate qualifier" );
-			this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+			this->NotifyError ( kXMPErrSev_Recoverable, error );
 			delete currQual;
 
 		} else {
 		
+			XMP_Assert ( currQual->FitsParent ( xmpParent ) );
 			currQual->options |= kXMP_PropIsQualifier;
 			currQual->parent = xmpParent;
 	
@@ -666,6 +683,7 @@ void RDF_Parser::FixupQualifiedNode ( XMP_Node * xmpParent )
 	
 	for ( childNum = 0, childLim = xmpParent->children.size(); childNum != childLim; ++childNum ) {
 		XMP_Node * currChild = xmpParent->children[childNum];
+		XMP_Assert ( currChild->FitsParent ( xmpParent ) );
 		currChild->parent = xmpParent;
 	}
 
@@ -690,7 +708,7 @@ void RDF_Parser::RDF ( XMP_Node * xmpTree, const XML_Node & xmlNode )
 
 	if ( ! xmlNode.attrs.empty() ) {
 		XMP_Error error ( kXMPErr_BadRDF, "Invalid attributes of rdf:RDF element" );
-		this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+		this->NotifyError ( kXMPErrSev_Recoverable, error );
 	}
 	this->NodeElementList ( xmpTree, xmlNode, kIsTopLevel );	// ! Attributes are ignored.
 
@@ -737,10 +755,10 @@ void RDF_Parser::NodeElement ( XMP_Node * xmpParent, const XML_Node & xmlNode, b
 	RDFTermKind nodeTerm = GetRDFTermKind ( xmlNode.name );
 	if ( (nodeTerm != kRDFTerm_Description) && (nodeTerm != kRDFTerm_Other) ) {
 		XMP_Error error ( kXMPErr_BadRDF, "Node element must be rdf:Description or typedNode" );
-		this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+		this->NotifyError ( kXMPErrSev_Recoverable, error );
 	} else if ( isTopLevel && (nodeTerm == kRDFTerm_Other) ) {
 		XMP_Error error ( kXMPErr_BadXMP, "Top level typedNode not allowed" );
-		this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+		this->NotifyError ( kXMPErrSev_Recoverable, error );
 	} else {
 		this->NodeElementAttrs ( xmpParent, xmlNode, isTopLevel );
 		this->PropertyElementList ( xmpParent, xmlNode, isTopLevel );
@@ -786,7 +804,7 @@ void RDF_Parser::NodeElementAttrs ( XMP_Node * xmpParent, const XML_Node & xmlNo
 
 				if ( exclusiveAttrs & kExclusiveAttrMask ) {
 					XMP_Error error ( kXMPErr_BadRDF, "Mutally exclusive about, ID, nodeID attributes" );
-					this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+					this->NotifyError ( kXMPErrSev_Recoverable, error );
 					continue;	// Skip the later mutually exclusive attributes.
 				}
 				exclusiveAttrs |= (1 << attrTerm);
@@ -800,7 +818,7 @@ void RDF_Parser::NodeElementAttrs ( XMP_Node * xmpParent, const XML_Node & xmlNo
 					} else if ( ! (*currAttr)->value.empty() ) {
 						if ( xmpParent->name != (*currAttr)->value ) {
 							XMP_Error error ( kXMPErr_BadXMP, "Mismatched top level rdf:about values" );
-							this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+							this->NotifyError ( kXMPErrSev_Recoverable, error );
 						}
 					}
 				}
@@ -814,7 +832,7 @@ void RDF_Parser::NodeElementAttrs ( XMP_Node * xmpParent, const XML_Node & xmlNo
 			default :
 				{
 					XMP_Error error ( kXMPErr_BadRDF, "Invalid nodeElement attribute" );
-					this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+					this->NotifyError ( kXMPErrSev_Recoverable, error );
 				}
 				continue;
 
@@ -840,7 +858,7 @@ void RDF_Parser::PropertyElementList ( XMP_Node * xmpParent, const XML_Node & xm
 		if ( (*currChild)->IsWhitespaceNode() ) continue;
 		if ( (*currChild)->kind != kElemNode ) {
 			XMP_Error error ( kXMPErr_BadRDF, "Expected property element node not found" );
-			this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+			this->NotifyError ( kXMPErrSev_Recoverable, error );
 			continue;
 		}
 		this->PropertyElement ( xmpParent, **currChild, isTopLevel );
@@ -903,7 +921,7 @@ void RDF_Parser::PropertyElement ( XMP_Node * xmpParent, const XML_Node & xmlNod
 	RDFTermKind nodeTerm = GetRDFTermKind ( xmlNode.name );
 	if ( ! IsPropertyElementName ( nodeTerm ) ) {
 		XMP_Error error ( kXMPErr_BadRDF, "Invalid property element name" );
-		this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+		this->NotifyError ( kXMPErrSev_Recoverable, error );
 		return;
 	}
 	
@@ -1007,7 +1025,7 @@ void RDF_Parser::ResourcePropertyElement ( XMP_Node * xmpParent, const XML_Node
 			continue;	// Ignore all rdf:ID attributes.
 		} else {
 			XMP_Error error ( kXMPErr_BadRDF, "Invalid attribute for resource property element" );
-			this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+			this->NotifyError ( kXMPErrSev_Recoverable, error );
 			continue;
 		}
 	}
@@ -1020,12 +1038,12 @@ void RDF_Parser::ResourcePropertyElement ( XMP_Node * xmpParent, const XML_Node
 	}
 	if ( currChild == endChild ) {
 		XMP_Error error ( kXMPErr_BadRDF, "Missing child of resource property element" );
-		this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+		this->NotifyError ( kXMPErrSev_Recoverable, error );
 		return;
 	}
 	if ( (*currChild)->kind != kElemNode ) {
 		XMP_Error error ( kXMPErr_BadRDF, "Children of resource property element must be XML elements" );
-		this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+		this->NotifyError ( kXMPErrSev_Recoverable, error );
 		return;
 	}
 
@@ -1042,7 +1060,7 @@ void RDF_Parser::ResourcePropertyElement ( XMP_Node * xmpParent, const XML_Node
 			size_t colonPos = (*currChild)->name.find_first_of(':');
 			if ( colonPos == XMP_VarString::npos ) {
 				XMP_Error error ( kXMPErr_BadXMP, "All XML elements must be in a namespace" );
-				this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+				this->NotifyError ( kXMPErrSev_Recoverable, error );
 				return;
 			}
 			typeName.append ( (*currChild)->name, colonPos+1, XMP_VarString::npos );	// Append just the local name.
@@ -1062,7 +1080,7 @@ void RDF_Parser::ResourcePropertyElement ( XMP_Node * xmpParent, const XML_Node
 	for ( ++currChild; currChild != endChild; ++currChild ) {
 		if ( ! (*currChild)->IsWhitespaceNode() ) {
 			XMP_Error error ( kXMPErr_BadRDF, "Invalid child of resource property element" );
-			this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+			this->NotifyError ( kXMPErrSev_Recoverable, error );
 			break;	// Don't bother looking for more trailing errors.
 		}
 	}
@@ -1096,7 +1114,7 @@ void RDF_Parser::LiteralPropertyElement ( XMP_Node * xmpParent, const XML_Node &
 			continue; 	// Ignore all rdf:ID and rdf:datatype attributes.
 		} else {
 			XMP_Error error ( kXMPErr_BadRDF, "Invalid attribute for literal property element" );
-			this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+			this->NotifyError ( kXMPErrSev_Recoverable, error );
 			continue;
 		}
 	}
@@ -1110,7 +1128,7 @@ void RDF_Parser::LiteralPropertyElement ( XMP_Node * xmpParent, const XML_Node &
 			textSize += (*currChild)->value.size();
 		} else {
 			XMP_Error error ( kXMPErr_BadRDF, "Invalid child of literal property element" );
-			this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+			this->NotifyError ( kXMPErrSev_Recoverable, error );
 		}
 	}
 	
@@ -1135,7 +1153,7 @@ void RDF_Parser::ParseTypeLiteralPropertyElement ( XMP_Node * xmpParent, const X
 {
 	IgnoreParam(xmpParent); IgnoreParam(xmlNode); IgnoreParam(isTopLevel); 
 	XMP_Error error ( kXMPErr_BadXMP, "ParseTypeLiteral property element not allowed" );
-	this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+	this->NotifyError ( kXMPErrSev_Recoverable, error );
 
 }	// RDF_Parser::ParseTypeLiteralPropertyElement
 
@@ -1170,7 +1188,7 @@ void RDF_Parser::ParseTypeResourcePropertyElement ( XMP_Node * xmpParent, const
 			continue;	// Ignore all rdf:ID attributes.
 		} else {
 			XMP_Error error ( kXMPErr_BadRDF, "Invalid attribute for ParseTypeResource property element" );
-			this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+			this->NotifyError ( kXMPErrSev_Recoverable, error );
 			continue;
 		}
 	}
@@ -1196,7 +1214,7 @@ void RDF_Parser::ParseTypeCollectionPropertyElement ( XMP_Node * xmpParent, cons
 {
 	IgnoreParam(xmpParent); IgnoreParam(xmlNode); IgnoreParam(isTopLevel); 
 	XMP_Error error ( kXMPErr_BadXMP, "ParseTypeCollection property element not allowed" );
-	this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+	this->NotifyError ( kXMPErrSev_Recoverable, error );
 
 }	// RDF_Parser::ParseTypeCollectionPropertyElement
 
@@ -1213,7 +1231,7 @@ void RDF_Parser::ParseTypeOtherPropertyElement ( XMP_Node * xmpParent, const XML
 {
 	IgnoreParam(xmpParent); IgnoreParam(xmlNode); IgnoreParam(isTopLevel); 
 	XMP_Error error ( kXMPErr_BadXMP, "ParseTypeOther property element not allowed" );
-	this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+	this->NotifyError ( kXMPErrSev_Recoverable, error );
 
 }	// RDF_Parser::ParseTypeOtherPropertyElement
 
@@ -1261,7 +1279,7 @@ void RDF_Parser::EmptyPropertyElement ( XMP_Node * xmpParent, const XML_Node & x
 	
 	if ( ! xmlNode.content.empty() ) {
 		XMP_Error error ( kXMPErr_BadRDF, "Nested content not allowed with rdf:resource or property attributes" );
-		this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+		this->NotifyError ( kXMPErrSev_Recoverable, error );
 		return;
 	}
 	
@@ -1283,12 +1301,12 @@ void RDF_Parser::EmptyPropertyElement ( XMP_Node * xmpParent, const XML_Node & x
 			case kRDFTerm_resource :
 				if ( hasNodeIDAttr ) {
 					XMP_Error error ( kXMPErr_BadRDF, "Empty property element can't have both rdf:resource and rdf:nodeID" );
-					this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+					this->NotifyError ( kXMPErrSev_Recoverable, error );
 					return;
 				}
 				if ( hasValueAttr ) {
 					XMP_Error error ( kXMPErr_BadXMP, "Empty property element can't have both rdf:value and rdf:resource" );
-					this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+					this->NotifyError ( kXMPErrSev_Recoverable, error );
 					return;
 				}
 				hasResourceAttr = true;
@@ -1298,7 +1316,7 @@ void RDF_Parser::EmptyPropertyElement ( XMP_Node * xmpParent, const XML_Node & x
 			case kRDFTerm_nodeID :
 				if ( hasResourceAttr ) {
 					XMP_Error error ( kXMPErr_BadRDF, "Empty property element can't have both rdf:resource and rdf:nodeID" );
-					this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+					this->NotifyError ( kXMPErrSev_Recoverable, error );
 					return;
 				}
 				hasNodeIDAttr = true;
@@ -1308,7 +1326,7 @@ void RDF_Parser::EmptyPropertyElement ( XMP_Node * xmpParent, const XML_Node & x
 				if ( (*currAttr)->name == "rdf:value" ) {
 					if ( hasResourceAttr ) {
 						XMP_Error error ( kXMPErr_BadXMP, "Empty property element can't have both rdf:value and rdf:resource" );
-						this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+						this->NotifyError ( kXMPErrSev_Recoverable, error );
 						return;
 					}
 					hasValueAttr = true;
@@ -1321,7 +1339,7 @@ void RDF_Parser::EmptyPropertyElement ( XMP_Node * xmpParent, const XML_Node & x
 			default :
 				{
 					XMP_Error error ( kXMPErr_BadRDF, "Unrecognized attribute of empty property element" );
-					this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+					this->NotifyError ( kXMPErrSev_Recoverable, error );
 				}
 				
 				return;
@@ -1375,7 +1393,7 @@ void RDF_Parser::EmptyPropertyElement ( XMP_Node * xmpParent, const XML_Node & x
 			default :
 				{
 					XMP_Error error ( kXMPErr_BadRDF, "Unrecognized attribute of empty property element" );
-					this->errorCallback->NotifyClient ( kXMPErrSev_Recoverable, error );
+					this->NotifyError ( kXMPErrSev_Recoverable, error );
 				}
 				continue;
 
@@ -1402,3 +1420,501 @@ void XMPMeta::ProcessRDF ( const XML_Node & rdfNode, XMP_OptionBits options )
 }	// XMPMeta::ProcessRDF
 
 // =================================================================================================
+// RDF_StreamParser
+// ================
+//
+// The single pass RDF recognizer. It is driven by the XML parser events and builds the XMP tree
+// directly, only the open XML elements exist. The lookahead of the recursive descent parser is
+// replaced by deferring decisions: a property element without telling attributes is held as pending
+// until its content shows whether it is a literal, resource, or empty property element.
+//
+// Only well formed XMP is handled. Anything the two pass parser would complain about, or that needs
+// the whole XML tree such as picking among several rdf:RDF elements, aborts the stream parse. The
+// packet is then parsed again with the two pass parser, which does the error reporting.
+
+enum {	// Kinds of open XML elements for the stream parser.
+	kStreamElem_Outside,		// Outside of the rdf:RDF element, or inside an unused one.
+	kStreamElem_RDF,			// The rdf:RDF element, containing the top level node elements.
+	kStreamElem_Node,			// An rdf:Description or typed node, containing property elements.
+	kStreamElem_PendingProp,	// A property element that might be literal, resource, or empty.
+	kStreamElem_LiteralProp,	// A literal property element, collecting the text value.
+	kStreamElem_EmptyProp,		// An empty property element, already in the XMP tree.
+	kStreamElem_ResourceProp,	// A resource property element, its node element has been seen.
+	kStreamElem_StructProp,		// An rdf:parseType="Resource" property element.
+	kStreamElem_Ignored			// Content that is stripped, e.g. iX:changes.
+};
+
+struct RDF_StreamElem {
+	XMP_Uns8		 kind;
+	bool			 isTopLevel;
+	bool			 hasContent;	// Character data has been seen.
+	XMP_Node *		 xmpParent;		// The parent of this element's XMP node.
+	XMP_Node *		 xmpNode;		// The XMP node for this element, the parent of nested properties.
+	const XML_Node * xmlNode;
+	XMP_VarString	 text;
+	RDF_StreamElem() : kind(kStreamElem_Outside), isTopLevel(false), hasContent(false),
+	                   xmpParent(0), xmpNode(0), xmlNode(0) {};
+};
+
+class RDF_StreamParser : public RDF_Parser, public XMLEventSink {
+public:
+
+	bool foundRoot;	// A usable rdf:RDF element was found.
+
+	void StartElement ( const XML_Node & xmlNode );
+	void EndElement ( const XML_Node & xmlNode );
+	void CharacterData ( XMP_StringPtr cData, size_t len );
+	void ProcessingInstruction ( XMP_StringPtr target, XMP_StringPtr data );
+
+	RDF_StreamParser ( XMP_Node * _xmpTree, XMP_OptionBits _options, XMPMeta::ErrorCallbackInfo * ec )
+		: RDF_Parser(ec), foundRoot(false), xmpTree(_xmpTree), options(_options), rootCount(0), depth(0)
+	{
+		this->abortOnError = true;
+	};
+
+private:
+
+	XMP_Node *		xmpTree;
+	XMP_OptionBits	options;
+	size_t			rootCount;
+	size_t			depth;	// The number of open elements, the used portion of elemStack.
+	std::vector < RDF_StreamElem > elemStack;	// ! Entries are reused, to keep their text buffers.
+
+	bool CheckErrors() { if ( this->sawError ) this->aborted = true; return this->aborted; };
+
+	RDF_StreamElem & PushElem ( XMP_Uns8 kind, const XML_Node & xmlNode );
+
+	void StartPropertyElement ( XMP_Node * xmpParent, const XML_Node & xmlNode, bool isTopLevel );
+	void StartResourceNode ( const XML_Node & xmlNode );
+	void FinishLiteral ( RDF_StreamElem & propElem );
+
+};
+
+// -------------------------------------------------------------------------------------------------
+
+static bool
+IsWhitespaceText ( XMP_StringPtr cData, size_t len )
+{
+	for ( size_t i = 0; i < len; ++i ) {
+		if ( ! IsWhitespaceChar ( cData[i] ) ) return false;
+	}
+	return true;
+}
+
+// =================================================================================================
+// RDF_StreamParser::PushElem
+// ==========================
+
+RDF_StreamElem & RDF_StreamParser::PushElem ( XMP_Uns8 kind, const XML_Node & xmlNode )
+{
+
+	if ( this->depth == this->elemStack.size() ) this->elemStack.push_back ( RDF_StreamElem() );
+	RDF_StreamElem & elem = this->elemStack[this->depth];
+	++this->depth;
+
+	elem.kind = kind;
+	elem.isTopLevel = false;
+	elem.hasContent = false;
+	elem.xmpParent = 0;
+	elem.xmpNode = 0;
+	elem.xmlNode = &xmlNode;
+	elem.text.erase();
+
+	return elem;
+
+}	// RDF_StreamParser::PushElem
+
+// =================================================================================================
+// RDF_StreamParser::StartElement
+// ==============================
+
+void RDF_StreamParser::StartElement ( const XML_Node & xmlNode )
+{
+
+	if ( xmlNode.name == "rdf:RDF" ) {
+		++this->rootCount;	// Choosing among several roots needs the whole XML tree.
+		if ( this->rootCount > 1 ) {
+			this->aborted = true;
+			return;
+		}
+	}
+
+	XMP_Uns8 parentKind = kStreamElem_Outside;
+	if ( this->depth > 0 ) parentKind = this->elemStack[this->depth-1].kind;
+
+	switch ( parentKind ) {
+
+		case kStreamElem_Outside :
+			if ( xmlNode.name != "rdf:RDF" ) {
+				this->PushElem ( kStreamElem_Outside, xmlNode );
+			} else if ( (this->options & kXMP_RequireXMPMeta) &&
+			            ((xmlNode.parent == 0) ||
+			             ((xmlNode.parent->name != "x:xmpmeta") && (xmlNode.parent->name != "x:xapmeta"))) ) {
+				this->PushElem ( kStreamElem_Outside, xmlNode );	// Not a usable root, the XMP stays empty.
+			} else if ( ! xmlNode.attrs.empty() ) {
+				this->aborted = true;	// Invalid attributes of rdf:RDF element.
+			} else {
+				this->foundRoot = true;
+				this->PushElem ( kStreamElem_RDF, xmlNode );
+			}
+			break;
+
+		case kStreamElem_Ignored :
+			this->PushElem ( kStreamElem_Ignored, xmlNode );
+			break;
+
+		case kStreamElem_RDF :
+			if ( GetRDFTermKind ( xmlNode.name ) != kRDFTerm_Description ) {
+				this->aborted = true;	// Top level node elements must be rdf:Description.
+			} else {
+				this->NodeElementAttrs ( this->xmpTree, xmlNode, kIsTopLevel );
+				if ( this->CheckErrors() ) return;
+				RDF_StreamElem & nodeElem = this->PushElem ( kStreamElem_Node, xmlNode );
+				nodeElem.isTopLevel = true;
+				nodeElem.xmpNode = this->xmpTree;
+			}
+			break;
+
+		case kStreamElem_Node :
+		case kStreamElem_StructProp :
+			{
+				const RDF_StreamElem & parent = this->elemStack[this->depth-1];
+				const bool isTopLevel = (parentKind == kStreamElem_Node) && parent.isTopLevel;
+				this->StartPropertyElement ( parent.xmpNode, xmlNode, isTopLevel );
+			}
+			break;
+
+		case kStreamElem_PendingProp :
+			this->StartResourceNode ( xmlNode );
+			break;
+
+		default :	// Literal, empty, or resource property elements can't have more child elements.
+			this->aborted = true;
+			break;
+
+	}
+
+}	// RDF_StreamParser::StartElement
+
+// =================================================================================================
+// RDF_StreamParser::StartPropertyElement
+// ======================================
+//
+// The first part of RDF_Parser::PropertyElement. The attributes tell the kind of property element,
+// except for one with only rdf:ID and xml:lang attributes. That is pending until its content is seen.
+
+void RDF_StreamParser::StartPropertyElement ( XMP_Node * xmpParent, const XML_Node & xmlNode, bool isTopLevel )
+{
+	
+	if ( ! IsPropertyElementName ( GetRDFTermKind ( xmlNode.name ) ) ) {
+		this->aborted = true;	// Invalid property element name.
+		return;
+	}
+
+	XMP_Uns8 kind = kStreamElem_PendingProp;
+	const size_t attrLim = xmlNode.attrs.size();
+
+	if ( attrLim > 3 ) {
+
+		kind = kStreamElem_EmptyProp;	// Only an emptyPropertyElt can have more than 3 attributes.
+
+	} else {
+
+		size_t attrNum = 0;
+		for ( ; attrNum < attrLim; ++attrNum ) {
+			const XMP_VarString & attrName = xmlNode.attrs[attrNum]->name;
+			if ( (attrName != "xml:lang") && (attrName != "rdf:ID") ) break;
+		}
+
+		if ( attrNum < attrLim ) {
+			const XML_Node * currAttr = xmlNode.attrs[attrNum];
+			if ( currAttr->name == "rdf:datatype" ) {
+				kind = kStreamElem_LiteralProp;
+			} else if ( currAttr->name != "rdf:parseType" ) {
+				kind = kStreamElem_EmptyProp;
+			} else if ( currAttr->value == "Resource" ) {
+				kind = kStreamElem_StructProp;
+			} else {
+				this->aborted = true;	// Literal, Collection, and other parse types are not allowed.
+				return;
+			}
+		}
+
+	}
+
+	RDF_StreamElem & propElem = this->PushElem ( kind, xmlNode );
+	propElem.xmpParent  = xmpParent;
+	propElem.isTopLevel = isTopLevel;
+
+	if ( kind == kStreamElem_EmptyProp ) {
+
+		this->EmptyPropertyElement ( xmpParent, xmlNode, isTopLevel );	// ! Any content will abort.
+		(void) this->CheckErrors();
+
+	} else if ( kind == kStreamElem_StructProp ) {
+
+		// The start of RDF_Parser::ParseTypeResourcePropertyElement, the fields are nested elements.
+
+		XMP_Node * newStruct = this->AddChildNode ( xmpParent, xmlNode, "", isTopLevel );
+		if ( (newStruct == 0) || this->CheckErrors() ) {
+			this->aborted = true;
+			return;
+		}
+		newStruct->options |= kXMP_PropValueIsStruct;
+		propElem.xmpNode = newStruct;
+
+		for ( size_t attrNum = 0; attrNum < attrLim; ++attrNum ) {
+			const XML_Node * currAttr = xmlNode.attrs[attrNum];
+			if ( currAttr->name == "xml:lang" ) {
+				this->AddQualifierNode ( newStruct, *currAttr );
+			} else if ( (currAttr->name != "rdf:parseType") && (currAttr->name != "rdf:ID") ) {
+				this->aborted = true;	// Invalid attribute for ParseTypeResource property element.
+				return;
+			}
+		}
+		(void) this->CheckErrors();
+
+	}
+
+}	// RDF_StreamParser::StartPropertyElement
+
+// =================================================================================================
+// RDF_StreamParser::StartResourceNode
+// ===================================
+//
+// A pending property element has a child element, it is a resource property element. This is the
+// first part of RDF_Parser::ResourcePropertyElement, plus the node element attributes.
+
+void RDF_StreamParser::StartResourceNode ( const XML_Node & xmlNode )
+{
+	RDF_StreamElem & propElem = this->elemStack[this->depth-1];
+	const XML_Node & propNode = *propElem.xmlNode;
+	
+	if ( ! IsWhitespaceText ( propElem.text.c_str(), propElem.text.size() ) ) {
+		this->aborted = true;	// Children of resource property element must be XML elements.
+		return;
+	}
+	
+	if ( propElem.isTopLevel && (propNode.name == "iX:changes") ) {	// Strip old "punchcard" chaff.
+		propElem.kind = kStreamElem_Ignored;
+		this->PushElem ( kStreamElem_Ignored, xmlNode );
+		return;
+	}
+
+	XMP_Node * newCompound = this->AddChildNode ( propElem.xmpParent, propNode, "", propElem.isTopLevel );
+	if ( (newCompound == 0) || this->CheckErrors() ) {
+		this->aborted = true;
+		return;
+	}
+	
+	for ( size_t attrNum = 0, attrLim = propNode.attrs.size(); attrNum < attrLim; ++attrNum ) {
+		const XML_Node * currAttr = propNode.attrs[attrNum];
+		if ( currAttr->name == "xml:lang" ) {
+			this->AddQualifierNode ( newCompound, *currAttr );
+		} else if ( currAttr->name != "rdf:ID" ) {
+			this->aborted = true;	// Invalid attribute for resource property element.
+			return;
+		}
+	}
+
+	if ( xmlNode.name == "rdf:Bag" ) {
+		newCompound->options |= kXMP_PropValueIsArray;
+	} else if ( xmlNode.name == "rdf:Seq" ) {
+		newCompound->options |= kXMP_PropValueIsArray | kXMP_PropArrayIsOrdered;
+	} else if ( xmlNode.name == "rdf:Alt" ) {
+		newCompound->options |= kXMP_PropValueIsArray | kXMP_PropArrayIsOrdered | kXMP_PropArrayIsAlternate;
+	} else {
+		// This is the Typed Node case. Add an rdf:type qualifier with a URI value.
+		if ( xmlNode.name != "rdf:Description" ) {
+			size_t colonPos = xmlNode.name.find_first_of(':');
+			if ( colonPos == XMP_VarString::npos ) {
+				this->aborted = true;	// All XML elements must be in a namespace.
+				return;
+			}
+			XMP_VarString typeName ( xmlNode.ns );
+			typeName.append ( xmlNode.name, colonPos+1, XMP_VarString::npos );	// Append just the local name.
+			XMP_Node * typeQual = this->AddQualifierNode ( newCompound, XMP_VarString("rdf:type"), typeName );
+			if ( typeQual != 0 ) typeQual->options |= kXMP_PropValueIsURI;
+		}
+		newCompound->options |= kXMP_PropValueIsStruct;
+	}
+
+	RDFTermKind nodeTerm = GetRDFTermKind ( xmlNode.name );
+	if ( (nodeTerm != kRDFTerm_Description) && (nodeTerm != kRDFTerm_Other) ) {
+		this->aborted = true;	// Node element must be rdf:Description or typedNode.
+		return;
+	}
+	this->NodeElementAttrs ( newCompound, xmlNode, kNotTopLevel );
+	if ( this->CheckErrors() ) return;
+
+	propElem.kind = kStreamElem_ResourceProp;
+	propElem.xmpNode = newCompound;
+
+	RDF_StreamElem & nodeElem = this->PushElem ( kStreamElem_Node, xmlNode );	// ! Might move propElem.
+	nodeElem.xmpNode = newCompound;
+
+}	// RDF_StreamParser::StartResourceNode
+
+// =================================================================================================
+// RDF_StreamParser::FinishLiteral
+// ===============================
+//
+// The same as RDF_Parser::LiteralPropertyElement, using the collected text.
+
+void RDF_StreamParser::FinishLiteral ( RDF_StreamElem & propElem )
+{
+	const XML_Node & propNode = *propElem.xmlNode;
+
+	XMP_Node * newChild = this->AddChildNode ( propElem.xmpParent, propNode, "", propElem.isTopLevel );
+	if ( (newChild == 0) || this->CheckErrors() ) {
+		this->aborted = true;
+		return;
+	}
+	
+	for ( size_t attrNum = 0, attrLim = propNode.attrs.size(); attrNum < attrLim; ++attrNum ) {
+		const XML_Node * currAttr = propNode.attrs[attrNum];
+		if ( currAttr->name == "xml:lang" ) {
+			this->AddQualifierNode ( newChild, *currAttr );
+		} else if ( (currAttr->name != "rdf:ID") && (currAttr->name != "rdf:datatype") ) {
+			this->aborted = true;	// Invalid attribute for literal property element.
+			return;
+		}
+	}
+	
+	newChild->value.assign ( propElem.text );
+	(void) this->CheckErrors();
+
+}	// RDF_StreamParser::FinishLiteral
+
+// =================================================================================================
+// RDF_StreamParser::EndElement
+// ============================
+
+void RDF_StreamParser::EndElement ( const XML_Node & xmlNode )
+{
+	IgnoreParam ( xmlNode );
+
+	XMP_Assert ( this->depth > 0 );
+	if ( this->depth == 0 ) return;
+	RDF_StreamElem & elem = this->elemStack[this->depth-1];
+	XMP_Assert ( elem.xmlNode == &xmlNode );
+
+	switch ( elem.kind ) {
+
+		case kStreamElem_PendingProp :
+			if ( ! elem.hasContent ) {
+				this->EmptyPropertyElement ( elem.xmpParent, *elem.xmlNode, elem.isTopLevel );
+				(void) this->CheckErrors();
+			} else {
+				this->FinishLiteral ( elem );	// ! Only character data, it is a literal.
+			}
+			break;
+
+		case kStreamElem_LiteralProp :
+			this->FinishLiteral ( elem );
+			break;
+
+		case kStreamElem_ResourceProp :
+			if ( elem.xmpNode->options & kRDF_HasValueElem ) {
+				this->FixupQualifiedNode ( elem.xmpNode );
+			} else if ( elem.xmpNode->options & kXMP_PropArrayIsAlternate ) {
+				DetectAltText ( elem.xmpNode );
+			}
+			(void) this->CheckErrors();
+			break;
+
+		case kStreamElem_StructProp :
+			if ( elem.xmpNode->options & kRDF_HasValueElem ) this->FixupQualifiedNode ( elem.xmpNode );
+			(void) this->CheckErrors();
+			break;
+
+		default :
+			break;
+
+	}
+
+	--this->depth;
+
+}	// RDF_StreamParser::EndElement
+
+// =================================================================================================
+// RDF_StreamParser::CharacterData
+// ===============================
+
+void RDF_StreamParser::CharacterData ( XMP_StringPtr cData, size_t len )
+{
+	if ( this->depth == 0 ) return;
+	RDF_StreamElem & elem = this->elemStack[this->depth-1];
+
+	switch ( elem.kind ) {
+
+		case kStreamElem_Outside :
+		case kStreamElem_Ignored :
+			break;
+
+		case kStreamElem_PendingProp :
+		case kStreamElem_LiteralProp :
+			elem.text.append ( cData, len );
+			elem.hasContent = true;
+			break;
+
+		case kStreamElem_EmptyProp :
+			this->aborted = true;	// Nested content not allowed with rdf:resource or property attributes.
+			break;
+
+		default :
+			if ( ! IsWhitespaceText ( cData, len ) ) this->aborted = true;	// Only elements are allowed.
+			break;
+
+	}
+
+}	// RDF_StreamParser::CharacterData
+
+// =================================================================================================
+// RDF_StreamParser::ProcessingInstruction
+// =======================================
+
+void RDF_StreamParser::ProcessingInstruction ( XMP_StringPtr target, XMP_StringPtr data )
+{
+	IgnoreParam ( target ); IgnoreParam ( data );
+
+	if ( this->depth == 0 ) return;
+	XMP_Uns8 kind = this->elemStack[this->depth-1].kind;
+	if ( (kind != kStreamElem_Outside) && (kind != kStreamElem_Ignored) ) this->aborted = true;
+
+}	// RDF_StreamParser::ProcessingInstruction
+
+// =================================================================================================
+// XMPMeta::ProcessRDFStream
+// =========================
+//
+// Parse a complete XMP packet in a single pass, building the XMP tree straight from the XML parser
+// events. Returns false if the stream parser gave up, the XMP tree must then be cleared and the
+// packet parsed again the usual way.
+
+bool XMPMeta::ProcessRDFStream ( XMP_StringPtr buffer, XMP_StringLen xmpSize, XMP_OptionBits options, bool * foundRoot )
+{
+	RDF_StreamParser rdfParser ( &this->tree, options, &this->errorCallback );
+
+	XMP_Assert ( this->xmlParser == 0 );
+	this->xmlParser = XMP_NewExpatAdapter ( ExpatAdapter::kUseGlobalNamespaces );
+	this->xmlParser->SetErrorCallback ( &this->errorCallback );
+	this->xmlParser->eventSink = &rdfParser;
+
+	try {
+		(void) this->ProcessXMLBuffer ( buffer, xmpSize, true );
+	} catch ( ... ) {
+		delete this->xmlParser;	// ! Before the stream parser goes away.
+		this->xmlParser = 0;
+		throw;
+	}
+
+	delete this->xmlParser;
+	this->xmlParser = 0;
+
+	*foundRoot = rdfParser.foundRoot;
+	return (! rdfParser.aborted);
+
+}	// XMPMeta::ProcessRDFStream
+
+// =================================================================================================
@@ -9,6 +9,8 @@
 #include "public/include/XMP_Environment.h"	// ! This must be the first include!
 #include "public/include/XMP_Const.h"
 
+#include <algorithm>
+
 #include "public/include/client-glue/WXMPMeta.hpp"
 
 #include "XMPCore/source/XMPCore_Impl.hpp"
@@ -29,6 +31,42 @@
 	#endif
 #endif
 
+// =================================================================================================
+// XMP_ReadLockAll
+// ===============
+//
+// Holds the read locks of a list of XMP objects. Each lock is taken once, in address order, the
+// list can have the same object more than once.
+
+class XMP_ReadLockAll {
+public:
+
+	XMP_ReadLockAll() : lockedCount(0) {};
+	~XMP_ReadLockAll()
+	{
+		while ( this->lockedCount > 0 ) this->locks[--this->lockedCount]->Release();
+	}
+
+	void Acquire ( const XMPMeta * const * metas, XMP_Uns32 metaCount )
+	{
+		this->locks.reserve ( metaCount );
+		for ( XMP_Uns32 metaNum = 0; metaNum < metaCount; ++metaNum ) {
+			this->locks.push_back ( (XMP_ReadWriteLock*) &metas[metaNum]->lock );
+		}
+		std::sort ( this->locks.begin(), this->locks.end() );
+		this->locks.erase ( std::unique ( this->locks.begin(), this->locks.end() ), this->locks.end() );
+		for ( ; this->lockedCount < this->locks.size(); ++this->lockedCount ) {
+			this->locks[this->lockedCount]->Acquire ( kXMP_ReadLock );
+		}
+	}
+
+private:
+
+	std::vector<XMP_ReadWriteLock*> locks;
+	size_t lockedCount;
+
+};
+
 #if __cplusplus
 extern "C" {
 #endif
@@ -274,6 +312,123 @@ WXMPMeta_GetProperty_1 ( XMPMetaRef		  xmpObjRef,
 
 // -------------------------------------------------------------------------------------------------
 
+/* class static */ void
+WXMPMeta_ResolvePropertyAtom_1 ( XMP_StringPtr schemaNS,
+								 XMP_StringPtr propName,
+								 WXMP_Result * wResult )
+{
+	XMP_ENTER_Static ( "WXMPMeta_ResolvePropertyAtom_1" )
+	
+		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
+		if ( (propName == 0) || (*propName == 0) ) XMP_Throw ( "Empty property name", kXMPErr_BadXPath );
+
+		XMP_PropertyAtom * propAtom = XMPMeta::ResolvePropertyAtom ( schemaNS, propName );
+		wResult->ptrResult = propAtom;
+
+	XMP_EXIT
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/* class static */ void
+WXMPMeta_ReleasePropertyAtom_1 ( XMPPropertyAtomRef propAtom,
+								 WXMP_Result *		wResult )
+{
+	XMP_ENTER_Static ( "WXMPMeta_ReleasePropertyAtom_1" )
+
+		delete ( (XMP_PropertyAtom*)propAtom );
+
+	XMP_EXIT
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void
+WXMPMeta_GetPropertyByAtom_1 ( XMPMetaRef		  xmpObjRef,
+							   XMPPropertyAtomRef propAtom,
+							   void *             propValue,
+							   XMP_OptionBits *   options,
+							   SetClientStringProc SetClientString,
+							   WXMP_Result *	  wResult ) /* const */
+{
+	XMP_ENTER_ObjRead ( XMPMeta, "WXMPMeta_GetPropertyByAtom_1" )
+	
+		if ( propAtom == 0 ) XMP_Throw ( "Null property atom", kXMPErr_BadParam );
+		
+		XMP_StringPtr valuePtr = 0;
+		XMP_StringLen valueSize = 0;
+
+		XMP_OptionBits voidOptionBits = 0;
+		if ( options == 0 ) options = &voidOptionBits;
+
+		bool found = thiz.GetPropertyByAtom ( *((XMP_PropertyAtom*)propAtom), &valuePtr, &valueSize, options );
+		wResult->int32Result = found;
+		
+		if ( found && (propValue != 0) ) (*SetClientString) ( propValue, valuePtr, valueSize );
+
+	XMP_EXIT
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void
+WXMPMeta_SetPropertyByAtom_1 ( XMPMetaRef		  xmpObjRef,
+							   XMPPropertyAtomRef propAtom,
+							   XMP_StringPtr	  propValue,
+							   XMP_OptionBits	  options,
+							   WXMP_Result *	  wResult )
+{
+	XMP_ENTER_ObjWrite ( XMPMeta, "WXMPMeta_SetPropertyByAtom_1" )
+
+		if ( propAtom == 0 ) XMP_Throw ( "Null property atom", kXMPErr_BadParam );
+
+		thiz->SetPropertyByAtom ( *((XMP_PropertyAtom*)propAtom), propValue, options );
+		
+	XMP_EXIT
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/* class static */ void
+WXMPMeta_GetPropertiesByAtom_1 ( const XMPMetaRef *			xmpRefs,
+								 XMP_Uns32					metaCount,
+								 const XMPPropertyAtomRef *	propAtoms,
+								 XMP_Uns32					atomCount,
+								 XMP_Uns32 *				valueOffsets,
+								 char *						valueBytes,
+								 XMP_Uns32					bytesSize,
+								 XMP_OptionBits *			options,
+								 XMP_Uns8 *					presentBits,
+								 WXMP_Result *				wResult )
+{
+	XMP_ENTER_Static ( "WXMPMeta_GetPropertiesByAtom_1" )
+
+		if ( (metaCount != 0) && (xmpRefs == 0) ) XMP_Throw ( "Null XMP object list", kXMPErr_BadParam );
+		if ( (atomCount != 0) && (propAtoms == 0) ) XMP_Throw ( "Null property atom list", kXMPErr_BadParam );
+		if ( valueOffsets == 0 ) XMP_Throw ( "Null value offsets", kXMPErr_BadParam );
+		if ( (valueBytes == 0) && (bytesSize != 0) ) XMP_Throw ( "Null value buffer", kXMPErr_BadParam );
+
+		for ( XMP_Uns32 metaNum = 0; metaNum < metaCount; ++metaNum ) {
+			if ( xmpRefs[metaNum] == 0 ) XMP_Throw ( "Null XMP object", kXMPErr_BadParam );
+		}
+		for ( XMP_Uns32 atomNum = 0; atomNum < atomCount; ++atomNum ) {
+			if ( propAtoms[atomNum] == 0 ) XMP_Throw ( "Null property atom", kXMPErr_BadParam );
+		}
+
+		const XMPMeta * const * metas = (const XMPMeta * const *) xmpRefs;
+
+		XMP_ReadLockAll metaLocks;
+		metaLocks.Acquire ( metas, metaCount );
+
+		wResult->int32Result = XMPMeta::GetPropertiesByAtom ( metas, metaCount,
+															   (const XMP_PropertyAtom * const *) propAtoms, atomCount,
+															   valueOffsets, valueBytes, bytesSize, options, presentBits );
+
+	XMP_EXIT
+}
+
+// -------------------------------------------------------------------------------------------------
+
 void
 WXMPMeta_GetArrayItem_1 ( XMPMetaRef	   xmpObjRef,
 						  XMP_StringPtr	   schemaNS,
@@ -267,7 +267,7 @@ FindIndexedItem ( XMP_Node * arrayNode, const XMP_VarString & indexStep, bool cr
 	if ( index < 0 ) XMP_Throw ( "Array index must be larger than zero", kXMPErr_BadXPath );
 
 	if ( (index == (XMP_Index)arrayNode->children.size()) && createNodes ) {	// Append a new last+1 node.
-		XMP_Node * newItem = new XMP_Node ( arrayNode, kXMP_ArrayItemName, kXMP_NewImplicitNode );
+		XMP_Node * newItem = new ( arrayNode ) XMP_Node ( arrayNode, kXMP_ArrayItemName, kXMP_NewImplicitNode );
 		arrayNode->children.push_back ( newItem );
 	}
 
@@ -449,10 +449,10 @@ FollowXPathStep	( XMP_Node *	   parentNode,
 			XMP_Assert ( parentNode->options & kXMP_PropArrayIsAltText );
 			XMP_Assert ( (stepNum == 2) && (nextStep.step == "[?xml:lang=\"x-default\"]") );
 
-			nextNode = new XMP_Node ( parentNode, kXMP_ArrayItemName,
+			nextNode = new ( parentNode ) XMP_Node ( parentNode, kXMP_ArrayItemName,
 									  (kXMP_PropHasQualifiers | kXMP_PropHasLang | kXMP_NewImplicitNode) );
 
-			XMP_Node * langQual = new XMP_Node ( nextNode, "xml:lang", "x-default", kXMP_PropIsQualifier );
+			XMP_Node * langQual = new ( nextNode ) XMP_Node ( nextNode, "xml:lang", "x-default", kXMP_PropIsQualifier );
 			nextNode->qualifiers.push_back ( langQual );
 
 			if ( parentNode->children.empty() ) {
@@ -814,6 +814,364 @@ ExpandXPath	( XMP_StringPtr			schemaNS,
 
 }	// ExpandXPath
 
+// =================================================================================================
+// XMP_NodeArena
+// =============
+//
+// Every XMP_Node allocation is preceded by a block header telling where it came from, the owning
+// arena or the heap. The header also keeps the node aligned the way malloc would.
+
+union XMP_NodeBlockHeader {
+	XMP_NodeArena * arena;	// Zero for a heap node.
+	long double aligner;
+};
+
+enum { kXMP_NodeArenaMinChunk = 16, kXMP_NodeArenaMaxChunk = 1024 };	// Blocks per chunk.
+
+XMP_NodeArena::XMP_NodeArena()
+	: freeBlocks(0), nextBlock(0), chunkLimit(0),
+	  blockSize(sizeof(XMP_NodeBlockHeader) + sizeof(XMP_Node)), chunkBlocks(kXMP_NodeArenaMinChunk),
+	  releasing(false)
+{
+	const size_t alignment = sizeof(XMP_NodeBlockHeader);
+	this->blockSize = ((this->blockSize + alignment - 1) / alignment) * alignment;
+}
+
+XMP_NodeArena::~XMP_NodeArena()
+{
+	for ( size_t chunkNum = 0, chunkLim = this->chunks.size(); chunkNum < chunkLim; ++chunkNum ) {
+		::operator delete ( this->chunks[chunkNum] );
+	}
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void * XMP_NodeArena::Allocate()
+{
+	XMP_Assert ( ! this->releasing );
+	void * block = this->freeBlocks;
+
+	if ( block != 0 ) {
+
+		this->freeBlocks = *((void**)block);
+
+	} else {
+
+		if ( this->nextBlock == this->chunkLimit ) {
+			const size_t chunkSize = this->chunkBlocks * this->blockSize;
+			this->chunks.reserve ( this->chunks.size() + 1 );	// ! Don't leak the chunk if this throws.
+			char * newChunk = (char*) ::operator new ( chunkSize );
+			this->chunks.push_back ( newChunk );
+			this->nextBlock = newChunk;
+			this->chunkLimit = newChunk + chunkSize;
+			if ( this->chunkBlocks < kXMP_NodeArenaMaxChunk ) this->chunkBlocks *= 2;
+		}
+
+		block = this->nextBlock;
+		this->nextBlock += this->blockSize;
+
+	}
+
+	return block;
+
+}	// XMP_NodeArena::Allocate
+
+// =================================================================================================
+// XMP_Node allocation
+// ===================
+
+void * XMP_Node::operator new ( size_t size )
+{
+	XMP_Assert ( size == sizeof(XMP_Node) );
+	XMP_NodeBlockHeader * header = (XMP_NodeBlockHeader*) ::operator new ( sizeof(XMP_NodeBlockHeader) + size );
+	header->arena = 0;
+	return (header + 1);
+}
+
+void * XMP_Node::operator new ( size_t size, XMP_Node * _parent )
+{
+	if ( (_parent == 0) || (_parent->arena == 0) ) return XMP_Node::operator new ( size );
+	XMP_Assert ( size == sizeof(XMP_Node) );
+	XMP_NodeBlockHeader * header = (XMP_NodeBlockHeader*) _parent->arena->Allocate();
+	header->arena = _parent->arena;
+	return (header + 1);
+}
+
+void XMP_Node::operator delete ( void * ptr )
+{
+	if ( ptr == 0 ) return;
+	XMP_NodeBlockHeader * header = ((XMP_NodeBlockHeader*)ptr) - 1;
+	if ( header->arena == 0 ) {
+		::operator delete ( header );
+	} else {
+		header->arena->Deallocate ( header );
+	}
+}
+
+void XMP_Node::operator delete ( void * ptr, XMP_Node * _parent )
+{
+	IgnoreParam ( _parent );
+	XMP_Node::operator delete ( ptr );	// ! The header knows where the node came from.
+}
+
+// -------------------------------------------------------------------------------------------------
+// A heap node can go anywhere, a node from an arena only to a parent in the tree of that arena.
+
+bool XMP_Node::FitsParent ( const XMP_Node * newParent ) const
+{
+	const XMP_NodeBlockHeader * header = ((const XMP_NodeBlockHeader*)this) - 1;
+	return ( (header->arena == 0) || ((newParent != 0) && (header->arena == newParent->arena)) );
+}
+
+// =================================================================================================
+// GetNodeNameAtoms
+// ================
+//
+// The table is created by whichever thread gets here first. Threads racing to create it each make
+// one, the loser deletes its own. TerminateNodeNameAtoms deletes it, a later use makes a new one.
+
+static std::atomic < XMP_NodeNameAtoms * > sNodeNameAtoms ( 0 );
+
+XMP_NodeNameAtoms & GetNodeNameAtoms()
+{
+	XMP_NodeNameAtoms * atoms = sNodeNameAtoms.load ( std::memory_order_acquire );
+	if ( atoms != 0 ) return *atoms;
+
+	XMP_NodeNameAtoms * newAtoms = new XMP_NodeNameAtoms;
+	if ( sNodeNameAtoms.compare_exchange_strong ( atoms, newAtoms, std::memory_order_acq_rel ) ) return *newAtoms;
+	delete newAtoms;	// ! Another thread won, atoms now holds its table.
+	return *atoms;
+
+}	// GetNodeNameAtoms
+
+void TerminateNodeNameAtoms()
+{
+	delete sNodeNameAtoms.exchange ( 0 );
+}	// TerminateNodeNameAtoms
+
+// -------------------------------------------------------------------------------------------------
+// AddNameAtom
+// -----------
+//
+// Add a new name to the table, unless that would go past the limits. The room is reserved first, so
+// racing threads can't go past them together.
+
+XMP_NameAtom AddNameAtom ( XMP_StringPtr name, size_t nameLen )
+{
+	XMP_NodeNameAtoms & nameAtoms = GetNodeNameAtoms();
+	if ( nameAtoms.full.load ( std::memory_order_acquire ) ) return 0;
+
+	const size_t nameCount = nameAtoms.nameCount.fetch_add ( 1 ) + 1;
+	const size_t nameBytes = nameAtoms.nameBytes.fetch_add ( nameLen ) + nameLen;
+	if ( (nameCount > kXMP_MaxNameAtoms) || (nameBytes > kXMP_MaxNameAtomBytes) ) {
+		nameAtoms.full.store ( true, std::memory_order_release );
+		return nameAtoms.table.Find ( name, nameLen );	// ! Another thread might have just added it.
+	}
+
+	return nameAtoms.table.Add ( name, nameLen );
+
+}	// AddNameAtom
+
+// -------------------------------------------------------------------------------------------------
+// XMP_NodeName::Assign
+// --------------------
+//
+// The new atom is made before the old one is released, the name might be the old atom's text.
+
+void XMP_NodeName::Assign ( XMP_StringPtr name, size_t nameLen )
+{
+	XMP_NameAtom newAtom = InternNameAtom ( name, nameLen );
+	bool newPrivate = false;
+
+	if ( newAtom == 0 ) {
+		XMP_InternTable::Entry * privateAtom = new XMP_InternTable::Entry;
+		privateAtom->key.assign ( name, nameLen );
+		privateAtom->hash = XMP_InternTable::Hash ( name, nameLen );
+		newAtom = privateAtom;
+		newPrivate = true;
+	}
+
+	this->Release();
+	this->atom = newAtom;
+	this->isPrivate = newPrivate;
+
+}	// XMP_NodeName::Assign
+
+// =================================================================================================
+// LookupOffspring
+// ===============
+//
+// Find the position of the first node with the given name atom in a vector of children or
+// qualifiers. Returns the vector size if there is no such node. Short vectors are scanned, longer
+// ones go through the node's name index. A position found in the index is checked against the node
+// there, in case the vector was reordered in place.
+//
+// Lookups run under the read lock of the XMPMeta too, concurrently with each other, those must not
+// touch the index. Only a caller that holds the write lock passes updateIndex, the index is then
+// created or rebuilt as needed, and items appended since the last use are added to it, so building
+// a tree one node at a time stays linear. Without updateIndex an index that is not current is only
+// used for the items it has, otherwise the vector is scanned.
+
+static void
+AddOffspringToIndex ( const XMP_NodeOffspring & offspring, XMP_NodeNameIndex * index )
+{
+
+	for ( size_t itemNum = index->itemCount, itemLim = offspring.size(); itemNum != itemLim; ++itemNum ) {
+		const XMP_Node * currItem = offspring[itemNum];
+		if ( currItem == 0 ) continue;	// ! Can happen while nodes are being moved around.
+		index->positions.insert ( std::make_pair ( currItem->name.Atom(), itemNum ) );	// ! Keeps the first.
+	}
+
+	index->itemCount = offspring.size();
+
+}	// AddOffspringToIndex
+
+static void
+BuildOffspringIndex ( const XMP_NodeOffspring & offspring, XMP_NodeNameIndex * index )
+{
+
+	index->positions.clear();
+	index->positions.reserve ( offspring.size() );
+	index->itemCount = 0;
+	AddOffspringToIndex ( offspring, index );
+
+	index->changeCount = offspring.ChangeCount();
+
+}	// BuildOffspringIndex
+
+static size_t
+ScanOffspring ( const XMP_NodeOffspring & offspring, XMP_NameAtom name )
+{
+	const size_t itemLim = offspring.size();
+	for ( size_t itemNum = 0; itemNum != itemLim; ++itemNum ) {
+		if ( (offspring[itemNum] != 0) && (offspring[itemNum]->name.Atom() == name) ) return itemNum;
+	}
+	return itemLim;
+}	// ScanOffspring
+
+static size_t
+ScanOffspringText ( const XMP_NodeOffspring & offspring, const XMP_VarString & name )
+{
+	// Compare the text, for the private atoms made once the name table is full.
+	const size_t itemLim = offspring.size();
+	for ( size_t itemNum = 0; itemNum != itemLim; ++itemNum ) {
+		if ( (offspring[itemNum] != 0) && (offspring[itemNum]->name.str() == name) ) return itemNum;
+	}
+	return itemLim;
+}	// ScanOffspringText
+
+static size_t
+LookupOffspring ( const XMP_NodeOffspring & offspring, XMP_NodeNameIndex * const * indexPtr, XMP_NameAtom name )
+{
+	// The read only lookup, see above.
+
+	const size_t itemLim = offspring.size();
+	const XMP_NodeNameIndex * index = *indexPtr;
+	if ( (name == 0) || (itemLim < kXMP_NodeIndexThreshold) || (index == 0) ||
+		 (index->changeCount != offspring.ChangeCount()) || (index->itemCount > itemLim) ) {
+		return ( (name == 0) ? itemLim : ScanOffspring ( offspring, name ) );
+	}
+
+	std::unordered_map < XMP_NameAtom, size_t >::const_iterator indexPos = index->positions.find ( name );
+	if ( indexPos != index->positions.end() ) {
+		size_t itemNum = indexPos->second;
+		if ( (itemNum < itemLim) && (offspring[itemNum] != 0) && (offspring[itemNum]->name.Atom() == name) ) return itemNum;
+	} else if ( index->itemCount == itemLim ) {
+		return itemLim;	// ! Reordering in place does not change which names are there.
+	}
+
+	return ScanOffspring ( offspring, name );	// Reordered in place, or appended to since the index was built.
+
+}	// LookupOffspring
+
+static size_t
+LookupOffspring ( const XMP_NodeOffspring & offspring, XMP_NodeNameIndex ** indexPtr, XMP_NameAtom name, bool updateIndex )
+{
+	if ( ! updateIndex ) return LookupOffspring ( offspring, indexPtr, name );
+
+	const size_t itemLim = offspring.size();
+	if ( itemLim < kXMP_NodeIndexThreshold ) return ( (name == 0) ? itemLim : ScanOffspring ( offspring, name ) );
+
+	XMP_NodeNameIndex * index = *indexPtr;
+	if ( index == 0 ) {
+		index = new XMP_NodeNameIndex;
+		*indexPtr = index;
+		BuildOffspringIndex ( offspring, index );
+	} else if ( (index->changeCount != offspring.ChangeCount()) || (index->itemCount > itemLim) ) {
+		BuildOffspringIndex ( offspring, index );
+	} else if ( index->itemCount < itemLim ) {
+		AddOffspringToIndex ( offspring, index );
+	}
+
+	if ( name == 0 ) return itemLim;	// ! No node has ever had this name, but keep the index current.
+
+	std::unordered_map < XMP_NameAtom, size_t >::const_iterator indexPos = index->positions.find ( name );
+	if ( indexPos == index->positions.end() ) return itemLim;
+
+	size_t itemNum = indexPos->second;
+	if ( (itemNum < itemLim) && (offspring[itemNum] != 0) && (offspring[itemNum]->name.Atom() == name) ) return itemNum;
+
+	BuildOffspringIndex ( offspring, index );	// The vector was reordered in place, e.g. sorted.
+	indexPos = index->positions.find ( name );
+	return ( (indexPos == index->positions.end()) ? itemLim : indexPos->second );
+
+}	// LookupOffspring
+
+static inline size_t
+LookupOffspring ( const XMP_NodeOffspring & offspring, XMP_NodeNameIndex ** indexPtr, XMP_StringPtr name, bool updateIndex )
+{
+	size_t itemNum = LookupOffspring ( offspring, indexPtr, FindNameAtom ( name, strlen ( name ) ), updateIndex );
+	if ( (itemNum == offspring.size()) && NameAtomsFull() ) itemNum = ScanOffspringText ( offspring, name );
+	return itemNum;
+}
+
+// =================================================================================================
+// IndexNodeTree
+// =============
+//
+// Build the name indexes of a whole tree, so that lookups under the read lock can use them. Called
+// under the write lock once a tree has been parsed, its nodes were not added through the lookups.
+
+void
+IndexNodeTree ( XMP_Node * node )
+{
+
+	if ( node->children.size() >= kXMP_NodeIndexThreshold ) {
+		if ( node->childIndex == 0 ) node->childIndex = new XMP_NodeNameIndex;
+		BuildOffspringIndex ( node->children, node->childIndex );
+	}
+
+	if ( node->qualifiers.size() >= kXMP_NodeIndexThreshold ) {
+		if ( node->qualIndex == 0 ) node->qualIndex = new XMP_NodeNameIndex;
+		BuildOffspringIndex ( node->qualifiers, node->qualIndex );
+	}
+
+	for ( size_t childNum = 0, childLim = node->children.size(); childNum < childLim; ++childNum ) {
+		IndexNodeTree ( node->children[childNum] );
+	}
+
+	for ( size_t qualNum = 0, qualLim = node->qualifiers.size(); qualNum < qualLim; ++qualNum ) {
+		IndexNodeTree ( node->qualifiers[qualNum] );
+	}
+
+}	// IndexNodeTree
+
+// =================================================================================================
+// FindChildAtom
+// =============
+//
+// Find an existing child node by its name atom, for callers that resolved the name ahead of time.
+// This is used under the read lock, the name index is only read.
+
+const XMP_Node *
+FindChildAtom ( const XMP_Node * parent, XMP_NameAtom childName )
+{
+	size_t childNum = LookupOffspring ( parent->children, &parent->childIndex, childName );
+	if ( (childNum == parent->children.size()) && NameAtomsFull() ) childNum = ScanOffspringText ( parent->children, childName->key );
+	if ( childNum == parent->children.size() ) return 0;
+	return parent->children[childNum];
+}	// FindChildAtom
+
 // =================================================================================================
 // FindSchemaNode
 // ==============
@@ -834,19 +1192,16 @@ FindSchemaNode	( XMP_Node *		xmpTree,
 	
 	XMP_Assert ( xmpTree->parent == 0 );
 	
-	for ( size_t schemaNum = 0, schemaLim = xmpTree->children.size(); schemaNum != schemaLim; ++schemaNum ) {
-		XMP_Node * currSchema = xmpTree->children[schemaNum];
-		XMP_Assert ( currSchema->parent == xmpTree );
-		if ( currSchema->name == nsURI ) {
-			schemaNode = currSchema;
-			if ( ptrPos != 0 ) *ptrPos = xmpTree->children.begin() + schemaNum;
-			break;
-		}
+	const size_t schemaNum = LookupOffspring ( xmpTree->children, &xmpTree->childIndex, nsURI, createNodes );
+	if ( schemaNum != xmpTree->children.size() ) {
+		schemaNode = xmpTree->children[schemaNum];
+		XMP_Assert ( schemaNode->parent == xmpTree );
+		if ( ptrPos != 0 ) *ptrPos = xmpTree->children.begin() + schemaNum;
 	}
 	
 	if ( (schemaNode == 0) && createNodes ) {
 
-		schemaNode = new XMP_Node ( xmpTree, nsURI, (kXMP_SchemaNode | kXMP_NewImplicitNode) );
+		schemaNode = new ( xmpTree ) XMP_Node ( xmpTree, nsURI, (kXMP_SchemaNode | kXMP_NewImplicitNode) );
 
 		try {
 			XMP_StringPtr prefixPtr;
@@ -917,18 +1272,15 @@ FindChildNode	( XMP_Node *		parent,
 		parent->options |= kXMP_PropValueIsStruct;
 	}
 	
-	for ( size_t childNum = 0, childLim = parent->children.size(); childNum != childLim; ++childNum ) {
-		XMP_Node * currChild = parent->children[childNum];
-		XMP_Assert ( currChild->parent == parent );
-		if ( currChild->name == childName ) {
-			childNode = currChild;
-			if ( ptrPos != 0 ) *ptrPos = parent->children.begin() + childNum;
-			break;
-		}
+	const size_t childNum = LookupOffspring ( parent->children, &parent->childIndex, childName, createNodes );
+	if ( childNum != parent->children.size() ) {
+		childNode = parent->children[childNum];
+		XMP_Assert ( childNode->parent == parent );
+		if ( ptrPos != 0 ) *ptrPos = parent->children.begin() + childNum;
 	}
 	
 	if ( (childNode == 0) && createNodes ) {
-		childNode = new XMP_Node ( parent, childName, kXMP_NewImplicitNode );
+		childNode = new ( parent ) XMP_Node ( parent, childName, kXMP_NewImplicitNode );
 		parent->children.push_back ( childNode );
 		if ( ptrPos != 0 ) *ptrPos = parent->children.end() - 1;
 	}
@@ -959,19 +1311,16 @@ FindQualifierNode	( XMP_Node *		parent,
 	
 	XMP_Assert ( *qualName != '?' );
 	
-	for ( size_t qualNum = 0, qualLim = parent->qualifiers.size(); qualNum != qualLim; ++qualNum ) {
-		XMP_Node * currQual = parent->qualifiers[qualNum];
-		XMP_Assert ( currQual->parent == parent );
-		if ( currQual->name == qualName ) {
-			qualNode = currQual;
-			if ( ptrPos != 0 ) *ptrPos = parent->qualifiers.begin() + qualNum;
-			break;
-		}
+	const size_t qualNum = LookupOffspring ( parent->qualifiers, &parent->qualIndex, qualName, createNodes );
+	if ( qualNum != parent->qualifiers.size() ) {
+		qualNode = parent->qualifiers[qualNum];
+		XMP_Assert ( qualNode->parent == parent );
+		if ( ptrPos != 0 ) *ptrPos = parent->qualifiers.begin() + qualNum;
 	}
 	
 	if ( (qualNode == 0) && createNodes ) {
 
-		qualNode = new XMP_Node ( parent, qualName, (kXMP_PropIsQualifier | kXMP_NewImplicitNode) );
+		qualNode = new ( parent ) XMP_Node ( parent, qualName, (kXMP_PropIsQualifier | kXMP_NewImplicitNode) );
 		parent->options |= kXMP_PropHasQualifiers;
 
 		const bool isLang 	 = XMP_LitMatch ( qualName, "xml:lang" );
@@ -1210,7 +1559,7 @@ CloneOffspring ( const XMP_Node * origParent, XMP_Node * cloneParent, bool skipE
 		for ( size_t qualNum = 0, qualLim = qualCount; qualNum != qualLim; ++qualNum ) {
 			const XMP_Node * origQual  = origParent->qualifiers[qualNum];
 			if ( skipEmpty && origQual->value.empty() && origQual->children.empty() ) continue;
-			XMP_Node * cloneQual = new XMP_Node ( cloneParent, origQual->name, origQual->value, origQual->options );
+			XMP_Node * cloneQual = new ( cloneParent ) XMP_Node ( cloneParent, origQual->name, origQual->value, origQual->options );
 			CloneOffspring ( origQual, cloneQual, skipEmpty );
 			if ( skipEmpty && cloneQual->value.empty() && cloneQual->children.empty() ) {
 				// Check again, might have had an array or struct with all empty children.
@@ -1229,7 +1578,7 @@ CloneOffspring ( const XMP_Node * origParent, XMP_Node * cloneParent, bool skipE
 		for ( size_t childNum = 0, childLim = childCount; childNum != childLim; ++childNum ) {
 			const XMP_Node * origChild  = origParent->children[childNum];
 			if ( skipEmpty && origChild->value.empty() && origChild->children.empty() ) continue;
-			XMP_Node * cloneChild = new XMP_Node ( cloneParent, origChild->name, origChild->value, origChild->options );
+			XMP_Node * cloneChild = new ( cloneParent ) XMP_Node ( cloneParent, origChild->name, origChild->value, origChild->options );
 			CloneOffspring ( origChild, cloneChild, skipEmpty );
 			if ( skipEmpty && cloneChild->value.empty() && cloneChild->children.empty() ) {
 				// Check again, might have had an array or struct with all empty children.
@@ -1262,7 +1611,7 @@ CloneSubtree ( const XMP_Node * origRoot, XMP_Node * cloneParent, bool skipEmpty
 		}
 	#endif
 	
-	XMP_Node * cloneRoot = new XMP_Node ( cloneParent, origRoot->name, origRoot->value, origRoot->options );
+	XMP_Node * cloneRoot = new ( cloneParent ) XMP_Node ( cloneParent, origRoot->name, origRoot->value, origRoot->options );
 	CloneOffspring ( origRoot, cloneRoot, skipEmpty ) ;
 
 	if ( skipEmpty && cloneRoot->value.empty() && cloneRoot->children.empty() ) {
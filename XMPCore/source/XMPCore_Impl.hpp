@@ -21,6 +21,7 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <cassert>
 #include <cstring>
 #include <cstdlib>
@@ -39,7 +40,50 @@ class XPathStepInfo;
 
 typedef XMP_Node *	XMP_NodePtr;
 
-typedef std::vector<XMP_Node*>		XMP_NodeOffspring;
+// -------------------------------------------------------------------------------------------------
+// XMP_NodeOffspring is the vector of children or qualifiers of an XMP_Node. It is a std::vector that
+// also counts the calls that change its membership, so that the lazily built name index of the
+// owning node can tell when it has gone stale. Appending does not bump the count, the index adds
+// the new items on its next use. Reordering in place (sort, swapping two items) does not bump the
+// count either, the index catches that when it checks the position it found.
+
+class XMP_NodeOffspring : public std::vector<XMP_Node*> {
+public:
+
+	typedef std::vector<XMP_Node*> BaseVector;
+
+	XMP_NodeOffspring() : changeCount(0) {};
+	XMP_NodeOffspring ( const XMP_NodeOffspring & other ) : BaseVector(other), changeCount(0) {};
+
+	XMP_NodeOffspring & operator= ( const XMP_NodeOffspring & other )
+		{ BaseVector::operator= ( other ); ++this->changeCount; return *this; };
+
+	void push_back ( XMP_Node * node ) { BaseVector::push_back ( node ); };	// ! Positions are unchanged.
+	void pop_back() { BaseVector::pop_back(); ++this->changeCount; };
+
+	iterator insert ( iterator pos, XMP_Node * node )
+		{ ++this->changeCount; return BaseVector::insert ( pos, node ); };
+	template < class InputIter > void insert ( iterator pos, InputIter first, InputIter last )
+		{ ++this->changeCount; BaseVector::insert ( pos, first, last ); };
+
+	iterator erase ( iterator pos ) { ++this->changeCount; return BaseVector::erase ( pos ); };
+	iterator erase ( iterator first, iterator last )
+		{ ++this->changeCount; return BaseVector::erase ( first, last ); };
+
+	void clear() { BaseVector::clear(); ++this->changeCount; };
+	void resize ( size_type count ) { BaseVector::resize ( count ); ++this->changeCount; };
+
+	void swap ( XMP_NodeOffspring & other )
+		{ BaseVector::swap ( other ); ++this->changeCount; ++other.changeCount; };
+
+	XMP_Uns32 ChangeCount() const { return this->changeCount; };
+
+private:
+
+	XMP_Uns32 changeCount;
+
+};
+
 typedef XMP_NodeOffspring::iterator	XMP_NodePtrPos;
 
 typedef XMP_VarString::iterator			XMP_VarStringPos;
@@ -75,6 +119,7 @@ typedef void(*XMP_DeleteProc)   (void * ptr);
 
 extern XMP_Bool sUseNewCoreAPIs;
 extern XMP_NamespaceTable * sRegisteredNamespaces;
+typedef const XMP_InternTable::Entry * XMP_NameAtom;
 
 extern XMP_AliasMap * sRegisteredAliasMap;
 
@@ -209,6 +254,12 @@ FindChildNode ( XMP_Node *		 parent,
 				bool			 createNodes,
 				XMP_NodePtrPos * ptrPos = 0 );
 
+extern const XMP_Node *
+FindChildAtom ( const XMP_Node * parent, XMP_NameAtom childName );
+
+extern void
+IndexNodeTree ( XMP_Node * node );
+
 extern XMP_Node *
 FindQualifierNode ( XMP_Node *		 parent,
 					XMP_StringPtr	 qualName,
@@ -300,6 +351,176 @@ enum {	// Bits for XPathStepInfo options.	// *** Add mask check to init code.
 // =================================================================================================
 // XMP_Node details
 
+// -------------------------------------------------------------------------------------------------
+// XMP_NodeNameIndex maps the names of a node's children or qualifiers to their positions. It is only
+// built once the offspring vector reaches kXMP_NodeIndexThreshold items, smaller vectors are faster
+// to scan. The index is only built or updated under the write lock of the XMPMeta, by the lookups
+// that create nodes and by IndexNodeTree after parsing. Lookups under the read lock only read it,
+// and scan the vector if the index is missing or its change count is behind the vector's.
+
+#define kXMP_NodeIndexThreshold	16
+
+// -------------------------------------------------------------------------------------------------
+// Node names are atoms, interned in one table for the whole process. The same few hundred names turn
+// up over and over, each is stored once and names are compared by their atoms. The table is created
+// on first use, not by XMPMeta::Initialize, nodes can be made before that. Names are never removed,
+// XMPMeta::Terminate deletes the table with TerminateNodeNameAtoms. An atom is only valid until then,
+// no node may outlive Terminate. FindNameAtom returns 0 for a name that no node ever had.
+//
+// Parsed files can bring any number of odd names, so the table stops growing at kXMP_MaxNameAtoms
+// names or kXMP_MaxNameAtomBytes of name text. InternNameAtom then returns 0 for a new name, its
+// XMP_NodeName gets a private atom of its own. Private atoms are compared by their text, the name
+// lookups fall back to scanning once the table is full.
+
+#define kXMP_MaxNameAtoms		(16*1024)
+#define kXMP_MaxNameAtomBytes	(512*1024)
+
+struct XMP_NodeNameAtoms {
+	XMP_InternTable table;
+	XMP_NameAtom emptyAtom;
+	std::atomic < size_t > nameCount, nameBytes;	// Reserved by AddNameAtom, can be ahead of the table.
+	std::atomic < bool > full;	// Set once a name was turned away.
+	XMP_NodeNameAtoms() : emptyAtom(table.Add ( "", 0 )), nameCount(1), nameBytes(0), full(false) {};
+};
+
+extern XMP_NodeNameAtoms & GetNodeNameAtoms();
+extern void TerminateNodeNameAtoms();
+extern XMP_NameAtom AddNameAtom ( XMP_StringPtr name, size_t nameLen );
+
+static inline XMP_NameAtom FindNameAtom ( XMP_StringPtr name, size_t nameLen )
+{
+	return GetNodeNameAtoms().table.Find ( name, nameLen );
+}
+
+static inline XMP_NameAtom InternNameAtom ( XMP_StringPtr name, size_t nameLen )
+{
+	XMP_NameAtom atom = FindNameAtom ( name, nameLen );
+	if ( atom == 0 ) atom = AddNameAtom ( name, nameLen );
+	return atom;	// ! Zero for a new name once the table is full.
+}
+
+static inline bool NameAtomsFull()
+{
+	return GetNodeNameAtoms().full.load ( std::memory_order_acquire );
+}
+
+// XMP_NodeName behaves enough like a const XMP_VarString for the code using node names. Assigning
+// a new name interns it.
+
+class XMP_NodeName {
+public:
+
+	XMP_NodeName() : atom(GetNodeNameAtoms().emptyAtom), isPrivate(false) {};
+	XMP_NodeName ( XMP_StringPtr name ) : atom(0), isPrivate(false) { this->Assign ( name, strlen ( name ) ); };
+	XMP_NodeName ( const XMP_VarString & name ) : atom(0), isPrivate(false) { this->Assign ( name.c_str(), name.size() ); };
+	XMP_NodeName ( const XMP_NodeName & other ) : atom(0), isPrivate(false) { *this = other; };
+
+	~XMP_NodeName() { this->Release(); };
+
+	XMP_NodeName & operator= ( XMP_StringPtr name ) { this->Assign ( name, strlen ( name ) ); return *this; };
+	XMP_NodeName & operator= ( const XMP_VarString & name ) { this->Assign ( name.c_str(), name.size() ); return *this; };
+	XMP_NodeName & operator= ( const XMP_NodeName & other )
+	{
+		if ( other.isPrivate ) {
+			this->Assign ( other.c_str(), other.size() );
+		} else {
+			this->Release();
+			this->atom = other.atom;
+		}
+		return *this;
+	};
+
+	void erase() { this->Release(); this->atom = GetNodeNameAtoms().emptyAtom; };
+
+	XMP_NameAtom Atom() const { return this->atom; };
+	const XMP_VarString & str() const { return this->atom->key; };
+	operator const XMP_VarString & () const { return this->atom->key; };
+
+	XMP_StringPtr c_str() const { return this->atom->key.c_str(); };
+	size_t size() const { return this->atom->key.size(); };
+	bool empty() const { return this->atom->key.empty(); };
+	char operator[] ( size_t pos ) const { return this->atom->key[pos]; };
+
+	size_t find ( char ch, size_t pos = 0 ) const { return this->atom->key.find ( ch, pos ); };
+	size_t find ( XMP_StringPtr str, size_t pos = 0 ) const { return this->atom->key.find ( str, pos ); };
+	size_t find_first_of ( char ch, size_t pos = 0 ) const { return this->atom->key.find_first_of ( ch, pos ); };
+	size_t find_first_of ( XMP_StringPtr str, size_t pos = 0 ) const { return this->atom->key.find_first_of ( str, pos ); };
+
+	bool operator== ( const XMP_NodeName & other ) const
+		{ return (this->atom == other.atom) || ((this->isPrivate || other.isPrivate) && (this->atom->key == other.atom->key)); };
+	bool operator!= ( const XMP_NodeName & other ) const { return ! (*this == other); };
+	bool operator< ( const XMP_NodeName & other ) const { return (this->atom->key < other.atom->key); };
+
+	bool IsPrivate() const { return this->isPrivate; };
+
+private:
+
+	XMP_NameAtom atom;
+	bool isPrivate;	// The atom is owned by this name, the table was full.
+
+	void Assign ( XMP_StringPtr name, size_t nameLen );
+	void Release() { if ( this->isPrivate ) delete this->atom; this->isPrivate = false; };
+
+};
+
+static inline bool operator== ( const XMP_NodeName & left, XMP_StringPtr right ) { return (left.str() == right); }
+static inline bool operator== ( XMP_StringPtr left, const XMP_NodeName & right ) { return (left == right.str()); }
+static inline bool operator== ( const XMP_NodeName & left, const XMP_VarString & right ) { return (left.str() == right); }
+static inline bool operator== ( const XMP_VarString & left, const XMP_NodeName & right ) { return (left == right.str()); }
+static inline bool operator!= ( const XMP_NodeName & left, XMP_StringPtr right ) { return (left.str() != right); }
+static inline bool operator!= ( XMP_StringPtr left, const XMP_NodeName & right ) { return (left != right.str()); }
+static inline bool operator!= ( const XMP_NodeName & left, const XMP_VarString & right ) { return (left.str() != right); }
+static inline bool operator!= ( const XMP_VarString & left, const XMP_NodeName & right ) { return (left != right.str()); }
+
+// -------------------------------------------------------------------------------------------------
+
+struct XMP_NodeNameIndex {
+	XMP_Uns32 changeCount;	// The offspring change count when the positions were last built.
+	size_t itemCount;		// The offspring items in the positions, later ones were appended since.
+	std::unordered_map < XMP_NameAtom, size_t > positions;
+	XMP_NodeNameIndex() : changeCount(0), itemCount(0) {};
+};
+
+// -------------------------------------------------------------------------------------------------
+// XMP_NodeArena holds the nodes of one XMPMeta tree. Nodes are carved out of large chunks, freed
+// nodes are reused, and the chunks are released together when the XMPMeta goes away. Nodes created
+// with "new ( parent ) XMP_Node ( parent, ... )" come from the parent's arena, plain "new" uses the
+// heap. An arena node must never be moved to another tree, clone it there instead. Code that moves
+// a node to a new parent asserts FitsParent first. The arena is
+// only used under the write lock of its XMPMeta, so it has no lock of its own.
+
+class XMP_NodeArena {
+public:
+
+	XMP_NodeArena();
+	~XMP_NodeArena();
+
+	void * Allocate();	// Room for a node and its block header.
+
+	void Deallocate ( void * block )
+	{
+		if ( this->releasing ) return;	// The chunks are about to go all at once.
+		*((void**)block) = this->freeBlocks;
+		this->freeBlocks = block;
+	};
+
+	void BeginRelease() { this->releasing = true; };	// Called before the XMPMeta deletes its tree.
+
+private:
+
+	std::vector < void * > chunks;
+	void * freeBlocks;		// The freed blocks, linked through their first word.
+	char * nextBlock;		// The unused part of the last chunk.
+	char * chunkLimit;
+	size_t blockSize;
+	size_t chunkBlocks;		// The block count for the next chunk, it doubles up to a limit.
+	bool   releasing;
+
+	XMP_NodeArena ( const XMP_NodeArena & );	// ! Hidden on purpose.
+	XMP_NodeArena & operator= ( const XMP_NodeArena & );
+
+};
+
 #if 0	// Pattern for iterating over the children or qualifiers:
 	for ( size_t xxNum = 0, xxLim = _node_->_offspring_.size(); xxNum < xxLim; ++xxNum ) {
 		const XMP_Node * _curr_ = _node_->_offspring_[xxNum];
@@ -310,16 +531,21 @@ class XMP_Node {
 public:
 
 	XMP_OptionBits		options;
-	XMP_VarString		name, value;
+	XMP_NodeName		name;
+	XMP_VarString		value;
 	XMP_Node *			parent;
 	XMP_NodeOffspring	children;
 	XMP_NodeOffspring	qualifiers;
+	XMP_NodeNameIndex *	childIndex;	// Lazily built name lookup tables, see FindChildNode.
+	XMP_NodeNameIndex *	qualIndex;
+	XMP_NodeArena *		arena;		// The arena for new offspring, inherited from the parent.
 	#if XMP_DebugBuild
 		// *** XMP_StringPtr	_namePtr, _valuePtr;	// *** Not working, need operator=?
 	#endif
 
 	XMP_Node ( XMP_Node * _parent, XMP_StringPtr _name, XMP_OptionBits _options )
-		: options(_options), name(_name), parent(_parent)
+		: options(_options), name(_name), parent(_parent), childIndex(0), qualIndex(0),
+		  arena((_parent == 0) ? 0 : _parent->arena)
 	{
 		#if XMP_DebugBuild
 			XMP_Assert ( (name.find ( ':' ) != XMP_VarString::npos) || (name == kXMP_ArrayItemName) ||
@@ -330,7 +556,8 @@ public:
 	};
 
 	XMP_Node ( XMP_Node * _parent, const XMP_VarString & _name, XMP_OptionBits _options )
-		: options(_options), name(_name), parent(_parent)
+		: options(_options), name(_name), parent(_parent), childIndex(0), qualIndex(0),
+		  arena((_parent == 0) ? 0 : _parent->arena)
 	{
 		#if XMP_DebugBuild
 			XMP_Assert ( (name.find ( ':' ) != XMP_VarString::npos) || (name == kXMP_ArrayItemName) ||
@@ -341,7 +568,8 @@ public:
 	};
 
 	XMP_Node ( XMP_Node * _parent, XMP_StringPtr _name, XMP_StringPtr _value, XMP_OptionBits _options )
-		: options(_options), name(_name), value(_value), parent(_parent)
+		: options(_options), name(_name), value(_value), parent(_parent), childIndex(0), qualIndex(0),
+		  arena((_parent == 0) ? 0 : _parent->arena)
 	{
 		#if XMP_DebugBuild
 			XMP_Assert ( (name.find ( ':' ) != XMP_VarString::npos) || (name == kXMP_ArrayItemName) ||
@@ -352,7 +580,8 @@ public:
 	};
 
 	XMP_Node ( XMP_Node * _parent, const XMP_VarString & _name, const XMP_VarString & _value, XMP_OptionBits _options )
-		: options(_options), name(_name), value(_value), parent(_parent)
+		: options(_options), name(_name), value(_value), parent(_parent), childIndex(0), qualIndex(0),
+		  arena((_parent == 0) ? 0 : _parent->arena)
 	{
 		#if XMP_DebugBuild
 			XMP_Assert ( (name.find ( ':' ) != XMP_VarString::npos) || (name == kXMP_ArrayItemName) ||
@@ -372,6 +601,8 @@ public:
 			if ( children[i] != 0 ) delete children[i];
 		}
 		children.clear();
+		delete childIndex;
+		childIndex = 0;
 	}
 
 	void RemoveQualifiers()
@@ -380,6 +611,8 @@ public:
 			if ( qualifiers[i] != 0 ) delete qualifiers[i];
 		}
 		qualifiers.clear();
+		delete qualIndex;
+		qualIndex = 0;
 	}
 
 	void ClearNode()
@@ -393,10 +626,17 @@ public:
 
 	void SetValue( XMP_StringPtr value );
 
+	bool FitsParent ( const XMP_Node * newParent ) const;	// Check before moving a node, see XMP_NodeArena.
+
 	virtual ~XMP_Node() { RemoveChildren(); RemoveQualifiers(); };
 
+	static void * operator new ( size_t size );
+	static void * operator new ( size_t size, XMP_Node * _parent );	// Use the parent's arena.
+	static void operator delete ( void * ptr );
+	static void operator delete ( void * ptr, XMP_Node * _parent );
+
 private:
-	XMP_Node() : options(0), parent(0)	// ! Make sure parent pointer is always set.
+	XMP_Node() : options(0), parent(0), childIndex(0), qualIndex(0), arena(0)	// ! Make sure parent pointer is always set.
 	{
 		#if XMP_DebugBuild
 			// *** _namePtr  = name.c_str();
@@ -404,6 +644,9 @@ private:
 		#endif
 	};
 
+	XMP_Node ( const XMP_Node & );	// ! Hide the copy operations, the name indices are owned.
+	XMP_Node & operator= ( const XMP_Node & );
+
 };
 
 class XMP_AutoNode {	// Used to hold a child during subtree construction.
@@ -412,13 +655,13 @@ public:
 	XMP_AutoNode() : nodePtr(0) {};
 	~XMP_AutoNode() { if ( nodePtr != 0 ) delete ( nodePtr ); nodePtr = 0; };
 	XMP_AutoNode ( XMP_Node * _parent, XMP_StringPtr _name, XMP_OptionBits _options )
-		: nodePtr ( new XMP_Node ( _parent, _name, _options ) ) {};
+		: nodePtr ( new ( _parent ) XMP_Node ( _parent, _name, _options ) ) {};
 	XMP_AutoNode ( XMP_Node * _parent, const XMP_VarString & _name, XMP_OptionBits _options )
-		: nodePtr ( new XMP_Node ( _parent, _name, _options ) ) {};
+		: nodePtr ( new ( _parent ) XMP_Node ( _parent, _name, _options ) ) {};
 	XMP_AutoNode ( XMP_Node * _parent, XMP_StringPtr _name, XMP_StringPtr _value, XMP_OptionBits _options )
-		: nodePtr ( new XMP_Node ( _parent, _name, _value, _options ) ) {};
+		: nodePtr ( new ( _parent ) XMP_Node ( _parent, _name, _value, _options ) ) {};
 	XMP_AutoNode ( XMP_Node * _parent, const XMP_VarString & _name, const XMP_VarString & _value, XMP_OptionBits _options )
-		: nodePtr ( new XMP_Node ( _parent, _name, _value, _options ) ) {};
+		: nodePtr ( new ( _parent ) XMP_Node ( _parent, _name, _value, _options ) ) {};
 };
 
 // =================================================================================================
@@ -25,298 +25,190 @@
 // Support Routines
 // =================================================================================================
 
-
-#ifndef TraceIterators
-	#define TraceIterators 0
-#endif
-
-#if TraceIterators
-	static const char * sStageNames[] = { "before", "self", "qualifiers", "children" };
-#endif
-
-static XMP_Node * sDummySchema = 0;	// ! Used for some ugliness with aliases.
-
 // -------------------------------------------------------------------------------------------------
-// AddSchemaProps
-// --------------
+// SetFramePath
+// ------------
 //
-// Add the top level properties to the IterNode for a schema.
+// Replace the current node's part of the path, the path of its parent is already in currPath. Schema
+// nodes have an empty path. The fixed ancestors of a property iteration have no part in the path,
+// the base node of that iteration uses the root path built by the constructor.
 
 static void
-AddSchemaProps ( IterInfo & /*info*/, IterNode & iterSchema, const XMP_Node * xmpSchema )
+SetFramePath ( IterInfo & info, size_t level )
 {
-	#if TraceIterators
-		printf ( "    Adding properties of %s\n", xmpSchema->name.c_str() );
-	#endif
-
-	for ( size_t propNum = 0, propLim = xmpSchema->children.size(); propNum != propLim; ++propNum ) {
-		const XMP_Node * xmpProp = xmpSchema->children[propNum];
-		// *** set the has-aliases bit when appropriate
-		iterSchema.children.push_back ( IterNode ( xmpProp->options, xmpProp->name, 0 ) );
-		#if TraceIterators
-			printf ( "        %s\n", xmpProp->name.c_str() );
-		#endif
+	IterFrame & frame = info.frames[level];
+	if ( level < info.baseLevel ) return;
+
+	info.currPath.erase ( frame.pathStart );
+	frame.leafOffset = frame.pathStart;
+
+	if ( level == 0 ) return;	// A schema node.
+
+	if ( level == info.baseLevel ) {
+		info.currPath += info.rootPath;
+		frame.leafOffset = info.rootLeafOffset;
+		return;
 	}
 
-}	// AddSchemaProps
+	const XMP_Node * parent = frame.parent;
+	const XMP_Node * node = frame.node;
+
+	if ( frame.isQualifier ) {
+		info.currPath += "/?";	// All qualifiers are named and use paths like "Prop/?Qual".
+		frame.leafOffset += 2;
+		info.currPath += node->name;
+	} else if ( XMP_NodeIsSchema ( parent->options ) ) {
+		info.currPath += node->name;
+	} else if ( parent->options & kXMP_PropValueIsArray ) {
+		char buffer [32];	// AUDIT: Using sizeof(buffer) below for snprintf length is safe.
+		snprintf ( buffer, sizeof(buffer), "[%lu]", (unsigned long)frame.index+1 );	// ! XPath indices are one-based.
+		info.currPath += buffer;
+	} else {
+		XMP_Assert ( parent->options & kXMP_PropValueIsStruct );
+		info.currPath += '/';
+		frame.leafOffset += 1;
+		info.currPath += node->name;
+	}
+
+}	// SetFramePath
 
 // -------------------------------------------------------------------------------------------------
-// AddNodeOffspring
-// ----------------
+// ValidateFrames
+// --------------
 //
-// Add the immediate children and qualifiers to an IterNode.
-
-static void
-AddNodeOffspring ( IterInfo & info, IterNode & iterParent, const XMP_Node * xmpParent )
+// The XMP tree can be changed between calls to Next. Check that each frame's node is still where it
+// was, from the top of the tree down so that only live nodes are looked at. A node that moved among
+// its siblings is found again, the paths from there on are rebuilt. If a node is gone the iteration
+// continues with whatever is now at its position, which is normally the next sibling. Returns false
+// if the root of the iteration is gone.
+
+static bool
+ValidateFrames ( IterInfo & info )
 {
-	XMP_VarString currPath ( iterParent.fullPath );
-	size_t        leafOffset = iterParent.fullPath.size();
-	
-	if ( (! xmpParent->qualifiers.empty()) && (! (info.options & kXMP_IterOmitQualifiers)) ) {
+	size_t rebuildLevel = info.frames.size();
 
-		#if TraceIterators
-			printf ( "    Adding qualifiers of %s\n", currPath.c_str() );
-		#endif
-
-		currPath += "/?";	// All qualifiers are named and use paths like "Prop/?Qual".
-		leafOffset += 2;
-		
-		for ( size_t qualNum = 0, qualLim = xmpParent->qualifiers.size(); qualNum != qualLim; ++qualNum ) {
-			const XMP_Node * xmpQual = xmpParent->qualifiers[qualNum];
-			currPath += xmpQual->name;
-			iterParent.qualifiers.push_back ( IterNode ( xmpQual->options, currPath, leafOffset ) );
-			currPath.erase ( leafOffset );
-			#if TraceIterators
-				printf ( "        %s\n", xmpQual->name.c_str() );
-			#endif
-		}
-		
-		leafOffset -= 2;
-		currPath.erase ( leafOffset );
+	for ( size_t level = 0, limit = info.frames.size(); level < limit; ++level ) {
 
-	}
+		IterFrame & frame = info.frames[level];
+		if ( frame.node == 0 ) break;	// Only the top frame can be before its first node.
 
-	if ( ! xmpParent->children.empty() ) {
-	
-		#if TraceIterators
-			printf ( "    Adding children of %s\n", currPath.c_str() );
-		#endif
+		const XMP_NodeOffspring & siblings = frame.Siblings();
+		if ( (frame.index < siblings.size()) && (siblings[frame.index] == frame.node) ) continue;
 
-		XMP_Assert ( xmpParent->options & kXMP_PropCompositeMask );
-		
-		if ( xmpParent->options & kXMP_PropValueIsStruct ) {
-			currPath += '/';
-			leafOffset += 1;
-		}
-		
-		for ( size_t childNum = 0, childLim = xmpParent->children.size(); childNum != childLim; ++childNum ) {
-			const XMP_Node * xmpChild = xmpParent->children[childNum];
-			if ( ! (xmpParent->options & kXMP_PropValueIsArray) ) {
-				currPath += xmpChild->name;
-			} else {
-				char buffer [32];	// AUDIT: Using sizeof(buffer) below for snprintf length is safe.
-				snprintf ( buffer, sizeof(buffer), "[%lu]", (unsigned long)childNum+1 );	// ! XPath indices are one-based.
-				currPath += buffer;
-			}
-			iterParent.children.push_back ( IterNode ( xmpChild->options, currPath, leafOffset ) );
-			currPath.erase ( leafOffset );
-			#if TraceIterators
-				printf ( "        %s\n", (iterParent.children.back().fullPath.c_str() + leafOffset) );
-			#endif
+		size_t newIndex = 0;
+		for ( size_t sibLim = siblings.size(); newIndex < sibLim; ++newIndex ) {
+			if ( siblings[newIndex] == frame.node ) break;
 		}
-	
-	}
 
-}	// AddNodeOffspring
+		if ( newIndex < siblings.size() ) {
+			frame.index = newIndex;
+			if ( rebuildLevel > level ) rebuildLevel = level;
+			continue;
+		}
 
-// -------------------------------------------------------------------------------------------------
-// SetCurrSchema
-// -------------
+		if ( (level < info.baseLevel) || ((level == info.baseLevel) && (! info.baseSiblings)) ) return false;
 
-static inline void
-SetCurrSchema ( IterInfo & info, XMP_StringPtr schemaName )
-{
+		info.currPath.erase ( frame.pathStart );
+		frame.node = 0;
+		frame.visitStage = kIter_BeforeVisit;
+		info.frames.resize ( level + 1 );
+		break;
 
-	info.currSchema = schemaName;
-	#if 0	// *** XMP_DebugBuild
-		info._schemaPtr = info.currSchema.c_str();
-	#endif
+	}
 
-}	// SetCurrSchema
+	if ( rebuildLevel < info.baseLevel ) rebuildLevel = info.baseLevel;	// The fixed ancestors have no path.
 
-static inline void
-SetCurrSchema ( IterInfo & info, XMP_VarString & schemaName )
-{
+	if ( rebuildLevel < info.frames.size() ) {
+		info.currPath.erase ( info.frames[rebuildLevel].pathStart );
+		for ( size_t level = rebuildLevel, limit = info.frames.size(); level < limit; ++level ) {
+			IterFrame & frame = info.frames[level];
+			if ( level > rebuildLevel ) frame.pathStart = info.currPath.size();
+			if ( frame.visitStage != kIter_BeforeVisit ) SetFramePath ( info, level );
+		}
+	}
 
-	info.currSchema = schemaName;
-	#if 0	// *** XMP_DebugBuild
-		info._schemaPtr = info.currSchema.c_str();
-	#endif
+	return true;
 
-}	// SetCurrSchema
+}	// ValidateFrames
 
 // -------------------------------------------------------------------------------------------------
-// AdvanceIterPos
+// GetNextXMPNode
 // --------------
 //
-// Adjust currPos and possibly endPos for the next step in a pre-order depth-first traversal. The
-// current node has just been visited, move on to its qualifiers, children, then siblings, or back
-// up to an ancestor. AdvanceIterPos either moves to a property or qualifier node that can be
-// visited, or to the end of the entire iteration.
+// Used by XMPIterator::Next to move to the next XMP node in a pre-order depth-first traversal,
+// ignoring the kXMP_IterJustLeafNodes flag. From a node that was just visited we move on to its
+// qualifiers, children, then siblings, or back up to an ancestor. Empty schema are passed over.
 
-static void
-AdvanceIterPos ( IterInfo & info )
+static const XMP_Node *
+GetNextXMPNode ( IterInfo & info )
 {
-	// -------------------------------------------------------------------------------------------
-	// Keep looking until we find a node to visit or the end of everything. The first time through
-	// the current node will exist, we just visited it. But we have to keep looking if the current
-	// node was the last of its siblings or is an empty schema.
-	
-	// ! It is possible that info.currPos == info.endPos on entry. Don't dereference info.currPos yet!
+	const bool justChildren = ((info.options & kXMP_IterJustChildren) != 0);
 
-	while ( true ) {
-	
-		if ( info.currPos == info.endPos ) {
-		
-			// ------------------------------------------------------------------------------------
-			// At the end of a set of siblings, move up to an ancestor. We've either just finished
-			// the qualifiers and will move to the children, or have just finished the children and
-			// will move on to the next sibling.
-			
-			if ( info.ancestors.empty() ) break;	// We're at the end of the schema list.
-
-			IterPosPair & parent = info.ancestors.back();
-			info.currPos = parent.first;
-			info.endPos  = parent.second;
-			info.ancestors.pop_back();
-			
-			#if TraceIterators
-				printf ( "    Moved up to %s, stage = %s\n",
-				         info.currPos->fullPath.c_str(), sStageNames[info.currPos->visitStage] );
-			#endif
-		
-		} else {
-			
-			// -------------------------------------------------------------------------------------------
-			// Decide what to do with this iteration node based on its state. Don't use a switch statment,
-			// some of the cases want to break from the loop. A break in a switch just exits the case.
-			
-			#if TraceIterators
-				printf ( "    Moving from %s, stage = %s\n",
-				         info.currPos->fullPath.c_str(), sStageNames[info.currPos->visitStage] );
-			#endif
-			
-			if ( info.currPos->visitStage == kIter_BeforeVisit ) {		// Visit this node now.
-				if ( info.currPos->options & kXMP_SchemaNode ) SetCurrSchema ( info, info.currPos->fullPath );
-				break;
-			}
+	while ( ! info.frames.empty() ) {
 
-			if ( info.currPos->visitStage == kIter_VisitSelf ) {		// Just finished visiting the value portion.
-				info.currPos->visitStage = kIter_VisitQualifiers;		// Start visiting the qualifiers.
-				if ( ! info.currPos->qualifiers.empty() ) {
-					info.ancestors.push_back ( IterPosPair ( info.currPos, info.endPos ) );
-					info.endPos  = info.currPos->qualifiers.end();		// ! Set the parent's endPos before changing currPos!
-					info.currPos = info.currPos->qualifiers.begin();
-					break;
-				}
-			}
+		// Don't hold a reference to the top frame, pushing a new frame can move the stack. Don't
+		// use a switch statement, the stages fall through from one to the next.
 
-			if ( info.currPos->visitStage == kIter_VisitQualifiers ) {	// Just finished visiting the qualifiers.
-				info.currPos->qualifiers.clear();
-				info.currPos->visitStage = kIter_VisitChildren;			// Start visiting the children.
-				if ( ! info.currPos->children.empty() ) {
-					info.ancestors.push_back ( IterPosPair ( info.currPos, info.endPos ) );
-					info.endPos  = info.currPos->children.end();		// ! Set the parent's endPos before changing currPos!
-					info.currPos = info.currPos->children.begin();
-					break;
+		const size_t level = info.frames.size() - 1;
+		const bool canExpand = ((! justChildren) || (level < info.expandLimit));
+
+		if ( info.frames[level].visitStage == kIter_BeforeVisit ) {	// Visit the next sibling now.
+
+			IterFrame & frame = info.frames[level];
+			const XMP_NodeOffspring & siblings = frame.Siblings();
+
+			if ( frame.index >= siblings.size() ) {	// At the end of the siblings, move up to the parent.
+				if ( level == info.baseLevel ) {
+					info.frames.clear();
+				} else {
+					info.currPath.erase ( frame.pathStart );
+					info.frames.pop_back();
 				}
+				continue;
 			}
 
-			if ( info.currPos->visitStage == kIter_VisitChildren ) {	// Just finished visiting the children.
-				info.currPos->children.clear();
-				++info.currPos;											// Move to the next sibling.
+			frame.node = siblings[frame.index];
+			if ( (level == 0) && frame.node->children.empty() && (! justChildren) ) {
+				frame.visitStage = kIter_VisitChildren;	// Don't visit an empty schema.
 				continue;
 			}
-			
-			#if TraceIterators
-				if ( info.currPos != info.endPos ) {
-					printf ( "    Moved to %s, stage = %s\n",
-					         info.currPos->fullPath.c_str(), sStageNames[info.currPos->visitStage] );
-				}
-			#endif
-			
-		}
-
-	}	// Loop to find the next node.
-	
-	XMP_Assert ( (info.currPos == info.endPos) || (info.currPos->visitStage == kIter_BeforeVisit) );
 
-}	// AdvanceIterPos
+			frame.visitStage = kIter_VisitSelf;
+			SetFramePath ( info, level );
+			return frame.node;
 
-// -------------------------------------------------------------------------------------------------
-// GetNextXMPNode
-// --------------
-//
-// Used by XMPIterator::Next to obtain the next XMP node, ignoring the kXMP_IterJustLeafNodes flag.
-// This isolates some messy code, allowing a clean loop in Next if kXMP_IterJustLeafNodes is set.
+		}
 
-static const XMP_Node *
-GetNextXMPNode ( IterInfo & info )
-{
-	const XMP_Node * xmpNode = 0;
-
-	// ----------------------------------------------------------------------------------------------
-	// On entry currPos points to an iteration node whose state is either before-visit or visit-self.
-	// If it is before-visit then we will return that node's value part now. If it is visit-self it
-	// means the previous iteration returned the value portion of that node, so we can advance to the
-	// next node in the iteration tree. Then we find the corresponding XMP node, allowing for the XMP
-	// tree to have been modified since that part of the iteration tree was constructed.
-	
-	// ! NOTE: Supporting aliases throws in some nastiness with schemas. There might not be any XMP
-	// ! node for the schema, but we still have to visit it because of possible aliases. The static
-	// ! sDummySchema is returned if there is no real schema node.
+		if ( info.frames[level].visitStage == kIter_VisitSelf ) {	// Just finished visiting the value portion.
+			const XMP_Node * node = info.frames[level].node;
+			info.frames[level].visitStage = kIter_VisitQualifiers;	// Start visiting the qualifiers.
+			if ( canExpand && (! node->qualifiers.empty()) && (! (info.options & kXMP_IterOmitQualifiers)) &&
+				 (! XMP_NodeIsSchema ( node->options )) ) {
+				info.frames.push_back ( IterFrame ( node, true, info.currPath.size() ) );
+				continue;
+			}
+		}
 
-	if ( info.currPos->visitStage != kIter_BeforeVisit ) AdvanceIterPos ( info );
-	
-	bool isSchemaNode = false;
-	XMP_ExpandedXPath expPath;	// Keep outside the loop to avoid constant construct/destruct.
-	
-	while ( info.currPos != info.endPos ) {
+		if ( info.frames[level].visitStage == kIter_VisitQualifiers ) {	// Just finished visiting the qualifiers.
+			const XMP_Node * node = info.frames[level].node;
+			info.frames[level].visitStage = kIter_VisitChildren;	// Start visiting the children.
+			if ( canExpand && (! node->children.empty()) ) {
+				info.frames.push_back ( IterFrame ( node, false, info.currPath.size() ) );
+				continue;
+			}
+		}
 
-		isSchemaNode = XMP_NodeIsSchema ( info.currPos->options );
-		if ( isSchemaNode ) {
-			SetCurrSchema ( info, info.currPos->fullPath );
-			xmpNode = FindConstSchema ( &info.xmpObj->tree, info.currPos->fullPath.c_str() );
-			if ( xmpNode == 0 ) xmpNode = sDummySchema;
+		XMP_Assert ( info.frames[level].visitStage == kIter_VisitChildren );	// Just finished visiting the children.
+		if ( (level == info.baseLevel) && (! info.baseSiblings) ) {
+			info.frames.clear();	// The iteration root has no siblings to visit.
 		} else {
-			ExpandXPath ( info.currSchema.c_str(), info.currPos->fullPath.c_str(), &expPath );
-			xmpNode = FindConstNode ( &info.xmpObj->tree, expPath );
+			++info.frames[level].index;	// Move to the next sibling.
+			info.frames[level].visitStage = kIter_BeforeVisit;
 		}
-		if ( xmpNode != 0 ) break;	// Exit the loop, we found a live XMP node.
-
-		info.currPos->visitStage = kIter_VisitChildren;	// Make AdvanceIterPos move to the next sibling.
-		info.currPos->children.clear();
-		info.currPos->qualifiers.clear();
-		AdvanceIterPos ( info );
 
 	}
 
-	if ( info.currPos == info.endPos ) return 0;
-	
-	// -------------------------------------------------------------------------------------------
-	// Now we've got the iteration node and corresponding XMP node. Add the iteration children for
-	// structs and arrays. The children of schema were added when the iterator was constructed.
-
-	XMP_Assert ( info.currPos->visitStage == kIter_BeforeVisit );
-
-	if ( info.currPos->visitStage == kIter_BeforeVisit ) {
-		if ( (! isSchemaNode) && (! (info.options & kXMP_IterJustChildren)) ) {
-			AddNodeOffspring ( info, *info.currPos, xmpNode );
-		}
-		info.currPos->visitStage = kIter_VisitSelf;
-	}
-	
-	return xmpNode;
+	return 0;
 
 }	// GetNextXMPNode
 
@@ -331,7 +223,6 @@ GetNextXMPNode ( IterInfo & info )
 /* class static */ bool
 XMPIterator::Initialize()
 {
-	sDummySchema = new XMP_Node ( 0, "dummy:schema/", kXMP_SchemaNode);
 	return true;
 	
 }	// Initialize
@@ -343,8 +234,6 @@ XMPIterator::Initialize()
 /* class static */ void
 XMPIterator::Terminate() RELEASE_NO_THROW
 {
-	delete ( sDummySchema );
-	sDummySchema = 0;
 	return;
 	
 }	// Terminate
@@ -357,13 +246,12 @@ XMPIterator::Terminate() RELEASE_NO_THROW
 // XMPIterator
 // -----------
 //
-// Constructor for iterations over the nodes in an XMPMeta object. This builds a tree of iteration
-// nodes that caches the existing node names of the XMPMeta object. The iteration tree is a partial
-// replica of the XMPMeta tree. The initial iteration tree normally has just the root node, all of
-// the schema nodes for a full object iteration. Lower level nodes (children and qualifiers) are 
-// added when the parent is visited. If the kXMP_IterJustChildren option is passed then the initial
-// iterator includes the children and the parent is marked as done. The iteration tree nodes are
-// pruned when they are no longer needed. 
+// Constructor for iterations over the nodes in an XMPMeta object. The iteration walks the XMPMeta
+// tree directly, no copy of the node names is made. The constructor sets up the frame stack for the
+// first node to be visited. For a full object iteration that is the first schema. For a schema or
+// property iteration the frames from the schema down to the root node are made, the root is the
+// base of the iteration. If the kXMP_IterJustChildren option is passed for a schema or property
+// iteration the root node is marked as already visited.
 
 XMPIterator::XMPIterator ( const XMPMeta & xmpObj,
 						   XMP_StringPtr   schemaNS,
@@ -376,22 +264,20 @@ XMPIterator::XMPIterator ( const XMPMeta & xmpObj,
 	
 	// *** Lock the XMPMeta object if we ever stop using a full DLL lock.
 
+	const XMP_Node * rootNode = 0;
+
 	if ( *propName != 0 ) {
 
 		// An iterator rooted at a specific node.
 
-		#if TraceIterators
-			printf ( "\nNew XMP property iterator for \"%s\", options = %X\n    Schema = %s, root = %s\n",
-			         xmpObj.tree.name.c_str(), options, schemaNS, propName );
-		#endif
-		
 		XMP_ExpandedXPath propPath;
 		ExpandXPath ( schemaNS, propName, &propPath );
-		XMP_Node * propNode = FindConstNode ( &xmpObj.tree, propPath );	// If not found get empty iteration.
+		rootNode = FindConstNode ( &xmpObj.tree, propPath );	// If not found get empty iteration.
 		
-		if ( propNode != 0 ) {
+		if ( rootNode != 0 ) {
 
-			XMP_VarString rootName ( propPath[1].step );	// The schema is [0].
+			XMP_VarString & rootName = info.rootPath;
+			rootName = propPath[1].step;	// The schema is [0].
 			for ( size_t i = 2; i < propPath.size(); ++i ) {
 				XMP_OptionBits stepKind = GetStepKind ( propPath[i].options );
 				if ( stepKind <= kXMP_QualifierStep ) rootName += '/';
@@ -402,12 +288,7 @@ XMPIterator::XMPIterator ( const XMPMeta & xmpObj,
 			size_t leafOffset = rootName.size();
 			while ( (leafOffset > 0) && (propName[leafOffset] != '/') && (propName[leafOffset] != '[') ) --leafOffset;
 			if ( propName[leafOffset] == '/' ) ++leafOffset;
-
-			info.tree.children.push_back ( IterNode ( propNode->options, propName, leafOffset ) );
-			SetCurrSchema ( info, propPath[kSchemaStep].step.c_str() );
-			if ( info.options & kXMP_IterJustChildren ) {
-				AddNodeOffspring ( info, info.tree.children.back(), propNode );
-			}
+			info.rootLeafOffset = leafOffset;
 
 		}
 	
@@ -415,68 +296,50 @@ XMPIterator::XMPIterator ( const XMPMeta & xmpObj,
 
 		// An iterator for all properties in one schema.
 		
-		#if TraceIterators
-			printf ( "\nNew XMP schema iterator for \"%s\", options = %X\n    Schema = %s\n",
-			         xmpObj.tree.name.c_str(), options, schemaNS );
-		#endif
-		
-		info.tree.children.push_back ( IterNode ( kXMP_SchemaNode, schemaNS, 0 ) );
-		IterNode & iterSchema = info.tree.children.back();
-		
-		XMP_Node * xmpSchema = FindConstSchema ( &xmpObj.tree, schemaNS );
-		if ( xmpSchema != 0 ) AddSchemaProps ( info, iterSchema, xmpSchema );
-		
-		if ( iterSchema.children.empty() ) {
-			info.tree.children.pop_back();	// No properties, remove the schema node.
-		} else {
-			SetCurrSchema ( info, schemaNS );
-		}
+		rootNode = FindConstSchema ( &xmpObj.tree, schemaNS );
+		if ( (rootNode != 0) && rootNode->children.empty() ) rootNode = 0;	// No properties, empty iteration.
 	
 	} else {
 
-		// An iterator for all properties in all schema. First add schema that exist (have children),
-		// adding aliases from them if appropriate. Then add schema that have no actual properties
-		// but do have aliases to existing properties, if we're including aliases in the iteration.
+		// An iterator for all properties in all schema, the base frame walks the list of schema.
 		
-		#if TraceIterators
-			printf ( "\nNew XMP tree iterator for \"%s\", options = %X\n",
-			         xmpObj.tree.name.c_str(), options );
-		#endif
-		
-		// First pick up the schema that exist.
-		
-		for ( size_t schemaNum = 0, schemaLim = xmpObj.tree.children.size(); schemaNum != schemaLim; ++schemaNum ) {
+		if ( ! xmpObj.tree.children.empty() ) {
+			info.frames.push_back ( IterFrame ( &xmpObj.tree, false, 0 ) );
+			info.frames.back().node = xmpObj.tree.children[0];
+			info.baseSiblings = true;
+		}
 
-			const XMP_Node * xmpSchema = xmpObj.tree.children[schemaNum];
-			info.tree.children.push_back ( IterNode ( kXMP_SchemaNode, xmpSchema->name, 0 ) );
-			IterNode & iterSchema = info.tree.children.back();
+	}
 
-			if ( ! (info.options & kXMP_IterJustChildren) ) {
-				AddSchemaProps ( info, iterSchema, xmpSchema );
-				if ( iterSchema.children.empty() ) info.tree.children.pop_back();	// No properties, remove the schema node.
-			}
+	if ( rootNode != 0 ) {
 
-		}
+		// Make the frames from the schema down to the root node, the parent links are followed up
+		// from the root. The schema node's parent is the tree root.
 
-	}
-	
-	// Set the current iteration position to the first node to be visited.
-	
-	info.currPos = info.tree.children.begin();
-	info.endPos  = info.tree.children.end();
-	
-	if ( (info.options & kXMP_IterJustChildren) && (info.currPos != info.endPos) && (*schemaNS != 0) ) {
-		info.currPos->visitStage = kIter_VisitSelf;
-	}
+		std::vector < const XMP_Node * > lineage;
+		for ( const XMP_Node * node = rootNode; node->parent != 0; node = node->parent ) lineage.push_back ( node );
 
-	#if TraceIterators
-		if ( info.currPos == info.endPos ) {
-			printf ( "    ** Empty iteration **\n" );
-		} else {
-			printf ( "    Initial node %s, stage = %s, iterator @ %.8X\n",
-			         info.currPos->fullPath.c_str(), sStageNames[info.currPos->visitStage], this );
+		for ( size_t i = lineage.size(); i > 0; --i ) {
+			const XMP_Node * node = lineage[i-1];
+			IterFrame frame ( node->parent, ((node->options & kXMP_PropIsQualifier) != 0), 0 );
+			const XMP_NodeOffspring & siblings = frame.Siblings();
+			while ( (frame.index < siblings.size()) && (siblings[frame.index] != node) ) ++frame.index;
+			XMP_Assert ( frame.index < siblings.size() );
+			frame.node = node;
+			frame.visitStage = kIter_VisitChildren;
+			info.frames.push_back ( frame );
+		}
+
+		info.baseLevel = info.frames.size() - 1;
+		info.expandLimit = info.baseLevel + 1;
+		info.frames.back().visitStage = kIter_BeforeVisit;
+		
+		if ( info.options & kXMP_IterJustChildren ) {
+			info.frames.back().visitStage = kIter_VisitSelf;
+			SetFramePath ( info, info.baseLevel );
 		}
-	#endif
+
+	}
 	
 }	// XMPIterator for XMPMeta objects
 
@@ -499,9 +362,9 @@ XMPIterator::~XMPIterator() RELEASE_NO_THROW
 // Next
 // ----
 //
-// Do a preorder traversal of the cached nodes.
-
-// *** Need to document the relationships between currPos, endPos, and visitStage.
+// Do a preorder traversal of the XMP tree. The top frame is the node returned by the last call, its
+// visitStage tells what to do next. The path is kept in one buffer, only the last part changes when
+// moving to a sibling.
 
 bool
 XMPIterator::Next ( XMP_StringPtr *	 schemaNS,
@@ -514,47 +377,47 @@ XMPIterator::Next ( XMP_StringPtr *	 schemaNS,
 {
 	// *** Lock the XMPMeta object if we ever stop using a full DLL lock.
 	
-	// ! NOTE: Supporting aliases throws in some nastiness with schemas. There might not be any XMP
-	// ! node for the schema, but we still have to visit it because of possible aliases.
-	
-	if ( info.currPos == info.endPos ) return false;	// Happens at the start of an empty iteration.
-	
-	#if TraceIterators
-		printf ( "Next iteration from %s, stage = %s, iterator @ %.8X\n",
-			     info.currPos->fullPath.c_str(), sStageNames[info.currPos->visitStage], this );
-	#endif
+	if ( info.frames.empty() ) return false;	// Happens at the start of an empty iteration.
 	
+	if ( ! ValidateFrames ( info ) ) {
+		info.frames.clear();
+		return false;
+	}
+
 	const XMP_Node * xmpNode = GetNextXMPNode ( info );
 	if ( xmpNode == 0 ) return false;
-	bool isSchemaNode = XMP_NodeIsSchema ( info.currPos->options );
+	bool isSchemaNode = XMP_NodeIsSchema ( xmpNode->options );
 	
 	if ( info.options & kXMP_IterJustLeafNodes ) {
 		while ( isSchemaNode || (! xmpNode->children.empty()) ) {
-			info.currPos->visitStage = kIter_VisitQualifiers;	// Skip to this node's children.
+			info.frames.back().visitStage = kIter_VisitQualifiers;	// Skip to this node's children.
 			xmpNode = GetNextXMPNode ( info );
 			if ( xmpNode == 0 ) return false;
-			isSchemaNode = XMP_NodeIsSchema ( info.currPos->options );
+			isSchemaNode = XMP_NodeIsSchema ( xmpNode->options );
 		}
 	}
 	
-	*schemaNS = info.currSchema.c_str();
-	*nsSize   = static_cast<XMP_StringLen>(info.currSchema.size());
+	const IterFrame & frame = info.frames.back();
+	const XMP_Node * xmpSchema = info.frames.front().node;
 
-	*propOptions = info.currPos->options;
+	*schemaNS = xmpSchema->name.c_str();
+	*nsSize   = static_cast<XMP_StringLen>(xmpSchema->name.size());
+
+	*propOptions = (isSchemaNode ? kXMP_SchemaNode : xmpNode->options);
 
 	*propPath  = "";
 	*pathSize  = 0;
 	*propValue = "";
 	*valueSize = 0;
 	
-	if ( ! (*propOptions & kXMP_SchemaNode) ) {
+	if ( ! isSchemaNode ) {
 
-		*propPath = info.currPos->fullPath.c_str();
-		*pathSize = static_cast<XMP_StringLen>(info.currPos->fullPath.size());
+		*propPath = info.currPath.c_str();
+		*pathSize = static_cast<XMP_StringLen>(info.currPath.size());
 
 		if ( info.options & kXMP_IterJustLeafName ) {
-			*propPath += info.currPos->leafOffset;
-			*pathSize -= info.currPos->leafOffset;
+			*propPath += frame.leafOffset;
+			*pathSize -= static_cast<XMP_StringLen>(frame.leafOffset);
 			xmpNode->GetLocalURI ( schemaNS, nsSize );	// Use the leaf namespace, not the top namespace.
 		}
 		
@@ -565,11 +428,6 @@ XMPIterator::Next ( XMP_StringPtr *	 schemaNS,
 
 	}
 	
-	#if TraceIterators
-		printf ( "    Next node %s, stage = %s\n",
-			     info.currPos->fullPath.c_str(), sStageNames[info.currPos->visitStage] );
-	#endif
-	
 	return true;
 
 }	// Next
@@ -579,9 +437,8 @@ XMPIterator::Next ( XMP_StringPtr *	 schemaNS,
 // ----
 //
 // Skip some portion of the traversal related to the last visited node. We skip either that node's
-// children, or those children and the previous node's siblings. The implementation might look a bit
-// awkward because info.currNode always points to the next node to be visited. We might already have
-// moved past the things to skip, e.g. if the previous node was simple and the last of its siblings.
+// children, or those children and the node's siblings. Nothing moves here, the top frame is marked
+// so that the next call to Next moves on from the right place.
 
 enum {
 	kXMP_ValidIterSkipOptions	= kXMP_IterSkipSubtree | kXMP_IterSkipSiblings
@@ -590,32 +447,21 @@ enum {
 void
 XMPIterator::Skip ( XMP_OptionBits iterOptions )
 {
-//	if ( (info.currPos == kIter_NullPos) )  XMP_Throw ( "No prior postion to skip from", kXMPErr_BadIterPosition );
 	if ( iterOptions == 0 ) XMP_Throw ( "Must specify what to skip", kXMPErr_BadOptions );
 	if ( (iterOptions & ~kXMP_ValidIterSkipOptions) != 0 ) XMP_Throw ( "Undefined options", kXMPErr_BadOptions );
 
-	#if TraceIterators
-		printf ( "Skipping from %s, stage = %s, iterator @ %.8X",
-			     info.currPos->fullPath.c_str(), sStageNames[info.currPos->visitStage], this );
-	#endif
-	
+	if ( info.frames.empty() ) return;	// At the end of the iteration, nothing left to skip.
+
 	if ( iterOptions & kXMP_IterSkipSubtree ) {
-		#if TraceIterators
-			printf ( ", mode = subtree\n" );
-		#endif
-		info.currPos->visitStage = kIter_VisitChildren;
+		info.frames.back().visitStage = kIter_VisitChildren;
 	} else if ( iterOptions & kXMP_IterSkipSiblings ) {
-		#if TraceIterators
-			printf ( ", mode = siblings\n" );
-		#endif
-		info.currPos = info.endPos;
-		AdvanceIterPos ( info );
+		if ( info.frames.size() - 1 == info.baseLevel ) {
+			info.frames.clear();	// The base node's siblings are the whole iteration.
+		} else {
+			info.currPath.erase ( info.frames.back().pathStart );
+			info.frames.pop_back();
+		}
 	}
-	#if TraceIterators
-		printf ( "    Skipped to %s, stage = %s\n",
-			     info.currPos->fullPath.c_str(), sStageNames[info.currPos->visitStage] );
-	#endif
-	
 
 }	// Skip
 
@@ -15,13 +15,6 @@
 
 // =================================================================================================
 
-struct IterNode;
-typedef std::vector < IterNode >	IterOffspring;
-typedef IterOffspring::iterator		IterPos;
-
-typedef std::pair < IterPos, IterPos > IterPosPair;
-typedef std::vector < IterPosPair >	IterPosStack;
-
 enum {	// Values for the visitStage field, used to decide how to proceed past a node.
 	kIter_BeforeVisit		= 0,	// Have not visited this node at all.
 	kIter_VisitSelf			= 1,	// Have visited this node and returned its value/options portion.
@@ -29,60 +22,49 @@ enum {	// Values for the visitStage field, used to decide how to proceed past a
 	kIter_VisitChildren		= 3		// In the midst of visiting this node's children.
 };
 
-struct IterNode {
+// The iteration walks the XMP tree itself, there is no copy of the node names. An IterFrame is the
+// position within one list of siblings, the children or qualifiers of the parent. The frames for
+// the path from a schema to the current node are kept in a stack. The node pointer is kept so that
+// changes to the XMP tree between calls can be noticed, see ValidateFrames in XMPIterator.cpp.
 
-	XMP_OptionBits	options;
-	XMP_VarString	fullPath;
-	size_t			leafOffset;
-	IterOffspring	children, qualifiers;
-	XMP_Uns8		visitStage;
-	#if 0	// *** XMP_DebugBuild
-		XMP_StringPtr	_pathPtr, _leafPtr;	// *** Not working, need operator=?
-	#endif
-
-	IterNode() : options(0), leafOffset(0), visitStage(kIter_BeforeVisit)
-	{
-		#if 0	// *** XMP_DebugBuild
-			_pathPtr = _leafPtr = 0;
-		#endif
-	};
-
-	IterNode ( XMP_OptionBits _options, const XMP_VarString& _fullPath, size_t _leafOffset )
-			 : options(_options), fullPath(_fullPath), leafOffset(_leafOffset), visitStage(kIter_BeforeVisit)
-	{
-		#if 0	// *** XMP_DebugBuild
-			_pathPtr = fullPath.c_str();
-			_leafPtr = _pathPtr + leafOffset;
-		#endif
-	};
+struct IterFrame {
+
+	const XMP_Node * parent;
+	const XMP_Node * node;			// Should be the parent's child or qualifier at index.
+	size_t			 index;
+	size_t			 pathStart;		// Where this node's part of the path begins in IterInfo::currPath.
+	size_t			 leafOffset;	// Where the leaf name begins in IterInfo::currPath.
+	bool			 isQualifier;
+	XMP_Uns8		 visitStage;
+
+	IterFrame() : parent(0), node(0), index(0), pathStart(0), leafOffset(0), isQualifier(false), visitStage(kIter_BeforeVisit) {};
+
+	IterFrame ( const XMP_Node * _parent, bool _isQualifier, size_t _pathStart )
+		: parent(_parent), node(0), index(0), pathStart(_pathStart), leafOffset(_pathStart),
+		  isQualifier(_isQualifier), visitStage(kIter_BeforeVisit) {};
+
+	const XMP_NodeOffspring & Siblings() const { return (this->isQualifier ? this->parent->qualifiers : this->parent->children); };
 
 };
 
+typedef std::vector < IterFrame > IterFrameStack;
+
 struct IterInfo {
 
 	XMP_OptionBits	options;
 	const XMPMeta *	xmpObj;
-	XMP_VarString	currSchema;
-	IterPos			currPos, endPos;
-	IterPosStack	ancestors;
-	IterNode 		tree;
-	#if 0	// *** XMP_DebugBuild
-		XMP_StringPtr	_schemaPtr;	// *** Not working, need operator=?
-	#endif
-
-	IterInfo() : options(0), xmpObj(0)
-	{
-		#if 0	// *** XMP_DebugBuild
-			_schemaPtr = 0;
-		#endif
-	};
-
-	IterInfo ( XMP_OptionBits _options, const XMPMeta * _xmpObj ) : options(_options), xmpObj(_xmpObj)
-	{
-		#if 0	// *** XMP_DebugBuild
-			_schemaPtr = 0;
-		#endif
-	};
+	IterFrameStack	frames;			// The path from a schema node to the current node.
+	size_t			baseLevel;		// The frames below this hold the fixed ancestors of a property iteration.
+	size_t			expandLimit;	// With kXMP_IterJustChildren, only frames below this are expanded.
+	bool			baseSiblings;	// Visit the siblings of the base node, true when iterating all schema.
+	XMP_VarString	rootPath;		// The path of the base node for a property iteration.
+	size_t			rootLeafOffset;
+	XMP_VarString	currPath;		// The path of the current node, built incrementally as the frames change.
+
+	IterInfo() : options(0), xmpObj(0), baseLevel(0), expandLimit(0), baseSiblings(false), rootLeafOffset(0) {};
+
+	IterInfo ( XMP_OptionBits _options, const XMPMeta * _xmpObj )
+		: options(_options), xmpObj(_xmpObj), baseLevel(0), expandLimit(0), baseSiblings(false), rootLeafOffset(0) {};
 
 };
 
@@ -15,6 +15,8 @@
 	#include <iostream>
 #endif
 
+#include <algorithm>
+
 #include "XMPCore/source/XMPCore_Impl.hpp"
 
 #include "XMPCore/source/XMPMeta.hpp"
@@ -247,7 +249,7 @@ DoSetArrayItem ( XMP_Node *		arrayNode,
 	if ( itemIndex == arraySize+1 ) {
 
 		if ( itemLoc != 0 ) XMP_Throw ( "Can't insert before or after implicit new item", kXMPErr_BadIndex );
-		itemNode = new XMP_Node ( arrayNode, kXMP_ArrayItemName, 0 );
+		itemNode = new ( arrayNode ) XMP_Node ( arrayNode, kXMP_ArrayItemName, 0 );
 		arrayNode->children.push_back ( itemNode );
 
 	} else {
@@ -259,7 +261,7 @@ DoSetArrayItem ( XMP_Node *		arrayNode,
 		} else {
 			XMP_NodePtrPos itemPos = arrayNode->children.begin() + itemIndex;
 			if ( itemLoc == kXMP_InsertAfterItem ) ++itemPos;
-			itemNode = new XMP_Node ( arrayNode, kXMP_ArrayItemName, 0 );
+			itemNode = new ( arrayNode ) XMP_Node ( arrayNode, kXMP_ArrayItemName, 0 );
 			itemPos = arrayNode->children.insert ( itemPos, itemNode );
 		}
 
@@ -378,8 +380,8 @@ ChooseLocalizedText ( const XMP_Node *	 arrayNode,
 static void
 AppendLangItem ( XMP_Node * arrayNode, XMP_StringPtr itemLang, XMP_StringPtr itemValue )
 {
-	XMP_Node * newItem  = new XMP_Node ( arrayNode, kXMP_ArrayItemName, (kXMP_PropHasQualifiers | kXMP_PropHasLang) );
-	XMP_Node * langQual = new XMP_Node ( newItem, "xml:lang", kXMP_PropIsQualifier );
+	XMP_Node * newItem  = new ( arrayNode ) XMP_Node ( arrayNode, kXMP_ArrayItemName, (kXMP_PropHasQualifiers | kXMP_PropHasLang) );
+	XMP_Node * langQual = new ( newItem ) XMP_Node ( newItem, "xml:lang", kXMP_PropIsQualifier );
 	
 	try {	// ! Use SetNodeValue, not constructors above, to get the character checks.
 		SetNodeValue ( newItem, itemValue );
@@ -438,6 +440,189 @@ XMPMeta::GetProperty ( XMP_StringPtr	schemaNS,
 }	// GetProperty
 
 
+// -------------------------------------------------------------------------------------------------
+// ResolvePropertyAtom
+// -------------------
+//
+// The path is expanded once, this also checks the namespace and the path syntax. A top level alias
+// is replaced by its actual path here, the alias is resolved as of when the atom is made. The name
+// atoms are interned even if no node has these names yet, nodes created later get the same atoms.
+
+/* class static */ XMP_PropertyAtom *
+XMPMeta::ResolvePropertyAtom ( XMP_StringPtr schemaNS,
+							   XMP_StringPtr propName )
+{
+	XMP_Assert ( (schemaNS != 0) && (propName != 0) );	// Enforced by wrapper.
+
+	XMP_PropertyAtom * propAtom = new XMP_PropertyAtom;
+
+	try {
+		ExpandXPath ( schemaNS, propName, &propAtom->expPath );
+	} catch ( ... ) {
+		delete propAtom;
+		throw;
+	}
+
+	const XMP_ExpandedXPath & expPath = propAtom->expPath;
+	const XMP_ExpandedXPath * rootPath = &expPath;	// Supplies the schema and top level steps.
+	size_t stepNum = 2;	// The first step of expPath after those.
+
+	if ( expPath[kRootPropStep].options & kXMP_StepIsAlias ) {
+		XMP_AliasMapPos aliasPos = sRegisteredAliasMap->find ( expPath[kRootPropStep].step );
+		XMP_Assert ( aliasPos != sRegisteredAliasMap->end() );
+		rootPath = &aliasPos->second;
+		if ( rootPath->size() != 2 ) return propAtom;	// The alias is to an array item.
+	}
+
+	for ( size_t stepLim = expPath.size(); stepNum < stepLim; ++stepNum ) {
+		if ( GetStepKind ( expPath[stepNum].options ) != kXMP_StructFieldStep ) return propAtom;
+	}
+
+	std::vector<XMP_NameAtom> & nameAtoms = propAtom->nameAtoms;
+	nameAtoms.reserve ( expPath.size() );
+
+	for ( size_t rootNum = kSchemaStep; rootNum <= kRootPropStep; ++rootNum ) {
+		const XMP_VarString & stepName = (*rootPath)[rootNum].step;
+		nameAtoms.push_back ( InternNameAtom ( stepName.c_str(), stepName.size() ) );
+	}
+
+	for ( stepNum = 2; stepNum < expPath.size(); ++stepNum ) {
+		const XMP_VarString & stepName = expPath[stepNum].step;
+		nameAtoms.push_back ( InternNameAtom ( stepName.c_str(), stepName.size() ) );
+	}
+
+	if ( std::find ( nameAtoms.begin(), nameAtoms.end(), XMP_NameAtom(0) ) != nameAtoms.end() ) {
+		nameAtoms.clear();	// The name table is full, follow expPath.
+	}
+
+	return propAtom;
+
+}	// ResolvePropertyAtom
+
+
+// -------------------------------------------------------------------------------------------------
+// FindAtomNode
+// ------------
+//
+// Find an existing node for a property atom. A path with name atoms is followed through them as long
+// as the nodes are schemas and structs. Otherwise the expanded path is followed, which also throws
+// for a named step under a simple property or an array, as the string path lookup does. This is a
+// read only lookup, callers holding just the read lock may share the tree and its name indexes.
+
+static const XMP_Node *
+FindAtomNode ( const XMP_Node * xmpTree, const XMP_PropertyAtom & propAtom )
+{
+	const std::vector<XMP_NameAtom> & nameAtoms = propAtom.nameAtoms;
+	if ( nameAtoms.empty() ) return FindConstNode ( xmpTree, propAtom.expPath );
+
+	const XMP_Node * currNode = FindChildAtom ( xmpTree, nameAtoms[kSchemaStep] );
+
+	for ( size_t stepNum = 1, stepLim = nameAtoms.size(); (currNode != 0) && (stepNum < stepLim); ++stepNum ) {
+		if ( (stepNum > 1) && (! (currNode->options & kXMP_PropValueIsStruct)) ) {
+			return FindConstNode ( xmpTree, propAtom.expPath );
+		}
+		currNode = FindChildAtom ( currNode, nameAtoms[stepNum] );
+	}
+
+	return currNode;
+
+}	// FindAtomNode
+
+
+// -------------------------------------------------------------------------------------------------
+// GetPropertyByAtom
+// -----------------
+
+bool
+XMPMeta::GetPropertyByAtom ( const XMP_PropertyAtom & propAtom,
+							 XMP_StringPtr *	propValue,
+							 XMP_StringLen *	valueSize,
+							 XMP_OptionBits *	options ) const
+{
+	XMP_Assert ( (propValue != 0) && (valueSize != 0) && (options != 0) );	// Enforced by wrapper.
+
+	const XMP_Node * propNode = FindAtomNode ( &tree, propAtom );
+	if ( propNode == 0 ) return false;
+	
+	*propValue = propNode->value.c_str();
+	*valueSize = static_cast<XMP_StringLen>( propNode->value.size() );
+	*options   = propNode->options;
+	
+	return true;
+	
+}	// GetPropertyByAtom
+
+
+// -------------------------------------------------------------------------------------------------
+// GetPropertiesByAtom
+// -------------------
+//
+// The values are laid out by column, all of the values for the first atom then all for the next,
+// each column in the order of the XMP objects. Value i is valueBytes[valueOffsets[i]] up to
+// valueBytes[valueOffsets[i+1]], there is no terminating nul, so valueOffsets holds valueCount+1
+// entries. The offsets, options and present bits are always filled in. The bytes are copied up to
+// the first value that does not fit, nothing is written after it. Returns the number of bytes needed,
+// more than bytesSize if the bytes were cut short.
+//
+// The caller holds the read locks of all of the XMP objects.
+
+/* class static */ XMP_Uns32
+XMPMeta::GetPropertiesByAtom ( const XMPMeta * const *			metas,
+							   XMP_Uns32						metaCount,
+							   const XMP_PropertyAtom * const *	propAtoms,
+							   XMP_Uns32						atomCount,
+							   XMP_Uns32 *						valueOffsets,
+							   char *							valueBytes,
+							   XMP_Uns32						bytesSize,
+							   XMP_OptionBits *					options,
+							   XMP_Uns8 *						presentBits )
+{
+	XMP_Assert ( (metaCount == 0) || (metas != 0) );	// Enforced by wrapper.
+	XMP_Assert ( (atomCount == 0) || (propAtoms != 0) );	// Enforced by wrapper.
+	XMP_Assert ( (valueOffsets != 0) && ((valueBytes != 0) || (bytesSize == 0)) );	// Enforced by wrapper.
+
+	const size_t valueCount = (size_t)metaCount * atomCount;
+	if ( presentBits != 0 ) memset ( presentBits, 0, (valueCount + 7) / 8 );
+
+	XMP_Uns64 bytesNeeded = 0;
+	bool bytesFit = true;
+	size_t valueNum = 0;
+
+	for ( XMP_Uns32 atomNum = 0; atomNum < atomCount; ++atomNum ) {
+
+		const XMP_PropertyAtom & propAtom = *propAtoms[atomNum];
+
+		for ( XMP_Uns32 metaNum = 0; metaNum < metaCount; ++metaNum, ++valueNum ) {
+
+			valueOffsets[valueNum] = static_cast<XMP_Uns32>( bytesNeeded );
+
+			const XMP_Node * propNode = FindAtomNode ( &metas[metaNum]->tree, propAtom );
+			if ( propNode == 0 ) {
+				if ( options != 0 ) options[valueNum] = 0;
+				continue;
+			}
+
+			const size_t valueSize = propNode->value.size();
+			if ( bytesFit ) bytesFit = ( (bytesNeeded + valueSize) <= bytesSize );
+			if ( bytesFit ) {
+				memcpy ( valueBytes + bytesNeeded, propNode->value.data(), valueSize );	// AUDIT: Checked against bytesSize.
+			}
+			bytesNeeded += valueSize;
+			if ( bytesNeeded > 0xFFFFFFFFUL ) XMP_Throw ( "Property values too large for the offsets", kXMPErr_BadParam );
+
+			if ( options != 0 ) options[valueNum] = propNode->options;
+			if ( presentBits != 0 ) presentBits[valueNum >> 3] |= (XMP_Uns8)(1 << (valueNum & 7));
+
+		}
+
+	}
+
+	valueOffsets[valueCount] = static_cast<XMP_Uns32>( bytesNeeded );
+	return static_cast<XMP_Uns32>( bytesNeeded );
+
+}	// GetPropertiesByAtom
+
+
 // -------------------------------------------------------------------------------------------------
 // GetArrayItem
 // ------------
@@ -537,6 +722,28 @@ XMPMeta::SetProperty ( XMP_StringPtr  schemaNS,
 }	// SetProperty
 
 
+// -------------------------------------------------------------------------------------------------
+// SetPropertyByAtom
+// -----------------
+//
+// An existing node is set in place. Otherwise FindNode creates the missing nodes, as for SetProperty.
+
+void
+XMPMeta::SetPropertyByAtom ( const XMP_PropertyAtom & propAtom,
+							 XMP_StringPtr  propValue,
+							 XMP_OptionBits options )
+{
+	options = VerifySetOptions ( options, propValue );
+
+	XMP_Node * propNode = const_cast<XMP_Node*> ( FindAtomNode ( &tree, propAtom ) );	// Under the write lock.
+	if ( propNode == 0 ) propNode = FindNode ( &tree, propAtom.expPath, kXMP_CreateNodes, options );
+	if ( propNode == 0 ) XMP_Throw ( "Specified property does not exist", kXMPErr_BadXPath );
+	
+	SetNode ( propNode, propValue, options );
+	
+}	// SetPropertyByAtom
+
+
 // -------------------------------------------------------------------------------------------------
 // SetArrayItem
 // ------------
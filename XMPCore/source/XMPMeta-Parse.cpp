@@ -213,7 +213,7 @@ NormalizeDCArrays ( XMP_Node * xmpTree )
 		if ( arrayForm == 0 ) continue;	// Nothing to do if it isn't supposed to be an array.
 		
 		arrayForm = VerifySetOptions ( arrayForm, 0 );	// Set the implicit array bits.
-		XMP_Node * newArray = new XMP_Node ( dcSchema, currProp->name.c_str(), arrayForm );
+		XMP_Node * newArray = new ( dcSchema ) XMP_Node ( dcSchema, currProp->name.c_str(), arrayForm );
 		dcSchema->children[propNum] = newArray;
 		
 		if ( currProp->value.empty() ) {	// Don't add an empty item, leave the array empty.
@@ -222,12 +222,13 @@ NormalizeDCArrays ( XMP_Node * xmpTree )
 		
 		} else {
 		
+			XMP_Assert ( currProp->FitsParent ( newArray ) );
 			newArray->children.push_back ( currProp );
 			currProp->parent = newArray;
 			currProp->name = kXMP_ArrayItemName;
 			
 			if ( XMP_ArrayIsAltText ( arrayForm ) && (! (currProp->options & kXMP_PropHasLang)) ) {
-				XMP_Node * newLang = new XMP_Node ( currProp, "xml:lang", "x-default", kXMP_PropIsQualifier );
+				XMP_Node * newLang = new ( currProp ) XMP_Node ( currProp, "xml:lang", "x-default", kXMP_PropIsQualifier );
 				currProp->options |= (kXMP_PropHasQualifiers | kXMP_PropHasLang);
 				if ( currProp->qualifiers.empty() ) {	// *** Need a util?
 					currProp->qualifiers.push_back ( newLang );
@@ -309,7 +310,7 @@ TransplantArrayItemAlias ( XMP_Node * oldParent, size_t oldNum, XMP_Node * newPa
 		    errorCallback.NotifyClient ( kXMPErrSev_OperationFatal, error );	// *** Allow x-default.
 		}
 		childNode->options |= (kXMP_PropHasQualifiers | kXMP_PropHasLang);
-		XMP_Node * langQual = new XMP_Node ( childNode, "xml:lang", "x-default", kXMP_PropIsQualifier );	// *** AddLangQual util?
+		XMP_Node * langQual = new ( childNode ) XMP_Node ( childNode, "xml:lang", "x-default", kXMP_PropIsQualifier );	// *** AddLangQual util?
 		if ( childNode->qualifiers.empty() ) {
 			childNode->qualifiers.push_back ( langQual );
 		} else {
@@ -318,6 +319,7 @@ TransplantArrayItemAlias ( XMP_Node * oldParent, size_t oldNum, XMP_Node * newPa
 	}
 
 	oldParent->children.erase ( oldParent->children.begin() + oldNum );
+	XMP_Assert ( childNode->FitsParent ( newParent ) );
 	childNode->name = kXMP_ArrayItemName;
 	childNode->parent = newParent;
 	if ( newParent->children.empty() ) {
@@ -339,6 +341,7 @@ TransplantNamedAlias ( XMP_Node * oldParent, size_t oldNum, XMP_Node * newParent
 	XMP_Node * childNode = oldParent->children[oldNum];
 
 	oldParent->children.erase ( oldParent->children.begin() + oldNum );
+	XMP_Assert ( childNode->FitsParent ( newParent ) );
 	childNode->name = newName;
 	childNode->parent = newParent;
 	newParent->children.push_back ( childNode );
@@ -394,7 +397,7 @@ MoveExplicitAliases ( XMP_Node * tree, XMP_OptionBits parseOptions, XMPMeta::Err
 					TransplantNamedAlias ( currSchema, propNum, baseSchema, basePath[kRootPropStep].step );
 				} else {
 					// An alias to an array item, create the array and transplant the property.
-					baseNode = new XMP_Node ( baseSchema, basePath[kRootPropStep].step.c_str(), arrayOptions );
+					baseNode = new ( baseSchema ) XMP_Node ( baseSchema, basePath[kRootPropStep].step.c_str(), arrayOptions );
 					baseSchema->children.push_back ( baseNode );
 					TransplantArrayItemAlias ( currSchema, propNum, baseNode, errorCallback );
 				}
@@ -612,7 +615,7 @@ RepairAltText ( XMP_Node & tree, XMP_StringPtr schemaNS, XMP_StringPtr arrayName
 			} else {
 
 				// Add an xml:lang qualifier with the value "x-repair".
-				XMP_Node * repairLang = new XMP_Node ( currChild, "xml:lang", "x-repair", kXMP_PropIsQualifier );
+				XMP_Node * repairLang = new ( currChild ) XMP_Node ( currChild, "xml:lang", "x-repair", kXMP_PropIsQualifier );
 				if ( currChild->qualifiers.empty() ) {
 					currChild->qualifiers.push_back ( repairLang );
 				} else {
@@ -653,11 +656,11 @@ TouchUpDataModel ( XMPMeta * xmp, XMPMeta::ErrorCallbackInfo & /*errorCallback*/
 		// *** For now just do this for exif:UserComment, the one case we know about, late in cycle fix.
 		XMP_Node * userComment = FindChildNode ( currSchema, "exif:UserComment", kXMP_ExistingOnly );
 		if ( (userComment != 0) && XMP_PropIsSimple ( userComment->options ) ) {
-			XMP_Node * newChild = new XMP_Node ( userComment, kXMP_ArrayItemName,
+			XMP_Node * newChild = new ( userComment ) XMP_Node ( userComment, kXMP_ArrayItemName,
 												 userComment->value.c_str(), userComment->options );
 			newChild->qualifiers.swap ( userComment->qualifiers );
 			if ( ! XMP_PropHasLang ( newChild->options ) ) {
-				XMP_Node * langQual = new XMP_Node ( newChild, "xml:lang", "x-default", kXMP_PropIsQualifier );
+				XMP_Node * langQual = new ( newChild ) XMP_Node ( newChild, "xml:lang", "x-default", kXMP_PropIsQualifier );
 				newChild->qualifiers.insert ( newChild->qualifiers.begin(), langQual );
 				newChild->options |= (kXMP_PropHasQualifiers | kXMP_PropHasLang);
 			}
@@ -1199,28 +1202,42 @@ void XMPMeta::ProcessXMLTree ( XMP_OptionBits options )
 	const XML_Node * xmlRoot = FindRootNode ( *this->xmlParser, options );
 
 	if ( xmlRoot != 0 ) {
-
 		this->ProcessRDF ( *xmlRoot, options );
+		this->NormalizeParsedTree ( options );
+	}
 
-		NormalizeDCArrays ( &this->tree );
-		if ( this->tree.options & kXMP_PropHasAliases ) MoveExplicitAliases ( &this->tree, options, this->errorCallback );
-		TouchUpDataModel ( this, this->errorCallback );
-		
-		// Delete empty schema nodes. Do this last, other cleanup can make empty schema.
-		size_t schemaNum = 0;
-		while ( schemaNum < this->tree.children.size() ) {
-			XMP_Node * currSchema = this->tree.children[schemaNum];
-			if ( currSchema->children.size() > 0 ) {
-				++schemaNum;
-			} else {
-				delete this->tree.children[schemaNum];	// ! Delete the schema node itself.
-				this->tree.children.erase ( this->tree.children.begin() + schemaNum );
-			}
+}	// ProcessXMLTree
+
+
+// -------------------------------------------------------------------------------------------------
+// NormalizeParsedTree
+// -------------------
+//
+// Cleanup after the RDF has been turned into the XMP tree, by either the two pass or the single
+// pass parser.
+
+void XMPMeta::NormalizeParsedTree ( XMP_OptionBits options )
+{
+
+	NormalizeDCArrays ( &this->tree );
+	if ( this->tree.options & kXMP_PropHasAliases ) MoveExplicitAliases ( &this->tree, options, this->errorCallback );
+	TouchUpDataModel ( this, this->errorCallback );
+	
+	// Delete empty schema nodes. Do this last, other cleanup can make empty schema.
+	size_t schemaNum = 0;
+	while ( schemaNum < this->tree.children.size() ) {
+		XMP_Node * currSchema = this->tree.children[schemaNum];
+		if ( currSchema->children.size() > 0 ) {
+			++schemaNum;
+		} else {
+			delete this->tree.children[schemaNum];	// ! Delete the schema node itself.
+			this->tree.children.erase ( this->tree.children.begin() + schemaNum );
 		}
-		
 	}
 
-}	// ProcessXMLTree
+	IndexNodeTree ( &this->tree );	// Lookups under the read lock only use existing indexes.
+
+}	// NormalizeParsedTree
 
 
 // -------------------------------------------------------------------------------------------------
@@ -1250,10 +1267,24 @@ XMPMeta::ParseFromBuffer ( XMP_StringPtr  buffer,
 	const bool lastClientCall = ((options & kXMP_ParseMoreBuffers) == 0);	// *** Could use FlagIsSet & FlagIsClear macros.
 	
 	if ( this->xmlParser == 0 ) {
+
 		this->tree.ClearNode();	// Make sure the target XMP object is totally empty.
 		if ( (xmpSize == 0) && lastClientCall ) return;	// Tolerate empty parse. Expat complains if there are no XML elements.
+
+		if ( lastClientCall && (options & kXMP_ParseSinglePass) ) {
+			// The whole packet is at hand, try the single pass parser. If it gives up, the packet is
+			// parsed again by the two pass parser, which also takes care of reporting errors.
+			bool foundRoot = false;
+			if ( this->ProcessRDFStream ( buffer, xmpSize, options, &foundRoot ) ) {
+				if ( foundRoot ) this->NormalizeParsedTree ( options );
+				return;
+			}
+			this->tree.ClearNode();
+		}
+
 		this->xmlParser = XMP_NewExpatAdapter ( ExpatAdapter::kUseGlobalNamespaces );
 		this->xmlParser->SetErrorCallback ( &this->errorCallback );
+
 	}
 	
 	try {	// Cleanup the tree and xmlParser if anything fails.
@@ -23,6 +23,7 @@
 #include "source/UnicodeInlines.incl_cpp"
 #include "source/UnicodeConversions.hpp"
 #include "third-party/zuid/interfaces/MD5.h"
+#include "source/SIMDUtils.hpp"
 
 using namespace std;
 
@@ -273,74 +274,108 @@ EmitRDFArrayTag	( XMP_OptionBits  arrayForm,
 
 
 // -------------------------------------------------------------------------------------------------
-// AppendNodeValue
+// FindEscapedChar
 // ---------------
 //
-// Append a property or qualifier value to the output with appropriate XML escaping. The escaped
-// characters for elements and attributes are '&', '<', '>', and ASCII controls (tab, LF, CR). In
-// addition, '"' is escaped for attributes. For efficiency, this is done in a double loop. The outer
-// loop makes sure the whole value is processed. The inner loop does a contiguous unescaped run
-// followed by one escaped character (if we're not at the end).
-//
-// We depend on parsing and SetProperty logic to make sure there are no invalid ASCII controls in
-// the XMP values. The XML spec only allows tab, LF, and CR. Others are not even allowed as
-// numeric escape sequences.
+// Return the first character in [ptr,limit) that must be escaped, or limit if there is none. The
+// escaped characters for elements and attributes are '&', '<', '>', and ASCII controls (tab, LF, CR).
+// In addition, '"' is escaped for attributes. Most values have nothing to escape, the SSE2 form
+// looks at 16 characters at once.
 
 enum {
 	kForAttribute = true,
 	kForElement   = false
 };
 
-static void
-AppendNodeValue ( XMP_VarString & outputStr, const XMP_VarString & value, bool forAttribute )
+static inline bool
+IsEscapedChar ( XMP_Uns8 ch, bool forAttribute )
 {
+	return ( (ch < 0x20) || (ch == '&') || (ch == '<') || (ch == '>') || (forAttribute && (ch == '"')) );
+}
 
-	unsigned char * runStart = (unsigned char *) value.c_str();
-	unsigned char * runLimit  = runStart + value.size();
-	unsigned char * runEnd;
-	unsigned char   ch = 0;
-	
-	while ( runStart < runLimit ) {
-	
-		for ( runEnd = runStart; runEnd < runLimit; ++runEnd ) {
-			ch = *runEnd;
-			if ( forAttribute && (ch == '"') ) break;
-			if ( (ch < 0x20) || (ch == '&') || (ch == '<') || (ch == '>') ) break;
+static const XMP_Uns8 *
+FindEscapedChar ( const XMP_Uns8 * ptr, const XMP_Uns8 * limit, bool forAttribute )
+{
+
+	#if XMP_HasSSE2
+
+		const __m128i lastControl = _mm_set1_epi8 ( 0x1F );
+		const __m128i ampersand   = _mm_set1_epi8 ( '&' );
+		const __m128i lessThan    = _mm_set1_epi8 ( '<' );
+		const __m128i greaterThan = _mm_set1_epi8 ( '>' );
+		const __m128i quote       = _mm_set1_epi8 ( (forAttribute ? '"' : '&') );	// ! An extra '&' for elements.
+
+		while ( (limit - ptr) >= 16 ) {
+			const __m128i block = _mm_loadu_si128 ( (const __m128i *) ptr );
+			__m128i hits = _mm_cmpeq_epi8 ( _mm_min_epu8 ( block, lastControl ), block );	// The bytes <= 0x1F.
+			hits = _mm_or_si128 ( hits, _mm_cmpeq_epi8 ( block, ampersand ) );
+			hits = _mm_or_si128 ( hits, _mm_cmpeq_epi8 ( block, lessThan ) );
+			hits = _mm_or_si128 ( hits, _mm_cmpeq_epi8 ( block, greaterThan ) );
+			hits = _mm_or_si128 ( hits, _mm_cmpeq_epi8 ( block, quote ) );
+			XMP_Uns32 mask = (XMP_Uns32) _mm_movemask_epi8 ( hits );
+			if ( mask != 0 ) return ptr + FirstSetBit ( mask );
+			ptr += 16;
 		}
-		
-		outputStr.append ( (char *) runStart, (runEnd - runStart) );
-		
-		if ( runEnd < runLimit ) {
 
-			if ( ch < 0x20 ) {
-			
-				XMP_Assert ( (ch == kTab) || (ch == kLF) || (ch == kCR) );
+	#endif
 
-				char hexBuf[16];
-				memcpy ( hexBuf, "&#xn;", 6 );	// AUDIT: Length of "&#xn;" is 5, hexBuf size is 16.
-				hexBuf[3] = kHexDigits[ch&0xF];
-				outputStr.append ( hexBuf, 5 );
+	for ( ; ptr < limit; ++ptr ) {
+		if ( IsEscapedChar ( *ptr, forAttribute ) ) break;
+	}
 
-			} else {
+	return ptr;
 
-				if ( ch == '"' ) {
-					outputStr += "&quot;";
-				} else if ( ch == '<' ) {
-					outputStr += "&lt;";
-				} else if ( ch == '>' ) {
-					outputStr += "&gt;";
-				} else {
-					XMP_Assert ( ch == '&' );
-					outputStr += "&amp;";
-				}
+}	// FindEscapedChar
 
-			}
 
-			++runEnd;
+// -------------------------------------------------------------------------------------------------
+// AppendNodeValue
+// ---------------
+//
+// Append a property or qualifier value to the output with appropriate XML escaping, see
+// FindEscapedChar. Each unescaped run is appended at once, followed by one escaped character (if
+// we're not at the end).
+//
+// We depend on parsing and SetProperty logic to make sure there are no invalid ASCII controls in
+// the XMP values. The XML spec only allows tab, LF, and CR. Others are not even allowed as
+// numeric escape sequences.
 
-		}
+static void
+AppendNodeValue ( XMP_VarString & outputStr, const XMP_VarString & value, bool forAttribute )
+{
+
+	const XMP_Uns8 * runStart = (const XMP_Uns8 *) value.data();
+	const XMP_Uns8 * runLimit = runStart + value.size();
+
+	while ( runStart < runLimit ) {
+	
+		const XMP_Uns8 * runEnd = FindEscapedChar ( runStart, runLimit, forAttribute );
+		outputStr.append ( (const char *) runStart, (runEnd - runStart) );
+		if ( runEnd == runLimit ) break;
+
+		const XMP_Uns8 ch = *runEnd;
+
+		if ( ch < 0x20 ) {
 		
-		runStart = runEnd;
+			XMP_Assert ( (ch == kTab) || (ch == kLF) || (ch == kCR) );
+
+			char hexBuf[16];
+			memcpy ( hexBuf, "&#xn;", 6 );	// AUDIT: Length of "&#xn;" is 5, hexBuf size is 16.
+			hexBuf[3] = kHexDigits[ch&0xF];
+			outputStr.append ( hexBuf, 5 );
+
+		} else if ( ch == '"' ) {
+			outputStr.append ( "&quot;", 6 );
+		} else if ( ch == '<' ) {
+			outputStr.append ( "&lt;", 4 );
+		} else if ( ch == '>' ) {
+			outputStr.append ( "&gt;", 4 );
+		} else {
+			XMP_Assert ( ch == '&' );
+			outputStr.append ( "&amp;", 5 );
+		}
+
+		runStart = runEnd + 1;
 	
 	}
 
@@ -1090,16 +1125,29 @@ SerializeAsRDF ( const XMPMeta & xmpObj,
 				 XMP_OptionBits	 options,
 				 XMP_StringPtr	 newline,
 				 XMP_StringPtr	 indentStr,
-				 XMP_Index		 baseIndent )
+				 XMP_Index		 baseIndent,
+				 size_t			 padding )	// The padding the caller adds to headStr, 0 if none.
 {
 	const size_t treeNameLen = xmpObj.tree.name.size();
 	const size_t indentLen   = strlen ( indentStr );
 
-	// First estimate the worst case space and reserve room in the output string. This optimization
-	// avoids reallocating and copying the output as it grows. The initial count does not look at
-	// the values of properties, so it does not account for character entities, e.g. &#xA; for newline.
-	// Since there can be a lot of these in things like the base 64 encoding of a large thumbnail,
-	// inflate the count by 1/4 (easy to do) to accommodate.
+	// Write the packet trailer PI into the tail string as UTF-8.
+	
+	XMP_Index level;
+	
+	tailStr.erase();
+	if ( ! (options & kXMP_OmitPacketWrapper) ) {
+		tailStr.reserve ( strlen(kPacketTrailer) + (strlen(indentStr) * baseIndent) );
+		for ( level = baseIndent; level > 0; --level ) tailStr += indentStr;
+		tailStr += kPacketTrailer;
+		if ( options & kXMP_ReadOnlyPacket ) tailStr[tailStr.size()-4] = 'r';
+	}
+
+	// Estimate the worst case space and reserve room in the output string, including the padding and
+	// tail the caller adds. This optimization avoids reallocating and copying the output as it grows.
+	// The initial count does not look at the values of properties, so it does not account for
+	// character entities, e.g. &#xA; for newline. Since there can be a lot of these in things like the
+	// base 64 encoding of a large thumbnail, inflate the count by 1/4 (easy to do) to accommodate.
 	
 	// *** Need to include estimate for alias comments.
 	
@@ -1112,30 +1160,16 @@ SerializeAsRDF ( const XMPMeta & xmpObj,
 	}
 	
 	outputLen += (outputLen >> 2);	// Inflate by 1/4, an empirical fudge factor.
-	
-	// Now generate the RDF into the head string as UTF-8.
-	
-	XMP_Index level;
-	
-	std::string rdfstring;
-	headStr.erase();
-	rdfstring.reserve ( outputLen );
-
-	// Write the rdf:RDF start tag.
-	rdfstring += kRDF_RDFStart;
-	rdfstring += newline;
-	
-	// Write all of the properties.
-	if ( options & kXMP_UseCompactFormat ) {
-		SerializeCompactRDFSchemas ( xmpObj.tree, rdfstring, newline, indentStr, baseIndent );
-	} else {
-		bool useCanonicalRDF = XMP_OptionIsSet ( options, kXMP_UseCanonicalFormat );
-		SerializeCanonicalRDFSchemas ( xmpObj.tree, rdfstring, newline, indentStr, baseIndent, useCanonicalRDF );
+	outputLen += tailStr.size();
+	if ( ! (options & kXMP_ExactPacketLength) ) {
+		outputLen += padding;
+	} else if ( outputLen < padding ) {
+		outputLen = padding;	// The padding is the full packet size.
 	}
 
-	// Write the rdf:RDF end tag.
-	for ( level = baseIndent+1; level > 0; --level ) rdfstring += indentStr;
-	rdfstring += kRDF_RDFEnd;
+	headStr.erase();
+	headStr.reserve ( outputLen );
+
 	// Write the packet header PI.
 	if ( ! (options & kXMP_OmitPacketWrapper) ) {
 		for ( level = baseIndent; level > 0; --level ) headStr += indentStr;
@@ -1143,38 +1177,49 @@ SerializeAsRDF ( const XMPMeta & xmpObj,
 		headStr += newline;
 	}
 
-	// Write the xmpmeta element's start tag.
+	// Write the xmpmeta element's start tag. The RDF hash is filled in once the RDF is written.
+	size_t hashOffset = 0;
 	if ( ! (options & kXMP_OmitXMPMetaElement) ) {
 		for ( level = baseIndent; level > 0; --level ) headStr += indentStr;
 		headStr += kRDF_XMPMetaStart;
 		headStr += kXMPCore_VersionMessage  "\"";
-		std::string digestStr;
-		unsigned char digestBin [16];
 		if (options & kXMP_IncludeRDFHash)
 		{
-			std::string hashrdf;	
-			MD5_CTX    context;
-			MD5Init ( &context );
-			MD5Update ( &context, (XMP_Uns8*)rdfstring.c_str(), (unsigned int)rdfstring.size() );
-			MD5Final ( digestBin, &context );
-			char buffer [40];
-			for ( int in = 0, out = 0; in < 16; in += 1, out += 2 ) {
-				XMP_Uns8 byte = digestBin[in];
-				buffer[out]   = kHexDigits [ byte >> 4 ];
-				buffer[out+1] = kHexDigits [ byte & 0xF ];
-			}
-			buffer[32] = 0;
-			digestStr.append ( buffer );
 			headStr += " rdfhash=\"";
-			headStr += digestStr + "\"";
+			hashOffset = headStr.size();
+			headStr.append ( 32, '0' );
+			headStr += "\"";
 			headStr += " merged=\"0\"";
 		}
 		headStr += ">";
 		headStr += newline;
 	}
 
+	// Write the RDF in place, from the rdf:RDF start tag to the end tag.
 	for ( level = baseIndent+1; level > 0; --level ) headStr += indentStr;
-	headStr+= rdfstring ;
+	const size_t rdfOffset = headStr.size();
+
+	headStr += kRDF_RDFStart;
+	headStr += newline;
+	
+	if ( options & kXMP_UseCompactFormat ) {
+		SerializeCompactRDFSchemas ( xmpObj.tree, headStr, newline, indentStr, baseIndent );
+	} else {
+		bool useCanonicalRDF = XMP_OptionIsSet ( options, kXMP_UseCanonicalFormat );
+		SerializeCanonicalRDFSchemas ( xmpObj.tree, headStr, newline, indentStr, baseIndent, useCanonicalRDF );
+	}
+
+	for ( level = baseIndent+1; level > 0; --level ) headStr += indentStr;
+	headStr += kRDF_RDFEnd;
+
+	if ( hashOffset != 0 ) {
+		unsigned char digestBin [16];
+		char digestHex [33];
+		MD5Digest ( headStr.data() + rdfOffset, (XMP_Uns32)(headStr.size() - rdfOffset), digestBin );
+		MD5DigestToHex ( digestBin, digestHex );
+		memcpy ( &headStr[hashOffset], digestHex, 32 );
+	}
+
 	headStr += newline;
 
 	// Write the xmpmeta end tag.
@@ -1184,15 +1229,6 @@ SerializeAsRDF ( const XMPMeta & xmpObj,
 		headStr += newline;
 	}
 	
-	// Write the packet trailer PI into the tail string as UTF-8.
-	tailStr.erase();
-	if ( ! (options & kXMP_OmitPacketWrapper) ) {
-		tailStr.reserve ( strlen(kPacketTrailer) + (strlen(indentStr) * baseIndent) );
-		for ( level = baseIndent; level > 0; --level ) tailStr += indentStr;
-		tailStr += kPacketTrailer;
-		if ( options & kXMP_ReadOnlyPacket ) tailStr[tailStr.size()-4] = 'r';
-	}
-	
 }	// SerializeAsRDF
 
 
@@ -1277,7 +1313,8 @@ XMPMeta::SerializeToBuffer ( XMP_VarString * rdfString,
 	
 	std::string tailStr;
 
-	SerializeAsRDF ( *this, *rdfString, tailStr, options, newline, indentStr, baseIndent );
+	const size_t utf8Padding = ( (charEncoding == kXMP_EncodeUTF8) ? padding : 0 );	// Reserved with the output.
+	SerializeAsRDF ( *this, *rdfString, tailStr, options, newline, indentStr, baseIndent, utf8Padding );
 
 	if ( charEncoding == kXMP_EncodeUTF8 ) {
 
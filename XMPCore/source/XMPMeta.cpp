@@ -512,6 +512,8 @@ SortWithinOffspring ( XMP_NodeOffspring & nodeVec )
 // ! The caller assumes all risk that new aliases do not invalidate existing XMPMeta objects. Any
 // ! conflicts will result in later references throwing bad XPath exceptions.
 
+#if XMP_DebugBuild	// Only used to check kStandardAliases.
+
 static void
 RegisterAlias ( XMP_StringPtr  aliasNS,
 				XMP_StringPtr  aliasProp,
@@ -624,59 +626,127 @@ RegisterAlias ( XMP_StringPtr  aliasNS,
 
 }	// RegisterAlias
 
+#endif
+
 
 // -------------------------------------------------------------------------------------------------
 // RegisterStandardAliases
 // -----------------------
+//
+// The standard aliases are fixed, so they are kept resolved in a table instead of going through
+// RegisterAlias. The names use the prefixes of kStandardNamespaces. The table is sorted by alias
+// name, each entry goes at the end of the map. Debug builds check the table against RegisterAlias.
+
+struct StandardAlias {
+	XMP_StringPtr  aliasName;
+	XMP_StringPtr  aliasNS;	// ! Only for the debug check.
+	XMP_StringPtr  actualNS;
+	XMP_StringPtr  actualName;
+	XMP_OptionBits arrayForm;
+};
+
+static const StandardAlias kStandardAliases[] = {
+	{ "exif:DateTimeDigitized", kXMP_NS_EXIF,       kXMP_NS_XMP,        "xmp:CreateDate",         0 },
+	{ "pdf:Author",             kXMP_NS_PDF,        kXMP_NS_DC,         "dc:creator",             kXMP_PropArrayIsOrdered },
+	{ "pdf:BaseURL",            kXMP_NS_PDF,        kXMP_NS_XMP,        "xmp:BaseURL",            0 },
+	{ "pdf:CreationDate",       kXMP_NS_PDF,        kXMP_NS_XMP,        "xmp:CreateDate",         0 },
+	{ "pdf:Creator",            kXMP_NS_PDF,        kXMP_NS_XMP,        "xmp:CreatorTool",        0 },
+	{ "pdf:ModDate",            kXMP_NS_PDF,        kXMP_NS_XMP,        "xmp:ModifyDate",         0 },
+	{ "pdf:Subject",            kXMP_NS_PDF,        kXMP_NS_DC,         "dc:description",         kXMP_PropArrayIsAltText },
+	{ "pdf:Title",              kXMP_NS_PDF,        kXMP_NS_DC,         "dc:title",               kXMP_PropArrayIsAltText },
+	{ "photoshop:Author",       kXMP_NS_Photoshop,  kXMP_NS_DC,         "dc:creator",             kXMP_PropArrayIsOrdered },
+	{ "photoshop:Caption",      kXMP_NS_Photoshop,  kXMP_NS_DC,         "dc:description",         kXMP_PropArrayIsAltText },
+	{ "photoshop:Copyright",    kXMP_NS_Photoshop,  kXMP_NS_DC,         "dc:rights",              kXMP_PropArrayIsAltText },
+	{ "photoshop:Keywords",     kXMP_NS_Photoshop,  kXMP_NS_DC,         "dc:subject",             0 },
+	{ "photoshop:Marked",       kXMP_NS_Photoshop,  kXMP_NS_XMP_Rights, "xmpRights:Marked",       0 },
+	{ "photoshop:Title",        kXMP_NS_Photoshop,  kXMP_NS_DC,         "dc:title",               kXMP_PropArrayIsAltText },
+	{ "photoshop:WebStatement", kXMP_NS_Photoshop,  kXMP_NS_XMP_Rights, "xmpRights:WebStatement", 0 },
+	{ "png:Author",             kXMP_NS_PNG,        kXMP_NS_DC,         "dc:creator",             kXMP_PropArrayIsOrdered },
+	{ "png:Copyright",          kXMP_NS_PNG,        kXMP_NS_DC,         "dc:rights",              kXMP_PropArrayIsAltText },
+	{ "png:CreationTime",       kXMP_NS_PNG,        kXMP_NS_XMP,        "xmp:CreateDate",         0 },
+	{ "png:Description",        kXMP_NS_PNG,        kXMP_NS_DC,         "dc:description",         kXMP_PropArrayIsAltText },
+	{ "png:ModificationTime",   kXMP_NS_PNG,        kXMP_NS_XMP,        "xmp:ModifyDate",         0 },
+	{ "png:Software",           kXMP_NS_PNG,        kXMP_NS_XMP,        "xmp:CreatorTool",        0 },
+	{ "png:Title",              kXMP_NS_PNG,        kXMP_NS_DC,         "dc:title",               kXMP_PropArrayIsAltText },
+	{ "tiff:Artist",            kXMP_NS_TIFF,       kXMP_NS_DC,         "dc:creator",             kXMP_PropArrayIsOrdered },
+	{ "tiff:Copyright",         kXMP_NS_TIFF,       kXMP_NS_DC,         "dc:rights",              0 },
+	{ "tiff:DateTime",          kXMP_NS_TIFF,       kXMP_NS_XMP,        "xmp:ModifyDate",         0 },
+	{ "tiff:ImageDescription",  kXMP_NS_TIFF,       kXMP_NS_DC,         "dc:description",         kXMP_PropArrayIsAltText },
+	{ "tiff:Software",          kXMP_NS_TIFF,       kXMP_NS_XMP,        "xmp:CreatorTool",        0 },
+	{ "xmp:Author",             kXMP_NS_XMP,        kXMP_NS_DC,         "dc:creator",             kXMP_PropArrayIsOrdered },
+	{ "xmp:Authors",            kXMP_NS_XMP,        kXMP_NS_DC,         "dc:creator",             0 },
+	{ "xmp:Description",        kXMP_NS_XMP,        kXMP_NS_DC,         "dc:description",         0 },
+	{ "xmp:Format",             kXMP_NS_XMP,        kXMP_NS_DC,         "dc:format",              0 },
+	{ "xmp:Keywords",           kXMP_NS_XMP,        kXMP_NS_DC,         "dc:subject",             0 },
+	{ "xmp:Locale",             kXMP_NS_XMP,        kXMP_NS_DC,         "dc:language",            0 },
+	{ "xmp:Title",              kXMP_NS_XMP,        kXMP_NS_DC,         "dc:title",               0 },
+	{ "xmpRights:Copyright",    kXMP_NS_XMP_Rights, kXMP_NS_DC,         "dc:rights",              0 },
+};
+
+static const size_t kStandardAliasCount = sizeof(kStandardAliases) / sizeof(kStandardAliases[0]);
+
+#if XMP_DebugBuild
+
+static void
+CheckStandardAliases()
+{
+	XMP_AliasMap * tableMap = sRegisteredAliasMap;
+	sRegisteredAliasMap = new XMP_AliasMap;
+
+	for ( size_t i = 0; i < kStandardAliasCount; ++i ) {
+		const StandardAlias & alias = kStandardAliases[i];
+		RegisterAlias ( alias.aliasNS, alias.aliasName, alias.actualNS, alias.actualName, alias.arrayForm );
+	}
+
+	XMP_Assert ( sRegisteredAliasMap->size() == tableMap->size() );
+	for ( XMP_AliasMapPos mapPos = sRegisteredAliasMap->begin(); mapPos != sRegisteredAliasMap->end(); ++mapPos ) {
+		XMP_AliasMapPos tablePos = tableMap->find ( mapPos->first );
+		XMP_Assert ( (tablePos != tableMap->end()) && (tablePos->second.size() == mapPos->second.size()) );
+		for ( size_t step = 0; step < mapPos->second.size(); ++step ) {
+			XMP_Assert ( tablePos->second[step].step == mapPos->second[step].step );
+			XMP_Assert ( tablePos->second[step].options == mapPos->second[step].options );
+		}
+	}
+
+	delete sRegisteredAliasMap;
+	sRegisteredAliasMap = tableMap;
+
+}	// CheckStandardAliases
+
+#endif
 
 static void
 RegisterStandardAliases()
 {
+	XMP_Assert ( sRegisteredAliasMap->empty() );
+
+	for ( size_t i = 0; i < kStandardAliasCount; ++i ) {
+
+		const StandardAlias & alias = kStandardAliases[i];
+		XMP_Assert ( (i == 0) || (strcmp ( kStandardAliases[i-1].aliasName, alias.aliasName ) < 0) );
 
-	// Aliases from XMP to DC.
-	RegisterAlias ( kXMP_NS_XMP, "Author",       kXMP_NS_DC, "creator", kXMP_PropArrayIsOrdered );
-	RegisterAlias ( kXMP_NS_XMP, "Authors",      kXMP_NS_DC, "creator", 0 );
-	RegisterAlias ( kXMP_NS_XMP, "Description",  kXMP_NS_DC, "description", 0 );
-	RegisterAlias ( kXMP_NS_XMP, "Format",       kXMP_NS_DC, "format", 0 );
-	RegisterAlias ( kXMP_NS_XMP, "Keywords",     kXMP_NS_DC, "subject", 0 );
-	RegisterAlias ( kXMP_NS_XMP, "Locale",       kXMP_NS_DC, "language", 0 );
-	RegisterAlias ( kXMP_NS_XMP, "Title",        kXMP_NS_DC, "title", 0 );
-	RegisterAlias ( kXMP_NS_XMP_Rights, "Copyright", kXMP_NS_DC, "rights", 0 );
-
-	// Aliases from PDF to DC and XMP.
-	RegisterAlias ( kXMP_NS_PDF, "Author",       kXMP_NS_DC, "creator", kXMP_PropArrayIsOrdered );
-	RegisterAlias ( kXMP_NS_PDF, "BaseURL",      kXMP_NS_XMP, "BaseURL", 0 );
-	RegisterAlias ( kXMP_NS_PDF, "CreationDate", kXMP_NS_XMP, "CreateDate", 0 );
-	RegisterAlias ( kXMP_NS_PDF, "Creator",      kXMP_NS_XMP, "CreatorTool", 0 );
-	RegisterAlias ( kXMP_NS_PDF, "ModDate",      kXMP_NS_XMP, "ModifyDate", 0 );
-	RegisterAlias ( kXMP_NS_PDF, "Subject",      kXMP_NS_DC,  "description", kXMP_PropArrayIsAltText );
-	RegisterAlias ( kXMP_NS_PDF, "Title",        kXMP_NS_DC,  "title", kXMP_PropArrayIsAltText );
-
-	// Aliases from Photoshop to DC and XMP.
-	RegisterAlias ( kXMP_NS_Photoshop, "Author",       kXMP_NS_DC, "creator", kXMP_PropArrayIsOrdered );
-	RegisterAlias ( kXMP_NS_Photoshop, "Caption",      kXMP_NS_DC, "description", kXMP_PropArrayIsAltText );
-	RegisterAlias ( kXMP_NS_Photoshop, "Copyright",    kXMP_NS_DC, "rights", kXMP_PropArrayIsAltText );
-	RegisterAlias ( kXMP_NS_Photoshop, "Keywords",     kXMP_NS_DC, "subject", 0 );
-	RegisterAlias ( kXMP_NS_Photoshop, "Marked",       kXMP_NS_XMP_Rights, "Marked", 0 );
-	RegisterAlias ( kXMP_NS_Photoshop, "Title",        kXMP_NS_DC, "title", kXMP_PropArrayIsAltText );
-	RegisterAlias ( kXMP_NS_Photoshop, "WebStatement", kXMP_NS_XMP_Rights, "WebStatement", 0 );
-
-	// Aliases from TIFF and EXIF to DC and XMP.
-	RegisterAlias ( kXMP_NS_TIFF, "Artist",            kXMP_NS_DC,  "creator", kXMP_PropArrayIsOrdered);
-	RegisterAlias ( kXMP_NS_TIFF, "Copyright",         kXMP_NS_DC,  "rights", 0 );
-	RegisterAlias ( kXMP_NS_TIFF, "DateTime",          kXMP_NS_XMP, "ModifyDate", 0 );
-	RegisterAlias ( kXMP_NS_EXIF, "DateTimeDigitized", kXMP_NS_XMP, "CreateDate", 0 );
-	RegisterAlias ( kXMP_NS_TIFF, "ImageDescription",  kXMP_NS_DC,  "description", kXMP_PropArrayIsAltText );
-	RegisterAlias ( kXMP_NS_TIFF, "Software",          kXMP_NS_XMP, "CreatorTool", 0 );
-
-	// Aliases from PNG to DC and XMP.
-	RegisterAlias ( kXMP_NS_PNG, "Author",           kXMP_NS_DC,  "creator", kXMP_PropArrayIsOrdered);
-	RegisterAlias ( kXMP_NS_PNG, "Copyright",        kXMP_NS_DC,  "rights", kXMP_PropArrayIsAltText);
-	RegisterAlias ( kXMP_NS_PNG, "CreationTime",     kXMP_NS_XMP, "CreateDate", 0 );
-	RegisterAlias ( kXMP_NS_PNG, "Description",      kXMP_NS_DC,  "description", kXMP_PropArrayIsAltText);
-	RegisterAlias ( kXMP_NS_PNG, "ModificationTime", kXMP_NS_XMP, "ModifyDate", 0 );
-	RegisterAlias ( kXMP_NS_PNG, "Software",         kXMP_NS_XMP, "CreatorTool", 0 );
-	RegisterAlias ( kXMP_NS_PNG, "Title",            kXMP_NS_DC,  "title", kXMP_PropArrayIsAltText);
+		XMP_OptionBits arrayForm = VerifySetOptions ( alias.arrayForm, 0 );
+
+		XMP_AliasMapPos mapPos =
+			sRegisteredAliasMap->insert ( sRegisteredAliasMap->end(), XMP_AliasMap::value_type ( alias.aliasName, XMP_ExpandedXPath() ) );
+		XMP_ExpandedXPath & expActual = mapPos->second;
+
+		expActual.reserve ( 3 );
+		expActual.push_back ( XPathStepInfo ( alias.actualNS, kXMP_SchemaNode ) );
+		expActual.push_back ( XPathStepInfo ( alias.actualName, (kXMP_StructFieldStep | arrayForm) ) );
+		if ( arrayForm != 0 ) {
+			if ( ! (arrayForm & kXMP_PropArrayIsAltText) ) {
+				expActual.push_back ( XPathStepInfo ( "[1]", kXMP_ArrayIndexStep ) );
+			} else {
+				expActual.push_back ( XPathStepInfo ( "[?xml:lang=\"x-default\"]", kXMP_QualSelectorStep ) );
+			}
+		}
+
+	}
+
+	#if XMP_DebugBuild
+		CheckStandardAliases();
+	#endif
 
 }	// RegisterStandardAliases
 
@@ -686,12 +756,14 @@ RegisterStandardAliases()
 // ============
 
 
-XMPMeta::XMPMeta() : clientRefs(0), tree(XMP_Node(0,"",0)), xmlParser(0)
+XMPMeta::XMPMeta() : clientRefs(0), tree(0,"",0), xmlParser(0)
 {
 	#if XMP_TraceCTorDTor
 		printf ( "Default construct XMPMeta @ %.8X\n", this );
 	#endif
 
+	this->tree.arena = new XMP_NodeArena;
+
 	if ( sDefaultErrorCallback.clientProc != 0 ) {
 		this->errorCallback.wrapperProc = sDefaultErrorCallback.wrapperProc;
 		this->errorCallback.clientProc = sDefaultErrorCallback.clientProc;
@@ -713,6 +785,13 @@ XMPMeta::~XMPMeta() RELEASE_NO_THROW
 	if ( xmlParser != 0 ) delete ( xmlParser );
 	xmlParser = 0;
 
+	XMP_NodeArena * nodeArena = this->tree.arena;
+	nodeArena->BeginRelease();	// ! The node destructors still run, their blocks bypass the free list.
+	this->tree.RemoveChildren();	// ! Not ClearNode, it would touch the node name atoms.
+	this->tree.RemoveQualifiers();
+	this->tree.arena = 0;
+	delete nodeArena;
+
 }	// ~XMPMeta
 
 
@@ -743,6 +822,92 @@ XMPMeta::GetVersionInfo ( XMP_VersionInfo * info )
 
 }	// GetVersionInfo
 
+// -------------------------------------------------------------------------------------------------
+// StandardNamespaceIndex
+// ----------------------
+//
+// The standard namespaces are built into the library, with their hashes computed by the compiler.
+// The index over them is made once per process and is not deleted by Terminate, it does not
+// allocate.
+
+static const XMP_StaticNamespace kStandardNamespaces[] = {
+	XMP_StaticNamespaceEntry ( kXMP_NS_XML, "xml" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_RDF, "rdf" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_DC, "dc" ),
+
+	XMP_StaticNamespaceEntry ( kXMP_NS_XMP, "xmp" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_PDF, "pdf" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_Photoshop, "photoshop" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_PSAlbum, "album" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_EXIF, "exif" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_EXIF_Aux, "aux" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_ExifEX, "exifEX" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_TIFF, "tiff" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_PNG, "png" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_JPEG, "jpeg" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_JP2K, "jp2k" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_CameraRaw, "crs" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_ASF, "asf" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_WAV, "wav" ),
+
+	XMP_StaticNamespaceEntry ( kXMP_NS_AdobeStockPhoto, "bmsp" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_CreatorAtom, "creatorAtom" ),
+
+	XMP_StaticNamespaceEntry ( kXMP_NS_XMP_Rights, "xmpRights" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_XMP_MM, "xmpMM" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_XMP_BJ, "xmpBJ" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_XMP_Note, "xmpNote" ),
+
+	XMP_StaticNamespaceEntry ( kXMP_NS_DM, "xmpDM" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_Script, "xmpScript" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_BWF, "bext" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_AEScart, "AEScart" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_RIFFINFO, "riffinfo" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_XMP_Text, "xmpT" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_XMP_PagedFile, "xmpTPg" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_XMP_Graphics, "xmpG" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_XMP_Image, "xmpGImg" ),
+
+	XMP_StaticNamespaceEntry ( kXMP_NS_XMP_Font, "stFnt" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_XMP_Dimensions, "stDim" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_XMP_ResourceEvent, "stEvt" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_XMP_ResourceRef, "stRef" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_XMP_ST_Version, "stVer" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_XMP_ST_Job, "stJob" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_XMP_ManifestItem, "stMfs" ),
+
+	XMP_StaticNamespaceEntry ( kXMP_NS_XMP_IdentifierQual, "xmpidq" ),
+
+	XMP_StaticNamespaceEntry ( kXMP_NS_IPTCCore, "Iptc4xmpCore" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_IPTCExt, "Iptc4xmpExt" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_DICOM, "DICOM" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_PLUS, "plus" ),
+
+	XMP_StaticNamespaceEntry ( kXMP_NS_PDFA_Schema, "pdfaSchema" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_PDFA_Property, "pdfaProperty" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_PDFA_Type, "pdfaType" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_PDFA_Field, "pdfaField" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_PDFA_ID, "pdfaid" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_PDFA_Extension, "pdfaExtension" ),
+
+	XMP_StaticNamespaceEntry ( kXMP_NS_PDFX, "pdfx" ),
+	XMP_StaticNamespaceEntry ( kXMP_NS_PDFX_ID, "pdfxid" ),
+
+	XMP_StaticNamespaceEntry ( "adobe:ns:meta/", "x" ),
+	XMP_StaticNamespaceEntry ( "http://ns.adobe.com/iX/1.0/", "iX" ),
+
+	XMP_StaticNamespaceEntry ( kXMP_NS_iXML, "iXML" ),
+};
+
+static const size_t kStandardNamespaceCount = sizeof(kStandardNamespaces) / sizeof(kStandardNamespaces[0]);
+
+static const XMP_StaticNamespaceIndex &
+StandardNamespaceIndex()
+{
+	static const XMP_StaticNamespaceIndex sIndex ( kStandardNamespaces, kStandardNamespaceCount );
+	return sIndex;
+}	// StandardNamespaceIndex
+
 // -------------------------------------------------------------------------------------------------
 // Initialize
 // ----------
@@ -790,82 +955,21 @@ XMPMeta::Initialize()
 	
 	xdefaultName = new XMP_VarString ( "x-default" );
 
-	sRegisteredNamespaces = new XMP_NamespaceTable;
 	sRegisteredAliasMap   = new XMP_AliasMap;
 	InitializeUnicodeConversions();
 
 
-	// Register standard namespaces and aliases.
-
-	XMP_StringPtr	voidPtr;
-	XMP_StringLen	voidLen;
-
-	(void) RegisterNamespace ( kXMP_NS_XML, "xml", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_RDF, "rdf", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_DC, "dc", &voidPtr, &voidLen );
-
-	(void) RegisterNamespace ( kXMP_NS_XMP, "xmp", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_PDF, "pdf", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_Photoshop, "photoshop", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_PSAlbum, "album", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_EXIF, "exif", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_EXIF_Aux, "aux", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_ExifEX, "exifEX", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_TIFF, "tiff", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_PNG, "png", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_JPEG, "jpeg", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_JP2K, "jp2k", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_CameraRaw, "crs", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_ASF, "asf", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_WAV, "wav", &voidPtr, &voidLen );
-
-	(void) RegisterNamespace ( kXMP_NS_AdobeStockPhoto, "bmsp", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_CreatorAtom, "creatorAtom", &voidPtr, &voidLen );
-
-	(void) RegisterNamespace ( kXMP_NS_XMP_Rights, "xmpRights", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_XMP_MM, "xmpMM", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_XMP_BJ, "xmpBJ", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_XMP_Note, "xmpNote", &voidPtr, &voidLen );
-
-	(void) RegisterNamespace ( kXMP_NS_DM, "xmpDM", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_Script, "xmpScript", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_BWF, "bext", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_AEScart, "AEScart", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_RIFFINFO, "riffinfo", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_XMP_Text, "xmpT", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_XMP_PagedFile, "xmpTPg", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_XMP_Graphics, "xmpG", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_XMP_Image, "xmpGImg", &voidPtr, &voidLen );
-
-	(void) RegisterNamespace ( kXMP_NS_XMP_Font, "stFnt", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_XMP_Dimensions, "stDim", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_XMP_ResourceEvent, "stEvt", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_XMP_ResourceRef, "stRef", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_XMP_ST_Version, "stVer", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_XMP_ST_Job, "stJob", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_XMP_ManifestItem, "stMfs", &voidPtr, &voidLen );
-
-	(void) RegisterNamespace ( kXMP_NS_XMP_IdentifierQual, "xmpidq", &voidPtr, &voidLen );
-
-	(void) RegisterNamespace ( kXMP_NS_IPTCCore, "Iptc4xmpCore", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_IPTCExt, "Iptc4xmpExt", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_DICOM, "DICOM", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_PLUS, "plus", &voidPtr, &voidLen );
-
-	(void) RegisterNamespace ( kXMP_NS_PDFA_Schema, "pdfaSchema", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_PDFA_Property, "pdfaProperty", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_PDFA_Type, "pdfaType", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_PDFA_Field, "pdfaField", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_PDFA_ID, "pdfaid", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_PDFA_Extension, "pdfaExtension", &voidPtr, &voidLen );
-
-	(void) RegisterNamespace ( kXMP_NS_PDFX, "pdfx", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( kXMP_NS_PDFX_ID, "pdfxid", &voidPtr, &voidLen );
-
-	(void) RegisterNamespace ( "adobe:ns:meta/", "x", &voidPtr, &voidLen );
-	(void) RegisterNamespace ( "http://ns.adobe.com/iX/1.0/", "iX", &voidPtr, &voidLen );
-
-	(void) RegisterNamespace( kXMP_NS_iXML, "iXML", &voidPtr, &voidLen );
+	// The standard namespaces are always in the table, only the other ones are added to it.
+
+	sRegisteredNamespaces = new XMP_NamespaceTable ( &StandardNamespaceIndex() );
+
+	#if ENABLE_CPP_DOM_MODEL
+		for ( size_t i = 0; i < kStandardNamespaceCount; ++i ) {
+			const XMP_StaticNamespace & ns = kStandardNamespaces[i];
+			XMP_AutoLock aLock( sDefaultNamespacePrefixMapLock, true );
+			AdobeXMPCore_Int::INameSpacePrefixMap_I::InsertInDefaultNameSpacePrefixMap( ns.prefix, ns.prefixLen - 1, ns.uri, AdobeXMPCommon::npos );
+		}
+	#endif
 
 	RegisterStandardAliases();
 
@@ -978,6 +1082,7 @@ XMPMeta::Terminate() RELEASE_NO_THROW
 
 	EliminateGlobal ( xdefaultName );
 
+	TerminateNodeNameAtoms();	// ! After everything that might still hold nodes.
 	Terminate_LibUtils();
 
 	#if UseGlobalLibraryLock
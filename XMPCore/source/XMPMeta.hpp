@@ -25,6 +25,16 @@ extern XMP_VarString * xdefaultName;	// Needed in XMPMeta-Parse.cpp, MoveExplici
 class XMPIterator;
 class XMPUtils;
 
+// -------------------------------------------------------------------------------------------------
+// A property path resolved ahead of time, for properties that are looked up over and over. A path
+// made of the schema and struct field steps, after replacing a top level alias by its actual, is found
+// through the name atoms. Anything else, array items and qualifiers, by following the expanded path.
+
+struct XMP_PropertyAtom {
+	XMP_ExpandedXPath expPath;
+	std::vector<XMP_NameAtom> nameAtoms;	// The schema then each step, empty if expPath must be followed.
+};
+
 // -------------------------------------------------------------------------------------------------
 
 class XMPMeta {
@@ -81,6 +91,32 @@ public:
 				  XMP_StringPtr *  propValue,
 				  XMP_StringLen *  valueSize,
 				  XMP_OptionBits * options ) const;
+
+	static XMP_PropertyAtom *
+	ResolvePropertyAtom ( XMP_StringPtr schemaNS,
+						  XMP_StringPtr propName );
+
+	bool
+	GetPropertyByAtom ( const XMP_PropertyAtom & propAtom,
+						XMP_StringPtr *	 propValue,
+						XMP_StringLen *	 valueSize,
+						XMP_OptionBits * options ) const;
+
+	void
+	SetPropertyByAtom ( const XMP_PropertyAtom & propAtom,
+						XMP_StringPtr  propValue,
+						XMP_OptionBits options );
+
+	static XMP_Uns32
+	GetPropertiesByAtom ( const XMPMeta * const *			metas,
+						  XMP_Uns32							metaCount,
+						  const XMP_PropertyAtom * const *	propAtoms,
+						  XMP_Uns32							atomCount,
+						  XMP_Uns32 *						valueOffsets,
+						  char *							valueBytes,
+						  XMP_Uns32							bytesSize,
+						  XMP_OptionBits *					options,
+						  XMP_Uns8 *						presentBits );
 	
 	virtual bool
 	GetArrayItem ( XMP_StringPtr	schemaNS,
@@ -409,6 +445,8 @@ private:
 	void ProcessXMLTree ( XMP_OptionBits options );
 	bool ProcessXMLBuffer ( XMP_StringPtr buffer, XMP_StringLen xmpSize, bool lastClientCall );
 	void ProcessRDF ( const XML_Node & xmlTree, XMP_OptionBits options );
+	bool ProcessRDFStream ( XMP_StringPtr buffer, XMP_StringLen xmpSize, XMP_OptionBits options, bool * foundRoot );
+	void NormalizeParsedTree ( XMP_OptionBits options );
 
 };	// class XMPMeta
 
@@ -836,7 +836,7 @@ AppendSubtree ( const XMP_Node * sourceNode, XMP_Node * destParent,
 						CloneSubtree ( sourceItem, destNode, true /* skipEmpty */ );
 					} else {
 						// Edge case, non-empty dest array had no "x-default", insert that at the beginning.
-						XMP_Node * destItem = new XMP_Node ( destNode, sourceItem->name, sourceItem->value, sourceItem->options );
+						XMP_Node * destItem = new ( destNode ) XMP_Node ( destNode, sourceItem->name, sourceItem->value, sourceItem->options );
 						CloneOffspring ( sourceItem, destItem, true /* skipEmpty */ );
 						destNode->children.insert ( destNode->children.begin(), destItem );
 					}
@@ -1516,7 +1516,7 @@ XMPUtils::SeparateArrayItems ( XMPMeta *	  xmpObj,
 		
 		XMP_Node * newItem = 0;
 		if ( oldChild == oldChildCount ) {
-			newItem = new XMP_Node ( arrayNode, kXMP_ArrayItemName, itemValue.c_str(), 0 );
+			newItem = new ( arrayNode ) XMP_Node ( arrayNode, kXMP_ArrayItemName, itemValue.c_str(), 0 );
 		} else {
 			newItem = oldChildren[oldChild];
 			oldChildren[oldChild] = 0;	// ! Don't match again, let duplicates be seen.
@@ -1631,7 +1631,7 @@ XMPUtils::ApplyTemplate ( XMPMeta *	      workingXMP,
 			XMP_Node * workingSchema = FindSchemaNode ( &workingXMP->tree, templateSchema->name.c_str(),
 														kXMP_ExistingOnly, &workingSchemaPos );
 			if ( workingSchema == 0 ) {
-				workingSchema = new XMP_Node ( &workingXMP->tree, templateSchema->name, templateSchema->value, kXMP_SchemaNode );
+				workingSchema = new ( &workingXMP->tree ) XMP_Node ( &workingXMP->tree, templateSchema->name, templateSchema->value, kXMP_SchemaNode );
 				workingXMP->tree.children.push_back ( workingSchema );
 				workingSchemaPos = workingXMP->tree.children.end() - 1;
 			}
@@ -1836,7 +1836,7 @@ XMPUtils::DuplicateSubtree ( const XMPMeta & source,
 
 			for ( size_t propNum = 0, propLim = currSchema->children.size(); propNum < propLim; ++propNum ) {
 				sourceNode = currSchema->children[propNum];
-				XMP_Node * copyNode = new XMP_Node ( destNode, sourceNode->name, sourceNode->value, sourceNode->options );
+				XMP_Node * copyNode = new ( destNode ) XMP_Node ( destNode, sourceNode->name, sourceNode->value, sourceNode->options );
 				destNode->children.push_back ( copyNode );
 				CloneOffspring ( sourceNode, copyNode );
 			}
@@ -1882,7 +1882,7 @@ XMPUtils::DuplicateSubtree ( const XMPMeta & source,
 			XMP_Node * destSchema = FindSchemaNode ( &dest->tree, nsURI, kXMP_CreateNodes );
 			if ( destSchema == 0 ) XMP_Throw ( "Failed to find destination schema", kXMPErr_BadSchema );
 
-			XMP_Node * copyNode = new XMP_Node ( destSchema, currField->name, currField->value, currField->options );
+			XMP_Node * copyNode = new ( destSchema ) XMP_Node ( destSchema, currField->name, currField->value, currField->options );
 			destSchema->children.push_back ( copyNode );
 			CloneOffspring ( currField, copyNode );
 
@@ -1706,11 +1706,10 @@ static bool MoveOneProperty ( XMPMeta & stdXMP, XMPMeta * extXMP,
 
 	XMP_Node * extSchema = FindSchemaNode ( &extXMP->tree, schemaURI, kXMP_CreateNodes );
 
-	propNode->parent = extSchema;
-
 	extSchema->options &= ~kXMP_NewImplicitNode;
-	extSchema->children.push_back ( propNode );
+	CloneSubtree ( propNode, extSchema );	// ! The nodes belong to the arena of stdXMP, copy them over.
 
+	delete propNode;
 	stdSchema->children.erase ( stdPropPos );
 	DeleteEmptySchema ( stdSchema );
 
@@ -1754,7 +1753,7 @@ static bool MoveOneProperty(XMPMeta2 & stdXMP, XMPMeta2 * extXMP,
 	#define Trace_PackageForJPEG 0
 #endif
 
-typedef std::pair < XMP_VarString*, XMP_VarString* > StringPtrPair;
+typedef std::pair < const XMP_VarString*, const XMP_VarString* > StringPtrPair;
 typedef std::pair < const char *, const char * > StringPtrPair2;
 typedef std::multimap < size_t, StringPtrPair > PropSizeMap;
 typedef std::multimap < size_t, StringPtrPair2 > PropSizeMap2;
@@ -1776,7 +1775,7 @@ static void CreateEstimatedSizeMap ( XMPMeta & stdXMP, PropSizeMap * propSizes )
 				 (stdProp->name == "xmpNote:HasExtendedXMP") ) continue;	// ! Don't move xmpNote:HasExtendedXMP.
 
 			size_t propSize = EstimateSizeForJPEG ( stdProp );
-			StringPtrPair namePair ( &stdSchema->name, &stdProp->name );
+			StringPtrPair namePair ( &stdSchema->name.str(), &stdProp->name.str() );
 			PropSizeMap::value_type mapValue ( propSize, namePair );
 
 			(void) propSizes->insert ( propSizes->upper_bound ( propSize ), mapValue );
@@ -2900,8 +2899,8 @@ XMPUtils::PackageForJPEG ( const XMPMeta & origXMP,
 		XMP_Node * crSchema = FindSchemaNode ( &stdXMP.tree, kXMP_NS_CameraRaw, kXMP_ExistingOnly, &crSchemaPos );
 
 		if ( crSchema != 0 ) {
-			crSchema->parent = &extXMP.tree;
-			extXMP.tree.children.push_back ( crSchema );
+			CloneSubtree ( crSchema, &extXMP.tree );	// ! The nodes belong to the arena of stdXMP.
+			delete crSchema;
 			stdXMP.tree.children.erase ( crSchemaPos );
 			stdXMP.SerializeToBuffer ( &tempStr, keepItSmall, 1, "", "", 0 );
 			#if Trace_PackageForJPEG
@@ -3012,18 +3011,11 @@ XMPUtils::PackageForJPEG ( const XMPMeta & origXMP,
 		extXMP.SerializeToBuffer ( &tempStr, (keepItSmall | kXMP_OmitPacketWrapper), 0, "", "", 0 );
 		*extStr = tempStr;
 
-		MD5_CTX  context;
 		XMP_Uns8 digest [16];
-		MD5Init ( &context );
-		MD5Update ( &context, (XMP_Uns8*)tempStr.c_str(), (XMP_Uns32)tempStr.size() );
-		MD5Final ( digest, &context );
-
-		digestStr->reserve ( 32 );
-		for ( size_t i = 0; i < 16; ++i ) {
-			XMP_Uns8 byte = digest[i];
-			digestStr->push_back ( kHexDigits [ byte>>4 ] );
-			digestStr->push_back ( kHexDigits [ byte&0xF ] );
-		}
+		char digestHex [33];
+		MD5Digest ( tempStr.c_str(), (XMP_Uns32)tempStr.size(), digest );
+		MD5DigestToHex ( digest, digestHex );
+		digestStr->append ( digestHex, 32 );
 
 		stdXMP.SetProperty ( kXMP_NS_XMP_Note, "HasExtendedXMP", digestStr->c_str(), 0 );
 		stdXMP.SerializeToBuffer ( &tempStr, keepItSmall, 1, "", "", 0 );
@@ -3232,18 +3224,11 @@ XMPUtils::PackageForJPEG(const XMPMeta2 & origXMP,
 		extXMP.SerializeToBuffer(&tempStr, (keepItSmall | kXMP_OmitPacketWrapper), 0, "", "", 0);
 		*extStr = tempStr;
 
-		MD5_CTX  context;
 		XMP_Uns8 digest[16];
-		MD5Init(&context);
-		MD5Update(&context, (XMP_Uns8*)tempStr.c_str(), (XMP_Uns32)tempStr.size());
-		MD5Final(digest, &context);
-
-		digestStr->reserve(32);
-		for (size_t i = 0; i < 16; ++i) {
-			XMP_Uns8 byte = digest[i];
-			digestStr->push_back(kHexDigits[byte >> 4]);
-			digestStr->push_back(kHexDigits[byte & 0xF]);
-		}
+		char digestHex[33];
+		MD5Digest(tempStr.c_str(), (XMP_Uns32)tempStr.size(), digest);
+		MD5DigestToHex(digest, digestHex);
+		digestStr->append(digestHex, 32);
 
 		stdXMP.SetProperty(kXMP_NS_XMP_Note, "HasExtendedXMP", digestStr->c_str(), 0);
 		stdXMP.SerializeToBuffer(&tempStr, keepItSmall, 1, "", "", 0);
@@ -1940,12 +1940,8 @@ void AVCHD_MetaHandler::MakeLegacyDigest ( std::string * digestStr )
 		return;
 	}
 
-	MD5_CTX context;
 	unsigned char digestBin [16];
-
-	MD5Init ( &context );
-	MD5Update ( &context, (XMP_Uns8*)&(legacyBuff[0]), (unsigned int) legacyBuff.size() );
-	MD5Final ( digestBin, &context );
+	MD5Digest ( &(legacyBuff[0]), (XMP_Uns32) legacyBuff.size(), digestBin );
 
 	*digestStr = BytesToHex ( digestBin, 16 );
 }	// AVCHD_MetaHandler::MakeLegacyDigest
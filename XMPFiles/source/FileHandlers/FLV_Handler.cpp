@@ -400,24 +400,13 @@ void FLV_MetaHandler::CacheFileData()
 // FLV_MetaHandler::MakeLegacyDigest
 // =================================
 
-#define kHexDigits "0123456789ABCDEF"
-
 void FLV_MetaHandler::MakeLegacyDigest ( std::string * digestStr )
 {
-	MD5_CTX    context;
 	unsigned char digestBin [16];
+	MD5Digest ( this->onMetaData.data(), (XMP_Uns32)this->onMetaData.size(), digestBin );
 
-	MD5Init ( &context );
-	MD5Update ( &context, (XMP_Uns8*)this->onMetaData.data(), (unsigned int)this->onMetaData.size() );
-	MD5Final ( digestBin, &context );
-
-	char buffer [40];
-	for ( int in = 0, out = 0; in < 16; in += 1, out += 2 ) {
-		XMP_Uns8 byte = digestBin[in];
-		buffer[out]   = kHexDigits [ byte >> 4 ];
-		buffer[out+1] = kHexDigits [ byte & 0xF ];
-	}
-	buffer[32] = 0;
+	char buffer [33];
+	MD5DigestToHex ( digestBin, buffer );
 	digestStr->erase();
 	digestStr->append ( buffer, 32 );
 
@@ -146,11 +146,36 @@ JPEG_MetaHandler::~JPEG_MetaHandler()
 
 }	// JPEG_MetaHandler::~JPEG_MetaHandler
 
+// =================================================================================================
+// JPEG_MetaHandler::Reset
+// =======================
+//
+// Only called after a read-only open, so the managers are readers. They are emptied but kept, along
+// with the content strings, for the next read-only JPEG.
+
+bool JPEG_MetaHandler::Reset()
+{
+
+	this->ResetCommonState();
+
+	this->exifContents.clear();
+	this->psirContents.clear();
+	this->extendedXMP.clear();
+	this->skipReconcile = false;
+
+	if ( this->exifMgr != 0 ) this->exifMgr->ParseMemoryStream ( 0, 0, false );
+	if ( this->psirMgr != 0 ) this->psirMgr->ParseMemoryResources ( 0, 0, false );
+	if ( this->iptcMgr != 0 ) this->iptcMgr->ParseMemoryDataSets ( 0, 0, false );
+
+	return true;
+
+}	// JPEG_MetaHandler::Reset
+
 // =================================================================================================
 // CacheExtendedXMP
 // ================
 
-static void CacheExtendedXMP ( ExtendedXMPInfo * extXMP, XMP_Uns8 * buffer, size_t bufferLen )
+static void CacheExtendedXMP ( ExtendedXMPInfo * extXMP, const XMP_Uns8 * buffer, size_t bufferLen )
 {
 
 	// Have a portion of the extended XMP, cache the contents. This is complicated by the need to
@@ -170,7 +195,7 @@ static void CacheExtendedXMP ( ExtendedXMPInfo * extXMP, XMP_Uns8 * buffer, size
 	if ( bufferLen < kExtXMPPrefixLength ) return;	// Ignore bad input.
 	XMP_Assert ( CheckBytes ( &buffer[0], kExtXMPSignatureString, kExtXMPSignatureLength ) );
 
-	XMP_Uns8 * bufferPtr = buffer + kExtXMPSignatureLength;	// Start at the GUID.
+	const XMP_Uns8 * bufferPtr = buffer + kExtXMPSignatureLength;	// Start at the GUID.
 	
 	JPEG_MetaHandler::GUID_32 guid;
 	XMP_Assert ( sizeof(guid.data) == 32 );
@@ -337,8 +362,8 @@ void JPEG_MetaHandler::CacheFileData()
 
 				size_t psirLen = contentLen - kPSIRSignatureLength;
 				fileRef->Seek ( (contentOrigin + kPSIRSignatureLength), kXMP_SeekFromStart );
-				fileRef->ReadAll ( buffer, (XMP_Int32)psirLen );
-				this->psirContents.append( (char *) buffer, psirLen );
+				const XMP_Uns8 * psirData = XIO::ReadSpan ( fileRef, (XMP_Uns32)psirLen, buffer );
+				this->psirContents.append( (char *) psirData, psirLen );
 				continue;	// Move on to the next marker.
 
 			}
@@ -358,8 +383,8 @@ void JPEG_MetaHandler::CacheFileData()
 
 				size_t exifLen = contentLen - kExifSignatureLength;
 				fileRef->Seek ( (contentOrigin + kExifSignatureLength), kXMP_SeekFromStart );
-				fileRef->ReadAll ( buffer, (XMP_Int32)exifLen );
-				this->exifContents.append ( (char*)buffer, exifLen );
+				const XMP_Uns8 * exifData = XIO::ReadSpan ( fileRef, (XMP_Uns32)exifLen, buffer );
+				this->exifContents.append ( (char*)exifData, exifLen );
 				continue;	// Move on to the next marker.
 
 			}
@@ -370,8 +395,8 @@ void JPEG_MetaHandler::CacheFileData()
 				this->containsXMP = true;	// Found the standard XMP packet.
 				size_t xmpLen = contentLen - kMainXMPSignatureLength;
 				fileRef->Seek ( (contentOrigin + kMainXMPSignatureLength), kXMP_SeekFromStart );
-				fileRef->ReadAll ( buffer, (XMP_Int32)xmpLen );
-				this->xmpPacket.assign ( (char*)buffer, xmpLen );
+				const XMP_Uns8 * xmpData = XIO::ReadSpan ( fileRef, (XMP_Uns32)xmpLen, buffer );
+				this->xmpPacket.assign ( (char*)xmpData, xmpLen );
 				this->packetInfo.offset = contentOrigin + kMainXMPSignatureLength;
 				this->packetInfo.length = (XMP_Int32)xmpLen;
 				this->packetInfo.padSize   = 0;	// Assume the rest for now, set later in ProcessXMP.
@@ -385,8 +410,8 @@ void JPEG_MetaHandler::CacheFileData()
 				 CheckBytes ( &buffer[0], kExtXMPSignatureString, kExtXMPSignatureLength ) ) {
 
 				fileRef->Seek ( contentOrigin, kXMP_SeekFromStart );
-				fileRef->ReadAll ( buffer, contentLen );
-				CacheExtendedXMP ( &extXMP, buffer, contentLen );
+				const XMP_Uns8 * extData = XIO::ReadSpan ( fileRef, contentLen, buffer );
+				CacheExtendedXMP ( &extXMP, extData, contentLen );
 				continue;	// Move on to the next marker.
 
 			}
@@ -458,8 +483,8 @@ static void TrimFullExifAPP1 ( std::string * exifContents )
 	TIFF_MemoryReader::TagInfo tagInfo;
 	bool tagFound, isNikon;
 
-	// ! Make a copy of the data to parse! The RO memory TIFF manager will flip bytes in-place!
-	tempMgr.ParseMemoryStream ( exifContents->data(), (XMP_Uns32)exifContents->size(), true /* copy data */ );
+	// The RO memory TIFF manager does not modify the stream, parse it in place.
+	tempMgr.ParseMemoryStream ( exifContents->data(), (XMP_Uns32)exifContents->size(), false /* copy data */ );
 
 	// Only trim the Exif APP1 from Nikon cameras.
 	tagFound = tempMgr.GetTag ( kTIFF_PrimaryIFD, kTIFF_Make, &tagInfo );
@@ -536,16 +561,18 @@ void JPEG_MetaHandler::ProcessXMP()
 
 	// Create the PSIR and IPTC handlers, even if there is no legacy. They might be needed for updates.
 
-	XMP_Assert ( (this->psirMgr == 0) && (this->iptcMgr == 0) );	// ProcessTNail might create the exifMgr.
-
 	bool readOnly = false;
 	if ( this->parent ){
 		readOnly = ((this->parent->openFlags & kXMPFiles_OpenForUpdate) == 0);
 	}
+
+	// A handler reused by a read-only open keeps the readers from the previous file, see Reset.
+	XMP_Assert ( readOnly || ((this->psirMgr == 0) && (this->iptcMgr == 0)) );	// ProcessTNail might create the exifMgr.
+
 	if ( readOnly ) {
 		if ( this->exifMgr == 0 ) this->exifMgr = new TIFF_MemoryReader();
-		this->psirMgr = new PSIR_MemoryReader();
-		this->iptcMgr = new IPTC_Reader();	// ! Parse it later.
+		if ( this->psirMgr == 0 ) this->psirMgr = new PSIR_MemoryReader();
+		if ( this->iptcMgr == 0 ) this->iptcMgr = new IPTC_Reader();	// ! Parse it later.
 	} else {
 		if ( this->exifContents.size() == (65534 - 2 - 6) ) TrimFullExifAPP1 ( &this->exifContents );
 		if ( this->exifMgr == 0 ) this->exifMgr = new TIFF_FileWriter();
@@ -562,22 +589,37 @@ void JPEG_MetaHandler::ProcessXMP()
 	PSIR_Manager & psir = *this->psirMgr;
 	IPTC_Manager & iptc = *this->iptcMgr;
 
-	bool haveExif = (! this->exifContents.empty());
+	// The skip options are only allowed for read-only opens, the legacy that is not parsed here
+	// would otherwise be lost by UpdateFile.
+
+	XMP_OptionBits skipOptions = 0;
+	if ( this->parent ) skipOptions = ImportSkipOptions ( this->parent->openFlags );
+	XMP_Assert ( readOnly || (skipOptions == 0) );
+
+	// The IPTC is in the PSIR, skipping the PSIR skips the IPTC too.
+	if ( skipOptions & k2XMP_SkipPSIR ) skipOptions |= k2XMP_SkipIPTC;
+
+	bool haveExif = (! this->exifContents.empty()) && (! (skipOptions & k2XMP_SkipExif));
 	if ( haveExif ) {
-		exif.ParseMemoryStream ( this->exifContents.c_str(), (XMP_Uns32)this->exifContents.size() );
+		// The read-only reader borrows exifContents, which lives as long as the handler.
+		StartPhaseCheck ( exif );
+		exif.ParseMemoryStream ( this->exifContents.c_str(), (XMP_Uns32)this->exifContents.size(), (! readOnly) );
+		EndPhaseCheck ( exif, "Exif parse" );
 	}
 
-	bool havePSIR = (! this->psirContents.empty());
+	bool havePSIR = (! this->psirContents.empty()) && (! (skipOptions & k2XMP_SkipPSIR));
 	if ( havePSIR ) {
+		StartPhaseCheck ( psir );
 		psir.ParseMemoryResources ( this->psirContents.c_str(), (XMP_Uns32)this->psirContents.size() );
+		EndPhaseCheck ( psir, "PSIR parse" );
 	}
 
 	PSIR_Manager::ImgRsrcInfo iptcInfo;
 	bool haveIPTC = false;
-	if ( havePSIR ) haveIPTC = psir.GetImgRsrc ( kPSIR_IPTC, &iptcInfo );;
+	if ( havePSIR && (! (skipOptions & k2XMP_SkipIPTC)) ) haveIPTC = psir.GetImgRsrc ( kPSIR_IPTC, &iptcInfo );
 	int iptcDigestState = kDigestMatches;
 
-	if ( haveIPTC ) {
+	if ( haveIPTC && (! (skipOptions & k2XMP_SkipDigests)) ) {
 
 		bool haveDigest = false;
 		PSIR_Manager::ImgRsrcInfo digestInfo;
@@ -587,12 +629,14 @@ void JPEG_MetaHandler::ProcessXMP()
 		if ( ! haveDigest ) {
 			iptcDigestState = kDigestMissing;
 		} else {
+			StartPhaseCheck ( digest );
 			iptcDigestState = PhotoDataUtils::CheckIPTCDigest ( iptcInfo.dataPtr, iptcInfo.dataLen, digestInfo.dataPtr );
+			EndPhaseCheck ( digest, "IPTC digest" );
 		}
 
 	}
 
-	XMP_OptionBits options = 0;
+	XMP_OptionBits options = skipOptions;
 	if ( this->containsXMP ) options |= k2XMP_FileHadXMP;
 	if ( haveExif ) options |= k2XMP_FileHadExif;
 	if ( haveIPTC ) options |= k2XMP_FileHadIPTC;
@@ -608,9 +652,11 @@ void JPEG_MetaHandler::ProcessXMP()
 		// Common code takes care of packetInfo.charForm, .padSize, and .writeable.
 		XMP_StringPtr packetStr = this->xmpPacket.c_str();
 		XMP_StringLen packetLen = (XMP_StringLen)this->xmpPacket.size();
+		StartPhaseCheck ( xmp );
 		try {
 			this->xmpObj.ParseFromBuffer ( packetStr, packetLen );
 		} catch ( ... ) { /* Ignore parsing failures, someday we hope to get partial XMP back. */ }
+		EndPhaseCheck ( xmp, "XMP parse" );
 		haveXMP = true;
 	}
 
@@ -651,8 +697,14 @@ void JPEG_MetaHandler::ProcessXMP()
 	// Process the legacy metadata.
 
 	if ( haveIPTC && (! haveXMP) && (iptcDigestState == kDigestMatches) ) iptcDigestState = kDigestMissing;
-	if (iptcInfo.dataLen) iptc.ParseMemoryDataSets ( iptcInfo.dataPtr, iptcInfo.dataLen );
+	if ( haveIPTC && iptcInfo.dataLen ) {
+		StartPhaseCheck ( iptcParse );
+		iptc.ParseMemoryDataSets ( iptcInfo.dataPtr, iptcInfo.dataLen );
+		EndPhaseCheck ( iptcParse, "IPTC parse" );
+	}
+	StartPhaseCheck ( import );
 	ImportPhotoData ( exif, iptc, psir, iptcDigestState, &this->xmpObj, options );
+	EndPhaseCheck ( import, "legacy import" );
 
 	this->containsXMP = true;	// Assume we had something for the XMP.
 
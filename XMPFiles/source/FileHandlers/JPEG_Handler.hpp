@@ -55,6 +55,8 @@ public:
 	void UpdateFile    ( bool doSafeUpdate );
     void WriteTempFile ( XMP_IO* tempRef );
 
+	bool Reset();
+
 	struct GUID_32 {	// A hack to get an assignment operator for an array.
 		char data [32];
 		void operator= ( const GUID_32 & in )
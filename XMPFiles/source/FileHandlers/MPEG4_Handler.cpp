@@ -536,11 +536,11 @@ static void ExportMVHDItems ( const SXMPMeta & xmp, MOOV_Manager * moovMgr , boo
 
 		if ( createFound && haveISOFile) {
 			if ( createSeconds != oldCreate ) PutUns64BE ( createSeconds, ((XMP_Uns8*)mvhdInfo.content + 4) );
-			moovMgr->NoteChange();
+			moovMgr->NoteChange ( mvhdRef );
 		}
 		if ( modifyFound  ) {
 			if ( modifySeconds != oldModify ) PutUns64BE ( modifySeconds, ((XMP_Uns8*)mvhdInfo.content + 12) );
-			moovMgr->NoteChange();
+			moovMgr->NoteChange ( mvhdRef );
 		}
 
 	} else if ( ((createSeconds >> 32) == 0) && ((modifySeconds >> 32) == 0) ) {
@@ -554,11 +554,11 @@ static void ExportMVHDItems ( const SXMPMeta & xmp, MOOV_Manager * moovMgr , boo
 
 		if ( createFound && haveISOFile) {
 			if ( (XMP_Uns32)createSeconds != oldCreate ) PutUns32BE ( (XMP_Uns32)createSeconds, ((XMP_Uns8*)mvhdInfo.content + 4) );
-			moovMgr->NoteChange();
+			moovMgr->NoteChange ( mvhdRef );
 		}
 		if ( modifyFound ) {
 			if ( (XMP_Uns32)modifySeconds != oldModify ) PutUns32BE ( (XMP_Uns32)modifySeconds, ((XMP_Uns8*)mvhdInfo.content + 8) );
-			moovMgr->NoteChange();
+			moovMgr->NoteChange ( mvhdRef );
 		}
 
 	} else {
@@ -1297,7 +1297,7 @@ static void ExportTimecodeItems ( const SXMPMeta & xmp, MPEG4_MetaHandler::Timec
 	 	if ( tmcdInfo->timeScale != 0 ) { // Entry must not be created if not existing before
 			tmcdInfo->timeScale = (XMP_Uns32)int64;
 			PutUns32BE ( tmcdInfo->timeScale, (void*)&stsdRawEntry->timeScale );
-			moovMgr->NoteChange();
+			moovMgr->NoteChange ( stsdRef );
 	 	}
 	 }
 
@@ -1308,7 +1308,7 @@ static void ExportTimecodeItems ( const SXMPMeta & xmp, MPEG4_MetaHandler::Timec
 	 	if ( tmcdInfo->frameDuration != 0 ) { // Entry must not be created if not existing before
 			tmcdInfo->frameDuration = (XMP_Uns32)int64;
 			PutUns32BE ( tmcdInfo->frameDuration, (void*)&stsdRawEntry->frameDuration );
-			moovMgr->NoteChange();
+			moovMgr->NoteChange ( stsdRef );
 	 	}
 	 }
 	
@@ -1319,7 +1319,7 @@ static void ExportTimecodeItems ( const SXMPMeta & xmp, MPEG4_MetaHandler::Timec
 		XMP_Uns8 newCount = (XMP_Uns8) ( (floatScale / floatDuration) + 0.5 );
 		if ( newCount != stsdRawEntry->frameCount ) {
 			stsdRawEntry->frameCount = newCount;
-			moovMgr->NoteChange();
+			moovMgr->NoteChange ( stsdRef );
 		}
 	 }
 
@@ -1337,12 +1337,12 @@ static void ExportTimecodeItems ( const SXMPMeta & xmp, MPEG4_MetaHandler::Timec
 			XMP_Uns32 flags = GetUns32BE ( &stsdRawEntry->flags );
 			flags = (flags & 0xFFFFFFFE) | (XMP_Uns32)tmcdInfo->isDropFrame;
 			PutUns32BE ( flags, (void*)&stsdRawEntry->flags );
-		 	moovMgr->NoteChange();
+		 	moovMgr->NoteChange ( stsdRef );
 		}
 
 		XMP_Uns32 oldSample = tmcdInfo->timecodeSample;
 		ok = DecomposeTimecode ( xmpValue.c_str(), tmcdInfo );
-	 	if ( ok && (oldSample != tmcdInfo->timecodeSample) ) moovMgr->NoteChange();
+	 	if ( ok && (oldSample != tmcdInfo->timecodeSample) ) moovMgr->NoteChange ( stsdRef );
 
 	}
 
@@ -1999,13 +1999,25 @@ void MPEG4_MetaHandler::CacheFileData()
 		if ( (! moovFound) && (currBox.boxType == ISOMedia::k_moov) ) {
 
 			XMP_Uns64 fullMoovSize = currBox.headerSize + currBox.contentSize;
-			if ( fullMoovSize > TopBoxSizeLimit) {	// From here on we know 32-bit offsets are safe.
-				XMP_Throw ( "Oversize 'moov' box", kXMPErr_EnforceFailure );
-			}
 
-			this->moovMgr.fullSubtree.assign ( (XMP_Uns32)fullMoovSize, 0 );
-			fileRef->Seek ( boxPos, kXMP_SeekFromStart );
-			fileRef->Read ( &this->moovMgr.fullSubtree[0], (XMP_Uns32)fullMoovSize );
+			if ( ! isUpdate ) {
+
+				// Only the metadata is wanted, parse the box tree from the file without reading the
+				// sample tables. The moovBoxSize is not used when reading.
+
+				this->moovMgr.ParseFileTree ( fileRef, boxPos, this->fileMode );
+
+			} else {
+
+				if ( fullMoovSize > TopBoxSizeLimit) {	// From here on we know 32-bit offsets are safe.
+					XMP_Throw ( "Oversize 'moov' box", kXMPErr_EnforceFailure );
+				}
+
+				this->moovMgr.fullSubtree.assign ( (XMP_Uns32)fullMoovSize, 0 );
+				fileRef->Seek ( boxPos, kXMP_SeekFromStart );
+				fileRef->Read ( &this->moovMgr.fullSubtree[0], (XMP_Uns32)fullMoovSize );
+
+			}
 
 			this->moovBoxPos = boxPos;
 			this->moovBoxSize = (XMP_Uns32)fullMoovSize;
@@ -2079,7 +2091,7 @@ void MPEG4_MetaHandler::ProcessXMP()
 		XMP_Error error ( kXMPErr_BadFileFormat,"No 'moov' box" );
 		XMPFileHandler::NotifyClient(&parent_->errorCallback, kXMPErrSev_FileFatal, error);
 	}
-	this->moovMgr.ParseMemoryTree ( this->fileMode );
+	if ( ! this->moovMgr.IsParsed() ) this->moovMgr.ParseMemoryTree ( this->fileMode );	// Read-only opens parse in CacheFileData.
 	if ( (this->xmpBoxPos == 0) || (! haveISOFile) ) {
 
 		// Look for the QuickTime moov/uuid/XMP_ box.
@@ -2381,8 +2393,12 @@ bool MPEG4_MetaHandler::ParseTimecodeTrack()
 
 static XMP_Uns8 kZeroes[64 * 1024];	// C semantics guarantee zero initialization.
 
+// A box that keeps its size is updated in place. With changedRanges only those ranges are written,
+// a 'moov' box rebuilt at the same size usually differs in just the XMP and a few fields.
+
 void MPEG4_MetaHandler::UpdateTopLevelBox ( XMP_Uns64 oldOffset, XMP_Uns32 oldSize,
-											const XMP_Uns8 * newBox, XMP_Uns32 newSize )
+											const XMP_Uns8 * newBox, XMP_Uns32 newSize,
+											const MOOV_Manager::ChangedRangeList * changedRanges /* = 0 */ )
 {
 	if ( (oldSize == 0) && (newSize == 0) ) return;	// Sanity check, should not happen.
 
@@ -2395,8 +2411,16 @@ void MPEG4_MetaHandler::UpdateTopLevelBox ( XMP_Uns64 oldOffset, XMP_Uns32 oldSi
 	if ( newSize == oldSize ) {
 
 		// Trivial case, update the existing box in-place.
-		fileRef->Seek ( oldOffset, kXMP_SeekFromStart );
-		fileRef->Write ( newBox, oldSize );
+		if ( changedRanges == 0 ) {
+			fileRef->Seek ( oldOffset, kXMP_SeekFromStart );
+			fileRef->Write ( newBox, oldSize );
+		} else {
+			for ( size_t i = 0, limit = changedRanges->size(); i < limit; ++i ) {
+				const MOOV_Manager::ChangedRange & range = (*changedRanges)[i];
+				fileRef->Seek ( (oldOffset + range.offset), kXMP_SeekFromStart );
+				fileRef->Write ( (newBox + range.offset), range.size );
+			}
+		}
 
 	} else if ( (oldOffset + oldSize) == oldFileSize ) {
 
@@ -2820,6 +2844,81 @@ void MPEG4_MetaHandler::OptimizeFileLayout()
 
 }	// MPEG4_MetaHandler::OptimizeFileLayout
 
+// =================================================================================================
+// AdjustXMPPadding
+// ================
+//
+// Keep a 'free' box in 'moov'/'udta' as room for the 'XMP_' box to grow. A change in the XMP size is
+// taken from or given back to that box, so the 'moov' box keeps its size and can be updated in place
+// instead of being rewritten or moved to the end of the file. When there is not enough room the
+// 'moov' box has to grow anyway, the padding is then reset to a fresh reserve.
+
+static const XMP_Uns32 kMinXMPPadding = 4*1024;
+
+static XMP_Uns32 XMPPaddingReserve ( XMP_Uns32 xmpSize )
+{
+	XMP_Uns32 reserve = xmpSize / 2;
+	if ( reserve < kMinXMPPadding ) reserve = kMinXMPPadding;
+	return reserve;
+}
+
+static void AdjustXMPPadding ( MOOV_Manager * moovMgr, XMP_Uns32 oldXMPSize, XMP_Uns32 newXMPSize )
+{
+	MOOV_Manager::BoxRef udtaRef = moovMgr->GetBox ( "moov/udta", 0 );
+	if ( udtaRef == 0 ) return;	// Sanity check, should not happen, the 'XMP_' box was just set.
+
+	MOOV_Manager::BoxInfo freeInfo;
+	MOOV_Manager::BoxRef  freeRef = moovMgr->GetTypeChild ( udtaRef, ISOMedia::k_free, &freeInfo );
+
+	XMP_Uns32 reserve = XMPPaddingReserve ( newXMPSize );
+
+	XMP_Uns32 newPadding;
+	if ( freeRef != 0 ) {
+		XMP_Int64 room = (XMP_Int64)freeInfo.contentSize + oldXMPSize - newXMPSize;
+		newPadding = (room > 0) ? (XMP_Uns32)room : reserve;	// No empty box for an exact fit.
+	} else if ( newXMPSize > oldXMPSize ) {
+		newPadding = reserve;
+	} else if ( (oldXMPSize - newXMPSize) > 8 ) {
+		newPadding = oldXMPSize - newXMPSize - 8;	// Room for the 'free' box header.
+	} else {
+		return;	// The 'moov' box shrinks by a few bytes, not worth a 'free' box.
+	}
+
+	RawDataBlock zeroes;
+	zeroes.assign ( newPadding, 0 );
+
+	if ( freeRef != 0 ) {
+		moovMgr->ISOBaseMedia_Manager::SetBox ( freeRef, &zeroes[0], newPadding );
+	} else {
+		moovMgr->AddChildBox ( udtaRef, ISOMedia::k_free, &zeroes[0], newPadding );
+	}
+
+}	// AdjustXMPPadding
+
+// =================================================================================================
+// AddXMPPadding
+// =============
+//
+// Add the 'free' box used by AdjustXMPPadding if there is none yet, for when the 'moov' box is going
+// to be rewritten anyway. Returns true if the box was added.
+
+static bool AddXMPPadding ( MOOV_Manager * moovMgr )
+{
+	MOOV_Manager::BoxInfo xmpInfo;
+	MOOV_Manager::BoxRef  udtaRef = moovMgr->GetBox ( "moov/udta", 0 );
+	if ( udtaRef == 0 ) return false;
+
+	if ( moovMgr->GetTypeChild ( udtaRef, ISOMedia::k_free, 0 ) != 0 ) return false;
+	if ( moovMgr->GetTypeChild ( udtaRef, ISOMedia::k_XMP_, &xmpInfo ) == 0 ) return false;
+
+	XMP_Uns32 reserve = XMPPaddingReserve ( xmpInfo.contentSize );
+	RawDataBlock zeroes;
+	zeroes.assign ( reserve, 0 );
+	moovMgr->AddChildBox ( udtaRef, ISOMedia::k_free, &zeroes[0], reserve );
+	return true;
+
+}	// AddXMPPadding
+
 // =================================================================================================
 // MPEG4_MetaHandler::UpdateFile
 // =============================
@@ -2949,8 +3048,13 @@ void MPEG4_MetaHandler::UpdateFile ( bool doSafeUpdate )
 			this->moovMgr.WipeBoxFree ( fileRef, this->xmpBoxPos, this->xmpBoxSize );
 		}
 
-		// The udta form of XMP has just the XMP packet.
+		// The udta form of XMP has just the XMP packet. Padding after it absorbs the size change.
+		MOOV_Manager::BoxInfo oldXMPInfo;
+		MOOV_Manager::BoxRef  oldXMPRef = this->moovMgr.GetBox ( "moov/udta/XMP_", &oldXMPInfo );
+		XMP_Uns32 oldXMPSize = (oldXMPRef == 0) ? 0 : oldXMPInfo.contentSize;
+
 		this->moovMgr.SetBox ( "moov/udta/XMP_", this->xmpPacket.c_str(), (XMP_Uns32)this->xmpPacket.size() );
+		AdjustXMPPadding ( &this->moovMgr, oldXMPSize, (XMP_Uns32)this->xmpPacket.size() );
 
 	}
 
@@ -2958,11 +3062,15 @@ void MPEG4_MetaHandler::UpdateFile ( bool doSafeUpdate )
 
 	if ( this->moovMgr.IsChanged() ) {
 		this->moovMgr.UpdateMemoryTree();
+		if ( (! useUuidXMP) && (this->moovMgr.fullSubtree.size() != moovBoxSize) ) {
+			// The 'moov' box is rewritten anyway, leave room for the XMP to grow in place next time.
+			if ( AddXMPPadding ( &this->moovMgr ) ) this->moovMgr.UpdateMemoryTree();
+		}
 		if ( progressTracker != 0 ) {
 			progressTracker->AddTotalWork ( (float)this->moovMgr.fullSubtree.size() );
 		}
 		this->UpdateTopLevelBox ( moovBoxPos, moovBoxSize, &this->moovMgr.fullSubtree[0],
-								  (XMP_Uns32)this->moovMgr.fullSubtree.size() );
+								  (XMP_Uns32)this->moovMgr.fullSubtree.size(), &this->moovMgr.changedRanges );
 	}
 
 	if ( this->tmcdInfo.sampleOffset != 0 ) {
@@ -23,6 +23,12 @@
 ///
 /// This header ...
 ///
+/// The QuickTime form of the XMP, \c moov/udta/XMP_, is followed by a \c free box used as padding.
+/// Changes in the XMP size are taken from or given back to it, so that the \c moov box keeps its size
+/// and only the changed bytes are written. The padding is added the first time the \c moov box has to
+/// be rewritten at a new size, and refilled when it runs out. Each time the file grows by at least
+/// 4 KB, or by half the XMP size if that is more.
+///
 //  ================================================================================================
 
 extern XMPFileHandler * MPEG4_MetaHandlerCTor ( XMPFiles * parent );
@@ -78,7 +84,8 @@ private:
 	{};	// Hidden on purpose.
 
 	bool ParseTimecodeTrack();
-	void UpdateTopLevelBox ( XMP_Uns64 oldOffset, XMP_Uns32 oldSize, const XMP_Uns8 * newBox, XMP_Uns32 newSize );
+	void UpdateTopLevelBox ( XMP_Uns64 oldOffset, XMP_Uns32 oldSize, const XMP_Uns8 * newBox, XMP_Uns32 newSize,
+							 const MOOV_Manager::ChangedRangeList * changedRanges = 0 );
 
 	void OptimizeFileLayout();
 
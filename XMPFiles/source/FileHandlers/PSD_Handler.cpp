@@ -211,14 +211,25 @@ void PSD_MetaHandler::ProcessXMP()
 	IPTC_Manager & iptc = *this->iptcMgr;
 	TIFF_Manager & exif = *this->exifMgr;
 
+	// The skip options are only allowed for read-only opens. The image resources are part of the
+	// file layout and always parsed, skipping PSIR only skips importing them.
+
+	XMP_OptionBits skipOptions = 0;
+	if ( this->parent ) skipOptions = ImportSkipOptions ( this->parent->openFlags );
+	XMP_Assert ( readOnly || (skipOptions == 0) );
+
 	PSIR_Manager::ImgRsrcInfo iptcInfo, exifInfo;
-	bool haveIPTC = psir.GetImgRsrc ( kPSIR_IPTC, &iptcInfo );
-	bool haveExif = psir.GetImgRsrc ( kPSIR_Exif, &exifInfo );
+	bool haveIPTC = (! (skipOptions & k2XMP_SkipIPTC)) && psir.GetImgRsrc ( kPSIR_IPTC, &iptcInfo );
+	bool haveExif = (! (skipOptions & k2XMP_SkipExif)) && psir.GetImgRsrc ( kPSIR_Exif, &exifInfo );
 	int iptcDigestState = kDigestMatches;
 
-	if ( haveExif ) exif.ParseMemoryStream ( exifInfo.dataPtr, exifInfo.dataLen );
+	if ( haveExif ) {
+		StartPhaseCheck ( exifParse );
+		exif.ParseMemoryStream ( exifInfo.dataPtr, exifInfo.dataLen, (! readOnly) );	// The read-only reader borrows the PSIR data.
+		EndPhaseCheck ( exifParse, "Exif parse" );
+	}
 
-	if ( haveIPTC ) {
+	if ( haveIPTC && (! (skipOptions & k2XMP_SkipDigests)) ) {
 
 		bool haveDigest = false;
 		PSIR_Manager::ImgRsrcInfo digestInfo;
@@ -228,12 +239,14 @@ void PSD_MetaHandler::ProcessXMP()
 		if ( ! haveDigest ) {
 			iptcDigestState = kDigestMissing;
 		} else {
+			StartPhaseCheck ( digest );
 			iptcDigestState = PhotoDataUtils::CheckIPTCDigest ( iptcInfo.dataPtr, iptcInfo.dataLen, digestInfo.dataPtr );
+			EndPhaseCheck ( digest, "IPTC digest" );
 		}
 
 	}
 
-	XMP_OptionBits options = 0;
+	XMP_OptionBits options = skipOptions;
 	if ( this->containsXMP ) options |= k2XMP_FileHadXMP;
 	if ( haveIPTC ) options |= k2XMP_FileHadIPTC;
 	if ( haveExif ) options |= k2XMP_FileHadExif;
@@ -249,17 +262,25 @@ void PSD_MetaHandler::ProcessXMP()
 		// Common code takes care of packetInfo.charForm, .padSize, and .writeable.
 		XMP_StringPtr packetStr = this->xmpPacket.c_str();
 		XMP_StringLen packetLen = (XMP_StringLen)this->xmpPacket.size();
+		StartPhaseCheck ( xmp );
 		try {
 			this->xmpObj.ParseFromBuffer ( packetStr, packetLen );
 		} catch ( ... ) { /* Ignore parsing failures, someday we hope to get partial XMP back. */ }
+		EndPhaseCheck ( xmp, "XMP parse" );
 		haveXMP = true;
 	}
 
 	// Process the legacy metadata.
 
 	if ( haveIPTC && (! haveXMP) && (iptcDigestState == kDigestMatches) ) iptcDigestState = kDigestMissing;
-	if (iptcInfo.dataLen) iptc.ParseMemoryDataSets ( iptcInfo.dataPtr, iptcInfo.dataLen );
+	if ( haveIPTC && iptcInfo.dataLen ) {
+		StartPhaseCheck ( iptcParse );
+		iptc.ParseMemoryDataSets ( iptcInfo.dataPtr, iptcInfo.dataLen );
+		EndPhaseCheck ( iptcParse, "IPTC parse" );
+	}
+	StartPhaseCheck ( import );
 	ImportPhotoData ( exif, iptc, psir, iptcDigestState, &this->xmpObj, options );
+	EndPhaseCheck ( import, "legacy import" );
 	this->containsXMP = true;	// Assume we now have something in the XMP.
 
 }	// PSD_MetaHandler::ProcessXMP
@@ -69,7 +69,7 @@ bool SWF_CheckFormat ( XMP_FileFormat format,
 // ================================
 
 SWF_MetaHandler::SWF_MetaHandler ( XMPFiles * _parent )
-	: isCompressed(false), hasFileAttributes(false), hasMetadata(false), brokenSWF(false), expandedSize(0), firstTagOffset(0)
+	: isCompressed(false), hasFileAttributes(false), hasMetadata(false), brokenSWF(false), firstTagOffset(0)
 {
 	this->parent = _parent;
 	this->handlerFlags = kSWF_HandlerFlags;
@@ -86,14 +86,39 @@ SWF_MetaHandler::~SWF_MetaHandler()
 	// Nothing to do at this time.
 }
 
+// =================================================================================================
+// ReadTagContent
+// ==============
+//
+// Append a tag's content to a string or RawDataBlock, in blocks so that a bogus length in a broken
+// file does not cause a huge allocation. Returns false if the stream ends first.
+
+template <class T>
+static bool ReadTagContent ( SWF_IO::ExpandedReader * swfIn, XMP_Uns32 length, T * dataOut )
+{
+	XMP_Uns8 buffer [16*1024];
+
+	while ( length > 0 ) {
+		XMP_Uns32 ioCount = length;
+		if ( ioCount > sizeof(buffer) ) ioCount = sizeof(buffer);
+		XMP_Uns32 gotCount = swfIn->Read ( buffer, ioCount );
+		dataOut->insert ( dataOut->end(), &buffer[0], &buffer[gotCount] );
+		if ( gotCount < ioCount ) return false;
+		length -= ioCount;
+	}
+
+	return true;
+
+}	// ReadTagContent
+
 // =================================================================================================
 // SWF_MetaHandler::CacheFileData
 // ==============================
 //
-// SWF files are pretty small, have simple metadata, and often have ZIP compression. Because they
-// are small and often compressed, we always cache the fully expanded SWF in memory. That is used
-// for both reading and updating. Note that SWF_CheckFormat has already done basic checks on the
-// size and signature, they don't need to be repeated here.
+// SWF files have simple metadata near the front, and often have ZIP compression. The expanded SWF
+// is walked as a stream, inflating compressed files a block at a time, and only the tags of
+// interest are kept. The walk stops as soon as both are found. Note that SWF_CheckFormat has
+// already done basic checks on the size and signature, they don't need to be repeated here.
 //
 // Try to find the FileAttributes and Metadata tags, saving their offsets for later use if updating
 // the file. We need to be tolerant when reading, allowing the FileAttributes tag to be anywhere and
@@ -104,77 +129,80 @@ SWF_MetaHandler::~SWF_MetaHandler()
 void SWF_MetaHandler::CacheFileData() {
 
 	XMP_Assert ( (! this->processedXMP) && (! this->containsXMP) );
-	XMP_Assert ( this->expandedSWF.empty() );
 
 	XMP_IO * fileRef = this->parent->ioRef;
 	XMP_Int64 fileLength = fileRef->Length();
 	XMP_Enforce ( fileLength <= SWF_IO::MaxExpandedSize );
 
-	// Get the uncompressed SWF stream into memory.
-	
-	fileRef->Rewind();
-	XMP_Uns8 buffer [SWF_IO::HeaderPrefixSize];	// Read the uncompressed file header prefix.
-	fileRef->ReadAll ( buffer, SWF_IO::HeaderPrefixSize );
+	SWF_IO::ExpandedReader swfIn ( fileRef );
+	this->isCompressed = swfIn.IsCompressed();
+
+	// Find the first tag, the header size depends on the RECT bits following the header prefix.
+
+	XMP_Uns8 buffer [SWF_IO::HeaderPrefixSize + 1];
+	if ( swfIn.Read ( buffer, sizeof(buffer) ) < sizeof(buffer) ) return;	// Throw?
+	this->firstTagOffset = SWF_IO::FileHeaderSize ( buffer[SWF_IO::HeaderPrefixSize] );
+
+	XMP_Uns32 headerRest = this->firstTagOffset - swfIn.Offset();
+	if ( swfIn.Skip ( headerRest ) < headerRest ) return;
 
-	XMP_Uns32 signature = GetUns32LE ( &buffer[0] ) & 0xFFFFFF;	// Discard the version byte.
-	this->expandedSize = GetUns32LE ( &buffer[4] );
-	if ( signature == SWF_IO::CompressedSignature ) this->isCompressed = true;
-	
-	if ( this->isCompressed ) {
-	
-		// Expand the SWF file into memory.
-		this->expandedSWF.reserve ( this->expandedSize );	// Try to avoid reallocations.
-		SWF_IO::DecompressFileToMemory ( fileRef, &this->expandedSWF );
-		this->expandedSize = (XMP_Uns32)this->expandedSWF.size();	// Use the true length.
-	
-	} else {
-	
-		// Read the entire uncompressed file into memory.
-		this->expandedSize = (XMP_Uns32)fileLength;	// Use the true length.
-		this->expandedSWF.insert ( this->expandedSWF.end(), (size_t)fileLength, 0 );
-		fileRef->Rewind();
-		fileRef->ReadAll ( &this->expandedSWF[0], (XMP_Uns32)fileLength );
-	
-	}
-	
 	// Look for the FileAttributes and Metadata tags.
-	
-	if(this->expandedSize <= SWF_IO::HeaderPrefixSize ) return; // Throw?
-	this->firstTagOffset = SWF_IO::FileHeaderSize ( this->expandedSWF[SWF_IO::HeaderPrefixSize] );
-	
-	XMP_Uns32 currOffset = this->firstTagOffset;
-	SWF_IO::TagInfo currTag;
-	
-	for ( ; currOffset < this->expandedSize; currOffset = SWF_IO::NextTagOffset(currTag) ) {
-	
-		bool ok = SWF_IO::GetTagInfo ( this->expandedSWF, currOffset, &currTag );
+
+	while ( true ) {
+
+		SWF_IO::TagInfo currTag;
+		currTag.tagOffset = swfIn.Offset();
+
+		XMP_Uns8 tagHeader [6];
+		XMP_Uns32 ioCount = swfIn.Read ( tagHeader, 2 );
+		if ( ioCount == 0 ) break;	// The normal end of the tags.
+
+		bool ok = (ioCount == 2);
+		if ( ok ) {
+			XMP_Uns16 tagHeader16 = GetUns16LE ( &tagHeader[0] );
+			currTag.tagID = tagHeader16 >> 6;
+			currTag.contentLength = tagHeader16 & SWF_IO::TagLengthMask;
+			if ( currTag.contentLength == SWF_IO::TagLengthMask ) {
+				ok = (swfIn.Read ( &tagHeader[2], 4 ) == 4);	// Make sure there is room for the extended length.
+				currTag.contentLength = GetUns32LE ( &tagHeader[2] );
+				currTag.hasLongHeader = true;
+			}
+		}
+
+		if ( ok ) {
+			if ( currTag.tagID == SWF_IO::FileAttributesTagID ) {
+				this->fileAttributesTag = currTag;
+				this->fileAttributes.assign ( &tagHeader[0], &tagHeader[SWF_IO::FullTagLength(currTag) - currTag.contentLength] );
+				ok = ReadTagContent ( &swfIn, currTag.contentLength, &this->fileAttributes );
+				this->hasFileAttributes = ok;
+			} else if ( currTag.tagID == SWF_IO::MetadataTagID ) {
+				this->metadataTag = currTag;
+				this->xmpPacket.clear();
+				ok = ReadTagContent ( &swfIn, currTag.contentLength, &this->xmpPacket );
+				this->hasMetadata = ok;
+			} else {
+				ok = (swfIn.Skip ( currTag.contentLength ) == currTag.contentLength);
+			}
+		}
+
 		if ( ! ok ) {
 			this->brokenSWF = true;	// Let the read finish, but refuse to update.
 			break;
 		}
-		
-		if ( currTag.tagID == SWF_IO::FileAttributesTagID ) {
-			this->fileAttributesTag = currTag;
-			this->hasFileAttributes = true;
-			if ( this->hasMetadata ) break;	// Exit if we have both.
-		}
-		
-		if ( currTag.tagID == SWF_IO::MetadataTagID ) {
-			this->metadataTag = currTag;
-			this->hasMetadata = true;
-			if ( this->hasFileAttributes ) break;	// Exit if we have both.
-		}
-		
+
+		if ( this->hasFileAttributes && this->hasMetadata ) break;	// Exit if we have both.
+
 	}
-	
+
 	if ( this->hasMetadata ) {
 		this->packetInfo.offset = SWF_IO::ContentOffset ( this->metadataTag );
 		this->packetInfo.length = this->metadataTag.contentLength;
-		this->xmpPacket.assign ( (char*)&this->expandedSWF[(size_t)this->packetInfo.offset], (size_t)this->packetInfo.length );
 		FillPacketInfo ( this->xmpPacket, &this->packetInfo );
 		this->containsXMP = true;
+	} else {
+		this->xmpPacket.clear();
 	}
-	
+
 }	// SWF_MetaHandler::CacheFileData
 
 // =================================================================================================
@@ -212,7 +240,9 @@ XMP_OptionBits SWF_MetaHandler::GetSerializeOptions()
 // SWF_MetaHandler::UpdateFile
 // ===========================
 //
-// Update the expanded SWF in memory, then write it to the file.
+// Stream the expanded SWF from the file to a temp file, inflating and deflating as needed. The new
+// stream has the FileAttributes tag first, then the Metadata tag, then the other tags in their
+// original order. The old FileAttributes and Metadata tags are left out.
 
 void SWF_MetaHandler::UpdateFile ( bool doSafeUpdate )
 {
@@ -225,114 +255,101 @@ void SWF_MetaHandler::UpdateFile ( bool doSafeUpdate )
 	if ( this->brokenSWF ) {
 		XMP_Throw ( "SWF is broken, can't update.", kXMPErr_BadFileFormat );
 	}
+	if ( this->firstTagOffset == 0 ) {
+		XMP_Throw ( "Index not valid.Invalid SWF, can't update.", kXMPErr_BadIndex );
+	}
 	
-	// Make sure there is a FileAttributes tag at the front, with the HasMetadata flag set.
-	
-	if ( ! this->hasFileAttributes ) {
-	
-		// Insert a new FileAttributes tag as the first tag.
-		
-		XMP_Uns8 buffer [6];	// Two byte header plus four byte content.
-		PutUns16LE ( ((SWF_IO::FileAttributesTagID << 6) | 4), &buffer[0] );
-		PutUns32LE ( SWF_IO::HasMetadataMask, &buffer[2] );
-		
-		if(this->expandedSWF.size() < this->firstTagOffset ){
-                     XMP_Throw ( "Index not valid.Invalid SWF, can't update.", kXMPErr_BadIndex );
-                 }
-		this->expandedSWF.insert ( (this->expandedSWF.begin() + this->firstTagOffset), 6, 0 );
-		memcpy ( &this->expandedSWF[this->firstTagOffset], &buffer[0], 6 );
-
-		this->hasFileAttributes = true;
-#if XMP_DebugBuild
-		bool ok =
-#endif
-			SWF_IO::GetTagInfo ( this->expandedSWF, this->firstTagOffset, &this->fileAttributesTag );
-		XMP_Assert ( ok );
-		
-		if ( this->hasMetadata ) this->metadataTag.tagOffset += 6;	// The Metadata tag is now further back.
+	// Make sure there is a FileAttributes tag with the HasMetadata flag set.
+
+	RawDataBlock newAttributes;
 
+	if ( ! this->hasFileAttributes ) {
+		newAttributes.assign ( 6, 0 );	// Two byte header plus four byte content.
+		PutUns16LE ( ((SWF_IO::FileAttributesTagID << 6) | 4), &newAttributes[0] );
+		PutUns32LE ( SWF_IO::HasMetadataMask, &newAttributes[2] );
 	} else {
-		
-		// Make sure the HasMetadata flag is set.
+		newAttributes = this->fileAttributes;
 		if ( this->fileAttributesTag.contentLength > 0 ) {
-			XMP_Uns32 flagsOffset = SWF_IO::ContentOffset ( this->fileAttributesTag );
-			this->expandedSWF[flagsOffset] |= SWF_IO::HasMetadataMask;
-		}
-
-		// Make sure the FileAttributes tag is the first tag.
-		if ( this->fileAttributesTag.tagOffset != this->firstTagOffset ) {
-
-			RawDataBlock attrTag;
-			XMP_Uns32 attrTagLength = SWF_IO::FullTagLength ( this->fileAttributesTag );
-			attrTag.assign ( attrTagLength, 0 );
-			memcpy ( &attrTag[0], &this->expandedSWF[this->fileAttributesTag.tagOffset], attrTagLength );
-			
-			RawDataBlock::iterator attrTagPos = this->expandedSWF.begin() + this->fileAttributesTag.tagOffset;
-			RawDataBlock::iterator attrTagEnd = attrTagPos + attrTagLength;
-			this->expandedSWF.erase ( attrTagPos, attrTagEnd );	// Remove the old FileAttributes tag;
-			
-			if ( this->hasMetadata && (this->metadataTag.tagOffset < this->fileAttributesTag.tagOffset) ) {
-				this->metadataTag.tagOffset += attrTagLength;	// The FileAttributes tag will become in front.
-			}
-			
-			if(this->expandedSWF.size() < this->firstTagOffset ){
-                             XMP_Throw ( "Index not valid.Invalid SWF, can't update.", kXMPErr_BadIndex );
-                        }
-			this->expandedSWF.insert ( (this->expandedSWF.begin() + this->firstTagOffset), attrTagLength, 0 );
-			memcpy ( &this->expandedSWF[this->firstTagOffset], &attrTag[0], attrTagLength );
-			
-			this->fileAttributesTag.tagOffset = this->firstTagOffset;
-
+			XMP_Uns32 flagsOffset = SWF_IO::ContentOffset ( this->fileAttributesTag ) - this->fileAttributesTag.tagOffset;
+			newAttributes[flagsOffset] |= SWF_IO::HasMetadataMask;
 		}
-
 	}
 	
-	// Make sure the XMP is as small as possible. Write the XMP as the second tag.
-	
-	XMP_Assert ( this->hasFileAttributes );
-	
+	// Make sure the XMP is as small as possible. It always gets a long tag header.
+
 	XMP_OptionBits smallOptions = kXMP_OmitPacketWrapper | kXMP_UseCompactFormat | kXMP_OmitAllFormatting | kXMP_OmitXMPMetaElement;
 	this->xmpObj.SerializeToBuffer ( &this->xmpPacket, smallOptions );
-	
+
+	XMP_Uns8 metaHeader [6];
+	PutUns16LE ( ((SWF_IO::MetadataTagID << 6) | SWF_IO::TagLengthMask), &metaHeader[0] );
+	PutUns32LE ( (XMP_Uns32)this->xmpPacket.size(), &metaHeader[2] );
+
+	// Collect the old tags to leave out, in file order.
+
+	XMP_Uns32 skipOffsets [2], skipLengths [2];
+	size_t skipCount = 0;
+
+	if ( this->hasFileAttributes ) {
+		skipOffsets[skipCount] = this->fileAttributesTag.tagOffset;
+		skipLengths[skipCount] = SWF_IO::FullTagLength ( this->fileAttributesTag );
+		++skipCount;
+	}
 	if ( this->hasMetadata ) {
-		// Remove the old XMP, the size and location have probably changed.
-		XMP_Uns32 oldMetaLength = SWF_IO::FullTagLength ( this->metadataTag );
-		RawDataBlock::iterator oldMetaPos = this->expandedSWF.begin() + this->metadataTag.tagOffset;
-		RawDataBlock::iterator oldMetaEnd = oldMetaPos + oldMetaLength;
-		this->expandedSWF.erase ( oldMetaPos, oldMetaEnd );
+		skipOffsets[skipCount] = this->metadataTag.tagOffset;
+		skipLengths[skipCount] = SWF_IO::FullTagLength ( this->metadataTag );
+		++skipCount;
 	}
-	
-	this->metadataTag.hasLongHeader = true;
-	this->metadataTag.tagID = SWF_IO::MetadataTagID;
-	this->metadataTag.tagOffset = SWF_IO::NextTagOffset ( this->fileAttributesTag );
-	this->metadataTag.contentLength = (XMP_Uns32)this->xmpPacket.size();
-
-	XMP_Uns32 newMetaLength = 6 + this->metadataTag.contentLength;	// Always use a long tag header.
-	if(this->expandedSWF.size() < this->metadataTag.tagOffset ){
-             XMP_Throw ( "Index not valid.Invalid SWF, can't update.", kXMPErr_BadIndex );
+	if ( (skipCount == 2) && (skipOffsets[1] < skipOffsets[0]) ) {
+		std::swap ( skipOffsets[0], skipOffsets[1] );
+		std::swap ( skipLengths[0], skipLengths[1] );
 	}
-	this->expandedSWF.insert ( (this->expandedSWF.begin() + this->metadataTag.tagOffset), newMetaLength, 0 );
 
-	PutUns16LE ( ((SWF_IO::MetadataTagID << 6) | SWF_IO::TagLengthMask), &this->expandedSWF[this->metadataTag.tagOffset] );
-	PutUns32LE ( this->metadataTag.contentLength, &this->expandedSWF[this->metadataTag.tagOffset+2] );
-	memcpy ( &this->expandedSWF[this->metadataTag.tagOffset+6], this->xmpPacket.c_str(), this->metadataTag.contentLength );
-
-	this->hasMetadata = true;
-	
-	// Update the uncompressed file length and rewrite the file.
-	
-	PutUns32LE ( (XMP_Uns32)this->expandedSWF.size(), &this->expandedSWF[4] );
+	// Write the new stream to a temp file, then replace the original.
 
 	XMP_IO * fileRef = this->parent->ioRef;
-	fileRef->Rewind();
-	fileRef->Truncate ( 0 );
-	
-	if ( this->isCompressed ) {
-		SWF_IO::CompressMemoryToFile ( this->expandedSWF, fileRef );
-	} else {
-		fileRef->Write ( &this->expandedSWF[0], (XMP_Uns32)this->expandedSWF.size() );
+	XMP_IO * tempRef = fileRef->DeriveTemp();
+
+	try {
+
+		SWF_IO::ExpandedReader swfIn ( fileRef );
+		SWF_IO::ExpandedWriter swfOut ( tempRef, this->isCompressed );
+
+		XMP_Uns32 headerCount = SWF_IO::CopyExpanded ( &swfIn, &swfOut, this->firstTagOffset );
+		XMP_Enforce ( headerCount == this->firstTagOffset );
+
+		swfOut.Write ( &newAttributes[0], (XMP_Uns32)newAttributes.size() );
+		swfOut.Write ( metaHeader, 6 );
+		swfOut.Write ( this->xmpPacket.c_str(), (XMP_Uns32)this->xmpPacket.size() );
+
+		for ( size_t i = 0; i < skipCount; ++i ) {
+			XMP_Uns32 copyCount = skipOffsets[i] - swfIn.Offset();
+			XMP_Enforce ( SWF_IO::CopyExpanded ( &swfIn, &swfOut, copyCount ) == copyCount );
+			XMP_Enforce ( swfIn.Skip ( skipLengths[i] ) == skipLengths[i] );
+		}
+
+		(void) SWF_IO::CopyExpanded ( &swfIn, &swfOut, (XMP_Uns32)SWF_IO::MaxExpandedSize );	// Copy the rest.
+		(void) swfOut.Finish();
+
+	} catch ( ... ) {
+		fileRef->DeleteTemp();
+		throw;
 	}
 
+	fileRef->AbsorbTemp();
+
+	// Note the new layout, in case the handler is asked about it.
+
+	this->fileAttributes = newAttributes;
+	this->hasFileAttributes = true;
+	(void) SWF_IO::GetTagInfo ( newAttributes, 0, &this->fileAttributesTag );
+	this->fileAttributesTag.tagOffset = this->firstTagOffset;
+
+	this->hasMetadata = true;
+	this->metadataTag.hasLongHeader = true;
+	this->metadataTag.tagID = SWF_IO::MetadataTagID;
+	this->metadataTag.tagOffset = SWF_IO::NextTagOffset ( this->fileAttributesTag );
+	this->metadataTag.contentLength = (XMP_Uns32)this->xmpPacket.size();
+
 }	// SWF_MetaHandler::UpdateFile
 
 // =================================================================================================
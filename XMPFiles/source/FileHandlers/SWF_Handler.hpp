@@ -57,11 +57,11 @@ public:
 private:
 
 	SWF_MetaHandler() : isCompressed(false), hasFileAttributes(false), hasMetadata(false), brokenSWF(false),
-						expandedSize(0), firstTagOffset(0) {};
+						firstTagOffset(0) {};
 
 	bool isCompressed, hasFileAttributes, hasMetadata, brokenSWF;
-	XMP_Uns32 expandedSize, firstTagOffset;
-	RawDataBlock expandedSWF;
+	XMP_Uns32 firstTagOffset;
+	RawDataBlock fileAttributes;	// The full FileAttributes tag, header and content.
 	
 	SWF_IO::TagInfo fileAttributesTag, metadataTag;
 
@@ -19,6 +19,9 @@
 #include "XMPFiles/source/FormatSupport/XMPScanner.hpp"
 #include "XMPFiles/source/FileHandlers/Scanner_Handler.hpp"
 
+#include <atomic>
+#include <exception>
+#include <thread>
 #include <vector>
 
 using namespace std;
@@ -39,6 +42,251 @@ struct CandidateInfo {
 	SXMPMeta *     xmpObj;
 };
 
+// =================================================================================================
+// Parallel scanning
+// =================
+//
+// Files of at least kParallelScanMinLength are split into ranges of at least kScanRangeMinLength,
+// one per thread. The extra threads come from a budget shared by all scans in the process, at most
+// kScanMaxThreads-1 run at once however many files are scanned. A scan that gets none from the
+// budget is sequential. Each range is scanned by its own XMPScanner, reading past
+// the range end while the scanner is inside a possible packet. The packets from the ranges are then
+// merged in file order, a packet is dropped if it starts before the end of the previous kept one.
+// That is where a sequential scan would resume, so the result is the same. A range that ends with
+// an unfinished packet was scanned to EOF, like a sequential scan the later ranges are ignored.
+
+static const XMP_Int64 kParallelScanMinLength = 64*1024*1024;
+static const XMP_Int64 kScanRangeMinLength    = 16*1024*1024;
+static const unsigned  kScanMaxThreads        = 8;
+static const XMP_Uns32 kRangeBufferSize       = 1024*1024;
+
+static std::atomic<unsigned> sScanThreadsInUse ( 0 );
+
+struct ScanRange {
+	XMP_Int64 start, end;
+	XMPScanner::SnipInfoVector packets;
+	bool endsInPacket;
+	std::exception_ptr error;
+	ScanRange() : start(0), end(0), endsInPacket(false) {};
+};
+
+// =================================================================================================
+// CollectPackets
+// ==============
+//
+// Copy the packet snips from a scanner. Returns true if the last scanned snip is an unfinished packet.
+
+static bool CollectPackets ( XMPScanner & scanner, XMPScanner::SnipInfoVector * packets )
+{
+	XMPScanner::SnipInfoVector snips;
+	scanner.Report ( snips );
+
+	bool inPacket = false;
+	for ( size_t i = 0; i < snips.size(); ++i ) {
+		const XMPScanner::SnipInfo & snip = snips[i];
+		if ( snip.fState == XMPScanner::eNotSeenSnip ) continue;
+		inPacket = (snip.fState == XMPScanner::ePartialPacketSnip);
+		if ( (snip.fState == XMPScanner::eValidPacketSnip) || (snip.fState == XMPScanner::eBadPacketSnip) ) {
+			packets->push_back ( snip );
+			packets->back().fEncodingAttr = "";	// ! Points into the scanner.
+		}
+	}
+
+	return inPacket;
+
+}	// CollectPackets
+
+// =================================================================================================
+// ScanOneRange
+// ============
+
+static void ScanOneRange ( const std::string * filePath, XMP_Int64 fileLen, ScanRange * range,
+						   std::atomic<bool> * stop, XMP_AbortProc abortProc, void * abortArg )
+{
+	Host_IO::FileRef hostFile = Host_IO::noFileRef;
+
+	try {
+
+		hostFile = Host_IO::Open ( filePath->c_str(), Host_IO::openReadOnly );
+		if ( hostFile == Host_IO::noFileRef ) XMP_Throw ( "ScanFileForPackets: Can't reopen file", kXMPErr_ExternalFailure );
+		Host_IO::Seek ( hostFile, range->start, kXMP_SeekFromStart );
+
+		XMPScanner scanner ( fileLen );
+		std::vector<XMP_Uns8> buffer ( kRangeBufferSize );
+
+		for ( XMP_Int64 bufPos = range->start; bufPos < fileLen; ) {
+
+			if ( stop->load ( std::memory_order_relaxed ) ) break;
+			if ( (abortProc != 0) && abortProc ( abortArg ) ) {	// ! Only passed to the caller's thread.
+				XMP_Throw ( "ScanFileForPackets - User abort", kXMPErr_UserAbort );
+			}
+
+			if ( bufPos >= range->end ) {
+				XMPScanner::SnipInfoVector unused;
+				if ( ! CollectPackets ( scanner, &unused ) ) break;	// Past the range and not in a packet.
+			}
+
+			XMP_Uns32 bufLen = kRangeBufferSize;
+			if ( (XMP_Int64)bufLen > (fileLen - bufPos) ) bufLen = (XMP_Uns32)(fileLen - bufPos);
+			XMP_Uns32 ioCount = Host_IO::Read ( hostFile, &buffer[0], bufLen );
+			if ( ioCount != bufLen ) XMP_Throw ( "ScanFileForPackets: Read failure", kXMPErr_ExternalFailure );
+
+			scanner.Scan ( &buffer[0], bufPos, bufLen );
+			bufPos += bufLen;
+
+		}
+
+		range->endsInPacket = CollectPackets ( scanner, &range->packets );
+
+	} catch ( ... ) {
+		range->error = std::current_exception();
+		stop->store ( true );
+	}
+
+	if ( hostFile != Host_IO::noFileRef ) Host_IO::Close ( hostFile );
+
+}	// ScanOneRange
+
+// =================================================================================================
+// ReserveScanThreads
+// ==================
+//
+// Take up to wanted extra threads from the shared budget, returns how many were taken.
+
+static unsigned ReserveScanThreads ( unsigned wanted )
+{
+	unsigned inUse = sScanThreadsInUse.load();
+	unsigned granted;
+
+	do {
+		const unsigned available = (inUse < (kScanMaxThreads - 1)) ? ((kScanMaxThreads - 1) - inUse) : 0;
+		granted = (wanted < available) ? wanted : available;
+		if ( granted == 0 ) return 0;
+	} while ( ! sScanThreadsInUse.compare_exchange_weak ( inUse, inUse + granted ) );
+
+	return granted;
+
+}	// ReserveScanThreads
+
+// =================================================================================================
+// ScanPathForPackets
+// ==================
+
+void ScanPathForPackets ( const std::string & filePath, XMP_Int64 fileLen, unsigned rangeCount,
+						  XMP_AbortProc abortProc, void * abortArg, XMPScanner::SnipInfoVector * packets )
+{
+	XMP_Assert ( rangeCount > 0 );
+	packets->clear();
+
+	std::vector<ScanRange> ranges ( rangeCount );
+	XMP_Int64 rangeLength = fileLen / rangeCount;
+	for ( unsigned r = 0; r < rangeCount; ++r ) {
+		ranges[r].start = r * rangeLength;
+		ranges[r].end = (r == (rangeCount - 1)) ? fileLen : ((r + 1) * rangeLength);
+	}
+
+	// The caller's thread does the first range, the abort proc is only called from there.
+
+	std::atomic<bool> stop ( false );
+	std::vector<std::thread> workers;
+
+	try {
+		workers.reserve ( rangeCount - 1 );
+		for ( unsigned r = 1; r < rangeCount; ++r ) {
+			workers.push_back ( std::thread ( ScanOneRange, &filePath, fileLen, &ranges[r], &stop, (XMP_AbortProc)0, (void*)0 ) );
+		}
+	} catch ( ... ) {
+		stop.store ( true );	// Could not start all threads, give up once the started ones finish.
+	}
+
+	ScanOneRange ( &filePath, fileLen, &ranges[0], &stop, abortProc, abortArg );
+	for ( size_t t = 0; t < workers.size(); ++t ) workers[t].join();
+
+	if ( workers.size() != (rangeCount - 1) ) {
+		XMP_Throw ( "ScanFileForPackets: Can't start scanning threads", kXMPErr_ExternalFailure );
+	}
+	for ( unsigned r = 0; r < rangeCount; ++r ) {
+		if ( ranges[r].error ) std::rethrow_exception ( ranges[r].error );
+	}
+
+	XMP_Int64 resumeOffset = 0;
+	for ( unsigned r = 0; r < rangeCount; ++r ) {
+		const XMPScanner::SnipInfoVector & rangePackets = ranges[r].packets;
+		for ( size_t i = 0; i < rangePackets.size(); ++i ) {
+			if ( rangePackets[i].fOffset < resumeOffset ) continue;	// Already found by an earlier range.
+			packets->push_back ( rangePackets[i] );
+			resumeOffset = rangePackets[i].fOffset + rangePackets[i].fLength;
+		}
+		if ( ranges[r].endsInPacket ) break;
+	}
+
+}	// ScanPathForPackets
+
+// =================================================================================================
+// ScanFileForPackets
+// ==================
+
+void ScanFileForPackets ( XMPFiles * parent, XMPScanner::SnipInfoVector * packets )
+{
+	XMP_IO *  fileRef = parent->ioRef;
+	XMP_Int64 fileLen = fileRef->Length();
+
+	XMP_AbortProc abortProc  = parent->abortProc;
+	void *        abortArg   = parent->abortArg;
+	const bool    checkAbort = (abortProc != 0);
+
+	packets->clear();
+
+	unsigned threadCount = std::thread::hardware_concurrency();
+	if ( threadCount > kScanMaxThreads ) threadCount = kScanMaxThreads;
+	if ( (XMP_Int64)threadCount > (fileLen / kScanRangeMinLength) ) threadCount = (unsigned)(fileLen / kScanRangeMinLength);
+
+	const bool canReopen = parent->UsesLocalIO() && (! parent->GetFilePath().empty()) &&
+						   XMP_OptionIsClear ( parent->openFlags, kXMPFiles_OpenForUpdate );
+
+	unsigned extraThreads = 0;
+	if ( (fileLen >= kParallelScanMinLength) && (threadCount >= 2) && canReopen ) {
+		extraThreads = ReserveScanThreads ( threadCount - 1 );
+	}
+
+	if ( extraThreads == 0 ) {
+
+		// Small files, no way to open the file again, or other scans use the thread budget, scan
+		// sequentially through the ioRef. Files open for update are not reopened, some hosts don't
+		// allow that.
+
+		XMPScanner scanner ( fileLen );
+
+		enum { kBufferSize = 64*1024 };
+		XMP_Uns8 buffer [kBufferSize];
+
+		fileRef->Rewind();
+
+		size_t bufLen;
+		for ( XMP_Int64 bufPos = 0; bufPos < fileLen; bufPos += bufLen ) {
+			if ( checkAbort && abortProc(abortArg) ) {
+				XMP_Throw ( "ScanFileForPackets - User abort", kXMPErr_UserAbort );
+			}
+			bufLen = fileRef->Read ( buffer, kBufferSize );
+			if ( bufLen == 0 ) XMP_Throw ( "ScanFileForPackets: Read failure", kXMPErr_ExternalFailure );
+			scanner.Scan ( buffer, bufPos, bufLen );
+		}
+
+		(void) CollectPackets ( scanner, packets );
+		return;
+
+	}
+
+	try {
+		ScanPathForPackets ( parent->GetFilePath(), fileLen, (extraThreads + 1), abortProc, abortArg, packets );
+	} catch ( ... ) {
+		sScanThreadsInUse -= extraThreads;
+		throw;
+	}
+	sScanThreadsInUse -= extraThreads;
+
+}	// ScanFileForPackets
+
 // =================================================================================================
 // Scanner_MetaHandlerCTor
 // =======================
@@ -247,30 +495,16 @@ void Scanner_MetaHandler::CacheFileData()
 		// ------------------------------------------------------
 		// Scan the entire file to find all of the valid packets.
 
-		XMP_Int64  fileLen = fileRef->Length();
-		XMPScanner scanner ( fileLen );
+		XMPScanner::SnipInfoVector snips;
+		ScanFileForPackets ( this->parent, &snips );
 
 		enum { kBufferSize = 64*1024 };
 		XMP_Uns8	buffer [kBufferSize];
 
-		fileRef->Rewind();
-
-		for ( bufPos = 0; bufPos < fileLen; bufPos += bufLen ) {
-			if ( checkAbort && abortProc(abortArg) ) {
-				XMP_Throw ( "Scanner_MetaHandler::LocateXMP - User abort", kXMPErr_UserAbort );
-			}
-			bufLen = fileRef->Read ( buffer, kBufferSize );
-			if ( bufLen == 0 ) XMP_Throw ( "Scanner_MetaHandler::LocateXMP: Read failure", kXMPErr_ExternalFailure );
-			scanner.Scan ( buffer, bufPos, bufLen );
-		}
-
 		// --------------------------------------------------------------
 		// Parse the valid packet snips, building a vector of candidates.
 
-		long snipCount = scanner.GetSnipCount();
-
-		XMPScanner::SnipInfoVector snips ( snipCount );
-		scanner.Report ( snips );
+		long snipCount = (long)snips.size();
 
 		for ( pkt = 0; pkt < snipCount; ++pkt ) {
 
@@ -11,6 +11,7 @@
 // =================================================================================================
 
 #include "XMPFiles/source/FileHandlers/Trivial_Handler.hpp"
+#include "XMPFiles/source/FormatSupport/XMPScanner.hpp"
 
 // =================================================================================================
 /// \file Scanner_Handler.hpp
@@ -22,6 +23,18 @@
 
 extern XMPFileHandler * Scanner_MetaHandlerCTor ( XMPFiles * parent );
 
+// Scan all of the parent's file for packets. Returns the valid and bad packet snips in file order,
+// the other snips are dropped and fEncodingAttr is always empty. Large local files are split into
+// ranges that are scanned concurrently, each with its own file handle and scanner. A packet that
+// crosses the end of a range is finished by the scanner of that range. The scanning threads come
+// from a budget shared by the whole process, the scan is sequential when none are left.
+extern void ScanFileForPackets ( XMPFiles * parent, XMPScanner::SnipInfoVector * packets );
+
+// Scan the file at filePath in rangeCount ranges, rangeCount-1 of them on new threads. The abort
+// proc is only called from the caller's thread. Used by ScanFileForPackets, which picks the count.
+extern void ScanPathForPackets ( const std::string & filePath, XMP_Int64 fileLen, unsigned rangeCount,
+								 XMP_AbortProc abortProc, void * abortArg, XMPScanner::SnipInfoVector * packets );
+
 static const XMP_OptionBits kScanner_HandlerFlags = kTrivial_HandlerFlags;
 
 class Scanner_MetaHandler : public Trivial_MetaHandler
@@ -662,8 +662,6 @@ bool SonyHDV_MetaHandler::MakeIndexFilePath ( std::string& idxPath, const std::s
 // SonyHDV_MetaHandler::MakeLegacyDigest
 // =====================================
 
-#define kHexDigits "0123456789ABCDEF"
-
 void SonyHDV_MetaHandler::MakeLegacyDigest ( std::string * digestStr )
 {
 	std::string idxPath;
@@ -676,13 +674,8 @@ void SonyHDV_MetaHandler::MakeLegacyDigest ( std::string * digestStr )
 	ReadIDXFile ( idxPath, this->clipName, 0,  dummy, &context, false );
 	MD5Final ( digestBin, &context );
 
-	char buffer [40];
-	for ( int in = 0, out = 0; in < 16; in += 1, out += 2 ) {
-		XMP_Uns8 byte = digestBin[in];
-		buffer[out]   = kHexDigits [ byte >> 4 ];
-		buffer[out+1] = kHexDigits [ byte & 0xF ];
-	}
-	buffer[32] = 0;
+	char buffer [33];
+	MD5DigestToHex ( digestBin, buffer );
 	digestStr->erase();
 	digestStr->append ( buffer, 32 );
 
@@ -201,24 +201,43 @@ void TIFF_MetaHandler::ProcessXMP()
 	PSIR_Manager & psir = *this->psirMgr;
 	IPTC_Manager & iptc = *this->iptcMgr;
 
+	// The skip options are only allowed for read-only opens. The TIFF stream itself is already
+	// parsed, skipping Exif only leaves the tiff: and exif: XMP alone. The PSIR is still needed for
+	// the IPTC digest unless that is skipped too.
+
+	XMP_OptionBits skipOptions = ImportSkipOptions ( this->parent->openFlags );
+	XMP_Assert ( readOnly || (skipOptions == 0) );
+
+	TIFF_Manager::TagInfo iptcInfo;
+	bool haveIPTC = false;
+	if ( ! (skipOptions & k2XMP_SkipIPTC) ) {
+		haveIPTC = tiff.GetTag ( kTIFF_PrimaryIFD, kTIFF_IPTC, &iptcInfo );	// The TIFF IPTC tag.
+	}
+	bool checkDigest = haveIPTC && (! (skipOptions & k2XMP_SkipDigests));
+
 	TIFF_Manager::TagInfo psirInfo;
-	bool havePSIR = tiff.GetTag ( kTIFF_PrimaryIFD, kTIFF_PSIR, &psirInfo );
+	bool havePSIR = false;
+	if ( (! (skipOptions & k2XMP_SkipPSIR)) || checkDigest ) {
+		havePSIR = tiff.GetTag ( kTIFF_PrimaryIFD, kTIFF_PSIR, &psirInfo );
+	}
 
 	if ( havePSIR ) {	// ! Do the Photoshop 6 integration before other legacy analysis.
+		StartPhaseCheck ( psirParse );
 		psir.ParseMemoryResources ( psirInfo.dataPtr, psirInfo.dataLen );
+		EndPhaseCheck ( psirParse, "PSIR parse" );
 		PSIR_Manager::ImgRsrcInfo buriedExif;
-		found = psir.GetImgRsrc ( kPSIR_Exif, &buriedExif );
+		found = (! (skipOptions & k2XMP_SkipExif)) && psir.GetImgRsrc ( kPSIR_Exif, &buriedExif );
 		if ( found ) {
 			tiff.IntegrateFromPShop6 ( buriedExif.dataPtr, buriedExif.dataLen );
 			if ( ! readOnly ) psir.DeleteImgRsrc ( kPSIR_Exif );
 		}
 	}
 
-	TIFF_Manager::TagInfo iptcInfo;
-	bool haveIPTC = tiff.GetTag ( kTIFF_PrimaryIFD, kTIFF_IPTC, &iptcInfo );	// The TIFF IPTC tag.
 	int iptcDigestState = kDigestMatches;
 
-	if ( haveIPTC ) {
+	if ( checkDigest ) {
+
+		StartPhaseCheck ( digest );
 
 		bool haveDigest = false;
 		PSIR_Manager::ImgRsrcInfo digestInfo;
@@ -245,9 +264,11 @@ void TIFF_MetaHandler::ProcessXMP()
 
 		}
 
+		EndPhaseCheck ( digest, "IPTC digest" );
+
 	}
 
-	XMP_OptionBits options = k2XMP_FileHadExif;	// TIFF files are presumed to have Exif legacy.
+	XMP_OptionBits options = skipOptions | k2XMP_FileHadExif;	// TIFF files are presumed to have Exif legacy.
 	if ( haveIPTC ) options |= k2XMP_FileHadIPTC;
 	if ( this->containsXMP ) options |= k2XMP_FileHadXMP;
 
@@ -262,17 +283,25 @@ void TIFF_MetaHandler::ProcessXMP()
 		// Common code takes care of packetInfo.charForm, .padSize, and .writeable.
 		XMP_StringPtr packetStr = this->xmpPacket.c_str();
 		XMP_StringLen packetLen = (XMP_StringLen)this->xmpPacket.size();
+		StartPhaseCheck ( xmp );
 		try {
 			this->xmpObj.ParseFromBuffer ( packetStr, packetLen );
 		} catch ( ... ) { /* Ignore parsing failures, someday we hope to get partial XMP back. */ }
+		EndPhaseCheck ( xmp, "XMP parse" );
 		haveXMP = true;
 	}
 
 	// Process the legacy metadata.
 
 	if ( haveIPTC && (! haveXMP) && (iptcDigestState == kDigestMatches) ) iptcDigestState = kDigestMissing;
-	if (iptcInfo.dataLen) iptc.ParseMemoryDataSets ( iptcInfo.dataPtr, iptcInfo.dataLen );
+	if ( haveIPTC && iptcInfo.dataLen ) {
+		StartPhaseCheck ( iptcParse );
+		iptc.ParseMemoryDataSets ( iptcInfo.dataPtr, iptcInfo.dataLen );
+		EndPhaseCheck ( iptcParse, "IPTC parse" );
+	}
+	StartPhaseCheck ( import );
 	ImportPhotoData ( tiff, iptc, psir, iptcDigestState, &this->xmpObj, options );
+	EndPhaseCheck ( import, "legacy import" );
 
 	this->containsXMP = true;	// Assume we now have something in the XMP.
 
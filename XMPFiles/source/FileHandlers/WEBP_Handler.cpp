@@ -108,6 +108,11 @@ void WEBP_MetaHandler::ProcessXMP()
             !XMP_OptionIsSet(this->parent->openFlags, kXMPFiles_OpenForUpdate);
         xmpOnly =
             XMP_OptionIsSet(this->parent->openFlags, kXMPFiles_OpenOnlyXMP);
+        // Exif is the only legacy in WebP, skipping it leaves nothing to
+        // reconcile. Only allowed for read-only opens.
+        if (XMP_OptionIsSet(this->parent->openFlags, kXMPFiles_OpenSkipExif)) {
+            xmpOnly = true;
+        }
     }
     if (!xmpOnly) {
         if (readOnly) {
@@ -125,8 +130,11 @@ void WEBP_MetaHandler::ProcessXMP()
             WEBP::Chunk* exifChunk = this->mainChunk->getExifChunk();
             if (exifChunk != NULL) {
                 haveExif = true;
+                // The read-only reader borrows the chunk data, owned
+                // by the handler's chunk tree.
                 this->exifMgr->ParseMemoryStream(exifChunk->data.data() + 6,
-                                                 exifChunk->data.size() - 6);
+                                                 exifChunk->data.size() - 6,
+                                                 !readOnly);
             }
         }
     }
@@ -242,8 +242,6 @@ bool XDCAM_MetaHandler::MakeMediaproPath ( std::string * path, bool checkFile /*
 
 // *** Early hack version.
 
-#define kHexDigits "0123456789ABCDEF"
-
 // =================================================================================================
 // XDCAM_MetaHandler::MakeLegacyDigest
 // ================================
@@ -284,13 +282,8 @@ void XDCAM_MetaHandler::MakeLegacyDigest ( std::string * digestStr )
 
 	MD5Final ( digestBin, &context );
 
-	char buffer [40];
-	for ( int in = 0, out = 0; in < 16; in += 1, out += 2 ) {
-		XMP_Uns8 byte = digestBin[in];
-		buffer[out]   = kHexDigits [ byte >> 4 ];
-		buffer[out+1] = kHexDigits [ byte & 0xF ];
-	}
-	buffer[32] = 0;
+	char buffer [33];
+	MD5DigestToHex ( digestBin, buffer );
 	digestStr->append ( buffer );
 
 }	// XDCAM_MetaHandler::MakeLegacyDigest
@@ -1085,13 +1085,7 @@ void ASF_LegacyManager::ComputeDigest()
 
 	MD5Final ( digest, &context );
 
-	size_t in, out;
-	for ( in = 0, out = 0; in < 16; in += 1, out += 2 ) {
-		XMP_Uns8 byte = digest[in];
-		buffer[out]   = ReconcileUtils::kHexDigits [ byte >> 4 ];
-		buffer[out+1] = ReconcileUtils::kHexDigits [ byte & 0xF ];
-	}
-	buffer[32] = 0;
+	MD5DigestToHex ( digest, buffer );
 
 	digestStr.append ( buffer );
 
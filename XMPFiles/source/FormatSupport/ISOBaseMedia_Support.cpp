@@ -9,6 +9,7 @@
 
 #include "public/include/XMP_Environment.h"	// ! XMP_Environment.h must be the first included header.
 #include <sstream>
+#include <algorithm>
 
 #include "public/include/XMP_Const.h"
 
@@ -29,21 +30,25 @@ static KnownBoxList boxList;
 #define ISOboxType(x,y) boxList.insert(y)
 #define SEPARATOR ;
 	bool IsKnownBoxType(XMP_Uns32 boxType) {
-		if (boxList.empty()){
-			ISOBoxList ISOBoxPrivateList ;
-		}
+		XMP_Assert ( ! boxList.empty() );	// ! Filled by InitializeGlobals, read concurrently after that.
 		if (boxList.find(boxType)!=boxList.end()){
 			return true;
 		}
 		return false;
 	}
+	bool InitializeGlobals()
+	{
+		if (boxList.empty()){
+			ISOBoxList ISOBoxPrivateList ;
+		}
+		return true;
+	}
 	void TerminateGlobals()
 	{
 		boxList.clear();
 	}
 #undef ISOboxType
 #undef SEPARATOR
-static BoxInfo voidInfo;
 
 // =================================================================================================
 // GetBoxInfo - from memory
@@ -54,6 +59,7 @@ const XMP_Uns8 * GetBoxInfo ( const XMP_Uns8 * boxPtr, const XMP_Uns8 * boxLimit
 {
 	XMP_Uns32 u32Size;
 	
+	BoxInfo voidInfo;	// ! Per call, GetBoxInfo can run on several threads.
 	if ( info == 0 ) info = &voidInfo;
 	info->boxType = info->headerSize = 0;
 	info->contentSize = 0;
@@ -129,6 +135,7 @@ XMP_Uns64 GetBoxInfo ( XMP_IO* fileRef, const XMP_Uns64 boxOffset, const XMP_Uns
 	XMP_Uns8  buffer [8];
 	XMP_Uns32 u32Size;
 	
+	BoxInfo voidInfo;	// ! Per call, GetBoxInfo can run on several threads.
 	if ( info == 0 ) info = &voidInfo;
 	info->boxType = info->headerSize = 0;
 	info->contentSize = 0;
@@ -240,7 +247,22 @@ XMP_Uns8 * ISOBaseMedia_Manager::PickContentPtr(const BoxNode & node) const
 		return (XMP_Uns8*)&node.changedContent[0];
 	}
 	else {
-		return (XMP_Uns8*) &this->fullSubtree[0] + node.offset + node.headerSize;
+		XMP_Uns32 contentOffset = node.offset + node.headerSize;
+		if ( ! this->omittedContent.empty() ) {
+			// Find the last omitted range before the content, the content is after that in the
+			// compacted subtree by the total omitted through that range.
+			size_t lower = 0, upper = this->omittedContent.size();
+			while ( lower < upper ) {
+				size_t middle = lower + (upper - lower) / 2;
+				if ( this->omittedContent[middle].offset < contentOffset ) {
+					lower = middle + 1;
+				} else {
+					upper = middle;
+				}
+			}
+			if ( lower > 0 ) contentOffset -= this->omittedContent[lower-1].totalSize;
+		}
+		return (XMP_Uns8*) &this->fullSubtree[0] + contentOffset;
 	}
 }	// ISOBaseMedia_Manager::PickContentPtr
 
@@ -328,9 +350,85 @@ void ISOBaseMedia_Manager::NoteChange()
 {
 
 	this->subtreeRootNode.changed = true;
+	this->NoteChangedRange ( 0, 0xFFFFFFFF );	// Anything could have changed.
 
 } // ISOBaseMedia_Manager::NoteChange
 
+void ISOBaseMedia_Manager::NoteChange(BoxRef theBox)
+{
+	XMP_Assert(theBox != 0);
+	const BoxNode & node = *((BoxNode*)theBox);
+
+	this->subtreeRootNode.changed = true;
+	if (!node.changed) this->NoteChangedRange((node.offset + node.headerSize), node.contentSize);
+
+} // ISOBaseMedia_Manager::NoteChange
+
+// =================================================================================================
+// ISOBaseMedia_Manager::NoteChangedRange
+// ======================================
+//
+// Changes usually come in offset order, extend the last range when possible.
+
+void ISOBaseMedia_Manager::NoteChangedRange(XMP_Uns32 offset, XMP_Uns32 size)
+{
+	if (size == 0) return;
+
+	if (!this->changedRanges.empty()) {
+		ChangedRange & last = this->changedRanges.back();
+		XMP_Uns64 lastEnd = (XMP_Uns64)last.offset + last.size;
+		if ((offset >= last.offset) && (offset <= (lastEnd + kChangedRangeGap))) {
+			XMP_Uns64 newEnd = (XMP_Uns64)offset + size;
+			if (newEnd > lastEnd) last.size = (XMP_Uns32)std::min((newEnd - last.offset), (XMP_Uns64)0xFFFFFFFF);
+			return;
+		}
+	}
+
+	this->changedRanges.push_back(ChangedRange(offset, size));
+
+}	// ISOBaseMedia_Manager::NoteChangedRange
+
+// =================================================================================================
+// ISOBaseMedia_Manager::MergeChangedRanges
+// ========================================
+//
+// Sort the changed ranges, merge the ones that overlap or are close, and trim them to the subtree.
+
+static bool CompareChangedRanges(const ISOBaseMedia_Manager::ChangedRange & left,
+								 const ISOBaseMedia_Manager::ChangedRange & right)
+{
+	return (left.offset < right.offset);
+}
+
+void ISOBaseMedia_Manager::MergeChangedRanges(XMP_Uns32 subtreeSize)
+{
+	ChangedRangeList & ranges = this->changedRanges;
+	std::sort(ranges.begin(), ranges.end(), CompareChangedRanges);
+
+	size_t merged = 0;
+	for (size_t i = 0, limit = ranges.size(); i < limit; ++i) {
+
+		XMP_Uns64 start = ranges[i].offset;
+		if (start >= subtreeSize) break;
+		XMP_Uns64 end = std::min((start + ranges[i].size), (XMP_Uns64)subtreeSize);
+
+		if (merged > 0) {
+			ChangedRange & last = ranges[merged - 1];
+			XMP_Uns64 lastEnd = (XMP_Uns64)last.offset + last.size;
+			if (start <= (lastEnd + kChangedRangeGap)) {
+				if (end > lastEnd) last.size = (XMP_Uns32)(end - last.offset);
+				continue;
+			}
+		}
+
+		ranges[merged++] = ChangedRange((XMP_Uns32)start, (XMP_Uns32)(end - start));
+
+	}
+
+	ranges.resize(merged);
+
+}	// ISOBaseMedia_Manager::MergeChangedRanges
+
 // =================================================================================================
 // ISOBaseMedia_Manager::SetBox
 // ====================
@@ -347,11 +445,13 @@ void ISOBaseMedia_Manager::SetBox(BoxRef theBox, const void* dataPtr, XMP_Uns32
 		{
 			memcpy(node->idUUID, idUUID, 16);
 			this->subtreeRootNode.changed = true;
+			this->NoteChangedRange(node->offset, node->headerSize);
 		}
 		XMP_Uns8 * oldContent = PickContentPtr(*node);
 		if (memcmp(oldContent, dataPtr, size) == 0) return;	// No change.
 		memcpy(oldContent, dataPtr, size);	// Update the old content in-place
 		this->subtreeRootNode.changed = true;
+		if (!node->changed) this->NoteChangedRange((node->offset + node->headerSize), size);
 
 #if TraceUpdateMoovTree
 		XMP_Uns32 be32 = MakeUns32BE(node->boxType);
@@ -120,6 +120,7 @@ namespace ISOMedia {
 #undef SEPARATOR
 
 	bool IsKnownBoxType(XMP_Uns32 boxType) ;
+	bool InitializeGlobals();	// Initialize and terminate the known box list.
 	void TerminateGlobals();
 
 	static XMP_Uns8 k_xmpUUID [16] = { 0xBE, 0x7A, 0xCF, 0xCB, 0x97, 0xA9, 0x42, 0xE8, 0x9C, 0x71, 0x99, 0x94, 0x91, 0xE3, 0xAF, 0xAC };
@@ -201,7 +202,9 @@ public:
 
 	// ---------------------------------------------------------------------------------------------
 	// NoteChange - Note overall change, value was directly replaced.
+	// NoteChange(ref) - Like above, the box's content was directly replaced.
 	virtual void NoteChange();
+	void NoteChange(BoxRef theBox);
 
 
 	// SetBox(ref) - Replace the content with a copy of the given data.
@@ -278,6 +281,49 @@ public:
 
 	RawDataBlock fullSubtree;	// The entire box, straight from the file or from UpdateMemoryTree.
 
+	// ---------------------------------------------------------------------------------------------
+	// A read-only parse straight from the file can leave out the content of bulky boxes that carry
+	// no metadata, see MOOV_Manager::ParseFileTree. The omitted boxes keep their true offsets, their
+	// content size is set to zero. The omitted ranges are kept in offset order, with the total size
+	// omitted through the end of each range, PickContentPtr uses them to find the content of other
+	// boxes in the compacted fullSubtree. A tree with omitted content can't be updated.
+
+	struct OmittedRange {
+		XMP_Uns32 offset;		// The offset of the omitted content in the full box.
+		XMP_Uns32 size;
+		XMP_Uns32 totalSize;	// The total omitted through the end of this range.
+		OmittedRange() : offset(0), size(0), totalSize(0) {};
+		OmittedRange ( XMP_Uns32 _offset, XMP_Uns32 _size, XMP_Uns32 _totalSize )
+			: offset(_offset), size(_size), totalSize(_totalSize) {};
+	};
+
+	typedef std::vector<OmittedRange> OmittedList;
+
+	OmittedList omittedContent;
+
+	// ---------------------------------------------------------------------------------------------
+	// The byte ranges of fullSubtree that may differ from the parsed box, so that a box updated at
+	// the same size can be written by range. SetBox and NoteChange(ref) note the content changed in
+	// place, UpdateMemoryTree adds the boxes it moves, resizes or replaces and then merges the list,
+	// ranges less than kChangedRangeGap apart become one. A range can cover unchanged bytes, never
+	// the reverse. NoteChange() does not say what changed and covers everything.
+
+	struct ChangedRange {
+		XMP_Uns32 offset;
+		XMP_Uns32 size;
+		ChangedRange() : offset(0), size(0) {};
+		ChangedRange ( XMP_Uns32 _offset, XMP_Uns32 _size ) : offset(_offset), size(_size) {};
+	};
+
+	typedef std::vector<ChangedRange> ChangedRangeList;
+
+	enum { kChangedRangeGap = 64 };
+
+	ChangedRangeList changedRanges;
+
+	void NoteChangedRange(XMP_Uns32 offset, XMP_Uns32 size);
+	void MergeChangedRanges(XMP_Uns32 subtreeSize);
+
 	//virtual void ParseMemoryTree(XMP_Uns8 fileMode) {} //make this virtual
 	//virtual void UpdateMemoryTree() {}
 	void FillBoxInfo(const BoxNode & node, BoxInfo * info) const;
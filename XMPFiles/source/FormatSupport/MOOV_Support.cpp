@@ -88,6 +88,8 @@ void MOOV_Manager::ParseMemoryTree ( XMP_Uns8 _fileMode )
 	this->subtreeRootNode.children.clear();
 	this->subtreeRootNode.changedContent.clear();
 	this->subtreeRootNode.changed = false;
+	this->omittedContent.clear();
+	this->changedRanges.clear();
 
 	if ( this->fullSubtree.empty() ) return;
 	
@@ -182,6 +184,153 @@ void MOOV_Manager::ParseNestedBoxes ( BoxNode * parentNode, const std::string &
 
 }	// MOOV_Manager::ParseNestedBoxes
 
+// =================================================================================================
+// MOOV_Manager::ParseFileTree
+// ===========================
+//
+// Parse the 'moov' box from the file, building the same BoxNode tree as ParseMemoryTree. The box
+// headers are read as the tree is walked. The content of the sample tables and similar bulky boxes
+// is not read, these can make the 'moov' box hundreds of MB for long recordings. Everything else
+// is copied into fullSubtree. The tree offsets are the offsets in the file's 'moov' box.
+
+void MOOV_Manager::ParseFileTree ( XMP_IO * fileRef, XMP_Uns64 moovOffset, XMP_Uns8 _fileMode )
+{
+	this->fileMode = _fileMode;
+	
+	this->subtreeRootNode.offset = this->subtreeRootNode.boxType = 0;
+	this->subtreeRootNode.headerSize = this->subtreeRootNode.contentSize = 0;
+	this->subtreeRootNode.children.clear();
+	this->subtreeRootNode.changedContent.clear();
+	this->subtreeRootNode.changed = false;
+	this->omittedContent.clear();
+	this->changedRanges.clear();
+	this->fullSubtree.clear();
+
+	ISOMedia::BoxInfo moovInfo;
+	(void) ISOMedia::GetBoxInfo ( fileRef, moovOffset, fileRef->Length(), &moovInfo );
+	XMP_Enforce ( moovInfo.boxType == ISOMedia::k_moov );
+	
+	XMP_Uns64 fullMoovSize = moovInfo.headerSize + moovInfo.contentSize;
+	if ( fullMoovSize > 0xFFFFFFFFULL ) {	// From here on we know 32-bit offsets are safe.
+		XMP_Throw ( "Oversize 'moov' box", kXMPErr_EnforceFailure );
+	}
+	
+	this->subtreeRootNode.boxType = ISOMedia::k_moov;
+	this->subtreeRootNode.headerSize = moovInfo.headerSize;
+	this->subtreeRootNode.contentSize = (XMP_Uns32)moovInfo.contentSize;
+
+	XMP_Uns32 copiedSize = 0;
+	this->ParseFileBoxes ( fileRef, moovOffset, &this->subtreeRootNode, "moov", &copiedSize );
+	this->CopyFileContent ( fileRef, moovOffset, &copiedSize, (XMP_Uns32)fullMoovSize );
+
+	if ( this->fullSubtree.size() > TopBoxSizeLimit ) {
+		XMP_Throw ( "Oversize 'moov' box", kXMPErr_EnforceFailure );
+	}
+	
+}	// MOOV_Manager::ParseFileTree
+
+// =================================================================================================
+// MOOV_Manager::ParseFileBoxes
+// ============================
+//
+// The file form of ParseNestedBoxes. The boxes of interest are the same, the content of a box is
+// omitted if it is large and is a sample table or media data or free space. The omitted content is
+// recorded in omittedContent, copiedSize is how far the 'moov' box has been copied or omitted.
+
+static const XMP_Uns32 kOmitContentSize = 64*1024;	// Smaller sample tables are kept, e.g. for the timecode track.
+
+void MOOV_Manager::ParseFileBoxes ( XMP_IO * fileRef, XMP_Uns64 moovOffset, BoxNode * parentNode,
+									const std::string & parentPath, XMP_Uns32 * copiedSize )
+{
+	ISOMedia::BoxInfo isoInfo;
+	XMP_Uns64 childOrigin = moovOffset + parentNode->offset + parentNode->headerSize;
+	XMP_Uns64 childLimit  = childOrigin + parentNode->contentSize;
+	XMP_Uns64 nextChild;
+	
+	parentNode->contentSize = 0;	// Exclude nested box size.
+
+	if ( parentNode->boxType == ISOMedia::k_meta && parentPath != "moov/meta") {	// ! The 'meta' box is a FullBox.
+		parentNode->contentSize = 4;
+		childOrigin += 4;
+	}
+
+	const bool inSampleTable = (parentNode->boxType == ISOMedia::k_stbl);
+
+	for ( XMP_Uns64 currChild = childOrigin; currChild < childLimit; currChild = nextChild ) {
+	
+		nextChild = ISOMedia::GetBoxInfo ( fileRef, currChild, childLimit, &isoInfo );
+		if ( (isoInfo.boxType == 0) &&
+			 (isoInfo.headerSize < 8) &&
+			 (isoInfo.contentSize == 0) ) continue;	// Skip trailing padding that QT sometimes writes.
+		
+		XMP_Uns32 childOffset = (XMP_Uns32) (currChild - moovOffset);
+		if( isoInfo.boxType == ISOMedia::k_uuid )
+			parentNode->children.push_back ( BoxNode ( childOffset, isoInfo.boxType, isoInfo.headerSize, (XMP_Uns8 *)isoInfo.idUUID, (XMP_Uns32)isoInfo.contentSize ) );
+		else
+			parentNode->children.push_back ( BoxNode ( childOffset, isoInfo.boxType, isoInfo.headerSize, (XMP_Uns32)isoInfo.contentSize ) );
+		BoxNode * newChild = &parentNode->children.back();
+		
+		const char * pathSuffix = 0;	// Set to non-zero for boxes of interest.
+		bool omitContent = false;
+
+		switch ( isoInfo.boxType ) {	// Want these boxes regardless of parent.
+			case ISOMedia::k_udta : pathSuffix = "/udta"; break;
+			case ISOMedia::k_meta : pathSuffix = "/meta"; break;
+			case ISOMedia::k_ilst : pathSuffix = "/ilst"; break;
+			case ISOMedia::k_trak : pathSuffix = "/trak"; break;
+			case ISOMedia::k_edts : pathSuffix = "/edts"; break;
+			case ISOMedia::k_mdia : pathSuffix = "/mdia"; break;
+			case ISOMedia::k_minf : pathSuffix = "/minf"; break;
+			case ISOMedia::k_dinf : pathSuffix = "/dinf"; break;
+			case ISOMedia::k_stbl : pathSuffix = "/stbl"; break;
+			case ISOMedia::k_mdat :
+			case ISOMedia::k_free :
+			case ISOMedia::k_skip :
+			case ISOMedia::k_wide : omitContent = true; break;
+			case ISOMedia::k_stsd : break;	// The sample descriptions are needed for the timecode track.
+			default : omitContent = inSampleTable; break;
+		}
+
+		if ( pathSuffix != 0 ) {
+			this->ParseFileBoxes ( fileRef, moovOffset, newChild, (parentPath + pathSuffix), copiedSize );
+		} else if ( omitContent && (newChild->contentSize > kOmitContentSize) ) {
+			XMP_Uns32 contentOffset = newChild->offset + newChild->headerSize;
+			this->CopyFileContent ( fileRef, moovOffset, copiedSize, contentOffset );
+			XMP_Uns32 totalSize = newChild->contentSize;
+			if ( ! this->omittedContent.empty() ) totalSize += this->omittedContent.back().totalSize;
+			this->omittedContent.push_back ( OmittedRange ( contentOffset, newChild->contentSize, totalSize ) );
+			*copiedSize = contentOffset + newChild->contentSize;
+			newChild->contentSize = 0;
+		}
+	
+	}
+
+}	// MOOV_Manager::ParseFileBoxes
+
+// =================================================================================================
+// MOOV_Manager::CopyFileContent
+// =============================
+//
+// Append the 'moov' box from copiedSize up to copyLimit to fullSubtree. Everything between omitted
+// content is copied, including the headers and what is not parsed, so that only the omitted ranges
+// shift the offsets in fullSubtree.
+
+void MOOV_Manager::CopyFileContent ( XMP_IO * fileRef, XMP_Uns64 moovOffset, XMP_Uns32 * copiedSize, XMP_Uns32 copyLimit )
+{
+	if ( copyLimit <= *copiedSize ) return;
+
+	XMP_Uns32 copyLength = copyLimit - *copiedSize;
+	XMP_Enforce ( (this->fullSubtree.size() + copyLength) <= TopBoxSizeLimit );
+
+	size_t oldSize = this->fullSubtree.size();
+	this->fullSubtree.resize ( oldSize + copyLength );
+	fileRef->Seek ( (moovOffset + *copiedSize), kXMP_SeekFromStart );
+	fileRef->ReadAll ( &this->fullSubtree[oldSize], copyLength );
+
+	*copiedSize = copyLimit;
+
+}	// MOOV_Manager::CopyFileContent
+
 
 
 
@@ -259,6 +408,9 @@ XMP_Uns32 MOOV_Manager::NewSubtreeSize ( const BoxNode & node, const std::string
 //
 // Append this node's header, content, and children. Because the 'meta' box is a FullBox with nested
 // boxes, there can be both content and children. Ignore 'free' and 'wide' boxes.
+//
+// A box that keeps its offset and header size is in place, only its size field and changed content
+// can differ from the parsed tree. All of any other box is noted as changed.
 
 #define IncrNewPtr(count)	{ newPtr += count; XMP_Enforce ( newPtr <= newEnd ); }
 
@@ -267,7 +419,7 @@ XMP_Uns32 MOOV_Manager::NewSubtreeSize ( const BoxNode & node, const std::string
 #endif
 
 XMP_Uns8 * MOOV_Manager::AppendNewSubtree ( const BoxNode & node, const std::string & parentPath,
-											XMP_Uns8 * newPtr, XMP_Uns8 * newEnd )
+											XMP_Uns8 * newPtr, XMP_Uns8 * newEnd, const XMP_Uns8 * newStart )
 {
 	if ( (node.boxType == ISOMedia::k_free) || (node.boxType == ISOMedia::k_wide) ) {
 	}
@@ -285,6 +437,10 @@ XMP_Uns8 * MOOV_Manager::AppendNewSubtree ( const BoxNode & node, const std::str
 				  parentPath.c_str(), &be32, newOffset, node.contentSize, addr32 );
 	#endif
 
+	XMP_Uns32 newOffset = (XMP_Uns32) (newPtr - newStart);
+	XMP_Uns32 newHeaderSize = (node.boxType == ISOMedia::k_uuid) ? (8 + 16) : 8;
+	bool inPlace = (node.headerSize == newHeaderSize) && (node.offset == newOffset);
+
 	// Leave the size as 0 for now, append the type and content.
 	
 	XMP_Uns8 * boxOrigin = newPtr;	// Save origin to fill in the final size.
@@ -301,6 +457,12 @@ XMP_Uns8 * MOOV_Manager::AppendNewSubtree ( const BoxNode & node, const std::str
 		memcpy ( newPtr, content, node.contentSize );
 		IncrNewPtr ( node.contentSize );
 	}
+
+	if ( ! inPlace ) {
+		this->NoteChangedRange ( newOffset, (newHeaderSize + node.contentSize) );
+	} else if ( node.changed ) {
+		this->NoteChangedRange ( (newOffset + newHeaderSize), node.contentSize );
+	}
 	
 	// Append the nested boxes.
 	
@@ -313,14 +475,16 @@ XMP_Uns8 * MOOV_Manager::AppendNewSubtree ( const BoxNode & node, const std::str
 		std::string nodePath = parentPath + suffix;
 		
 		for ( size_t i = 0, limit = node.children.size(); i < limit; ++i ) {
-			newPtr = this->AppendNewSubtree ( node.children[i], nodePath, newPtr, newEnd );
+			newPtr = this->AppendNewSubtree ( node.children[i], nodePath, newPtr, newEnd, newStart );
 		}
 
 	}
 	
-	// Fill in the final size.
+	// Fill in the final size, fullSubtree still has the parsed box.
 	
-	PutUns32BE ( (XMP_Uns32)(newPtr - boxOrigin), boxOrigin );
+	XMP_Uns32 newBoxSize = (XMP_Uns32)(newPtr - boxOrigin);
+	PutUns32BE ( newBoxSize, boxOrigin );
+	if ( inPlace && (GetUns32BE ( &this->fullSubtree[newOffset] ) != newBoxSize) ) this->NoteChangedRange ( newOffset, 4 );
 	
 	return newPtr;
 	
@@ -333,6 +497,7 @@ XMP_Uns8 * MOOV_Manager::AppendNewSubtree ( const BoxNode & node, const std::str
 void MOOV_Manager::UpdateMemoryTree()
 {
 	if ( ! this->IsChanged() ) return;
+	XMP_Enforce ( this->omittedContent.empty() );	// Can't rewrite what was not read.
 	
 	XMP_Uns32 newSize = this->NewSubtreeSize ( this->subtreeRootNode, "" );
 	XMP_Enforce ( newSize < TopBoxSizeLimit);
@@ -348,10 +513,18 @@ void MOOV_Manager::UpdateMemoryTree()
 		newOrigin = newPtr;
 	#endif
 	
-	XMP_Uns8 * trueEnd = this->AppendNewSubtree ( this->subtreeRootNode, "", newPtr, newEnd );
+	XMP_Uns8 * trueEnd = this->AppendNewSubtree ( this->subtreeRootNode, "", newPtr, newEnd, newPtr );
 	XMP_Enforce ( trueEnd == newEnd );
 	
+	// Keep the changed ranges through the parse of the new tree. A second update adds to them, they
+	// still cover every change since the first parse.
+	ChangedRangeList changedRanges;
+	changedRanges.swap ( this->changedRanges );
+
 	this->fullSubtree.swap ( newData );
 	this->ParseMemoryTree ( this->fileMode );
+
+	this->changedRanges.swap ( changedRanges );
+	this->MergeChangedRanges ( newSize );
 	
 }	// MOOV_Manager::UpdateMemoryTree
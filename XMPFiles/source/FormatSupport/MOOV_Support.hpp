@@ -55,9 +55,24 @@ public:
 	// ---------------------------------------------------------------------------------------------
 
 
+	// ---------------------------------------------------------------------------------------------
+	// ParseMemoryTree - Parse fullSubtree, clears the changed ranges.
+	// UpdateMemoryTree - Rebuild fullSubtree from the tree. The changed ranges then cover everything
+	// that differs from the parsed box, they are only useful if the 'moov' box kept its size.
+
 	void ParseMemoryTree ( XMP_Uns8 fileMode );
 	void UpdateMemoryTree();
 
+	// ---------------------------------------------------------------------------------------------
+	// ParseFileTree - A read-only alternative to filling in fullSubtree and calling ParseMemoryTree.
+	// The box hierarchy is read from the file, the content of bulky sample tables and similar boxes
+	// is left out of fullSubtree, see omittedContent. The 'moov' box may then be larger than the
+	// TopBoxSizeLimit, only what is kept in memory has to fit under it.
+	// IsParsed - True after ParseMemoryTree or ParseFileTree.
+
+	void ParseFileTree ( XMP_IO * fileRef, XMP_Uns64 moovOffset, XMP_Uns8 fileMode );
+	bool IsParsed() const { return (this->subtreeRootNode.boxType == ISOMedia::k_moov); };
+
 	// ---------------------------------------------------------------------------------------------
 
 	#pragma pack (push, 1)	// ! These must match the file layout!
@@ -139,9 +154,13 @@ private:
 	
 	void ParseNestedBoxes ( BoxNode * parentNode, const std::string & parentPath, bool ignoreMetaBoxes );
 
+	void ParseFileBoxes ( XMP_IO * fileRef, XMP_Uns64 moovOffset, BoxNode * parentNode,
+						  const std::string & parentPath, XMP_Uns32 * copiedSize );
+	void CopyFileContent ( XMP_IO * fileRef, XMP_Uns64 moovOffset, XMP_Uns32 * copiedSize, XMP_Uns32 copyLimit );
+
 	XMP_Uns32  NewSubtreeSize ( const BoxNode & node, const std::string & parentPath );
 	XMP_Uns8 * AppendNewSubtree ( const BoxNode & node, const std::string & parentPath,
-										 XMP_Uns8 * newPtr, XMP_Uns8 * newEnd );
+										 XMP_Uns8 * newPtr, XMP_Uns8 * newEnd, const XMP_Uns8 * newStart );
 
 };	// MOOV_Manager
 
@@ -371,8 +371,6 @@ void P2_SpannedClip::DigestElement( MD5_CTX & md5Context, XML_NodePtr legacyCont
 	}
 
 }	// P2_MetaHandler::DigestLegacyItem
-#define kHexDigits "0123456789ABCDEF"
-
 void P2_SpannedClip::CreateDigest ( std::string * digestStr )
 {
 	digestStr->erase();
@@ -472,13 +470,8 @@ void P2_SpannedClip::CreateDigest ( std::string * digestStr )
 
 	MD5Final ( digestBin, &md5Context );
 
-	char buffer [40];
-	for ( int in = 0, out = 0; in < 16; in += 1, out += 2 ) {
-		XMP_Uns8 byte = digestBin[in];
-		buffer[out]   = kHexDigits [ byte >> 4 ];
-		buffer[out+1] = kHexDigits [ byte & 0xF ];
-	}
-	buffer[32] = 0;
+	char buffer [33];
+	MD5DigestToHex ( digestBin, buffer );
 	digestStr->append ( buffer );
 
 }
@@ -12,76 +12,12 @@
 #include "XMPFiles/source/FormatSupport/PNG_Support.hpp"
 
 #include "source/XIO.hpp"
+#include "source/CRC32.hpp"
 
 #include <string.h>
 
 typedef std::basic_string<unsigned char> filebuffer;
 
-namespace CRC
-{
-    /* Table of CRCs of all 8-bit messages. */
-    static unsigned long crc_table[256];
-    
-    /* Flag: has the table been computed? Initially false. */
-    static int crc_table_computed = 0;
-    
-    /* Make the table for a fast CRC. */
-    static void make_crc_table(void)
-    {
-        unsigned long c;
-        int n, k;
-        
-        for (n = 0; n < 256; n++)
-        {
-            c = (unsigned long) n;
-            for (k = 0; k < 8; k++)
-            {
-                if (c & 1)
-                {
-                    c = 0xedb88320L ^ (c >> 1);
-                }
-                else
-                {
-                    c = c >> 1;
-                }
-            }
-            crc_table[n] = c;
-        }
-        crc_table_computed = 1;
-    }
-    
-    /* Update a running CRC with the bytes buf[0..len-1]--the CRC
-     should be initialized to all 1's, and the transmitted value
-     is the 1's complement of the final running CRC (see the
-     crc() routine below). */
-    
-    static unsigned long update_crc(unsigned long crc, unsigned char *buf, int len)
-    {
-        unsigned long c = crc;
-        int n;
-        
-        if (!crc_table_computed)
-        {
-            make_crc_table();
-        }
-        
-        for (n = 0; n < len; n++)
-        {
-            c = crc_table[(c ^ buf[n]) & 0xff] ^ (c >> 8);
-        }
-        
-        return c;
-    }
-    
-    /* Return the CRC of the bytes buf[0..len-1]. */
-#if 0
-    static unsigned long crc(unsigned char *buf, int len)
-    {
-        return update_crc(0xffffffffL, buf, len) ^ 0xffffffffL;
-    }
-#endif
-} // namespace CRC
-
 namespace PNG_Support
 {
     enum chunkType {
@@ -356,33 +292,28 @@ namespace PNG_Support
     bool WriteXMPChunk ( XMP_IO* fileRef, XMP_Uns32 len, const char* inBuffer )
     {
         bool ret = false;
-        XMP_Uns32 datalen = (4 + ITXT_HEADER_LEN + len);
-        unsigned char* buffer = new unsigned char[datalen];
         
         try
         {
-            size_t pos = 0;
-            memcpy(&buffer[pos], ITXT_CHUNK_TYPE, 4);
-            pos += 4;
-            memcpy(&buffer[pos], ITXT_HEADER_DATA, ITXT_HEADER_LEN);
-            pos += ITXT_HEADER_LEN;
-            memcpy(&buffer[pos], inBuffer, len);
+            // The CRC covers the type and data, it is run over the pieces as they are written.
             
-            XMP_Uns32 crc_value = MakeUns32BE( (XMP_Uns32)CalculateCRC( buffer, datalen ));
-            datalen -= 4;
-            XMP_Uns32 len_value = MakeUns32BE( datalen );
-            datalen += 4;
+            XMP_Uns32 crc = CRC32::Update ( 0, ITXT_CHUNK_TYPE, 4 );
+            crc = CRC32::Update ( crc, ITXT_HEADER_DATA, ITXT_HEADER_LEN );
+            crc = CRC32::Update ( crc, inBuffer, len );
+            
+            XMP_Uns32 crc_value = MakeUns32BE( crc );
+            XMP_Uns32 len_value = MakeUns32BE( ITXT_HEADER_LEN + len );
             
             fileRef->Write ( &len_value, 4 );
-            fileRef->Write ( buffer, datalen );
+            fileRef->Write ( ITXT_CHUNK_TYPE, 4 );
+            fileRef->Write ( ITXT_HEADER_DATA, ITXT_HEADER_LEN );
+            fileRef->Write ( inBuffer, len );
             fileRef->Write ( &crc_value, 4 );
             
             ret = true;
         }
         catch ( ... ) {}
         
-        delete [] buffer;
-        
         return ret;
     }
     
@@ -511,7 +442,7 @@ namespace PNG_Support
     
     unsigned long CalculateCRC( unsigned char* inBuffer, XMP_Uns32 len )
     {
-        return CRC::update_crc(0xffffffffL, inBuffer, len) ^ 0xffffffffL;
+        return CRC32::Compute ( inBuffer, len );
     }
     
 } // namespace PNG_Support
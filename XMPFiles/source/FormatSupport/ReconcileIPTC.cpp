@@ -64,11 +64,7 @@ static inline void NormalizeToLF ( std::string * value )
 
 static inline void ComputeIPTCDigest ( const void * iptcPtr, const XMP_Uns32 iptcLen, MD5_Digest * digest )
 {
-	MD5_CTX context;
-
-	MD5Init ( &context );
-	MD5Update ( &context, (XMP_Uns8*)iptcPtr, iptcLen );
-	MD5Final ( *digest, &context );
+	MD5Digest ( iptcPtr, iptcLen, *digest );
 
 }	// ComputeIPTCDigest;
 
@@ -34,6 +34,21 @@
 #define RestoreExifTag(ns,prop)	\
 	if ( savedExif.DoesPropertyExist ( ns, prop ) ) SXMPUtils::DuplicateSubtree ( savedExif, xmp, ns, prop )
 
+XMP_OptionBits ImportSkipOptions ( XMP_OptionBits openFlags )
+{
+	XMP_OptionBits skipOptions = 0;
+
+	if ( openFlags & kXMPFiles_OpenSkipExif ) skipOptions |= k2XMP_SkipExif;
+	if ( openFlags & kXMPFiles_OpenSkipIPTC ) skipOptions |= k2XMP_SkipIPTC;
+	if ( openFlags & kXMPFiles_OpenSkipPSIR ) skipOptions |= k2XMP_SkipPSIR;
+	if ( openFlags & kXMPFiles_OpenSkipDigests ) skipOptions |= k2XMP_SkipDigests;
+
+	return skipOptions;
+
+}	// ImportSkipOptions
+
+// =================================================================================================
+
 void ImportPhotoData ( const TIFF_Manager & exif,
 					   const IPTC_Manager & iptc,
 					   const PSIR_Manager & psir,
@@ -44,44 +59,55 @@ void ImportPhotoData ( const TIFF_Manager & exif,
 	/*bool haveXMP  = XMP_OptionIsSet ( options, k2XMP_FileHadXMP );*/
 	bool haveExif = XMP_OptionIsSet ( options, k2XMP_FileHadExif );
 	bool haveIPTC = XMP_OptionIsSet ( options, k2XMP_FileHadIPTC );
-	
-	// Save some new Exif writebacks that can be XMP-only from older versions, delete all of the
-	// XMP's tiff: and exif: namespaces (they should only reflect native Exif), then put back the
-	// saved writebacks (which might get replaced by the native Exif values in the Import calls).
-	// The value of exif:ISOSpeedRatings is saved for special case handling of ISO over 65535.
+	bool skipExif = XMP_OptionIsSet ( options, k2XMP_SkipExif );
+	bool skipIPTC = XMP_OptionIsSet ( options, k2XMP_SkipIPTC );
+	bool skipPSIR = XMP_OptionIsSet ( options, k2XMP_SkipPSIR );
 
-	bool haveOldExif = true;	// Default to old Exif if no version tag.
-	TIFF_Manager::TagInfo tagInfo;
-	bool found = exif.GetTag ( kTIFF_ExifIFD, kTIFF_ExifVersion, &tagInfo );
-	if ( found && (tagInfo.type == kTIFF_UndefinedType) && (tagInfo.count == 4) ) {
-		haveOldExif = (strncmp ( (char*)tagInfo.dataPtr, "0230", 4 ) < 0);
-	}
-	
-	SXMPMeta savedExif;
-	
-	SaveExifTag ( kXMP_NS_EXIF, "DateTimeOriginal" );
-	SaveExifTag ( kXMP_NS_EXIF, "GPSLatitude" );
-	SaveExifTag ( kXMP_NS_EXIF, "GPSLongitude" );
-	SaveExifTag ( kXMP_NS_EXIF, "GPSTimeStamp" );
-	SaveExifTag ( kXMP_NS_EXIF, "GPSAltitude" );
-	SaveExifTag ( kXMP_NS_EXIF, "GPSAltitudeRef" );
-	SaveExifTag ( kXMP_NS_EXIF, "ISOSpeedRatings" );
-	
-	SXMPUtils::RemoveProperties ( xmp, kXMP_NS_TIFF, 0, kXMPUtil_DoAllProperties );
-	SXMPUtils::RemoveProperties ( xmp, kXMP_NS_EXIF, 0, kXMPUtil_DoAllProperties );
-	if ( ! haveOldExif ) SXMPUtils::RemoveProperties ( xmp, kXMP_NS_ExifEX, 0, kXMPUtil_DoAllProperties );
+	if ( skipExif ) haveExif = false;
+	if ( skipIPTC ) haveIPTC = false;
+	if ( skipExif & skipIPTC & skipPSIR ) return;	// Nothing to reconcile, keep the XMP as it is.
 
-	RestoreExifTag ( kXMP_NS_EXIF, "DateTimeOriginal" );
-	RestoreExifTag ( kXMP_NS_EXIF, "GPSLatitude" );
-	RestoreExifTag ( kXMP_NS_EXIF, "GPSLongitude" );
-	RestoreExifTag ( kXMP_NS_EXIF, "GPSTimeStamp" );
-	RestoreExifTag ( kXMP_NS_EXIF, "GPSAltitude" );
-	RestoreExifTag ( kXMP_NS_EXIF, "GPSAltitudeRef" );
-	RestoreExifTag ( kXMP_NS_EXIF, "ISOSpeedRatings" );
+	if ( ! skipExif ) {
+
+		// Save some new Exif writebacks that can be XMP-only from older versions, delete all of the
+		// XMP's tiff: and exif: namespaces (they should only reflect native Exif), then put back the
+		// saved writebacks (which might get replaced by the native Exif values in the Import calls).
+		// The value of exif:ISOSpeedRatings is saved for special case handling of ISO over 65535.
+
+		bool haveOldExif = true;	// Default to old Exif if no version tag.
+		TIFF_Manager::TagInfo tagInfo;
+		bool found = exif.GetTag ( kTIFF_ExifIFD, kTIFF_ExifVersion, &tagInfo );
+		if ( found && (tagInfo.type == kTIFF_UndefinedType) && (tagInfo.count == 4) ) {
+			haveOldExif = (strncmp ( (char*)tagInfo.dataPtr, "0230", 4 ) < 0);
+		}
+
+		SXMPMeta savedExif;
+
+		SaveExifTag ( kXMP_NS_EXIF, "DateTimeOriginal" );
+		SaveExifTag ( kXMP_NS_EXIF, "GPSLatitude" );
+		SaveExifTag ( kXMP_NS_EXIF, "GPSLongitude" );
+		SaveExifTag ( kXMP_NS_EXIF, "GPSTimeStamp" );
+		SaveExifTag ( kXMP_NS_EXIF, "GPSAltitude" );
+		SaveExifTag ( kXMP_NS_EXIF, "GPSAltitudeRef" );
+		SaveExifTag ( kXMP_NS_EXIF, "ISOSpeedRatings" );
+
+		SXMPUtils::RemoveProperties ( xmp, kXMP_NS_TIFF, 0, kXMPUtil_DoAllProperties );
+		SXMPUtils::RemoveProperties ( xmp, kXMP_NS_EXIF, 0, kXMPUtil_DoAllProperties );
+		if ( ! haveOldExif ) SXMPUtils::RemoveProperties ( xmp, kXMP_NS_ExifEX, 0, kXMPUtil_DoAllProperties );
+
+		RestoreExifTag ( kXMP_NS_EXIF, "DateTimeOriginal" );
+		RestoreExifTag ( kXMP_NS_EXIF, "GPSLatitude" );
+		RestoreExifTag ( kXMP_NS_EXIF, "GPSLongitude" );
+		RestoreExifTag ( kXMP_NS_EXIF, "GPSTimeStamp" );
+		RestoreExifTag ( kXMP_NS_EXIF, "GPSAltitude" );
+		RestoreExifTag ( kXMP_NS_EXIF, "GPSAltitudeRef" );
+		RestoreExifTag ( kXMP_NS_EXIF, "ISOSpeedRatings" );
+
+	}
 
 	// Not obvious here, but the logic in PhotoDataUtils follows the MWG reader guidelines.
 	
-	PhotoDataUtils::ImportPSIR ( psir, xmp, iptcDigestState );
+	if ( ! skipPSIR ) PhotoDataUtils::ImportPSIR ( psir, xmp, iptcDigestState );
 
 	if ( haveIPTC ) PhotoDataUtils::Import2WayIPTC ( iptc, xmp, iptcDigestState );
 	if ( haveExif ) PhotoDataUtils::Import2WayExif ( exif, xmp, iptcDigestState );
@@ -90,7 +116,7 @@ void ImportPhotoData ( const TIFF_Manager & exif,
 
 	// If photoshop:DateCreated does not exist try to create it from exif:DateTimeOriginal.
 	
-	if ( ! xmp->DoesPropertyExist ( kXMP_NS_Photoshop, "DateCreated" ) ) {
+	if ( (! skipExif) && (! xmp->DoesPropertyExist ( kXMP_NS_Photoshop, "DateCreated" )) ) {
 		std::string exifValue;
 		bool haveExifDTO = xmp->GetProperty ( kXMP_NS_EXIF, "DateTimeOriginal", &exifValue, 0 );
 		if ( haveExifDTO ) xmp->SetProperty ( kXMP_NS_Photoshop, "DateCreated", exifValue.c_str() );
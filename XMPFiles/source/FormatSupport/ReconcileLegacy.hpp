@@ -32,9 +32,17 @@
 enum {	// Bits for the options to ImportJTPtoXMP.
 	k2XMP_FileHadXMP  = 0x0001,	// Set if the file had an XMP packet.
 	k2XMP_FileHadIPTC = 0x0002,	// Set if the file had legacy IPTC.
-	k2XMP_FileHadExif = 0x0004	// Set if the file had legacy Exif.
+	k2XMP_FileHadExif = 0x0004,	// Set if the file had legacy Exif.
+	k2XMP_SkipExif    = 0x0010,	// Leave the tiff: and exif: XMP alone, the Exif was not parsed.
+	k2XMP_SkipIPTC    = 0x0020,	// The IPTC was not parsed.
+	k2XMP_SkipPSIR    = 0x0040,	// The image resources were not parsed.
+	k2XMP_SkipDigests = 0x0080	// The IPTC digest was not checked, only used by the handlers.
 };
 
+// The k2XMP_Skip bits for the kXMPFiles_OpenSkip bits of the open flags.
+
+extern XMP_OptionBits ImportSkipOptions ( XMP_OptionBits openFlags );
+
 extern void ImportPhotoData ( const TIFF_Manager & exif,
 						 	  const IPTC_Manager & iptc,
 							  const PSIR_Manager & psir,
@@ -38,9 +38,6 @@ static void CharacterDataHandler( void * userData, XMP_StringPtr cData, int len
 static void ProcessingInstructionHandler( void * userData, XMP_StringPtr target, XMP_StringPtr data );
 static void DeclarationHandler( void *userData, const XML_Char  *version, const XML_Char  *encoding, int standalone );
 
-static bool isRequireData = false;
-static XMP_Uns32 reqDepth = 0;
-
 // Flag is provided to support behaviour like Expat Adapter
 #if BanAllEntityUsage
 
@@ -59,7 +56,7 @@ static void StartDoctypeDeclHandler( void * userData, XMP_StringPtr doctypeName,
 
 // =================================================================================================
 
-SVG_Adapter::SVG_Adapter() : parser(0), registeredNamespaces(0), firstSVGElementOffset(-1), depth(0)
+SVG_Adapter::SVG_Adapter() : parser(0), registeredNamespaces(0), firstSVGElementOffset(-1), depth(0), isRequireData(false), reqDepth(0)
 {
 	
 	this->parser = XML_ParserCreateNS( 0, FullNameSeparator );
@@ -348,14 +345,14 @@ static void StartElementHandler( void * userData, XMP_StringPtr name, XMP_String
 
 	if ( iterator != thiz->mOffsetsMap.end() && iterator->second.parent == parentNode->name )
 	{
-		reqDepth = thiz->depth;
-		isRequireData = true;
+		thiz->reqDepth = thiz->depth;
+		thiz->isRequireData = true;
 		if ( iterator->second.startOffset == -1 )
 			iterator->second.startOffset = XML_GetCurrentByteIndex( thiz->parser );
 	}
 	else
 	{
-		isRequireData = false;
+		thiz->isRequireData = false;
 	}
 
 }	// StartElementHandler
@@ -382,7 +379,7 @@ static void EndElementHandler( void * userData, XMP_StringPtr name )
 		// StartOffset flag is provided to reject the elements of non-required namespace 
 		// Endoffset flag is provided to maintain state of first available element
 		// Depth flag is provided to support for workflow like <title><title>...</title></title>
-		if ( iterator->second.startOffset != -1 && iterator->second.endOffset == -1 && thiz->depth == reqDepth - 1 )
+		if ( iterator->second.startOffset != -1 && iterator->second.endOffset == -1 && thiz->depth == thiz->reqDepth - 1 )
 		{
 			iterator->second.endOffset = XML_GetCurrentByteIndex( thiz->parser );
 			thiz->mPrevRequiredElement = localName;
@@ -399,10 +396,10 @@ static void EndElementHandler( void * userData, XMP_StringPtr name )
 
 static void CharacterDataHandler( void * userData, XMP_StringPtr cData, int len )
 {
-	if ( !isRequireData )
-		return;
-	isRequireData = false;
 	SVG_Adapter * thiz = ( SVG_Adapter* ) userData;
+	if ( !thiz->isRequireData )
+		return;
+	thiz->isRequireData = false;
 
 	if ( ( cData == 0 ) || ( len == 0 ) ) { cData = ""; len = 0; }
 
@@ -74,6 +74,9 @@ public:
 
 	std::string mPrevRequiredElement;
 	XMP_Uns32 depth;	
+
+	bool isRequireData;	// Set when the character data of a registered element is wanted.
+	XMP_Uns32 reqDepth;	// The depth of that element.
 };
 
 // =================================================================================================
@@ -278,6 +278,237 @@ XMP_Int64 SWF_IO::CompressMemoryToFile ( const RawDataBlock & dataIn, XMP_IO*  f
 
 // =================================================================================================
 
+static const size_t kStreamBufferSize = 64*1024;
+
+SWF_IO::ExpandedReader::ExpandedReader ( XMP_IO * _fileIn )
+	: fileIn(_fileIn), isCompressed(false), streamEnded(false), offset(0)
+{
+
+	memset ( &this->zipState, 0, sizeof(this->zipState) );
+
+	const XMP_Int64 lengthIn = this->fileIn->Length();
+	XMP_Enforce ( ((XMP_Int64)SWF_IO::HeaderPrefixSize <= lengthIn) && (lengthIn <= SWF_IO::MaxExpandedSize) );
+
+	// The uncompressed part of the header is the start of the expanded stream in both cases.
+
+	this->fileIn->Rewind();
+	this->fileIn->ReadAll ( this->prefix, SWF_IO::HeaderPrefixSize );
+
+	XMP_Uns32 signature = GetUns32LE ( &this->prefix[0] ) & 0xFFFFFF;	// Discard the version byte.
+	this->isCompressed = (signature == SWF_IO::CompressedSignature);
+
+	if ( this->isCompressed ) {
+		int err = inflateInit ( &this->zipState );
+		XMP_Enforce ( err == Z_OK );
+		this->bufferIn.assign ( kStreamBufferSize, 0 );
+	}
+
+}	// SWF_IO::ExpandedReader::ExpandedReader
+
+// =================================================================================================
+
+SWF_IO::ExpandedReader::~ExpandedReader()
+{
+
+	if ( this->isCompressed ) inflateEnd ( &this->zipState );
+
+}	// SWF_IO::ExpandedReader::~ExpandedReader
+
+// =================================================================================================
+
+XMP_Uns32 SWF_IO::ExpandedReader::Read ( void * dataOut, XMP_Uns32 count )
+{
+	XMP_Uns8 * bytesOut = (XMP_Uns8*)dataOut;
+	XMP_Uns32 total = 0;
+
+	for ( ; (this->offset < SWF_IO::HeaderPrefixSize) && (total < count); ++total, ++this->offset ) {
+		bytesOut[total] = this->prefix[this->offset];
+	}
+
+	if ( ! this->isCompressed ) {
+
+		while ( total < count ) {
+			XMP_Uns32 ioCount = this->fileIn->Read ( &bytesOut[total], (count - total) );
+			if ( ioCount == 0 ) break;
+			total += ioCount;
+			this->offset += ioCount;
+		}
+
+	} else {
+
+		// Inflate directly into the caller's buffer. A truncated compressed stream just ends early,
+		// the same as DecompressFileToMemory.
+
+		this->zipState.next_out  = &bytesOut[total];
+		this->zipState.avail_out = count - total;
+
+		while ( (this->zipState.avail_out > 0) && (! this->streamEnded) ) {
+
+			if ( this->zipState.avail_in == 0 ) {
+				XMP_Uns32 ioCount = this->fileIn->Read ( &this->bufferIn[0], (XMP_Uns32)this->bufferIn.size() );
+				if ( ioCount == 0 ) break;
+				this->zipState.next_in  = &this->bufferIn[0];
+				this->zipState.avail_in = ioCount;
+			}
+
+			int err = inflate ( &this->zipState, Z_NO_FLUSH );
+			XMP_Enforce ( (err == Z_OK) || (err == Z_STREAM_END) );
+			if ( err == Z_STREAM_END ) this->streamEnded = true;
+
+		}
+
+		XMP_Uns32 ioCount = (count - total) - this->zipState.avail_out;
+		total += ioCount;
+		this->offset += ioCount;
+
+	}
+
+	return total;
+
+}	// SWF_IO::ExpandedReader::Read
+
+// =================================================================================================
+
+XMP_Uns32 SWF_IO::ExpandedReader::Skip ( XMP_Uns32 count )
+{
+	XMP_Uns8 buffer [16*1024];
+	XMP_Uns32 total = 0;
+
+	while ( total < count ) {
+		XMP_Uns32 ioCount = count - total;
+		if ( ioCount > sizeof(buffer) ) ioCount = sizeof(buffer);
+		ioCount = this->Read ( buffer, ioCount );
+		if ( ioCount == 0 ) break;
+		total += ioCount;
+	}
+
+	return total;
+
+}	// SWF_IO::ExpandedReader::Skip
+
+// =================================================================================================
+
+SWF_IO::ExpandedWriter::ExpandedWriter ( XMP_IO * _fileOut, bool _compress )
+	: fileOut(_fileOut), compress(_compress), offset(0)
+{
+
+	memset ( &this->zipState, 0, sizeof(this->zipState) );
+
+	this->fileOut->Rewind();
+	this->fileOut->Truncate ( 0 );
+
+	if ( this->compress ) {
+		int err = deflateInit ( &this->zipState, Z_DEFAULT_COMPRESSION );
+		XMP_Enforce ( err == Z_OK );
+		this->bufferOut.assign ( kStreamBufferSize, 0 );
+		this->zipState.next_out  = &this->bufferOut[0];
+		this->zipState.avail_out = (uInt)this->bufferOut.size();
+	}
+
+}	// SWF_IO::ExpandedWriter::ExpandedWriter
+
+// =================================================================================================
+
+SWF_IO::ExpandedWriter::~ExpandedWriter()
+{
+
+	if ( this->compress ) deflateEnd ( &this->zipState );
+
+}	// SWF_IO::ExpandedWriter::~ExpandedWriter
+
+// =================================================================================================
+
+void SWF_IO::ExpandedWriter::WriteCompressed ( int flush )
+{
+	int err;
+
+	do {
+
+		err = deflate ( &this->zipState, flush );
+		XMP_Enforce ( (err == Z_OK) || (err == Z_STREAM_END) || (err == Z_BUF_ERROR) );
+
+		XMP_Uns32 ioCount = (XMP_Uns32)this->bufferOut.size() - this->zipState.avail_out;
+		if ( (this->zipState.avail_out == 0) || ((flush == Z_FINISH) && (ioCount > 0)) ) {
+			this->fileOut->Write ( &this->bufferOut[0], ioCount );
+			this->zipState.next_out  = &this->bufferOut[0];
+			this->zipState.avail_out = (uInt)this->bufferOut.size();
+		}
+
+	} while ( (flush == Z_FINISH) ? (err != Z_STREAM_END) : (this->zipState.avail_in > 0) );
+
+}	// SWF_IO::ExpandedWriter::WriteCompressed
+
+// =================================================================================================
+
+void SWF_IO::ExpandedWriter::Write ( const void * dataIn, XMP_Uns32 count )
+{
+	const XMP_Uns8 * bytesIn = (const XMP_Uns8*)dataIn;
+	XMP_Enforce ( count <= (SWF_IO::MaxExpandedSize - this->offset) );
+
+	// The uncompressed part of the header is written as is.
+
+	if ( this->offset < SWF_IO::HeaderPrefixSize ) {
+		XMP_Uns32 prefixCount = SWF_IO::HeaderPrefixSize - this->offset;
+		if ( prefixCount > count ) prefixCount = count;
+		this->fileOut->Write ( bytesIn, prefixCount );
+		this->offset += prefixCount;
+		bytesIn += prefixCount;
+		count -= prefixCount;
+	}
+
+	if ( count == 0 ) return;
+	this->offset += count;
+
+	if ( ! this->compress ) {
+		this->fileOut->Write ( bytesIn, count );
+	} else {
+		this->zipState.next_in  = (Bytef*)bytesIn;
+		this->zipState.avail_in = count;
+		this->WriteCompressed ( Z_NO_FLUSH );
+	}
+
+}	// SWF_IO::ExpandedWriter::Write
+
+// =================================================================================================
+
+XMP_Uns32 SWF_IO::ExpandedWriter::Finish()
+{
+	XMP_Enforce ( this->offset >= SWF_IO::HeaderPrefixSize );
+
+	if ( this->compress ) this->WriteCompressed ( Z_FINISH );
+
+	XMP_Uns8 buffer [4];
+	PutUns32LE ( this->offset, &buffer[0] );
+	this->fileOut->Seek ( 4, kXMP_SeekFromStart );
+	this->fileOut->Write ( buffer, 4 );
+	this->fileOut->ToEOF();
+
+	return this->offset;
+
+}	// SWF_IO::ExpandedWriter::Finish
+
+// =================================================================================================
+
+XMP_Uns32 SWF_IO::CopyExpanded ( ExpandedReader * swfIn, ExpandedWriter * swfOut, XMP_Uns32 count )
+{
+	XMP_Uns8 buffer [16*1024];
+	XMP_Uns32 total = 0;
+
+	while ( total < count ) {
+		XMP_Uns32 ioCount = count - total;
+		if ( ioCount > sizeof(buffer) ) ioCount = sizeof(buffer);
+		ioCount = swfIn->Read ( buffer, ioCount );
+		if ( ioCount == 0 ) break;
+		swfOut->Write ( buffer, ioCount );
+		total += ioCount;
+	}
+
+	return total;
+
+}	// SWF_IO::CopyExpanded
+
+// =================================================================================================
+
 #if 0	// ! Not used, but save it for later transfer to a general ZIP utility file.
 
 XMP_Int64 SWF_IO::DecompressFileToFile ( XMP_IO * fileIn, XMP_IO * fileOut ) {
@@ -80,6 +80,71 @@ namespace SWF_IO {
 	
 	XMP_Int64 DecompressFileToMemory ( XMP_IO * fileIn, RawDataBlock * dataOut );
 	XMP_Int64 CompressMemoryToFile ( const RawDataBlock & dataIn, XMP_IO*  fileOut );
+
+	// ---------------------------------------------------------------------------------------------
+	// ExpandedReader - Sequential reading of the expanded SWF stream from the start of a file. A
+	// compressed file is inflated a block at a time as it is read, nothing else is kept in memory.
+	// Offsets are within the expanded stream, the same as offsets into DecompressFileToMemory
+	// output. Read and Skip return less than the count only at the end of the stream.
+
+	class ExpandedReader {
+	public:
+
+		ExpandedReader ( XMP_IO * fileIn );
+		~ExpandedReader();
+
+		bool IsCompressed() const { return this->isCompressed; };
+		XMP_Uns32 Offset() const { return this->offset; };
+
+		XMP_Uns32 Read ( void * dataOut, XMP_Uns32 count );
+		XMP_Uns32 Skip ( XMP_Uns32 count );
+
+	private:
+
+		XMP_IO * fileIn;
+		bool isCompressed, streamEnded;
+		XMP_Uns32 offset;
+		XMP_Uns8 prefix [HeaderPrefixSize];
+		z_stream zipState;
+		RawDataBlock bufferIn;
+
+		ExpandedReader() {};	// Hidden on purpose.
+
+	};
+
+	// ---------------------------------------------------------------------------------------------
+	// ExpandedWriter - Sequential writing of an expanded SWF stream to a file, deflating it as it is
+	// written if compress is true. The stream must start with the file header, the first 8 bytes
+	// are written as is. Finish flushes the compression, sets the expanded length in the file
+	// header, and returns that length.
+
+	class ExpandedWriter {
+	public:
+
+		ExpandedWriter ( XMP_IO * fileOut, bool compress );
+		~ExpandedWriter();
+
+		void Write ( const void * dataIn, XMP_Uns32 count );
+		XMP_Uns32 Finish();
+
+	private:
+
+		XMP_IO * fileOut;
+		bool compress;
+		XMP_Uns32 offset;
+		z_stream zipState;
+		RawDataBlock bufferOut;
+
+		void WriteCompressed ( int flush );
+
+		ExpandedWriter() {};	// Hidden on purpose.
+
+	};
+
+	// CopyExpanded - Copy count bytes from an ExpandedReader to an ExpandedWriter, returns the count
+	// copied. Less is copied only at the end of the input.
+
+	XMP_Uns32 CopyExpanded ( ExpandedReader * swfIn, ExpandedWriter * swfOut, XMP_Uns32 count );
 	
 };	// SWF_IO
 
@@ -219,6 +219,7 @@ void TIFF_FileWriter::SetTag ( XMP_Uns8 ifd, XMP_Uns16 id, XMP_Uns16 type, XMP_U
 
 		tagPtr->type  = type;	// These might be changing also.
 		tagPtr->count = count;
+		tagPtr->fileBased = this->fileParsed;	// A value from the data pool is replaced by an owned one.
 
 	}
 
@@ -851,8 +852,7 @@ void TIFF_FileWriter::ParseFileStream ( XMP_IO* fileRef )
 
 XMP_Uns32 TIFF_FileWriter::ProcessFileIFD ( XMP_Uns8 ifd, XMP_Uns32 ifdOffset, XMP_IO* fileRef )
 {
-	static const size_t ifdBufferSize = 12*65536;	// Enough for the largest possible IFD.
-    std::vector<XMP_Uns8> ifdBuffer(ifdBufferSize);
+	std::vector<XMP_Uns8> ifdBuffer;	// Sized for the actual IFD entries.
 	XMP_Uns8 intBuffer [4];	// For the IFD count and offset to next IFD.
 	
 	InternalIFDInfo& ifdInfo ( this->containedIFDs[ifd] );
@@ -868,6 +868,7 @@ XMP_Uns32 TIFF_FileWriter::ProcessFileIFD ( XMP_Uns8 ifd, XMP_Uns32 ifdOffset, X
 	XMP_Uns16 tagCount1 = this->GetUns16 ( intBuffer );
 	if ( tagCount1 >= 0x8000 ) return 0;	// Maybe wrong byte order.
 	if ( ! XIO::CheckFileSpace ( fileRef, 12*tagCount1 ) ) return 0;	// Bail for a truncated file.
+	ifdBuffer.assign ( (12*tagCount1 + 1), 0 );	// ! The extra byte keeps &ifdBuffer[0] valid for an empty IFD.
 	fileRef->ReadAll ( &ifdBuffer[0], 12*tagCount1 );
 
 	if ( ! XIO::CheckFileSpace ( fileRef, 4 ) ) {
@@ -924,26 +925,43 @@ XMP_Uns32 TIFF_FileWriter::ProcessFileIFD ( XMP_Uns8 ifd, XMP_Uns32 ifdOffset, X
 	}
 
 	// ------------------------------------------------------------------------
-	// Go back over the tag map and extract the data for large recognized tags.
+	// Go back over the tag map and extract the data for large recognized tags. The values all go
+	// into one data pool for the IFD, sized by a first pass. Large unrecognized tags such as the
+	// MakerNote or the strip offsets are never read, they are copied from the file if needed.
 
-	InternalTagMap::iterator tagPos = ifdInfo.tagMap.begin();
+	InternalTagMap::iterator tagPos;
 	InternalTagMap::iterator tagEnd = ifdInfo.tagMap.end();
 
 	const XMP_Uns16* knownTagPtr = sKnownTags[ifd];	// Points into the ordered recognized tag list.
+	size_t poolSize = 0;
 
-	for ( ; tagPos != tagEnd; ++tagPos ) {
-
+	for ( tagPos = ifdInfo.tagMap.begin(); tagPos != tagEnd; ++tagPos ) {
 		InternalTagInfo* currTag = &tagPos->second;
-
 		if ( currTag->dataLen <= 4 ) continue;	// Short values are already in the smallValue field.
-
 		while ( *knownTagPtr < currTag->id ) ++knownTagPtr;
 		if ( *knownTagPtr != currTag->id ) continue;	// Skip unrecognized tags.
+		poolSize += currTag->dataLen;
+	}
+
+	if ( poolSize == 0 ) return ifdInfo.origNextIFD;
+	ifdInfo.dataPool.assign ( poolSize, 0 );
+	XMP_Uns8* poolPtr = &ifdInfo.dataPool[0];
+
+	knownTagPtr = sKnownTags[ifd];
+
+	for ( tagPos = ifdInfo.tagMap.begin(); tagPos != tagEnd; ++tagPos ) {
+
+		InternalTagInfo* currTag = &tagPos->second;
+
+		if ( currTag->dataLen <= 4 ) continue;
+		while ( *knownTagPtr < currTag->id ) ++knownTagPtr;
+		if ( *knownTagPtr != currTag->id ) continue;
 
 		fileRef->Seek ( currTag->origDataOffset, kXMP_SeekFromStart );
-		currTag->dataPtr = (XMP_Uns8*) malloc ( currTag->dataLen );
-		if ( currTag->dataPtr == 0 ) XMP_Throw ( "No data block", kXMPErr_NoMemory );
-		fileRef->ReadAll ( currTag->dataPtr, currTag->dataLen );
+		fileRef->ReadAll ( poolPtr, currTag->dataLen );
+		currTag->dataPtr = poolPtr;
+		currTag->fileBased = false;	// The value is owned by the data pool, like a memory-based value.
+		poolPtr += currTag->dataLen;
 
 	}
 
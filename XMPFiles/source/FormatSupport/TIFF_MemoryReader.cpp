@@ -27,8 +27,9 @@
 /// one for each IFD, plus one for the collected non-local data for each IFD. Otherwise the logic
 /// is the same in both cases.
 ///
-/// The count for each IFD is extracted and a pointer set to the first entry in each IFD (serving as
-/// a normal C array pointer). The IFD entries are tweaked as follows:
+/// The count for each IFD is extracted and the IFD entries are copied to a block owned by the reader,
+/// with a pointer set to the first entry (serving as a normal C array pointer). The TIFF stream itself
+/// is never modified, so it can be parsed in place. The copied IFD entries are tweaked as follows:
 ///
 /// \li The id and type fields are converted to native values.
 /// \li The count field is converted to a native byte count.
@@ -545,11 +546,13 @@ void TIFF_MemoryReader::ParseMemoryStream ( const void* data, XMP_Uns32 length,
 	for ( size_t i = 0; i < kTIFF_KnownIFDCount; ++i ) {
 		this->containedIFDs[i].count = 0;
 		this->containedIFDs[i].entries = 0;
+		this->containedIFDs[i].ownedEntries.clear();
 	}
 
 	if ( length == 0 ) return;
 
-	// Allocate space for the full in-memory stream and copy it.
+	// Use the caller's stream directly, or allocate space for the full in-memory stream and copy
+	// it. The stream is only read, the IFD entries are tweaked in a copy.
 
 	if ( ! copyData ) {
 		XMP_Assert ( ! this->ownedStream );
@@ -654,9 +657,8 @@ XMP_Uns32 TIFF_MemoryReader::ProcessOneIFD ( XMP_Uns32 ifdOffset, XMP_Uns8 ifd,
 		}
 	}
 
-	XMP_Uns8* ifdPtr = this->tiffStream + ifdOffset;
+	const XMP_Uns8* ifdPtr = this->tiffStream + ifdOffset;
 	XMP_Uns16 ifdCount = this->GetUns16 ( ifdPtr );
-	TweakedIFDEntry* ifdEntries = (TweakedIFDEntry*)(ifdPtr+2);
 
 	if ( ifdCount >= 0x8000 ) {
 		XMP_Error error(kXMPErr_BadTIFF, "Outrageous IFD count" );
@@ -668,6 +670,11 @@ XMP_Uns32 TIFF_MemoryReader::ProcessOneIFD ( XMP_Uns32 ifdOffset, XMP_Uns8 ifd,
 		this->NotifyClient ( kXMPErrSev_FileFatal, error );
 	}
 
+	// Copy the entries, the tweaks and the sort must not touch the stream.
+	ifdInfo.ownedEntries.resize ( ifdCount + 1 );	// ! The extra entry keeps &ownedEntries[0] valid for an empty IFD.
+	memcpy ( &ifdInfo.ownedEntries[0], (ifdPtr+2), 12*ifdCount );	// AUDIT: Safe, the IFD bounds are checked above.
+	TweakedIFDEntry* ifdEntries = &ifdInfo.ownedEntries[0];
+
 	ifdInfo.count = ifdCount;
 	ifdInfo.entries = ifdEntries;
 
@@ -30,7 +30,17 @@ static const char * kTIFF_TypeNames[] = { "ShortOrLong", "BYTE", "ASCII", "SHORT
 // TIFF_Manager::TIFF_Manager
 // ==========================
 
-static bool sFirstCTor = true;
+#if XMP_DebugBuild
+static bool CheckKnownTags()
+{
+	for ( int ifd = 0; ifd < kTIFF_KnownIFDCount; ++ifd ) {	// Make sure the known tag arrays are sorted.
+		for ( const XMP_Uns16* idPtr = sKnownTags[ifd]; *idPtr != 0xFFFF; ++idPtr ) {
+			XMP_Assert ( *idPtr < *(idPtr+1) );
+		}
+	}
+	return true;
+}
+#endif
 
 TIFF_Manager::TIFF_Manager()
 	: GetUns16(0), GetUns32(0), GetFloat(0), GetDouble(0),
@@ -38,16 +48,10 @@ TIFF_Manager::TIFF_Manager()
 	  bigEndian(false), nativeEndian(false), errorCallbackPtr( NULL )
 {
 
-	if ( sFirstCTor ) {
-		sFirstCTor = false;
-		#if XMP_DebugBuild
-			for ( int ifd = 0; ifd < kTIFF_KnownIFDCount; ++ifd ) {	// Make sure the known tag arrays are sorted.
-				for ( const XMP_Uns16* idPtr = sKnownTags[ifd]; *idPtr != 0xFFFF; ++idPtr ) {
-					XMP_Assert ( *idPtr < *(idPtr+1) );
-				}
-			}
-		#endif
-	}
+	#if XMP_DebugBuild
+		static bool sKnownTagsChecked = CheckKnownTags();	// ! Once, even with concurrent first calls.
+		(void)sKnownTagsChecked;
+	#endif
 
 }	// TIFF_Manager::TIFF_Manager
 
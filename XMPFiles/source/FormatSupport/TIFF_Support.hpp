@@ -13,6 +13,7 @@
 #include "public/include/XMP_Environment.h"	// ! This must be the first include.
 
 #include <map>
+#include <vector>
 #include <stdlib.h>
 #include <string.h>
 
@@ -775,10 +776,12 @@ private:
 	XMP_Uns8* tiffStream;
 	XMP_Uns32 tiffLength;
 
-	// Memory usage notes: TIFF_MemoryReader is for memory-based read-only usage (both apply). There
-	// is no need to ever allocate separate blocks of memory, everything is used directly from the
-	// TIFF stream. Data pointers are computed on the fly, the offset field is 4 bytes and pointers
-	// will be 8 bytes for 64-bit platforms.
+	// Memory usage notes: TIFF_MemoryReader is for memory-based read-only usage (both apply). The
+	// tag values are used directly from the TIFF stream, which is never modified. It can be borrowed
+	// from the caller (copyData false), it must then outlive the reader. Only the IFD entries are
+	// copied, into a small block per IFD, so they can be tweaked and sorted. Data pointers are
+	// computed on the fly, the offset field is 4 bytes and pointers will be 8 bytes for 64-bit
+	// platforms.
 
 	struct TweakedIFDEntry {	// ! Most fields are in native byte order, dataOrPos is for offsets only.
 		XMP_Uns16 id;
@@ -790,7 +793,8 @@ private:
 
 	struct TweakedIFDInfo {
 		XMP_Uns16 count;
-		TweakedIFDEntry* entries;
+		TweakedIFDEntry* entries;	// Points into ownedEntries.
+		std::vector<TweakedIFDEntry> ownedEntries;
 		TweakedIFDInfo() : count(0), entries(0) {};
 	};
 
@@ -900,10 +904,11 @@ private:
 
 	// Memory usage notes: TIFF_FileWriter is for file-based OR read/write usage. For memory-based
 	// streams the dataPtr is initially into the stream, regardless of size. For file-based streams
-	// the dataPtr is initially a separate allocation for large values (over 4 bytes), and points to
-	// the smallValue field for small values. This is also the usage when a tag is changed (for both
-	// memory and file cases), the dataPtr is a separate allocation for large values (over 4 bytes),
-	// and points to the smallValue field for small values.
+	// the dataPtr is initially into the IFD's data pool for large values (over 4 bytes), and points
+	// to the smallValue field for small values. Pooled values are marked as not file-based so they
+	// are not freed. When a tag is changed (for both memory and file cases), the dataPtr is a
+	// separate allocation for large values (over 4 bytes), and points to the smallValue field for
+	// small values.
 
 	// ! The working data values are always stream endian, no matter where stored. They are flipped
 	// ! as necessary by GetTag and SetTag.
@@ -964,6 +969,7 @@ private:
 		XMP_Uns32 origIFDOffset;	// Original stream offset of the IFD.
 		XMP_Uns32 origNextIFD;		// Original stream offset of the following IFD.
 		InternalTagMap tagMap;
+		std::vector<XMP_Uns8> dataPool;	// The large file-based values read by ProcessFileIFD.
 		InternalIFDInfo() : changed(false), origCount(0), origIFDOffset(0), origNextIFD(0) {};
 		inline void clear()
 		{
@@ -971,6 +977,7 @@ private:
 			this->origCount = 0;
 			this->origIFDOffset = this->origNextIFD = 0;
 			this->tagMap.clear();
+			this->dataPool.clear();
 		};
 	};
 
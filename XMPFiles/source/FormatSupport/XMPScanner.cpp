@@ -27,6 +27,7 @@
 #include <cassert>
 #include <string>
 #include <cstdlib>
+#include <cstring>
 
 #if DEBUG
 	#include <iostream>
@@ -44,10 +45,120 @@
 	#define UseStringPushBack	0
 #endif
 
+#include "source/SIMDUtils.hpp"
+
+#if XMP_HasSSE2 && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+	#define ScannerHasAVX2	1	// Compiled with a target attribute, used if the CPU has it.
+	#include <immintrin.h>
+#else
+	#define ScannerHasAVX2	0
+#endif
+
 using namespace std;
 
 #if EnablePacketScanning
 
+// =================================================================================================
+// FindHeadCandidate
+// =================
+//
+// Prefilter for the '<' that starts a packet header. Returns the first '<' in [ptr,limit) that
+// could start a header, or limit if there is none. The header is "<?xpacket begin=" with 0, 1, or 3
+// nulls after each real byte, so the byte after the header's '<' is always '?' or a null. Any other
+// '<' would be rejected by the state machine a couple of steps later. A '<' in the last byte is
+// always a candidate, the state machine has to carry it into the next buffer.
+//
+// The vector forms look at a block of '<' bytes and the block one byte later at once. The choice
+// of form is made once, from what the CPU supports.
+
+typedef const XMP_Uns8 * (* FindHeadCandidateProc) ( const XMP_Uns8 * ptr, const XMP_Uns8 * limit );
+
+static const XMP_Uns8 *
+FindHeadCandidate_Scalar ( const XMP_Uns8 * ptr, const XMP_Uns8 * limit )
+{
+
+	while ( ptr < limit ) {
+		ptr = (const XMP_Uns8 *) memchr ( ptr, '<', (limit - ptr) );
+		if ( ptr == 0 ) return limit;
+		if ( ((ptr + 1) == limit) || (ptr[1] == '?') || (ptr[1] == 0) ) return ptr;
+		++ptr;
+	}
+
+	return limit;
+
+}	// FindHeadCandidate_Scalar
+
+#if XMP_HasSSE2
+
+static const XMP_Uns8 *
+FindHeadCandidate_SSE2 ( const XMP_Uns8 * ptr, const XMP_Uns8 * limit )
+{
+	const __m128i lessThan = _mm_set1_epi8 ( '<' );
+	const __m128i question = _mm_set1_epi8 ( '?' );
+	const __m128i zero     = _mm_setzero_si128();
+
+	while ( (limit - ptr) > 16 ) {	// ! Need the byte after the block too.
+		__m128i lessHits = _mm_cmpeq_epi8 ( _mm_loadu_si128 ( (const __m128i *) ptr ), lessThan );
+		if ( _mm_movemask_epi8 ( lessHits ) != 0 ) {	// Most blocks have no '<' at all.
+			__m128i nextBytes = _mm_loadu_si128 ( (const __m128i *) (ptr + 1) );
+			__m128i follows   = _mm_or_si128 ( _mm_cmpeq_epi8 ( nextBytes, question ), _mm_cmpeq_epi8 ( nextBytes, zero ) );
+			XMP_Uns32 mask = (XMP_Uns32) _mm_movemask_epi8 ( _mm_and_si128 ( lessHits, follows ) );
+			if ( mask != 0 ) return ptr + FirstSetBit ( mask );
+		}
+		ptr += 16;
+	}
+
+	return FindHeadCandidate_Scalar ( ptr, limit );
+
+}	// FindHeadCandidate_SSE2
+
+#endif
+
+#if ScannerHasAVX2
+
+__attribute__ (( target ( "avx2" ) ))
+static const XMP_Uns8 *
+FindHeadCandidate_AVX2 ( const XMP_Uns8 * ptr, const XMP_Uns8 * limit )
+{
+	const __m256i lessThan = _mm256_set1_epi8 ( '<' );
+	const __m256i question = _mm256_set1_epi8 ( '?' );
+	const __m256i zero     = _mm256_setzero_si256();
+
+	while ( (limit - ptr) > 32 ) {	// ! Need the byte after the block too.
+		__m256i lessHits = _mm256_cmpeq_epi8 ( _mm256_loadu_si256 ( (const __m256i *) ptr ), lessThan );
+		if ( _mm256_movemask_epi8 ( lessHits ) != 0 ) {	// Most blocks have no '<' at all.
+			__m256i nextBytes = _mm256_loadu_si256 ( (const __m256i *) (ptr + 1) );
+			__m256i follows   = _mm256_or_si256 ( _mm256_cmpeq_epi8 ( nextBytes, question ), _mm256_cmpeq_epi8 ( nextBytes, zero ) );
+			XMP_Uns32 mask = (XMP_Uns32) _mm256_movemask_epi8 ( _mm256_and_si256 ( lessHits, follows ) );
+			if ( mask != 0 ) return ptr + FirstSetBit ( mask );
+		}
+		ptr += 32;
+	}
+
+	return FindHeadCandidate_SSE2 ( ptr, limit );
+
+}	// FindHeadCandidate_AVX2
+
+#endif
+
+static FindHeadCandidateProc SelectFindHeadCandidate()
+{
+
+	#if ScannerHasAVX2
+		__builtin_cpu_init();	// ! Needed when called from a static initializer.
+		if ( __builtin_cpu_supports ( "avx2" ) ) return FindHeadCandidate_AVX2;
+	#endif
+
+	#if XMP_HasSSE2
+		return FindHeadCandidate_SSE2;
+	#else
+		return FindHeadCandidate_Scalar;
+	#endif
+
+}	// SelectFindHeadCandidate
+
+static FindHeadCandidateProc sFindHeadCandidate = SelectFindHeadCandidate();
+
 // =================================================================================================
 // =================================================================================================
 // class PacketMachine
@@ -186,9 +297,9 @@ XMPScanner::PacketMachine::FindLessThan ( PacketMachine * ths, const char * whic
 		ths->fCharForm = eChar8Bit;	// We might have just failed from a bogus 16 or 32 bit case.
 		ths->fBytesPerChar = 1;
 
-		while ( ths->fBufferPtr < ths->fBufferLimit ) {	// Don't skip nulls for the header's '<'!
-			if ( *ths->fBufferPtr == '<' ) break;
-			ths->fBufferPtr++;
+		if ( ths->fBufferPtr < ths->fBufferLimit ) {	// Don't skip nulls for the header's '<'!
+			ths->fBufferPtr = (const char *) sFindHeadCandidate ( (const XMP_Uns8 *) ths->fBufferPtr,
+																  (const XMP_Uns8 *) ths->fBufferLimit );
 		}
 
 		if ( ths->fBufferPtr >= ths->fBufferLimit ) return eTriNo;
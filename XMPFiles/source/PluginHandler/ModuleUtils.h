@@ -76,5 +76,16 @@ bool GetResourceDataFromModule(
 	const std::string & inResourceType,
 	std::string & outBuffer);
 
+/** @brief Return the path of the file a resource of a module is read from
+ *  @param inModulePath Absolute path of the module.
+ *  @param inResourceName Name of the resource file.
+ *  @param inResourceType Type/Extension of the resource file.
+ *  @return The path of the resource file, or an empty string if the resource is part of the module file.
+ */
+std::string GetResourceFilePath(
+	const std::string & inModulePath,
+	const std::string & inResourceName,
+	const std::string & inResourceType);
+
 } //namespace XMP_PLUGIN
 #endif
@@ -42,16 +42,16 @@ void CloseFile(
 }
 
 /** ************************************************************************************************************************
-** OpenResourceFile()
+** GetResourceFilePath()
 */
-static FilePtr OpenResourceFile(
-	OS_ModuleRef inOSModule,
-	const std::string& inResourceName,
-	const std::string& inResourceType)
+std::string GetResourceFilePath(
+	const std::string & inModulePath,
+	const std::string & inResourceName,
+	const std::string & inResourceType)
 {
 	// It is assumed, that all resources reside in a folder with
 	// the same name as the shared object plus '.resources' extension
-	std::string path( GetModulePath(inOSModule) );
+	std::string path( inModulePath );
 	
 	XMP_StringPtr extPos = path.c_str() + path.size();
 	for ( ; (extPos != path.c_str()) && (*extPos != '.'); --extPos ) {}
@@ -60,6 +60,18 @@ static FilePtr OpenResourceFile(
 	path += ".resources";
 	path += kDirChar;
 	path += inResourceName + "." + inResourceType;
+	return path;
+}
+
+/** ************************************************************************************************************************
+** OpenResourceFile()
+*/
+static FilePtr OpenResourceFile(
+	OS_ModuleRef inOSModule,
+	const std::string& inResourceName,
+	const std::string& inResourceType)
+{
+	std::string path( GetResourceFilePath( GetModulePath(inOSModule), inResourceName, inResourceType ) );
 
 	FilePtr file;
 	if( Host_IO::GetFileMode(path.c_str()) == Host_IO::kFMode_IsFile )
@@ -296,4 +296,20 @@ bool GetResourceDataFromModule(
 	return false;
 }
 
+std::string GetResourceFilePath(
+	const std::string & inModulePath,
+	const std::string & inResourceName,
+	const std::string & inResourceType)
+{
+	// The non-localized resources are in Contents/Resources of an application style bundle and
+	// in Resources of a framework style bundle, like the plugins are built.
+	std::string bundlePath( inModulePath );
+	if ( ! bundlePath.empty() && bundlePath[bundlePath.size()-1] != kDirChar ) bundlePath += kDirChar;
+
+	std::string path( bundlePath + "Contents/Resources/" + inResourceName + "." + inResourceType );
+	if ( Host_IO::Exists( path.c_str() ) ) return path;
+
+	return bundlePath + "Resources/" + inResourceName + "." + inResourceType;
+}
+
 } //namespace XMP_PLUGIN
@@ -64,5 +64,13 @@ bool GetResourceDataFromModule(
 	return false;
 }
 
+std::string GetResourceFilePath(
+	const std::string & /*inModulePath*/,
+	const std::string & /*inResourceName*/,
+	const std::string & /*inResourceType*/)
+{
+	return std::string();	// The resources are linked into the DLL.
+}
+
 } //namespace XMP_PLUGIN
 #endif
\ No newline at end of file
@@ -14,6 +14,7 @@
 #include "XMPFiles/source/HandlerRegistry.h"
 #include "FileHandlerInstance.h"
 #include "HostAPI.h"
+#include "third-party/zuid/interfaces/MD5.h"
 
 using namespace Common;
 using namespace std;
@@ -230,8 +231,8 @@ static bool Plugin_CheckFolderFormat_Replacement( XMP_FileFormat format,
 
 PluginManager* PluginManager::msPluginManager = 0;
 
-PluginManager::PluginManager( const std::string& pluginDir, const std::string& plugins )
-: mPluginDir ( pluginDir )
+PluginManager::PluginManager( const std::string& pluginDir, const std::string& plugins, bool noScan )
+: mPluginDir ( pluginDir ), mNoScan ( noScan )
 {
 
 	const std::size_t count = sizeof(kLibraryExtensions) / sizeof(kLibraryExtensions[0]);
@@ -384,11 +385,11 @@ static bool registerHandler( XMP_FileFormat format, FileHandlerSharedPtr handler
 	return ret;
 }
 
-void PluginManager::initialize( const std::string& pluginDir, const std::string& plugins )
+void PluginManager::initialize( const std::string& pluginDir, const std::string& plugins, bool noScan )
 {
 	try 
 	{
-		if( msPluginManager == 0 ) msPluginManager = new PluginManager( pluginDir, plugins );
+		if( msPluginManager == 0 ) msPluginManager = new PluginManager( pluginDir, plugins, noScan );
 		msPluginManager->initializeHostAPI();
 
 		msPluginManager->doScan( 2 );
@@ -601,14 +602,404 @@ static bool CheckPluginArchitecture ( XMLParserAdapter * xmlParser ) {
 }	// CheckPluginArchitecture
 
 // =================================================================================================
+// Plugin cache
+// ============
+//
+// doScan keeps what it found in a text file of the user's cache folder, one file per plugin folder:
+// the stamps of the scanned folders, of the modules and of their resource files, and what each
+// resource file declares. While the stamps are unchanged the handlers are added from the file,
+// without reading the folders, opening the modules or parsing their resource files.
+//
+// The cache folder is exempi in $XDG_CACHE_HOME or ~/.cache on UNIX, in ~/Library/Caches on Mac
+// and in %LOCALAPPDATA% on Windows. The file is named after the MD5 digest of the plugin folder path.
+// Nothing is written to the plugin folder. Without a usable cache folder every initialization scans.
+//
+// The file is written to a temporary file that then replaces it.
+//
+// Each line is a keyword and its fields, a path or a name is the last field. A file that cannot be
+// read back completely is ignored, so is a file naming a module outside of the plugin folder.
+//
+//	XMPPluginCache 1 <key>
+//	stamp <modifyTime> <length> <path>				length is -1 for a missing path
+//	module <loaded> <path>
+//	ext <extension>
+//	handler <type> <flags> <serializeOption> <overwrite> <version> <uid>
+//	format <fileFormat>
+//	check <offset> <length> <hex byteSeq>
+//	end
+
+const char* kPluginCacheFolder = "exempi";
+const char* kPluginCachePrefix = "XMPPluginCache-";
+const char* kPluginCacheHeader = "XMPPluginCache 1";
+
+struct PathStamp
+{
+	std::string	mPath;
+	XMP_Int64	mModifyTime;
+	XMP_Int64	mLength;
+};
+
+struct PluginCache
+{
+	std::string						mKey;
+	std::vector<PathStamp>			mStamps;
+	std::vector<PluginManifest>		mModules;
+};
+
+static PathStamp GetPathStamp ( const std::string & path )
+{
+	PathStamp stamp;
+	stamp.mPath = path;
+	if ( ! Host_IO::GetStamp ( path.c_str(), &stamp.mModifyTime, &stamp.mLength ) ) {
+		stamp.mModifyTime = 0;
+		stamp.mLength = -1;
+	}
+	return stamp;
+}
+
+static bool IsPluginCacheCurrent ( const PluginCache & cache )
+{
+	for ( size_t i = 0, limit = cache.mStamps.size(); i < limit; ++i ) {
+		const PathStamp & cached = cache.mStamps[i];
+		PathStamp current = GetPathStamp ( cached.mPath );
+		if ( (current.mModifyTime != cached.mModifyTime) || (current.mLength != cached.mLength) ) return false;
+	}
+	return true;
+}
+
+static std::string GetPluginCacheKey ( const StringVec & pluginsNeeded, XMP_Int32 maxNestingLevel )
+{
+	// The architecture is part of the key, a 32 and a 64 bit host can share the plugin folder.
+	#if XMP_64
+		const char * architecture = "x64";
+	#else
+		const char * architecture = "x86";
+	#endif
+
+	char buffer[32];
+	snprintf ( buffer, sizeof(buffer), "%s %d", architecture, (int)maxNestingLevel );
+
+	std::string key ( buffer );
+	for ( size_t i = 0, limit = pluginsNeeded.size(); i < limit; ++i ) {
+		key += ' ';
+		key += pluginsNeeded[i];
+	}
+	return key;
+}
+
+static bool IsPathInPluginFolder ( const std::string & path, const std::string & pluginDir )
+{
+	// Module paths are built by scanRecursive, the plugin folder, kDirChar and then the relative path.
+	std::string prefix = pluginDir + kDirChar;
+	if ( (path.size() <= prefix.size()) || (path.compare ( 0, prefix.size(), prefix ) != 0) ) return false;
+
+	for ( size_t start = prefix.size(); start <= path.size(); ) {
+		size_t end = path.find_first_of ( "/\\", start );
+		if ( end == std::string::npos ) end = path.size();
+		if ( path.compare ( start, (end - start), ".." ) == 0 ) return false;	// Back out of the folder.
+		start = end + 1;
+	}
+	return true;
+}
+
+static bool IsPluginCacheSafe ( const PluginCache & cache, const std::string & pluginDir )
+{
+	// The cache is a plain file, only load modules from where a scan would have found them.
+	for ( size_t i = 0, limit = cache.mModules.size(); i < limit; ++i ) {
+		if ( ! IsPathInPluginFolder ( cache.mModules[i].mPath, pluginDir ) ) return false;
+	}
+	return true;
+}
+
+static std::string GetUserCacheFolder()
+{
+	// The per-user folder for data that can be recreated, empty if there is none.
+	std::string folder;
+	#if XMP_WinBuild
+		const char * localAppData = getenv ( "LOCALAPPDATA" );
+		if ( (localAppData != 0) && (*localAppData != 0) ) folder = localAppData;
+	#else
+		const char * home = getenv ( "HOME" );
+		#if XMP_MacBuild
+			if ( (home != 0) && (*home == '/') ) folder = std::string ( home ) + "/Library/Caches";
+		#else
+			const char * cacheHome = getenv ( "XDG_CACHE_HOME" );
+			if ( (cacheHome != 0) && (*cacheHome == '/') ) {
+				folder = cacheHome;	// Relative paths are invalid and ignored.
+			} else if ( (home != 0) && (*home == '/') ) {
+				folder = std::string ( home ) + "/.cache";
+			}
+		#endif
+	#endif
+	return folder;
+}
+
+static std::string GetPluginCachePath ( const std::string & pluginDir )
+{
+	std::string userFolder = GetUserCacheFolder();
+	if ( userFolder.empty() ) return std::string();
+
+	MD5_CTX context;
+	XMP_Uns8 digest[16];
+	MD5Init ( &context );
+	MD5Update ( &context, (XMP_Uns8*)pluginDir.c_str(), (unsigned int)pluginDir.size() );
+	MD5Final ( digest, &context );
+
+	char hex[33];
+	for ( size_t i = 0; i < 16; ++i ) snprintf ( &hex[i*2], 3, "%02X", digest[i] );
+
+	return userFolder + kDirChar + kPluginCacheFolder + kDirChar + kPluginCachePrefix + hex + ".txt";
+}
+
+static bool CreatePluginCache ( const std::string & cachePath )
+{
+	// Create the missing folders, the cache folder and possibly the user cache folder itself.
+	size_t folderEnd = cachePath.rfind ( kDirChar );
+	size_t userEnd = cachePath.rfind ( kDirChar, (folderEnd - 1) );
+	try {
+		(void) Host_IO::CreateFolder ( cachePath.substr ( 0, userEnd ).c_str() );
+		(void) Host_IO::CreateFolder ( cachePath.substr ( 0, folderEnd ).c_str() );
+	} catch ( ... ) {
+		return false;	// No writable cache folder, scan every time.
+	}
+	return true;
+}
+
+static bool AppendField ( std::string * text, const char * fields, const std::string & last )
+{
+	if ( last.find_first_of ( "\n\r" ) != std::string::npos ) return false;
+	*text += fields;
+	*text += ' ';
+	*text += last;
+	*text += '\n';
+	return true;
+}
+
+static bool WritePluginCache ( const std::string & cachePath, const PluginCache & cache )
+{
+	static const char * kHexDigits = "0123456789ABCDEF";
+
+	std::string text;
+	char buffer[128];
+
+	if ( ! AppendField ( &text, kPluginCacheHeader, cache.mKey ) ) return false;
+
+	for ( size_t i = 0, limit = cache.mStamps.size(); i < limit; ++i ) {
+		const PathStamp & stamp = cache.mStamps[i];
+		snprintf ( buffer, sizeof(buffer), "stamp %lld %lld", (long long)stamp.mModifyTime, (long long)stamp.mLength );
+		if ( ! AppendField ( &text, buffer, stamp.mPath ) ) return false;
+	}
+
+	for ( size_t i = 0, limit = cache.mModules.size(); i < limit; ++i ) {
+
+		const PluginManifest & manifest = cache.mModules[i];
+		if ( ! AppendField ( &text, (manifest.mLoaded ? "module 1" : "module 0"), manifest.mPath ) ) return false;
+
+		for ( size_t j = 0; j < manifest.mExtensions.size(); ++j ) {
+			if ( ! AppendField ( &text, "ext", manifest.mExtensions[j] ) ) return false;
+		}
+
+		for ( size_t j = 0; j < manifest.mHandlers.size(); ++j ) {
+
+			const PluginManifest::Handler & record = manifest.mHandlers[j];
+			snprintf ( buffer, sizeof(buffer), "handler %lu %lu %lu %d %.17g",
+					   (unsigned long)record.mType, (unsigned long)record.mFlags, (unsigned long)record.mSerializeOption,
+					   (int)record.mOverwrite, record.mVersion );
+			if ( ! AppendField ( &text, buffer, record.mUID ) ) return false;
+
+			for ( size_t k = 0; k < record.mFormats.size(); ++k ) {
+				snprintf ( buffer, sizeof(buffer), "format %lu\n", (unsigned long)record.mFormats[k] );
+				text += buffer;
+			}
+
+			for ( size_t k = 0; k < record.mCheckFormats.size(); ++k ) {
+				const CheckFormat & check = record.mCheckFormats[k];
+				std::string byteSeq;
+				for ( size_t b = 0; b < check.mByteSeq.size(); ++b ) {
+					XMP_Uns8 byte = (XMP_Uns8)check.mByteSeq[b];
+					byteSeq += kHexDigits[byte >> 4];
+					byteSeq += kHexDigits[byte & 0xF];
+				}
+				snprintf ( buffer, sizeof(buffer), "check %lld %lu", (long long)check.mOffset, (unsigned long)check.mLength );
+				(void) AppendField ( &text, buffer, byteSeq );
+			}
+
+		}
+
+	}
+
+	text += "end\n";
+
+	// Another process may be reading the cache, replace it with a complete file. Host_IO::Rename
+	// does not replace an existing file, for a moment there is no cache, which only means a scan.
+
+	std::string tempPath;
+	Host_IO::FileRef file = Host_IO::noFileRef;
+	try {
+		tempPath = Host_IO::CreateTemp ( cachePath.c_str() );
+		file = Host_IO::Open ( tempPath.c_str(), Host_IO::openReadWrite );
+		if ( file == Host_IO::noFileRef ) XMP_Throw ( "WritePluginCache: Can't open temp file", kXMPErr_ExternalFailure );
+		Host_IO::Write ( file, text.data(), (XMP_Uns32)text.size() );
+		Host_IO::Close ( file );
+		file = Host_IO::noFileRef;
+		Host_IO::Delete ( cachePath.c_str() );
+		Host_IO::Rename ( tempPath.c_str(), cachePath.c_str() );
+	} catch ( ... ) {
+		try {
+			if ( file != Host_IO::noFileRef ) Host_IO::Close ( file );
+			if ( ! tempPath.empty() ) Host_IO::Delete ( tempPath.c_str() );
+		} catch ( ... ) {
+			// Leave it, a stray temporary file only takes space.
+		}
+		return false;
+	}
+
+	return true;
 
-void PluginManager::loadResourceFile( ModuleSharedPtr module )
+}	// WritePluginCache
+
+static bool GetLastField ( const char * line, int fieldPos, std::string * field )
+{
+	if ( (fieldPos < 0) || (line[fieldPos] != ' ') ) return false;
+	field->assign ( line + fieldPos + 1 );
+	return true;
+}
+
+static int GetHexDigit ( char digit )
+{
+	if ( ('0' <= digit) && (digit <= '9') ) return digit - '0';
+	if ( ('A' <= digit) && (digit <= 'F') ) return digit - 'A' + 10;
+	return -1;
+}
+
+static bool ReadPluginCache ( const std::string & cachePath, PluginCache * cache )
+{
+	std::string text;
+
+	Host_IO::FileRef file = Host_IO::noFileRef;
+	try {
+		file = Host_IO::Open ( cachePath.c_str(), Host_IO::openReadOnly );
+		if ( file == Host_IO::noFileRef ) return false;
+		XMP_Int64 length = Host_IO::Length ( file );
+		if ( (length <= 0) || (length > 16*1024*1024) ) {
+			Host_IO::Close ( file );
+			return false;
+		}
+		text.resize ( (size_t)length );
+		XMP_Uns32 bytesRead = Host_IO::Read ( file, &text[0], (XMP_Uns32)length );
+		Host_IO::Close ( file );
+		if ( bytesRead != length ) return false;
+	} catch ( ... ) {
+		if ( file != Host_IO::noFileRef ) Host_IO::Close ( file );
+		return false;
+	}
+
+	bool ended = false;
+	size_t lineStart = 0;
+
+	while ( lineStart < text.size() ) {
+
+		size_t lineEnd = text.find ( '\n', lineStart );
+		if ( (lineEnd == std::string::npos) || ended ) return false;
+		std::string lineStr ( text, lineStart, (lineEnd - lineStart) );
+		const char * line = lineStr.c_str();
+		bool first = (lineStart == 0);
+		lineStart = lineEnd + 1;
+
+		long long time, length;
+		unsigned long type, flags, option;
+		int loaded, fieldPos = -1;
+		double version;
+		std::string field;
+
+		PluginManifest * manifest = cache->mModules.empty() ? 0 : &cache->mModules.back();
+		PluginManifest::Handler * record = ((manifest == 0) || manifest->mHandlers.empty()) ? 0 : &manifest->mHandlers.back();
+
+		if ( first ) {
+
+			size_t headerLen = strlen ( kPluginCacheHeader );
+			if ( strncmp ( line, kPluginCacheHeader, headerLen ) != 0 ) return false;
+			if ( ! GetLastField ( line, (int)headerLen, &cache->mKey ) ) return false;
+
+		} else if ( sscanf ( line, "stamp %lld %lld%n", &time, &length, &fieldPos ) == 2 ) {
+
+			if ( ! GetLastField ( line, fieldPos, &field ) ) return false;
+			PathStamp stamp;
+			stamp.mPath = field;
+			stamp.mModifyTime = time;
+			stamp.mLength = length;
+			cache->mStamps.push_back ( stamp );
+
+		} else if ( sscanf ( line, "module %d%n", &loaded, &fieldPos ) == 1 ) {
+
+			if ( ! GetLastField ( line, fieldPos, &field ) ) return false;
+			cache->mModules.push_back ( PluginManifest() );
+			cache->mModules.back().mPath = field;
+			cache->mModules.back().mLoaded = (loaded != 0);
+
+		} else if ( strncmp ( line, "ext ", 4 ) == 0 ) {
+
+			if ( manifest == 0 ) return false;
+			manifest->mExtensions.push_back ( std::string ( line + 4 ) );
+
+		} else if ( sscanf ( line, "handler %lu %lu %lu %d %lf%n", &type, &flags, &option, &loaded, &version, &fieldPos ) == 5 ) {
+
+			if ( (manifest == 0) || (! GetLastField ( line, fieldPos, &field )) ) return false;
+			manifest->mHandlers.push_back ( PluginManifest::Handler() );
+			PluginManifest::Handler & newRecord = manifest->mHandlers.back();
+			newRecord.mUID = field;
+			newRecord.mType = (FileHandlerType)type;
+			newRecord.mFlags = (XMP_OptionBits)flags;
+			newRecord.mSerializeOption = (XMP_OptionBits)option;
+			newRecord.mOverwrite = (loaded != 0);
+			newRecord.mVersion = version;
+
+		} else if ( sscanf ( line, "format %lu", &type ) == 1 ) {
+
+			if ( record == 0 ) return false;
+			record->mFormats.push_back ( (XMP_FileFormat)type );
+
+		} else if ( sscanf ( line, "check %lld %lu%n", &time, &flags, &fieldPos ) == 2 ) {
+
+			if ( (record == 0) || (! GetLastField ( line, fieldPos, &field )) || ((field.size() & 1) != 0) ) return false;
+			CheckFormat check;
+			check.mOffset = time;
+			check.mLength = (XMP_Uns32)flags;
+			for ( size_t b = 0; b < field.size(); b += 2 ) {
+				int high = GetHexDigit ( field[b] );
+				int low = GetHexDigit ( field[b+1] );
+				if ( (high < 0) || (low < 0) ) return false;
+				check.mByteSeq += (char)((high << 4) | low);
+			}
+			record->mCheckFormats.push_back ( check );
+
+		} else if ( lineStr == "end" ) {
+
+			ended = true;
+
+		} else {
+
+			return false;
+
+		}
+
+	}
+
+	return ended;
+
+}	// ReadPluginCache
+
+// =================================================================================================
+
+void PluginManager::loadResourceFile( ModuleSharedPtr module, PluginManifest * manifest )
 {
 	
 	OS_ModuleRef moduleRef = LoadModule ( module->getPath(), true );
 
 	if ( moduleRef != 0 ) {
 
+		if ( manifest != 0 ) manifest->mLoaded = true;
+
 		XMLParserAdapter* parser = 0;
 	
 		try {
@@ -622,7 +1013,7 @@ void PluginManager::loadResourceFile( ModuleSharedPtr module )
 				parser->ParseBuffer ( (XMP_Uns8*)buffer.c_str(), buffer.size(), true );
 
 				if ( CheckPluginArchitecture ( parser ) ) {
-					ResourceParser resource ( module );
+					ResourceParser resource ( module, manifest );
 					resource.parseElementList ( &parser->tree, true );
 				}
 
@@ -645,12 +1036,15 @@ void PluginManager::loadResourceFile( ModuleSharedPtr module )
 
 // =================================================================================================
 
-void PluginManager::scanRecursive( const std::string & tempPath, std::vector<std::string>& ioFoundLibs, XMP_Int32 inLevel, XMP_Int32 inMaxNestingLevel )
+void PluginManager::scanRecursive( const std::string & tempPath, std::vector<std::string>& ioFoundLibs, XMP_Int32 inLevel, XMP_Int32 inMaxNestingLevel, std::vector<PathStamp>* ioFolders )
 {
 	++inLevel;
 	Host_IO::AutoFolder aFolder;
 	if ( Host_IO::GetFileMode( tempPath.c_str() ) != Host_IO::kFMode_IsFolder ) return;
 
+	// Take the stamp before reading the folder, a later change must not match it.
+	if ( ioFolders != 0 ) ioFolders->push_back ( GetPathStamp ( tempPath ) );
+
 	aFolder.folder = Host_IO::OpenFolder( tempPath.c_str() );
 	std::string childPath, childName;
 
@@ -671,7 +1065,7 @@ void PluginManager::scanRecursive( const std::string & tempPath, std::vector<std
 		if ( okFolder ) {
 
 			if ( inLevel < inMaxNestingLevel ) {
-				scanRecursive ( childPath + kDirChar, ioFoundLibs, inLevel, inMaxNestingLevel );
+				scanRecursive ( childPath + kDirChar, ioFoundLibs, inLevel, inMaxNestingLevel, ioFolders );
 			}
 
 		} else {
@@ -720,25 +1114,105 @@ void PluginManager::doScan( const XMP_Int32 inMaxNumOfNestedFolder )
 {
 	XMP_Assert(inMaxNumOfNestedFolder > 0);
 	if ( inMaxNumOfNestedFolder < 1 ) return; // noop, wrong parameter
-		
+	if ( Host_IO::GetFileMode ( mPluginDir.c_str() ) != Host_IO::kFMode_IsFolder ) return;
+
+	std::string cachePath = GetPluginCachePath ( mPluginDir );
+	std::string cacheKey = GetPluginCacheKey ( mPluginsNeeded, inMaxNumOfNestedFolder );
+
+	// Use the cache if nothing it was made from has changed. The modules that could not be opened
+	// are tried again.
+	PluginCache cache;
+	if ( (! cachePath.empty()) && ReadPluginCache ( cachePath, &cache ) && (cache.mKey == cacheKey) &&
+		 IsPluginCacheSafe ( cache, mPluginDir ) && (mNoScan || IsPluginCacheCurrent ( cache )) ) {
+
+		bool changed = false;
+
+		for ( size_t i = 0, limit = cache.mModules.size(); i < limit; ++i ) {
+			PluginManifest & manifest = cache.mModules[i];
+			if ( manifest.mLoaded ) {
+				addCachedHandlers ( manifest );
+			} else if ( ! mNoScan ) {
+				ModuleSharedPtr module ( new Module ( manifest.mPath ) );
+				loadResourceFile ( module, &manifest );
+				changed |= manifest.mLoaded;
+			}
+		}
+
+		if ( changed ) (void) WritePluginCache ( cachePath, cache );
+		return;
+
+	}
+
+	if ( mNoScan ) return;
+
+	bool keepCache = (! cachePath.empty()) && CreatePluginCache ( cachePath );
+
+	cache = PluginCache();
+	cache.mKey = cacheKey;
+
 	// scan directory
 	std::vector<std::string> foundLibs;
 	XMP_Int32 iteration = 0;
-	scanRecursive ( mPluginDir, foundLibs, iteration, inMaxNumOfNestedFolder );
+	scanRecursive ( mPluginDir, foundLibs, iteration, inMaxNumOfNestedFolder, &cache.mStamps );
 
 	// add found modules
 	std::vector<std::string>::const_iterator iter = foundLibs.begin();
 	std::vector<std::string>::const_iterator iterEnd = foundLibs.end();
 	for ( ; iter != iterEnd; ++iter ) {
 		std::string path ( *iter );
+
+		cache.mStamps.push_back ( GetPathStamp ( path ) );
+		std::string resourcePath = GetResourceFilePath ( path, kResourceName_UIDs, "txt" );
+		if ( ! resourcePath.empty() ) cache.mStamps.push_back ( GetPathStamp ( resourcePath ) );
+
+		cache.mModules.push_back ( PluginManifest() );
+		PluginManifest & manifest = cache.mModules.back();
+		manifest.mPath = path;
+
 		ModuleSharedPtr module ( new Module ( path ) );
-		loadResourceFile ( module );
+		loadResourceFile ( module, &manifest );
 	}
 
+	if ( keepCache ) (void) WritePluginCache ( cachePath, cache );
+
 }	// PluginManager::doScan
 
 // =================================================================================================
 
+void PluginManager::addCachedHandlers( const PluginManifest & manifest )
+{
+	ResourceParser::initialize(); // The private file formats are kept with the XMPAtoms.
+
+	std::string path ( manifest.mPath );
+	ModuleSharedPtr module ( new Module ( path ) );
+
+	for ( size_t i = 0, limit = manifest.mExtensions.size(); i < limit; ++i ) {
+		(void) HandlerRegistry::getInstance().getFileFormat ( manifest.mExtensions[i], true );
+	}
+
+	for ( size_t i = 0, limit = manifest.mHandlers.size(); i < limit; ++i ) {
+
+		const PluginManifest::Handler & record = manifest.mHandlers[i];
+
+		std::string uid ( record.mUID );
+		FileHandlerSharedPtr handler ( new FileHandler ( uid, record.mFlags, record.mType, module ) );
+		handler->setVersion ( record.mVersion );
+		handler->setSerializeOption ( record.mSerializeOption );
+		handler->setOverwriteHandler ( record.mOverwrite );
+		for ( size_t j = 0; j < record.mCheckFormats.size(); ++j ) {
+			handler->addCheckFormat ( record.mCheckFormats[j] );
+		}
+
+		for ( size_t j = 0; j < record.mFormats.size(); ++j ) {
+			PluginManager::addFileHandler ( record.mFormats[j], handler );
+		}
+
+	}
+
+}	// PluginManager::addCachedHandlers
+
+// =================================================================================================
+
 HostAPIRef PluginManager::getHostAPI( XMP_Uns32 version )
 {
 	HostAPIRef hostAPI = NULL;
@@ -53,6 +53,8 @@ typedef std::vector<ModuleSharedPtr>						ModuleVec;
 typedef std::vector<XMP_FileFormat>							XMP_FileFormatVec;
 
 struct FileHandlerPair;
+struct PluginManifest;
+struct PathStamp;
 
 inline void CheckError( WXMP_Error & error )
 {
@@ -90,8 +92,10 @@ public:
 	 *  @param pluginDir The directory where to search for the plugins. 
 	 *  @param plugins Comma separated list of the plugins which should be loaded from the plugin directory.
 	 *  By default, all plug-ins available in the pluginDir will be loaded.
+	 *  @param noScan Load the plugins recorded in the plugin cache without looking at the plugin directory.
+	 *  No plugin is loaded if there is no cache.
 	 */
-	static void initialize( const std::string& pluginDir, const std::string& plugins = std::string() );
+	static void initialize( const std::string& pluginDir, const std::string& plugins = std::string(), bool noScan = false );
 	
 	/**
 	 *  Terminate the plugin manager.
@@ -151,7 +155,7 @@ public:
 	static HostAPIRef getHostAPI( XMP_Uns32 version );
 
 private:
-	PluginManager( const std::string& pluginDir, const std::string& plugins );
+	PluginManager( const std::string& pluginDir, const std::string& plugins, bool noScan );
 	~PluginManager();
 
 	/**
@@ -163,16 +167,26 @@ private:
 	/** 
 	 *  Load resource file of the given module.
 	 *  @param module
+	 *  @param manifest Optional record of what the resource file declares.
 	 *  @return Void.
 	 */
-	void loadResourceFile( ModuleSharedPtr module );
+	void loadResourceFile( ModuleSharedPtr module, PluginManifest * manifest = 0 );
 	
 	/** 
 	 *  Scan mPluginDir for the plugins. It also scans nested folder upto level inMaxNumOfNestedFolder.
+	 *  The result is kept in a cache file in mPluginDir, it is used instead of scanning as long as
+	 *  the folders, the modules and their resource files are unchanged.
 	 *  @param inMaxNumOfNestedFolder Nested level where to scan.
 	 *  @return Void.
 	 */
 	void doScan( const XMP_Int32 inMaxNumOfNestedFolder = 1 );
+
+	/** 
+	 *  Add the handlers of a module from its cached manifest, as loadResourceFile would.
+	 *  @param manifest Manifest read from the plugin cache.
+	 *  @return Void.
+	 */
+	void addCachedHandlers( const PluginManifest & manifest );
 	
 	/** 
 	 *  Scan recursively the directory /a inPath and insert the found plug-in in ioFoundLibs.
@@ -180,13 +194,15 @@ private:
 	 *  @param ioFoundLibs Vector of string. Found plug-in will be inserted in this vector.
 	 *  @param inLevel The current level
 	 *  @param inMaxNumOfNestedFolder Nested level where to scan upto.
+	 *  @param ioFolders Optional vector of stamps. The stamps of the scanned folders will be inserted in this vector.
 	 *  @return Void.
 	 */
 	void scanRecursive(
 			const std::string& inPath, 
 			std::vector<std::string>& ioFoundLibs, 
 			XMP_Int32 inLevel, 
-			XMP_Int32 inMaxNestingLevel );
+			XMP_Int32 inMaxNestingLevel,
+			std::vector<PathStamp>* ioFolders = 0 );
 
 	/**
 	 * Setup passed in HostAPI structure for the host API v1
@@ -216,6 +232,7 @@ private:
 	std::string						mPluginDir;
 	StringVec						mExtensions;
 	StringVec						mPluginsNeeded;
+	bool							mNoScan;
 	PluginHandlerMap				mHandlers;
 	SessionMap						mSessions;
 	HostAPIMap						mHostAPIs;
@@ -119,6 +119,23 @@ void ResourceParser::addHandler()
 		{
 			PluginManager::addFileHandler(*it, mHandler);
 		}
+
+		if( mManifest != 0 )
+		{
+			PluginManifest::Handler record;
+			record.mUID = mUID;
+			record.mVersion = mHandler->getVersion();
+			record.mType = mType;
+			record.mFlags = mFlags;
+			record.mSerializeOption = mSerializeOption;
+			record.mOverwrite = mOverwriteHandler;
+			for( XMP_Uns32 i = 0; i < mHandler->getCheckFormatSize(); ++i )
+			{
+				record.mCheckFormats.push_back( mHandler->getCheckFormat( i ) );
+			}
+			record.mFormats.assign( formatIDs.begin(), formatIDs.end() );
+			mManifest->mHandlers.push_back( record );
+		}
 	}
 }
 
@@ -184,6 +201,7 @@ bool ResourceParser::parseElementAttrs( const XML_Node * xmlNode, bool /*isTopLe
 			{
 			case Name_K:
 				this->mFileExtensions.insert( HandlerRegistry::getInstance().getFileFormat( (*currAttr)->value, true) );
+				if( mManifest != 0 ) mManifest->mExtensions.push_back( (*currAttr)->value );
 				break;
 			default:
 				//fix for bug 3565147: Plugin Architecture: If any unknown node is present in the Plugin Manifest then the Plugin is not loaded
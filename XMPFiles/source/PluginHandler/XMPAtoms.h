@@ -85,6 +85,35 @@ enum
 
 typedef std::map<std::string, XMPAtom> XMPAtomsMap;
 
+/** @struct PluginManifest
+ *  @brief What the resource file of one plugin module declares, as kept in the plugin cache.
+ */
+struct PluginManifest
+{
+	struct Handler
+	{
+		std::string					mUID;
+		double						mVersion;
+		FileHandlerType				mType;
+		XMP_OptionBits				mFlags;
+		XMP_OptionBits				mSerializeOption;
+		bool						mOverwrite;
+		std::vector<CheckFormat>	mCheckFormats;
+		XMP_FileFormatVec			mFormats;		// The formats the handler is added for.
+
+		Handler() : mVersion( 0.0 ), mType( 0 ), mFlags( 0 ), mSerializeOption( 0 ), mOverwrite( false ) {}
+	};
+
+	typedef std::vector<Handler> HandlerVec;
+
+	std::string		mPath;
+	bool			mLoaded;		// False if the module could not be opened.
+	StringVec		mExtensions;	// Private file extensions named in the resource file.
+	HandlerVec		mHandlers;
+
+	PluginManifest() : mLoaded( false ) {}
+};
+
 
 /** @class ResourceParser
  *  @brief Class to parse resource file of the plugin.
@@ -92,8 +121,12 @@ typedef std::map<std::string, XMPAtom> XMPAtomsMap;
 class ResourceParser
 {
 public:
-	ResourceParser(ModuleSharedPtr module)
-		: mModule(module), mType(0), mFlags(0), mSerializeOption(0), mVersion(0.0), mOverwriteHandler(false) {}
+	/**
+	 *  @param module The module whose resource file is parsed.
+	 *  @param manifest Optional record of what the resource file declares, for the plugin cache.
+	 */
+	ResourceParser(ModuleSharedPtr module, PluginManifest * manifest = 0)
+		: mModule(module), mManifest(manifest), mType(0), mFlags(0), mSerializeOption(0), mVersion(0.0), mOverwriteHandler(false) {}
 
 	/** 
 	 *  Initialize the XMPAtoms which will be used in parsing resource files.
@@ -176,6 +209,7 @@ private:
 	}
 
 	ModuleSharedPtr       mModule;
+	PluginManifest *      mManifest;
 	std::string           mUID;
 	FileHandlerType       mType;
 	XMP_OptionBits        mFlags;
@@ -29,13 +29,10 @@ extern "C" {
 
 // =================================================================================================
 
-static WXMP_Result voidResult;	// Used for functions that  don't use the normal result mechanism.
-
-// =================================================================================================
-
 void WXMPFiles_GetVersionInfo_1 ( XMP_VersionInfo * versionInfo )
 {
-	WXMP_Result * wResult = &voidResult;	// ! Needed to "fool" the EnterWrapper macro.
+	WXMP_Result void_wResult;
+	WXMP_Result * wResult = &void_wResult;	// ! Needed to "fool" the EnterWrapper macro.
 	XMP_ENTER_NoLock ( "WXMPFiles_GetVersionInfo_1" )
 
 		XMPFiles::GetVersionInfo ( versionInfo );
@@ -75,7 +72,8 @@ void WXMPFiles_Initialize_2 ( XMP_OptionBits options,
 
 void WXMPFiles_Terminate_1()
 {
-	WXMP_Result * wResult = &voidResult;	// ! Needed to "fool" the EnterWrapper macro.
+	WXMP_Result void_wResult;
+	WXMP_Result * wResult = &void_wResult;	// ! Needed to "fool" the EnterWrapper macro.
 	XMP_ENTER_NoLock ( "WXMPFiles_Terminate_1" )
 
 		XMPFiles::Terminate();
@@ -101,7 +99,8 @@ void WXMPFiles_CTor_1 ( WXMP_Result * wResult )
 
 void WXMPFiles_IncrementRefCount_1 ( XMPFilesRef xmpObjRef )
 {
-	WXMP_Result * wResult = &voidResult;	// ! Needed to "fool" the EnterWrapper macro.
+	WXMP_Result void_wResult;
+	WXMP_Result * wResult = &void_wResult;	// ! Needed to "fool" the EnterWrapper macro.
 	XMP_ENTER_ObjWrite ( XMPFiles, "WXMPFiles_IncrementRefCount_1" )
 
 		++thiz->clientRefs;
@@ -114,7 +113,8 @@ void WXMPFiles_IncrementRefCount_1 ( XMPFilesRef xmpObjRef )
 
 void WXMPFiles_DecrementRefCount_1 ( XMPFilesRef xmpObjRef )
 {
-	WXMP_Result * wResult = &voidResult;	// ! Needed to "fool" the EnterWrapper macro.
+	WXMP_Result void_wResult;
+	WXMP_Result * wResult = &void_wResult;	// ! Needed to "fool" the EnterWrapper macro.
 	XMP_ENTER_ObjWrite ( XMPFiles, "WXMPFiles_DecrementRefCount_1" )
 
 		XMP_Assert ( thiz->clientRefs > 0 );
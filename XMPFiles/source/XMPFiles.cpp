@@ -159,6 +159,7 @@ XMPFiles::Initialize( XMP_OptionBits options, const char* pluginFolder, const ch
 
 	if ( ! Initialize_LibUtils() ) return false;
 	if ( ! ID3_Support::InitializeGlobals() ) return false;
+	if ( ! ISOMedia::InitializeGlobals() ) return false;
 
 	#if GatherPerformanceData
 		sAPIPerf = new APIPerfCollection;
@@ -188,7 +189,8 @@ XMPFiles::Initialize( XMP_OptionBits options, const char* pluginFolder, const ch
 		if ( pluginFolder != 0 ) {
 			std::string pluginList;
 			if ( plugins != 0 ) pluginList.assign ( plugins );
-			PluginManager::initialize ( pluginFolder, pluginList );  // Load file handler plugins.
+			bool noScan = XMP_OptionIsSet ( options, kXMPFiles_NoPluginScan );
+			PluginManager::initialize ( pluginFolder, pluginList, noScan );  // Load file handler plugins.
 		}
 	#endif
 
@@ -334,6 +336,9 @@ XMPFiles::XMPFiles()
 	, ioRef(0)
 	, openFlags(0)
 	, handler(0)
+	, handlerCTor(0)
+	, spareHandler(0)
+	, spareCTor(0)
 	, tempPtr(0)
 	, tempUI32(0)
 	, abortProc(0)
@@ -375,6 +380,76 @@ static inline void CloseLocalFile ( XMPFiles* thiz )
 
 // =================================================================================================
 
+static const XMP_Uns32 kLocalReadBufferSize = 64*1024;
+
+static inline void BufferLocalFile ( XMPFiles* thiz )
+{
+	if ( ! thiz->UsesLocalIO() ) return;
+	XMPFiles_IO* localFile = (XMPFiles_IO*)thiz->ioRef;
+	if ( localFile == 0 ) return;
+
+	if ( thiz->openFlags & kXMPFiles_OpenMapFile ) localFile->MapFile();	// Only maps read-only files.
+	if ( thiz->openFlags & kXMPFiles_OpenBufferedRead ) localFile->SetReadBuffer ( kLocalReadBufferSize );
+
+}	// BufferLocalFile
+
+// =================================================================================================
+
+// Create the handler for an open, reusing the spare handler if it was made by the same constructor.
+// Spares are only kept from read-only opens, so they are only reused for read-only opens.
+
+static XMPFileHandler * NewHandler ( XMPFiles * thiz, XMPFileHandlerCTor handlerCTor, bool readOnly )
+{
+	XMPFileHandler * handler = thiz->spareHandler;
+	thiz->spareHandler = 0;
+	thiz->handlerCTor = handlerCTor;
+
+	if ( handler != 0 ) {
+		if ( readOnly && (thiz->spareCTor == handlerCTor) ) {
+			#if GatherPerformanceData
+				sAPIPerf->back().extraInfo += ", reused handler";
+			#endif
+			return handler;
+		}
+		delete handler;
+	}
+
+	return (*handlerCTor) ( thiz );
+
+}	// NewHandler
+
+// =================================================================================================
+
+// Delete the handler of a closing file, or keep it as the spare if it was opened read-only and can
+// be reset.
+
+static void ReleaseHandler ( XMPFiles * thiz )
+{
+	XMPFileHandler * handler = thiz->handler;
+	thiz->handler = 0;
+
+	bool keep = XMP_OptionIsClear ( thiz->openFlags, kXMPFiles_OpenForUpdate ) && (! handler->needsUpdate);
+	if ( keep ) {
+		try {
+			keep = handler->Reset();
+		} catch ( ... ) {
+			keep = false;
+		}
+	}
+
+	if ( ! keep ) {
+		delete handler;
+		return;
+	}
+
+	if ( thiz->spareHandler != 0 ) delete thiz->spareHandler;
+	thiz->spareHandler = handler;
+	thiz->spareCTor = thiz->handlerCTor;
+
+}	// ReleaseHandler
+
+// =================================================================================================
+
 XMPFiles::~XMPFiles() NO_EXCEPT_FALSE
 {
 	XMP_FILES_START
@@ -384,6 +459,10 @@ XMPFiles::~XMPFiles() NO_EXCEPT_FALSE
 		delete this->handler;
 		this->handler = 0;
 	}
+	if ( this->spareHandler != 0 ) {
+		delete this->spareHandler;
+		this->spareHandler = 0;
+	}
 
 	CloseLocalFile ( this );
 
@@ -945,6 +1024,10 @@ DoOpenFile ( XMPFiles *     thiz,
 			XMP_Throw ( "OptimizeFileLayout requires OpenForUpdate", kXMPErr_BadParam );
 	}
 
+	if ( (openFlags & kXMPFiles_OpenSkipReconcile) && (openFlags & kXMPFiles_OpenForUpdate) ) {
+			XMP_Throw ( "Skipping legacy metadata requires a read-only open", kXMPErr_BadParam );	// ! The update would lose it.
+	}
+
 	if ( thiz->handler != 0 ) XMP_Throw ( "File already open", kXMPErr_BadParam );
 	CloseLocalFile ( thiz );	// Sanity checks if prior call failed.
 
@@ -1061,7 +1144,7 @@ DoOpenFile ( XMPFiles *     thiz,
 				 (handlerFlags & kXMPFiles_FolderBasedFormat) );
 
 	if ( thiz->format == kXMP_UnknownFile ) thiz->format = handlerInfo->format;	// ! The CheckProc might have set it.
-	XMPFileHandler* handler = (*handlerCTor) ( thiz );
+	XMPFileHandler* handler = NewHandler ( thiz, handlerCTor, readOnly );
 	XMP_Assert ( handlerFlags == handler->handlerFlags );
 
 	thiz->handler = handler;
@@ -1073,6 +1156,7 @@ DoOpenFile ( XMPFiles *     thiz,
 				XMP_Throw ( "Open, file permission error", kXMPErr_FilePermission );
 			}
 		}
+		BufferLocalFile ( thiz );
 		handler->CacheFileData();
 	} catch ( ... ) {
 		delete thiz->handler;
@@ -1108,6 +1192,10 @@ static bool DoOpenFile( XMPFiles* thiz,
 			XMP_Throw ( "OptimizeFileLayout requires OpenForUpdate", kXMPErr_BadParam );
 	}
 
+	if ( (openFlags & kXMPFiles_OpenSkipReconcile) && (openFlags & kXMPFiles_OpenForUpdate) ) {
+			XMP_Throw ( "Skipping legacy metadata requires a read-only open", kXMPErr_BadParam );	// ! The update would lose it.
+	}
+
 	if ( thiz->handler != 0 ) XMP_Throw ( "File already open", kXMPErr_BadParam );
 
 	//
@@ -1124,11 +1212,12 @@ static bool DoOpenFile( XMPFiles* thiz,
 	XMPFileHandlerCTor handlerCTor	= hdlInfo.handlerCTor;
 	XMP_OptionBits handlerFlags		= hdlInfo.flags;
 
-	XMPFileHandler* handler			= (*handlerCTor) ( thiz );
+	bool readOnly = XMP_OptionIsClear ( openFlags, kXMPFiles_OpenForUpdate );
+
+	XMPFileHandler* handler			= NewHandler ( thiz, handlerCTor, readOnly );
 	XMP_Assert ( handlerFlags == handler->handlerFlags );
 
 	thiz->handler = handler;
-	bool readOnly = XMP_OptionIsClear ( openFlags, kXMPFiles_OpenForUpdate );
 
 	if ( thiz->ioRef == 0 ) {	//Need to open the file if not done already
 		thiz->ioRef = XMPFiles_IO::New_XMPFiles_IO ( clientPath, readOnly );
@@ -1139,6 +1228,7 @@ static bool DoOpenFile( XMPFiles* thiz,
 	//
 	try 
 	{
+		BufferLocalFile ( thiz );
 		handler->CacheFileData();
 
 		if( handler->containsXMP ) 
@@ -1276,8 +1366,7 @@ XMPFiles::CloseFile ( XMP_OptionBits closeFlags /* = 0 */ )
 				this->handler->UpdateFile ( doSafeUpdate );
 			}
 
-			delete this->handler;
-			this->handler = 0;
+			ReleaseHandler ( this );
 			CloseLocalFile ( this );
 
 		} else {
@@ -20,7 +20,9 @@
 #include "source/SafeStringAPIs.h"
 #include "source/XMP_ProgressTracker.hpp"
 
+class XMPFiles;
 class XMPFileHandler;
+typedef XMPFileHandler * (* XMPFileHandlerCTor) ( XMPFiles * parent );
 namespace Common{ struct XMPFileHandlerInfo; }
 
 // =================================================================================================
@@ -67,6 +69,7 @@ namespace Common{ struct XMPFileHandlerInfo; }
 //		- The physical file is opened via LFA_OpenFile.
 //		- A handler is selected by calling the registered format checkers.
 //		- The handler object is created by calling the registered constructor proc.
+//		- A read-only open reuses the handler kept by CloseFile if it has the same constructor proc.
 //
 //	CloseFile:
 //		- Return if there is no open file (not an error).
@@ -87,7 +90,7 @@ namespace Common{ struct XMPFileHandlerInfo; }
 //			- Close both the original and temp files.
 //			- Delete the file with the original name.
 //			- Rename the temp file to the original name.
-//		- Delete the handler object.
+//		- Delete the handler object, or keep it for the next open if it was read-only and can Reset.
 //		- Call LFA_Close if necessary.
 //
 //	GetFileInfo:
@@ -293,6 +296,9 @@ public:
 	XMP_IO *				ioRef;		// Non-zero if a file is open.
 	XMP_OptionBits			openFlags;
 	XMPFileHandler *		handler;	// Non-null if a file is open.
+	XMPFileHandlerCTor		handlerCTor;	// The constructor of the handler, to match the spare handler.
+	XMPFileHandler *		spareHandler;	// A reset read-only handler kept by CloseFile for the next open.
+	XMPFileHandlerCTor		spareCTor;
 	void *					tempPtr;	// For use between the CheckProc and handler creation.
 	XMP_Uns32				tempUI32;
 	XMP_AbortProc			abortProc;
@@ -498,6 +498,27 @@ void XMPFileHandler::ProcessXMP()
 
 }	// XMPFileHandler::ProcessXMP
 
+// =================================================================================================
+// XMPFileHandler::ResetCommonState
+// ================================
+//
+// Clear the common per-file state for a handler's Reset. The packet string keeps its capacity and
+// the XMP object keeps its node arena, so the next file mostly reuses the allocations.
+
+void XMPFileHandler::ResetCommonState()
+{
+
+	this->containsXMP = false;
+	this->processedXMP = false;
+	this->needsUpdate = false;
+	this->needsArtUpdate = false;
+
+	this->packetInfo = XMP_PacketInfo();
+	this->xmpPacket.clear();
+	this->xmpObj.Erase();
+
+}	// XMPFileHandler::ResetCommonState
+
 // =================================================================================================
 // XMPFileHandler::GetSerializeOptions
 // ===================================
@@ -94,6 +94,9 @@ extern XMP_Int32 sXMPFilesInitCount;
 	#define StartPerfCheck(proc,info)	/* do nothing */
 	#define EndPerfCheck(proc)	/* do nothing */
 
+	#define StartPhaseCheck(phase)	/* do nothing */
+	#define EndPhaseCheck(phase,name)	/* do nothing */
+
 #else
 
 	#include "PerfUtils.hpp"
@@ -140,6 +143,21 @@ extern XMP_Int32 sXMPFilesInitCount;
 		throw;																		\
 	}
 
+	// The phases of a call, such as the legacy reconciliation steps of opening a JPEG, are timed
+	// separately and added to the extra info of the call, e.g. ", IPTC digest 12us".
+
+	static inline void AddPhaseTime ( PerfUtils::MomentValue startTime, const char * name )
+	{
+		if ( (sAPIPerf == 0) || sAPIPerf->empty() ) return;
+		double elapsed = PerfUtils::GetElapsedSeconds ( startTime, PerfUtils::NoteThisMoment() );
+		char buffer [100];
+		snprintf ( buffer, sizeof(buffer), ", %s %ldus", name, (long) ((elapsed * 1000.0*1000.0) + 0.5) );
+		sAPIPerf->back().extraInfo += buffer;
+	}
+
+	#define StartPhaseCheck(phase)	PerfUtils::MomentValue phase##Start = PerfUtils::NoteThisMoment()
+	#define EndPhaseCheck(phase,name)	AddPhaseTime ( phase##Start, name )
+
 #endif
 
 // **** See CTECHXMP-4169947 *****
@@ -309,9 +327,15 @@ public:
 	virtual void SetErrorCallback ( ErrorCallbackBox /*errorCallbackBox*/ ) {}
 	virtual void SetProgressCallback ( XMP_ProgressTracker::CallbackInfo * /*progCBInfoPtr*/ ) {}
 
+	// Called by CloseFile after a read-only open. Return true if the handler cleared its file state
+	// and can be used for the next read-only open of the same format. The default is not reusable.
+	virtual bool Reset() { return false; }
+
 
 	static void NotifyClient(GenericErrorCallback * errCBptr, XMP_ErrorSeverity severity, XMP_Error & error);
 
+	void ResetCommonState();	// For Reset, clears the members below, keeping the allocations.
+
 	// ! Leave the data members public so common code can see them.
 
 	XMPFiles *     parent;			// Let's the handler see the file info.
@@ -329,8 +353,6 @@ public:
 	SXMPMeta				xmpObj;
 };	// XMPFileHandler
 
-typedef XMPFileHandler * (* XMPFileHandlerCTor) ( XMPFiles * parent );
-
 typedef bool (* CheckFileFormatProc ) ( XMP_FileFormat format,
 									   XMP_StringPtr  filePath,
 									   XMP_IO *       fileRef,
@@ -41,9 +41,17 @@
 #include "xmp.h"
 #include "xmperrors.h"
 
+#include <atomic>
 #include <string>
 #include <iostream>
 #include <memory>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
 
 #define XMP_INCLUDE_XMPFILES 1
 #define TXMP_STRING_TYPE std::string
@@ -586,6 +594,164 @@ XmpFileType xmp_files_check_file_format(const char *filePath)
     return file_type;
 }
 
+// Stop handing out files and record why the batch failed. Only the first
+// failure is kept, it is reported by the calling thread.
+static void stop_xmp_batch(size_t count, std::atomic<size_t> *next,
+                           std::atomic<int> *failure, int error)
+{
+    *next = count;
+    int none = 0;
+    failure->compare_exchange_strong(none, error);
+}
+
+// Read the files of a batch, taking the next index from next until there is
+// none left. The file and meta objects are reused from one file to the next.
+// An exception for a file is passed to the callback as its error, anything
+// else, like the callback throwing, stops the batch.
+static void get_xmp_batch_loop(const char *const *paths, size_t count,
+                               XMP_OptionBits options,
+                               std::atomic<size_t> *next,
+                               std::atomic<int> *failure,
+                               XmpFilesBatchCallback callback, void *user_data)
+{
+    try {
+        auto txf = std::unique_ptr<SXMPFiles>(new SXMPFiles);
+        SXMPMeta xmp;
+
+        for (size_t index = (*next)++; index < count; index = (*next)++) {
+            const char *path = paths[index];
+            int error = 0;
+            bool have_xmp = false;
+            try {
+                if (txf->OpenFile(path, XMP_FT_UNKNOWN, options)) {
+                    have_xmp = txf->GetXMP(&xmp);
+                } else {
+                    error = XMPErr_NoFileHandler;
+                }
+                txf->CloseFile();
+            }
+            catch (const XMP_Error &e) {
+                error = -e.GetID();
+            }
+            catch (const std::bad_alloc &) {
+                error = XMPErr_NoMemory;
+            }
+            catch (...) {
+                error = XMPErr_UnknownException;
+            }
+            if (error != 0 && error != XMPErr_NoFileHandler) {
+                // Start over with a clean file object after a failure.
+                txf.reset(new SXMPFiles);
+            }
+            callback(index, path,
+                     have_xmp ? reinterpret_cast<XmpPtr>(&xmp) : NULL, error,
+                     user_data);
+        }
+    }
+    catch (const std::bad_alloc &) {
+        stop_xmp_batch(count, next, failure, XMPErr_NoMemory);
+    }
+    catch (...) {
+        stop_xmp_batch(count, next, failure, XMPErr_UnknownException);
+    }
+}
+
+static bool get_xmp_batch(const char *const *paths, size_t count,
+                          XmpOpenFileOptions options, unsigned int threads,
+                          XmpFilesBatchCallback callback, void *user_data)
+{
+    if (options & XMP_OPEN_FORUPDATE) {
+        set_error(XMPErr_BadOptions);
+        return false;
+    }
+    XMP_OptionBits open_options = options | XMP_OPEN_READ;
+
+    std::atomic<size_t> next(0);
+    std::atomic<int> failure(0);
+    if (threads > count) {
+        threads = count;
+    }
+    if (threads <= 1) {
+        get_xmp_batch_loop(paths, count, open_options, &next, &failure,
+                           callback, user_data);
+    } else {
+        std::vector<std::thread> workers;
+        try {
+            workers.reserve(threads);
+            for (unsigned int i = 0; i < threads; i++) {
+                workers.push_back(std::thread(get_xmp_batch_loop, paths, count,
+                                              open_options, &next, &failure,
+                                              callback, user_data));
+            }
+        }
+        catch (const std::system_error &) {
+            stop_xmp_batch(count, &next, &failure, XMPErr_Unavailable);
+        }
+        catch (const std::bad_alloc &) {
+            stop_xmp_batch(count, &next, &failure, XMPErr_NoMemory);
+        }
+        // The threads that did start finish the file they are on.
+        for (auto &worker : workers) {
+            worker.join();
+        }
+    }
+
+    if (failure != 0) {
+        set_error(failure);
+        return false;
+    }
+    return true;
+}
+
+API_EXPORT
+bool xmp_files_get_xmp_batch(const char *const *paths, size_t count,
+                             XmpOpenFileOptions options, unsigned int threads,
+                             XmpFilesBatchCallback callback, void *user_data)
+{
+    CHECK_PTR(paths, false);
+    CHECK_PTR(callback, false);
+    RESET_ERROR;
+
+    return get_xmp_batch(paths, count, options, threads, callback, user_data);
+}
+
+API_EXPORT
+bool xmp_files_get_xmp_dir(const char *dir, XmpOpenFileOptions options,
+                           unsigned int threads,
+                           XmpFilesBatchCallback callback, void *user_data)
+{
+    CHECK_PTR(dir, false);
+    CHECK_PTR(callback, false);
+    RESET_ERROR;
+
+    DIR *d = opendir(dir);
+    if (d == NULL) {
+        set_error(XMPErr_BadParam);
+        return false;
+    }
+    std::vector<std::string> files;
+    std::string base(dir);
+    if (!base.empty() && base.back() != '/') {
+        base += '/';
+    }
+    struct dirent *entry;
+    while ((entry = readdir(d)) != NULL) {
+        std::string path = base + entry->d_name;
+        struct stat info;
+        if (stat(path.c_str(), &info) == 0 && S_ISREG(info.st_mode)) {
+            files.push_back(path);
+        }
+    }
+    closedir(d);
+
+    std::vector<const char *> paths;
+    for (auto &file : files) {
+        paths.push_back(file.c_str());
+    }
+    return get_xmp_batch(paths.data(), paths.size(), options, threads, callback,
+                         user_data);
+}
+
 API_EXPORT
 XmpPtr xmp_new_empty()
 {
@@ -643,6 +809,25 @@ bool xmp_parse(XmpPtr xmp, const char *buffer, size_t len)
     return true;
 }
 
+API_EXPORT
+bool xmp_parse_with_options(XmpPtr xmp, const char *buffer, size_t len,
+                            uint32_t options)
+{
+    CHECK_PTR(xmp, false);
+    CHECK_PTR(buffer, false);
+
+    SXMPMeta *txmp = (SXMPMeta *)xmp;
+    try {
+        // The whole packet is in the buffer, never wait for more.
+        txmp->ParseFromBuffer(buffer, len, options & ~kXMP_ParseMoreBuffers);
+    }
+    catch (const XMP_Error &e) {
+        set_error(e);
+        return false;
+    }
+    return true;
+}
+
 API_EXPORT
 bool xmp_serialize(XmpPtr xmp, XmpStringPtr buffer, uint32_t options,
                    uint32_t padding)
@@ -705,6 +890,126 @@ bool xmp_get_property(XmpPtr xmp, const char *schema, const char *name,
     return ret;
 }
 
+API_EXPORT
+XmpAtomPtr xmp_atom_new(const char *schema, const char *name)
+{
+    CHECK_PTR(schema, NULL);
+    CHECK_PTR(name, NULL);
+    RESET_ERROR;
+
+    try {
+        return reinterpret_cast<XmpAtomPtr>(
+            SXMPMeta::ResolvePropertyAtom(schema, name));
+    }
+    catch (const XMP_Error &e) {
+        set_error(e);
+    }
+    return NULL;
+}
+
+API_EXPORT
+bool xmp_atom_free(XmpAtomPtr atom)
+{
+    CHECK_PTR(atom, false);
+    RESET_ERROR;
+
+    try {
+        SXMPMeta::ReleasePropertyAtom(reinterpret_cast<XMPPropertyAtomRef>(atom));
+    }
+    catch (const XMP_Error &e) {
+        set_error(e);
+        return false;
+    }
+    return true;
+}
+
+API_EXPORT
+bool xmp_get_property_atom(XmpPtr xmp, XmpAtomPtr atom, XmpStringPtr property,
+                           uint32_t *propsBits)
+{
+    CHECK_PTR(xmp, false);
+    CHECK_PTR(atom, false);
+    RESET_ERROR;
+
+    bool ret = false;
+    try {
+        auto txmp = reinterpret_cast<const SXMPMeta *>(xmp);
+        XMP_OptionBits optionBits;
+        ret = txmp->GetPropertyByAtom(reinterpret_cast<XMPPropertyAtomRef>(atom),
+                                      STRING(property), &optionBits);
+        if (propsBits) {
+            *propsBits = optionBits;
+        }
+    }
+    catch (const XMP_Error &e) {
+        set_error(e);
+    }
+    return ret;
+}
+
+API_EXPORT
+bool xmp_set_property_atom(XmpPtr xmp, XmpAtomPtr atom, const char *value,
+                           uint32_t optionBits)
+{
+    CHECK_PTR(xmp, false);
+    CHECK_PTR(atom, false);
+    RESET_ERROR;
+
+    bool ret = false;
+    auto txmp = reinterpret_cast<SXMPMeta *>(xmp);
+    // see xmp_set_property()
+    if ((optionBits & (XMP_PROP_VALUE_IS_STRUCT | XMP_PROP_VALUE_IS_ARRAY)) &&
+        value && (*value == 0)) {
+        value = NULL;
+    }
+    try {
+        txmp->SetPropertyByAtom(reinterpret_cast<XMPPropertyAtomRef>(atom),
+                                value, optionBits);
+        ret = true;
+    }
+    catch (const XMP_Error &e) {
+        set_error(e);
+    }
+    catch (...) {
+    }
+    return ret;
+}
+
+API_EXPORT
+bool xmp_get_properties_atom(const XmpPtr *xmps, uint32_t count,
+                             const XmpAtomPtr *atoms, uint32_t atom_count,
+                             uint32_t *offsets, char *bytes,
+                             uint32_t bytes_size, uint32_t *props_bits,
+                             uint8_t *present, uint32_t *bytes_needed)
+{
+    CHECK_PTR(offsets, false);
+    if (count) {
+        CHECK_PTR(xmps, false);
+    }
+    RESET_ERROR;
+
+    bool ret = false;
+    try {
+        std::vector<XMPMetaRef> refs(count);
+        for (uint32_t i = 0; i < count; i++) {
+            CHECK_PTR(xmps[i], false);
+            refs[i] = reinterpret_cast<const SXMPMeta *>(xmps[i])->GetInternalRef();
+        }
+        uint32_t needed = SXMPMeta::GetPropertiesByAtom(
+            refs.data(), count,
+            reinterpret_cast<const XMPPropertyAtomRef *>(atoms), atom_count,
+            offsets, bytes, bytes_size, props_bits, present);
+        if (bytes_needed) {
+            *bytes_needed = needed;
+        }
+        ret = (needed <= bytes_size);
+    }
+    catch (const XMP_Error &e) {
+        set_error(e);
+    }
+    return ret;
+}
+
 API_EXPORT
 bool xmp_get_property_date(XmpPtr xmp, const char *schema, const char *name,
                            XmpDateTime *property, uint32_t *propsBits)
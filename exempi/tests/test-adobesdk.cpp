@@ -5,11 +5,26 @@
 
 #include <math.h>
 
+#include <atomic>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <boost/test/unit_test.hpp>
 
 #include "../../XMPCore/source/XMPUtils.hpp"
+#include "../../XMPFiles/source/XMPFiles.hpp"
+#include "../../XMPFiles/source/FileHandlers/Scanner_Handler.hpp"
+#include "../../XMPFiles/source/FormatSupport/MOOV_Support.hpp"
 #include "../source/EndianUtils.hpp"
 
+#if XMP_UNIXBuild
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+
 using boost::unit_test::test_suite;
 
 struct Fixture {
@@ -139,4 +154,602 @@ BOOST_AUTO_TEST_CASE(test_getFloat)
   BOOST_CHECK(resultD == (double)M_PI);
 }
 
+// Parse with and without the single pass parser, the results must be the same.
+static void checkSinglePassParity(const std::string& packet)
+{
+  XMPMeta twoPass;
+  XMPMeta singlePass;
+  twoPass.ParseFromBuffer(packet.c_str(), packet.size(), 0);
+  singlePass.ParseFromBuffer(packet.c_str(), packet.size(), kXMP_ParseSinglePass);
+
+  XMP_VarString twoPassOut;
+  XMP_VarString singlePassOut;
+  twoPass.SerializeToBuffer(&twoPassOut, kXMP_OmitPacketWrapper, 0, "", "", 0);
+  singlePass.SerializeToBuffer(&singlePassOut, kXMP_OmitPacketWrapper, 0, "", "", 0);
+  BOOST_CHECK_EQUAL(twoPassOut, singlePassOut);
+}
+
+#define RDF_HEADER "<x:xmpmeta xmlns:x=\"adobe:ns:meta/\">" \
+  "<rdf:RDF xmlns:rdf=\"http://www.w3.org/1999/02/22-rdf-syntax-ns#\">"
+#define RDF_FOOTER "</rdf:RDF></x:xmpmeta>"
+
+BOOST_AUTO_TEST_CASE(test_singlePassParse)
+{
+  // Arrays, alt-text, attributes and struct forms.
+  checkSinglePassParity(RDF_HEADER
+    "<rdf:Description rdf:about=\"\" xmlns:dc=\"http://purl.org/dc/elements/1.1/\""
+    " xmlns:xmp=\"http://ns.adobe.com/xap/1.0/\""
+    " xmlns:xmpRights=\"http://ns.adobe.com/xap/1.0/rights/\""
+    " xmlns:exif=\"http://ns.adobe.com/exif/1.0/\" xmp:Rating=\"3\">"
+    "<dc:creator><rdf:Seq><rdf:li>Alice</rdf:li><rdf:li>Bob</rdf:li></rdf:Seq></dc:creator>"
+    "<dc:subject><rdf:Bag><rdf:li>a</rdf:li><rdf:li/></rdf:Bag></dc:subject>"
+    "<dc:title><rdf:Alt><rdf:li xml:lang=\"fr\">Titre</rdf:li>"
+    "<rdf:li xml:lang=\"x-default\">Title</rdf:li></rdf:Alt></dc:title>"
+    "<xmpRights:UsageTerms xml:lang=\"en\">Free</xmpRights:UsageTerms>"
+    "<exif:Flash rdf:parseType=\"Resource\"><exif:Fired>False</exif:Fired>"
+    "<exif:Mode>2</exif:Mode></exif:Flash>"
+    "<exif:OECF><rdf:Description exif:Columns=\"2\"><exif:Rows>1</exif:Rows>"
+    "</rdf:Description></exif:OECF>"
+    "<xmp:Label rdf:resource=\"http://example.com/\"/>"
+    "<xmp:Nickname exif:Fired=\"True\" exif:Mode=\"1\"/>"
+    "<xmp:BaseURL></xmp:BaseURL>"
+    "</rdf:Description>"
+    RDF_FOOTER);
+
+  // rdf:value qualifiers and typed nodes.
+  checkSinglePassParity(RDF_HEADER
+    "<rdf:Description rdf:about=\"\" xmlns:ns1=\"http://ns.figuiere.net/exempi/test/\">"
+    "<ns1:Prop rdf:parseType=\"Resource\"><rdf:value>val</rdf:value>"
+    "<ns1:Qual>q</ns1:Qual></ns1:Prop>"
+    "<ns1:Typed><ns1:Type><ns1:Field>f</ns1:Field></ns1:Type></ns1:Typed>"
+    "</rdf:Description>"
+    RDF_FOOTER);
+
+  // Left to the two pass parser: parseType="Literal" and several rdf:RDF.
+  checkSinglePassParity(RDF_HEADER
+    "<rdf:Description rdf:about=\"\" xmlns:ns1=\"http://ns.figuiere.net/exempi/test/\">"
+    "<ns1:Prop1>one</ns1:Prop1>"
+    "<ns1:Prop2 rdf:parseType=\"Literal\">two</ns1:Prop2>"
+    "</rdf:Description>"
+    RDF_FOOTER);
+  checkSinglePassParity("<root>" RDF_HEADER
+    "<rdf:Description rdf:about=\"\" xmlns:ns1=\"http://ns.figuiere.net/exempi/test/\">"
+    "<ns1:Prop1>one</ns1:Prop1></rdf:Description>" RDF_FOOTER
+    "<rdf:RDF xmlns:rdf=\"http://www.w3.org/1999/02/22-rdf-syntax-ns#\"/></root>");
+
+  // No rdf:RDF at all, the XMP is empty.
+  checkSinglePassParity("<x:xmpmeta xmlns:x=\"adobe:ns:meta/\"/>");
+
+  // Malformed XML goes through the two pass parser, with the same outcome.
+  checkSinglePassParity(RDF_HEADER
+    "<rdf:Description rdf:about=\"\" xmlns:ns1=\"http://ns.figuiere.net/exempi/test/\">"
+    "<ns1:Prop1>one</ns1:Prop2></rdf:Description>" RDF_FOOTER);
+}
+
+// Lookups run under the read lock, concurrently, they must not build or update
+// the name indexes. Only writes and parsing do.
+BOOST_AUTO_TEST_CASE(test_nameIndexReaders)
+{
+  XMPMeta meta;
+  char name[32];
+  for (int i = 0; i < 100; i++) {
+    snprintf(name, sizeof(name), "Prop%d", i);
+    meta.SetProperty(kXMP_NS_CameraRaw, name, name, 0);
+  }
+  meta.DeleteProperty(kXMP_NS_CameraRaw, "Prop50");
+
+  XMP_Node* schema = meta.tree.children[0];
+  BOOST_REQUIRE(schema->childIndex != nullptr);
+  const XMP_Uns32 staleCount = schema->childIndex->changeCount;
+  BOOST_CHECK(staleCount != schema->children.ChangeCount());
+
+  std::atomic<int> mismatches(0);
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; t++) {
+    readers.push_back(std::thread([&meta, &mismatches]() {
+      char propName[32];
+      for (int round = 0; round < 20; round++) {
+        for (int i = 0; i < 100; i++) {
+          snprintf(propName, sizeof(propName), "Prop%d", i);
+          XMP_StringPtr value = nullptr;
+          XMP_StringLen len = 0;
+          XMP_OptionBits options = 0;
+          bool found = meta.GetProperty(kXMP_NS_CameraRaw, propName, &value, &len, &options);
+          if ((found != (i != 50)) || (found && (std::string(value, len) != propName))) {
+            mismatches++;
+          }
+        }
+      }
+    }));
+  }
+  for (size_t t = 0; t < readers.size(); t++) {
+    readers[t].join();
+  }
+  BOOST_CHECK_EQUAL(mismatches.load(), 0);
+  BOOST_CHECK_EQUAL(schema->childIndex->changeCount, staleCount);
+
+  // A write brings the index up to date.
+  meta.SetProperty(kXMP_NS_CameraRaw, "Prop50", "Prop50", 0);
+  BOOST_CHECK_EQUAL(schema->childIndex->changeCount, schema->children.ChangeCount());
+
+  // A parsed tree comes with its indexes.
+  std::string packet;
+  meta.SerializeToBuffer(&packet, 0, 0, "", "", 0);
+  XMPMeta parsed;
+  parsed.ParseFromBuffer(packet.c_str(), packet.size(), 0);
+  schema = parsed.tree.children[0];
+  BOOST_REQUIRE(schema->childIndex != nullptr);
+  BOOST_CHECK_EQUAL(schema->childIndex->changeCount, schema->children.ChangeCount());
+  BOOST_CHECK_EQUAL(schema->childIndex->itemCount, schema->children.size());
+}
+
+// Property atoms are read under the read lock too, they must not touch the index.
+BOOST_AUTO_TEST_CASE(test_atomReaders)
+{
+  XMPMeta meta;
+  std::vector<XMP_PropertyAtom*> atoms;
+  char name[32];
+  for (int i = 0; i < 100; i++) {
+    snprintf(name, sizeof(name), "Prop%d", i);
+    meta.SetProperty(kXMP_NS_CameraRaw, name, name, 0);
+    atoms.push_back(XMPMeta::ResolvePropertyAtom(kXMP_NS_CameraRaw, name));
+  }
+  meta.DeleteProperty(kXMP_NS_CameraRaw, "Prop50");
+
+  XMP_Node* schema = meta.tree.children[0];
+  BOOST_REQUIRE(schema->childIndex != nullptr);
+  const XMP_Uns32 staleCount = schema->childIndex->changeCount;
+  const size_t staleItems = schema->childIndex->itemCount;
+
+  std::atomic<int> mismatches(0);
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; t++) {
+    readers.push_back(std::thread([&meta, &atoms, &mismatches]() {
+      char propName[32];
+      for (int round = 0; round < 20; round++) {
+        for (int i = 0; i < 100; i++) {
+          snprintf(propName, sizeof(propName), "Prop%d", i);
+          XMP_StringPtr value = nullptr;
+          XMP_StringLen len = 0;
+          XMP_OptionBits options = 0;
+          bool found = meta.GetPropertyByAtom(*atoms[i], &value, &len, &options);
+          if ((found != (i != 50)) || (found && (std::string(value, len) != propName))) {
+            mismatches++;
+          }
+        }
+      }
+    }));
+  }
+  for (size_t t = 0; t < readers.size(); t++) {
+    readers[t].join();
+  }
+  BOOST_CHECK_EQUAL(mismatches.load(), 0);
+  BOOST_CHECK_EQUAL(schema->childIndex->changeCount, staleCount);
+  BOOST_CHECK_EQUAL(schema->childIndex->itemCount, staleItems);
+
+  for (size_t i = 0; i < atoms.size(); i++) {
+    delete atoms[i];
+  }
+}
+
+// The bulk read holds only the read locks as well.
+BOOST_AUTO_TEST_CASE(test_bulkAtomReaders)
+{
+  XMPMeta meta;
+  std::vector<XMP_PropertyAtom*> atoms;
+  char name[32];
+  for (int i = 0; i < 100; i++) {
+    snprintf(name, sizeof(name), "P%d%c", i % 10, 'a' + i / 10);
+    meta.SetProperty(kXMP_NS_CameraRaw, name, "v", 0);
+  }
+  for (int i = 0; i < 10; i++) {
+    snprintf(name, sizeof(name), "P%da", i);
+    atoms.push_back(XMPMeta::ResolvePropertyAtom(kXMP_NS_CameraRaw, name));
+  }
+  meta.DeleteProperty(kXMP_NS_CameraRaw, "P0a");
+
+  XMP_Node* schema = meta.tree.children[0];
+  BOOST_REQUIRE(schema->childIndex != nullptr);
+  const XMP_Uns32 staleCount = schema->childIndex->changeCount;
+
+  const XMPMeta* metas[] = { &meta, &meta };
+  std::atomic<int> mismatches(0);
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; t++) {
+    readers.push_back(std::thread([&metas, &atoms, &mismatches]() {
+      XMP_Uns32 offsets[21];
+      char bytes[20];
+      for (int round = 0; round < 50; round++) {
+        XMP_Uns32 needed = XMPMeta::GetPropertiesByAtom(metas, 2, atoms.data(), 10, offsets,
+                                                        bytes, sizeof(bytes), nullptr, nullptr);
+        if ((needed != 18) || (offsets[2] != 0)) {
+          mismatches++;
+        }
+      }
+    }));
+  }
+  for (size_t t = 0; t < readers.size(); t++) {
+    readers[t].join();
+  }
+  BOOST_CHECK_EQUAL(mismatches.load(), 0);
+  BOOST_CHECK_EQUAL(schema->childIndex->changeCount, staleCount);
+
+  for (size_t i = 0; i < atoms.size(); i++) {
+    delete atoms[i];
+  }
+}
+
+// Once the name table is full, new names get private atoms and are still found.
+BOOST_AUTO_TEST_CASE(test_nameAtomLimit)
+{
+  char name[32];
+  for (int i = 0; !NameAtomsFull(); i++) {
+    BOOST_REQUIRE(i <= kXMP_MaxNameAtoms);
+    snprintf(name, sizeof(name), "xmp:Filler%d", i);
+    InternNameAtom(name, strlen(name));
+  }
+  BOOST_CHECK(InternNameAtom("xmp:Overflow", strlen("xmp:Overflow")) == 0);
+
+  {
+    XMPMeta meta;
+    for (int i = 0; i < 40; i++) {
+      snprintf(name, sizeof(name), "Private%d", i);
+      meta.SetProperty(kXMP_NS_XMP, name, name, 0);
+    }
+    meta.SetStructField(kXMP_NS_XMP, "Private0Struct", kXMP_NS_XMP, "Field", "value", 0);
+
+    XMP_Node* schema = meta.tree.children[0];
+    BOOST_CHECK(schema->children[0]->name.IsPrivate());
+    BOOST_CHECK(schema->children[0]->name == "xmp:Private0");
+
+    XMP_StringPtr value = nullptr;
+    XMP_StringLen len = 0;
+    XMP_OptionBits options = 0;
+    BOOST_CHECK(meta.GetProperty(kXMP_NS_XMP, "Private39", &value, &len, &options));
+    BOOST_CHECK_EQUAL(std::string(value, len), "Private39");
+    BOOST_CHECK(meta.GetStructField(kXMP_NS_XMP, "Private0Struct", kXMP_NS_XMP, "Field",
+                                    &value, &len, &options));
+
+    XMP_PropertyAtom* atom = XMPMeta::ResolvePropertyAtom(kXMP_NS_XMP, "Private20");
+    BOOST_CHECK(atom->nameAtoms.empty());
+    BOOST_CHECK(meta.GetPropertyByAtom(*atom, &value, &len, &options));
+    BOOST_CHECK_EQUAL(std::string(value, len), "Private20");
+    delete atom;
+
+    std::string packet;
+    meta.SerializeToBuffer(&packet, 0, 0, "", "", 0);
+    XMPMeta parsed;
+    parsed.ParseFromBuffer(packet.c_str(), packet.size(), 0);
+    BOOST_CHECK(parsed.GetProperty(kXMP_NS_XMP, "Private39", &value, &len, &options));
+    BOOST_CHECK_EQUAL(std::string(value, len), "Private39");
+  }
+
+  // A new table comes with the next initialization.
+  XMPMeta::Terminate();
+  XMPMeta::Initialize();
+  BOOST_CHECK(!NameAtomsFull());
+}
+
+// The nodes come from the arena of their XMPMeta. A clone must not share them,
+// and nodes moved to another tree are copied into its arena.
+BOOST_AUTO_TEST_CASE(test_nodeArena)
+{
+  XMPMeta* orig = new XMPMeta;
+  const std::string bigValue(1000, 'x');
+  char name[32];
+  for (int i = 0; i < 100; i++) {
+    snprintf(name, sizeof(name), "Prop%d", i);
+    orig->SetProperty(kXMP_NS_CameraRaw, name, bigValue.c_str(), 0);
+  }
+  orig->SetProperty(kXMP_NS_XMP, "Rating", "5", 0);
+  orig->DeleteProperty(kXMP_NS_CameraRaw, "Prop0");
+  orig->SetProperty(kXMP_NS_CameraRaw, "Prop0", "reused", 0);
+
+  XMPMeta clone;
+  orig->Clone(&clone, 0);
+  delete orig;
+
+  XMP_StringPtr value = nullptr;
+  XMP_StringLen len = 0;
+  XMP_OptionBits options = 0;
+  BOOST_CHECK(clone.GetProperty(kXMP_NS_CameraRaw, "Prop0", &value, &len, &options));
+  BOOST_CHECK_EQUAL(std::string(value, len), "reused");
+
+  // The Camera Raw schema gets moved to the extended XMP.
+  XMP_VarString stdStr, extStr, digestStr;
+  XMPUtils::PackageForJPEG(clone, &stdStr, &extStr, &digestStr);
+  BOOST_CHECK(!extStr.empty());
+
+  XMPMeta full;
+  XMPMeta ext;
+  full.ParseFromBuffer(stdStr.c_str(), stdStr.size(), 0);
+  ext.ParseFromBuffer(extStr.c_str(), extStr.size(), 0);
+  XMPUtils::MergeFromJPEG(&full, ext);
+  BOOST_CHECK(full.GetProperty(kXMP_NS_CameraRaw, "Prop99", &value, &len, &options));
+  BOOST_CHECK_EQUAL(std::string(value, len), bigValue);
+
+  // A node can be moved within its tree only, a heap node anywhere.
+  XMP_Node* fullSchema = full.tree.children[0];
+  XMP_Node* extSchema = ext.tree.children[0];
+  BOOST_CHECK(fullSchema->children[0]->FitsParent(fullSchema));
+  BOOST_CHECK(!fullSchema->children[0]->FitsParent(extSchema));
+  BOOST_CHECK(!fullSchema->children[0]->FitsParent(nullptr));
+  XMP_Node* heapNode = new XMP_Node(0, "xmp:Heap", 0);
+  BOOST_CHECK(heapNode->FitsParent(extSchema));
+  delete heapNode;
+}
+
+#if XMP_UNIXBuild
+static void writeFile(const std::string& path, const std::string& content)
+{
+  FILE* file = fopen(path.c_str(), "w");
+  BOOST_REQUIRE(file);
+  fwrite(content.data(), 1, content.size(), file);
+  fclose(file);
+}
+
+static std::string pluginManifest(const char* flags)
+{
+  return std::string("<PluginResource Architecture=\"")
+#if XMP_64
+    + "x64"
+#else
+    + "x86"
+#endif
+    + "\"><Handler Name=\"net.figuiere.exempi.test\" Version=\"1.5\""
+      " HandlerType=\"NormalHandler\">"
+      "<CheckFormat Offset=\"0\" Length=\"4\" ByteSeq=\"ZZZ\n\"/>"
+      "<Extensions><Extension Name=\"zzz\"/></Extensions>"
+      "<HandlerFlags>" + flags + "</HandlerFlags></Handler></PluginResource>";
+}
+
+// On Linux a plugin module is only opened for its resource file until a
+// handler is used, an empty module does for the manifest.
+BOOST_AUTO_TEST_CASE(test_pluginCache)
+{
+  const XMP_FileFormat zzzFormat = 0x5A5A5A20;  // 'ZZZ '
+  const XMP_OptionBits options = kXMPFiles_IgnoreLocalText;
+  XMP_OptionBits flags = 0;
+
+  char dirTemplate[] = "/tmp/exempi-plugins-XXXXXX";
+  BOOST_REQUIRE(mkdtemp(dirTemplate));
+  const std::string dir(dirTemplate);
+  const std::string module = dir + "/test.xpi";
+  const std::string resources = dir + "/test.resources";
+  const std::string manifest = resources + "/XMPPLUGINUIDS.txt";
+  char cacheTemplate[] = "/tmp/exempi-cache-XXXXXX";
+  BOOST_REQUIRE(mkdtemp(cacheTemplate));
+  const std::string cacheHome(cacheTemplate);
+  const std::string cacheDir = cacheHome + "/exempi";
+  const char* oldCacheHome = getenv("XDG_CACHE_HOME");
+  const std::string savedCacheHome(oldCacheHome ? oldCacheHome : "");
+  BOOST_REQUIRE(setenv("XDG_CACHE_HOME", cacheHome.c_str(), 1) == 0);
+
+  writeFile(module, "");
+  BOOST_REQUIRE(mkdir(resources.c_str(), 0700) == 0);
+  writeFile(manifest,
+            pluginManifest("<HandlerFlag Name=\"kXMPFiles_CanInjectXMP\"/>"));
+
+  // The first scan writes the cache.
+  BOOST_REQUIRE(XMPFiles::Initialize(options, dir.c_str()));
+  BOOST_CHECK(XMPFiles::GetFormatInfo(zzzFormat, &flags));
+  BOOST_CHECK_EQUAL(flags, (XMP_OptionBits)kXMPFiles_CanInjectXMP);
+  XMPFiles::Terminate();
+
+  // One file in the cache folder, nothing new in the plugin folder.
+  std::string cache;
+  DIR* cacheFolder = opendir(cacheDir.c_str());
+  BOOST_REQUIRE(cacheFolder);
+  while (struct dirent* entry = readdir(cacheFolder)) {
+    if (entry->d_name[0] != '.') {
+      BOOST_CHECK(cache.empty());
+      cache = cacheDir + "/" + entry->d_name;
+    }
+  }
+  closedir(cacheFolder);
+  BOOST_CHECK(cache.compare(0, cacheDir.size() + 16, cacheDir + "/XMPPluginCache-") == 0);
+  BOOST_REQUIRE(access(cache.c_str(), R_OK) == 0);
+  BOOST_CHECK(access((dir + "/.XMPPluginCache").c_str(), F_OK) != 0);
+
+  // Unchanged plugins come from the cache, a scan would replace it.
+  struct stat cacheInfo, newCacheInfo;
+  BOOST_REQUIRE(stat(cache.c_str(), &cacheInfo) == 0);
+  flags = 0;
+  BOOST_REQUIRE(XMPFiles::Initialize(options, dir.c_str()));
+  BOOST_CHECK(XMPFiles::GetFormatInfo(zzzFormat, &flags));
+  BOOST_CHECK_EQUAL(flags, (XMP_OptionBits)kXMPFiles_CanInjectXMP);
+  XMPFiles::Terminate();
+  BOOST_REQUIRE(stat(cache.c_str(), &newCacheInfo) == 0);
+  BOOST_CHECK_EQUAL(newCacheInfo.st_ino, cacheInfo.st_ino);
+
+  // A changed manifest is read again.
+  writeFile(manifest,
+            pluginManifest("<HandlerFlag Name=\"kXMPFiles_CanInjectXMP\"/>"
+                           "<HandlerFlag Name=\"kXMPFiles_CanExpand\"/>"));
+  flags = 0;
+  BOOST_REQUIRE(XMPFiles::Initialize(options, dir.c_str()));
+  BOOST_CHECK(XMPFiles::GetFormatInfo(zzzFormat, &flags));
+  BOOST_CHECK_EQUAL(flags, (XMP_OptionBits)(kXMPFiles_CanInjectXMP | kXMPFiles_CanExpand));
+  XMPFiles::Terminate();
+
+  // Without scanning the cache is trusted, even with the plugin gone.
+  std::remove(manifest.c_str());
+  rmdir(resources.c_str());
+  std::remove(module.c_str());
+  BOOST_REQUIRE(XMPFiles::Initialize(options | kXMPFiles_NoPluginScan, dir.c_str()));
+  BOOST_CHECK(XMPFiles::GetFormatInfo(zzzFormat));
+  XMPFiles::Terminate();
+
+  // But not with a module outside of the plugin folder.
+  std::string cacheText;
+  {
+    std::ifstream in(cache.c_str());
+    std::getline(in, cacheText, '\0');
+  }
+  const std::string outside[] = { "/tmp/test.xpi", dir + "/../test.xpi" };
+  for (size_t i = 0; i < 2; i++) {
+    std::string badText(cacheText);
+    size_t pos = badText.find("module 1 " + module + "\n");
+    BOOST_REQUIRE(pos != std::string::npos);
+    badText.replace(pos + 9, module.size(), outside[i]);
+    writeFile(cache, badText);
+    BOOST_REQUIRE(XMPFiles::Initialize(options | kXMPFiles_NoPluginScan, dir.c_str()));
+    BOOST_CHECK(!XMPFiles::GetFormatInfo(zzzFormat));
+    XMPFiles::Terminate();
+  }
+  writeFile(cache, cacheText);
+
+  // A scan finds out the plugin is gone.
+  BOOST_REQUIRE(XMPFiles::Initialize(options, dir.c_str()));
+  BOOST_CHECK(!XMPFiles::GetFormatInfo(zzzFormat));
+  XMPFiles::Terminate();
+
+  // Nothing but the cache is left in its folder.
+  std::remove(cache.c_str());
+  BOOST_CHECK(rmdir(cacheDir.c_str()) == 0);
+  BOOST_CHECK(rmdir(cacheHome.c_str()) == 0);
+
+  // Without a usable cache folder every initialization scans, quietly.
+  writeFile(module, "");
+  BOOST_REQUIRE(mkdir(resources.c_str(), 0700) == 0);
+  writeFile(manifest,
+            pluginManifest("<HandlerFlag Name=\"kXMPFiles_CanInjectXMP\"/>"));
+  writeFile(cacheHome, "");
+  for (int i = 0; i < 2; i++) {
+    BOOST_REQUIRE(XMPFiles::Initialize(options, dir.c_str()));
+    BOOST_CHECK(XMPFiles::GetFormatInfo(zzzFormat));
+    XMPFiles::Terminate();
+  }
+  std::remove(cacheHome.c_str());
+  std::remove(manifest.c_str());
+  rmdir(resources.c_str());
+  std::remove(module.c_str());
+
+  if (oldCacheHome) {
+    setenv("XDG_CACHE_HOME", savedCacheHome.c_str(), 1);
+  } else {
+    unsetenv("XDG_CACHE_HOME");
+  }
+  BOOST_CHECK(rmdir(dir.c_str()) == 0);
+}
+
+// Small ranges so that packets cross the range splits, the result must be
+// the same as a single range scan.
+BOOST_AUTO_TEST_CASE(test_scanRanges)
+{
+  const std::string packet =
+    "<?xpacket begin=\"\xEF\xBB\xBF\" id=\"W5M0MpCehiHzreSzNTczkc9d\"?>"
+    "<x:xmpmeta xmlns:x=\"adobe:ns:meta/\"><rdf:RDF xmlns:rdf="
+    "\"http://www.w3.org/1999/02/22-rdf-syntax-ns#\"/></x:xmpmeta>"
+    "<?xpacket end=\"w\"?>";
+  const size_t fileLen = 4 * 1024 * 1024;
+  const size_t split = fileLen / 4;
+  const size_t offsets[] = { 1000, split - 60, 2 * split, 3 * split - 20,
+                             fileLen - packet.size() - 10 };
+  const size_t offsetCount = sizeof(offsets) / sizeof(offsets[0]);
+
+  std::string content(fileLen, '.');
+  for (size_t i = 0; i < offsetCount; i++) {
+    content.replace(offsets[i], packet.size(), packet);
+  }
+
+  char pathTemplate[] = "/tmp/exempi-scan-XXXXXX";
+  int fd = mkstemp(pathTemplate);
+  BOOST_REQUIRE(fd != -1);
+  close(fd);
+  const std::string path(pathTemplate);
+  writeFile(path, content);
+
+  XMPScanner::SnipInfoVector single;
+  XMPScanner::SnipInfoVector ranged;
+  ScanPathForPackets(path, fileLen, 1, 0, 0, &single);
+  ScanPathForPackets(path, fileLen, 4, 0, 0, &ranged);
+  std::remove(path.c_str());
+
+  BOOST_REQUIRE_EQUAL(single.size(), offsetCount);
+  BOOST_REQUIRE_EQUAL(ranged.size(), offsetCount);
+  for (size_t i = 0; i < offsetCount; i++) {
+    BOOST_CHECK_EQUAL(single[i].fOffset, (XMP_Int64)offsets[i]);
+    BOOST_CHECK_EQUAL(single[i].fLength, (XMP_Int64)packet.size());
+    BOOST_CHECK(single[i].fState == XMPScanner::eValidPacketSnip);
+    BOOST_CHECK_EQUAL(ranged[i].fOffset, single[i].fOffset);
+    BOOST_CHECK_EQUAL(ranged[i].fLength, single[i].fLength);
+    BOOST_CHECK(ranged[i].fState == single[i].fState);
+  }
+}
+#endif
+
+static void appendBox(std::string* box, const char* type,
+                      const std::string& content)
+{
+  const size_t size = 8 + content.size();
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    *box += (char)((size >> shift) & 0xFF);
+  }
+  box->append(type, 4);
+  *box += content;
+}
+
+// A 'moov' box rebuilt at the same size, the changed ranges must cover every
+// byte that differs and leave the untouched boxes out.
+BOOST_AUTO_TEST_CASE(test_moovChangedRanges)
+{
+  std::string xmp, udta, body, moov;
+  appendBox(&xmp, "XMP_", "<xmp/>");
+  appendBox(&xmp, "free", std::string(64, '\0'));
+  appendBox(&udta, "udta", xmp);
+  appendBox(&body, "mvhd", std::string(100, '\0'));
+  appendBox(&body, "iods", std::string(4096, 'I'));
+  body += udta;
+  appendBox(&moov, "moov", body);
+
+  MOOV_Manager moovMgr;
+  moovMgr.fullSubtree.assign(moov.begin(), moov.end());
+  moovMgr.ParseMemoryTree(MOOV_Manager::kFileIsModernQT);
+
+  // Change a field of 'mvhd' in place, grow the XMP into the padding.
+  MOOV_Manager::BoxInfo mvhdInfo;
+  MOOV_Manager::BoxRef mvhdRef = moovMgr.GetBox("moov/mvhd", &mvhdInfo);
+  BOOST_REQUIRE(mvhdRef);
+  ((XMP_Uns8*)mvhdInfo.content)[8] = 1;
+  moovMgr.NoteChange(mvhdRef);
+
+  const std::string newXMP("<xmp>0123456789/>");
+  MOOV_Manager::BoxRef udtaRef = moovMgr.GetBox("moov/udta", 0);
+  BOOST_REQUIRE(udtaRef);
+  moovMgr.SetBox("moov/udta/XMP_", newXMP.data(), newXMP.size());
+  const std::string padding(64 - (newXMP.size() - 6), '\0');
+  moovMgr.ISOBaseMedia_Manager::SetBox(
+    moovMgr.GetTypeChild(udtaRef, ISOMedia::k_free, 0), padding.data(),
+    padding.size());
+
+  moovMgr.UpdateMemoryTree();
+  BOOST_REQUIRE_EQUAL(moovMgr.fullSubtree.size(), moov.size());
+
+  const MOOV_Manager::ChangedRangeList& ranges = moovMgr.changedRanges;
+  size_t changedSize = 0;
+  for (size_t i = 0; i < ranges.size(); i++) {
+    changedSize += ranges[i].size;
+  }
+  BOOST_CHECK(changedSize < 200);
+  for (size_t pos = 0; pos < moov.size(); pos++) {
+    if ((XMP_Uns8)moov[pos] == moovMgr.fullSubtree[pos]) {
+      continue;
+    }
+    bool covered = false;
+    for (size_t i = 0; i < ranges.size(); i++) {
+      covered |= (pos >= ranges[i].offset) &&
+                 (pos < ranges[i].offset + ranges[i].size);
+    }
+    BOOST_CHECK_MESSAGE(covered, "changed byte " << pos << " not covered");
+  }
+
+  // A change that does not name its box covers everything.
+  moovMgr.NoteChange();
+  moovMgr.UpdateMemoryTree();
+  BOOST_REQUIRE_EQUAL(ranges.size(), 1U);
+  BOOST_CHECK_EQUAL(ranges[0].offset, 0U);
+  BOOST_CHECK_EQUAL(ranges[0].size, moov.size());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
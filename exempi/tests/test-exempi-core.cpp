@@ -45,6 +45,7 @@
 #include "utils.h"
 #include "xmpconsts.h"
 #include "xmp.h"
+#include "xmperrors.h"
 
 using boost::unit_test::test_suite;
 
@@ -235,3 +236,305 @@ BOOST_AUTO_TEST_CASE(test_exempi_core)
   BOOST_CHECK(!g_lt->check_leaks());
   BOOST_CHECK(!g_lt->check_errors());
 }
+
+// The single pass parser must give the same XMP as the default one.
+BOOST_AUTO_TEST_CASE(test_exempi_core_parse_options)
+{
+  FILE *f = fopen(g_testfile.c_str(), "rb");
+  BOOST_REQUIRE(f != NULL);
+  fseek(f, 0, SEEK_END);
+  size_t len = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  std::string buffer(len, '\0');
+  BOOST_REQUIRE(fread(&buffer[0], 1, len, f) == len);
+  fclose(f);
+
+  BOOST_CHECK(xmp_init());
+
+  XmpPtr xmp = xmp_new_empty();
+  XmpPtr singlePass = xmp_new_empty();
+  BOOST_CHECK(xmp_parse(xmp, buffer.c_str(), len));
+  BOOST_CHECK(xmp_parse_with_options(
+    singlePass, buffer.c_str(), len,
+    XMP_PARSE_REQUIREXMPMETA | XMP_PARSE_SINGLEPASS));
+
+  XmpStringPtr expected = xmp_string_new();
+  XmpStringPtr output = xmp_string_new();
+  BOOST_CHECK(xmp_serialize(xmp, expected, XMP_SERIAL_OMITPACKETWRAPPER, 0));
+  BOOST_CHECK(
+    xmp_serialize(singlePass, output, XMP_SERIAL_OMITPACKETWRAPPER, 0));
+  BOOST_CHECK(xmp_string_len(expected) != 0);
+  BOOST_CHECK_EQUAL(std::string(xmp_string_cstr(output)),
+                    std::string(xmp_string_cstr(expected)));
+
+  // Still an error, the fallback parser reports it.
+  const char* notXML = "This is not even XML";
+  BOOST_CHECK(!xmp_parse_with_options(singlePass, notXML, strlen(notXML),
+                                      XMP_PARSE_SINGLEPASS));
+  BOOST_CHECK(xmp_get_error() != 0);
+
+  xmp_string_free(output);
+  xmp_string_free(expected);
+  BOOST_CHECK(xmp_free(singlePass));
+  BOOST_CHECK(xmp_free(xmp));
+
+  xmp_terminate();
+
+  BOOST_CHECK(!g_lt->check_leaks());
+  BOOST_CHECK(!g_lt->check_errors());
+}
+
+// Enough properties in a single schema for the lookups to go through the
+// name index, with deletions and re-insertions in between.
+BOOST_AUTO_TEST_CASE(test_exempi_core_many_properties)
+{
+  const char* ns = "http://ns.figuiere.net/exempi/test/";
+  const int count = 200;
+  char name[32];
+
+  BOOST_CHECK(xmp_init());
+  BOOST_CHECK(xmp_register_namespace(ns, "extest", NULL));
+
+  XmpPtr xmp = xmp_new_empty();
+  BOOST_CHECK(xmp != NULL);
+
+  for (int i = 0; i < count; i++) {
+    snprintf(name, sizeof(name), "Prop%d", i);
+    BOOST_CHECK(xmp_set_property(xmp, ns, name, name, 0));
+  }
+  for (int i = 0; i < count; i++) {
+    snprintf(name, sizeof(name), "Prop%d", i);
+    BOOST_CHECK(xmp_has_property(xmp, ns, name));
+  }
+  BOOST_CHECK(!xmp_has_property(xmp, ns, "Prop200"));
+
+  for (int i = 0; i < count; i += 2) {
+    snprintf(name, sizeof(name), "Prop%d", i);
+    BOOST_CHECK(xmp_delete_property(xmp, ns, name));
+  }
+  XmpStringPtr the_prop = xmp_string_new();
+  for (int i = 0; i < count; i++) {
+    snprintf(name, sizeof(name), "Prop%d", i);
+    BOOST_CHECK(xmp_has_property(xmp, ns, name) == ((i % 2) != 0));
+    if (i % 2) {
+      BOOST_CHECK(xmp_get_property(xmp, ns, name, the_prop, NULL));
+      BOOST_CHECK(strcmp(name, xmp_string_cstr(the_prop)) == 0);
+    }
+  }
+
+  // Qualifiers go through the same index.
+  for (int i = 0; i < 40; i++) {
+    snprintf(name, sizeof(name), "Prop1/?extest:Qual%d", i);
+    BOOST_CHECK(xmp_set_property(xmp, ns, name, name, 0));
+  }
+  BOOST_CHECK(xmp_get_property(xmp, ns, "Prop1/?extest:Qual33", the_prop, NULL));
+  BOOST_CHECK(strcmp("Prop1/?extest:Qual33", xmp_string_cstr(the_prop)) == 0);
+
+  XmpStringPtr output = xmp_string_new();
+  BOOST_CHECK(xmp_serialize(xmp, output, XMP_SERIAL_OMITPACKETWRAPPER, 0));
+  XmpPtr copy = xmp_new(xmp_string_cstr(output), xmp_string_len(output));
+  BOOST_CHECK(copy != NULL);
+  BOOST_CHECK(xmp_has_property(copy, ns, "Prop199"));
+  BOOST_CHECK(!xmp_has_property(copy, ns, "Prop198"));
+  BOOST_CHECK(xmp_get_property(copy, ns, "Prop1/?extest:Qual39", the_prop, NULL));
+  BOOST_CHECK(strcmp("Prop1/?extest:Qual39", xmp_string_cstr(the_prop)) == 0);
+
+  xmp_string_free(output);
+  xmp_string_free(the_prop);
+  BOOST_CHECK(xmp_free(copy));
+  BOOST_CHECK(xmp_free(xmp));
+
+  xmp_terminate();
+}
+
+BOOST_AUTO_TEST_CASE(test_exempi_core_property_atoms)
+{
+  size_t len;
+  char *buffer;
+
+  FILE *f = fopen(g_testfile.c_str(), "rb");
+  BOOST_CHECK(f != NULL);
+  if (f == NULL) {
+    exit(128);
+  }
+  fseek(f, 0, SEEK_END);
+  len = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  buffer = (char *)malloc(len + 1);
+  size_t rlen = fread(buffer, 1, len, f);
+  BOOST_CHECK(rlen == len);
+  fclose(f);
+
+  BOOST_CHECK(xmp_init());
+
+  XmpAtomPtr make = xmp_atom_new(NS_TIFF, "Make");
+  BOOST_CHECK(make != NULL);
+  // An alias, looked up through the actual property dc:creator[1].
+  XmpAtomPtr author = xmp_atom_new(NS_XAP, "Author");
+  BOOST_CHECK(author != NULL);
+  // Resolved before any packet has the property.
+  XmpAtomPtr software = xmp_atom_new(NS_TIFF, "Software");
+  BOOST_CHECK(software != NULL);
+  BOOST_CHECK(xmp_atom_new("http://ns.figuiere.net/exempi/unknown/", "Foo") == NULL);
+  BOOST_CHECK(xmp_get_error() == XMPErr_BadSchema);
+
+  XmpPtr xmp = xmp_new(buffer, len);
+  BOOST_CHECK(xmp != NULL);
+  free(buffer);
+
+  XmpStringPtr the_prop = xmp_string_new();
+  uint32_t bits = 0;
+  BOOST_CHECK(xmp_get_property_atom(xmp, make, the_prop, &bits));
+  BOOST_CHECK(strcmp("Canon", xmp_string_cstr(the_prop)) == 0);
+  BOOST_CHECK(XMP_IS_PROP_SIMPLE(bits));
+
+  BOOST_CHECK(xmp_get_property_atom(xmp, author, the_prop, NULL));
+  BOOST_CHECK(strcmp("unknown", xmp_string_cstr(the_prop)) == 0);
+
+  BOOST_CHECK(!xmp_get_property_atom(xmp, software, the_prop, NULL));
+  BOOST_CHECK(xmp_set_property(xmp, NS_TIFF, "Software", "exempi", 0));
+  BOOST_CHECK(xmp_get_property_atom(xmp, software, the_prop, NULL));
+  BOOST_CHECK(strcmp("exempi", xmp_string_cstr(the_prop)) == 0);
+
+  // The same atoms work with any packet.
+  XmpPtr empty = xmp_new_empty();
+  BOOST_CHECK(!xmp_get_property_atom(empty, make, the_prop, NULL));
+  BOOST_CHECK(xmp_set_property(empty, NS_TIFF, "Make", "Leica", 0));
+  BOOST_CHECK(xmp_get_property_atom(empty, make, the_prop, NULL));
+  BOOST_CHECK(strcmp("Leica", xmp_string_cstr(the_prop)) == 0);
+
+  BOOST_CHECK(!xmp_get_property_atom(xmp, NULL, the_prop, NULL));
+
+  // Set through atoms, struct fields are created as needed.
+  XmpAtomPtr fired = xmp_atom_new(NS_EXIF, "Flash/exif:Fired");
+  BOOST_CHECK(fired != NULL);
+  BOOST_CHECK(xmp_get_property_atom(xmp, fired, the_prop, NULL));
+  BOOST_CHECK(strcmp("False", xmp_string_cstr(the_prop)) == 0);
+  BOOST_CHECK(xmp_set_property_atom(xmp, fired, "True", 0));
+  BOOST_CHECK(xmp_get_property(xmp, NS_EXIF, "Flash/exif:Fired", the_prop,
+                               NULL));
+  BOOST_CHECK(strcmp("True", xmp_string_cstr(the_prop)) == 0);
+
+  BOOST_CHECK(!xmp_get_property_atom(empty, fired, the_prop, NULL));
+  BOOST_CHECK(xmp_set_property_atom(empty, fired, "False", 0));
+  BOOST_CHECK(xmp_get_property(empty, NS_EXIF, "Flash/exif:Fired", the_prop,
+                               &bits));
+  BOOST_CHECK(strcmp("False", xmp_string_cstr(the_prop)) == 0);
+  BOOST_CHECK(XMP_IS_PROP_SIMPLE(bits));
+
+  BOOST_CHECK(xmp_set_property_atom(empty, author, "Hubert", 0));
+  BOOST_CHECK(xmp_get_property(empty, NS_DC, "creator[1]", the_prop, NULL));
+  BOOST_CHECK(strcmp("Hubert", xmp_string_cstr(the_prop)) == 0);
+
+  // A field of a simple property is a bad path, as with a string path.
+  XmpAtomPtr bad_field = xmp_atom_new(NS_TIFF, "Make/tiff:Model");
+  BOOST_CHECK(bad_field != NULL);
+  BOOST_CHECK(!xmp_get_property_atom(xmp, bad_field, the_prop, NULL));
+  BOOST_CHECK(xmp_get_error() == XMPErr_BadXPath);
+  BOOST_CHECK(!xmp_set_property_atom(xmp, bad_field, "EOS", 0));
+  BOOST_CHECK(xmp_get_error() == XMPErr_BadXPath);
+  BOOST_CHECK(!xmp_set_property_atom(xmp, NULL, "EOS", 0));
+
+  xmp_string_free(the_prop);
+  BOOST_CHECK(xmp_free(empty));
+  BOOST_CHECK(xmp_free(xmp));
+  BOOST_CHECK(xmp_atom_free(make));
+  BOOST_CHECK(xmp_atom_free(author));
+  BOOST_CHECK(xmp_atom_free(software));
+  BOOST_CHECK(xmp_atom_free(fired));
+  BOOST_CHECK(xmp_atom_free(bad_field));
+  BOOST_CHECK(!xmp_atom_free(NULL));
+
+  xmp_terminate();
+}
+
+BOOST_AUTO_TEST_CASE(test_exempi_core_properties_atoms)
+{
+  size_t len;
+  char *buffer;
+
+  FILE *f = fopen(g_testfile.c_str(), "rb");
+  BOOST_CHECK(f != NULL);
+  if (f == NULL) {
+    exit(128);
+  }
+  fseek(f, 0, SEEK_END);
+  len = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  buffer = (char *)malloc(len + 1);
+  size_t rlen = fread(buffer, 1, len, f);
+  BOOST_CHECK(rlen == len);
+  fclose(f);
+
+  BOOST_CHECK(xmp_init());
+
+  XmpPtr xmps[2];
+  xmps[0] = xmp_new(buffer, len);
+  BOOST_CHECK(xmps[0] != NULL);
+  free(buffer);
+  xmps[1] = xmp_new_empty();
+  BOOST_CHECK(xmp_set_property(xmps[1], NS_TIFF, "Make", "Leica", 0));
+
+  XmpAtomPtr atoms[3];
+  atoms[0] = xmp_atom_new(NS_TIFF, "Make");
+  atoms[1] = xmp_atom_new(NS_EXIF, "Flash/exif:Fired");
+  atoms[2] = xmp_atom_new(NS_DC, "creator");
+
+  uint32_t offsets[7];
+  uint32_t bits[6];
+  uint8_t present = 0xff;
+  uint32_t needed = 0;
+
+  // Too small, only the size and the offsets.
+  BOOST_CHECK(!xmp_get_properties_atom(xmps, 2, atoms, 3, offsets, NULL, 0,
+                                       bits, &present, &needed));
+  BOOST_CHECK(xmp_get_error() == 0);
+  BOOST_CHECK(needed == strlen("CanonLeicaFalse"));
+  BOOST_CHECK(offsets[6] == needed);
+
+  // Cut short, the values before the first one that does not fit.
+  char short_bytes[8];
+  memset(short_bytes, '*', sizeof(short_bytes));
+  BOOST_CHECK(!xmp_get_properties_atom(xmps, 2, atoms, 3, offsets, short_bytes,
+                                       sizeof(short_bytes), NULL, NULL,
+                                       &needed));
+  BOOST_CHECK(needed == strlen("CanonLeicaFalse"));
+  BOOST_CHECK(std::string(short_bytes, sizeof(short_bytes)) == "Canon***");
+
+  char bytes[32];
+  BOOST_CHECK(xmp_get_properties_atom(xmps, 2, atoms, 3, offsets, bytes,
+                                      sizeof(bytes), bits, &present, &needed));
+  BOOST_CHECK(needed == strlen("CanonLeicaFalse"));
+  BOOST_CHECK(std::string(bytes, needed) == "CanonLeicaFalse");
+
+  // By column: Make for both packets, then Flash/Fired, then creator.
+  const uint32_t expected_offsets[] = { 0, 5, 10, 15, 15, 15, 15 };
+  for (int i = 0; i < 7; i++) {
+    BOOST_CHECK(offsets[i] == expected_offsets[i]);
+  }
+  BOOST_CHECK(present == 0x17);
+  BOOST_CHECK(XMP_IS_PROP_SIMPLE(bits[0]));
+  BOOST_CHECK(bits[3] == 0);
+  BOOST_CHECK(XMP_IS_PROP_ARRAY(bits[4]));
+  BOOST_CHECK(bits[5] == 0);
+
+  BOOST_CHECK(xmp_get_properties_atom(NULL, 0, atoms, 3, offsets, NULL, 0,
+                                      NULL, NULL, &needed));
+  BOOST_CHECK(needed == 0);
+  BOOST_CHECK(offsets[0] == 0);
+
+  XmpAtomPtr no_atoms[] = { atoms[0], NULL };
+  BOOST_CHECK(!xmp_get_properties_atom(xmps, 2, no_atoms, 2, offsets, NULL, 0,
+                                       NULL, NULL, NULL));
+  BOOST_CHECK(xmp_get_error() == XMPErr_BadParam);
+  BOOST_CHECK(!xmp_get_properties_atom(xmps, 2, atoms, 3, NULL, NULL, 0,
+                                       NULL, NULL, NULL));
+
+  for (int i = 0; i < 3; i++) {
+    BOOST_CHECK(xmp_atom_free(atoms[i]));
+  }
+  BOOST_CHECK(xmp_free(xmps[0]));
+  BOOST_CHECK(xmp_free(xmps[1]));
+
+  xmp_terminate();
+}
@@ -174,3 +174,91 @@ BOOST_AUTO_TEST_CASE(test_exempi_iterate)
   BOOST_CHECK(!g_lt->check_leaks());
   BOOST_CHECK(!g_lt->check_errors());
 }
+
+// The iterator walks the live tree, deleting the node it is on must let it
+// carry on with the next sibling.
+BOOST_AUTO_TEST_CASE(test_exempi_iterate_modify)
+{
+  size_t len;
+  char *buffer;
+
+  FILE *f = fopen(g_testfile.c_str(), "rb");
+
+  BOOST_CHECK(f != NULL);
+  if (f == NULL) {
+    exit(128);
+  }
+  fseek(f, 0, SEEK_END);
+  len = ftell(f);
+  fseek(f, 0, SEEK_SET);
+
+  buffer = (char *)malloc(len + 1);
+  size_t rlen = fread(buffer, 1, len, f);
+
+  BOOST_CHECK(rlen == len);
+  BOOST_CHECK(xmp_init());
+
+  XmpPtr xmp = xmp_new(buffer, len);
+  BOOST_CHECK(xmp != NULL);
+
+  XmpStringPtr the_schema = xmp_string_new();
+  XmpStringPtr the_path = xmp_string_new();
+  XmpStringPtr the_prop = xmp_string_new();
+  uint32_t options;
+
+  typedef std::array<std::string, 2> tuple2;
+
+  {
+    XmpIteratorPtr iter =
+      xmp_iterator_new(xmp, NS_DC, NULL, XMP_ITER_OMITQUALIFIERS);
+
+    BOOST_CHECK(iter);
+    std::vector<tuple2> props;
+
+    while (xmp_iterator_next(iter, the_schema, the_path, the_prop, &options)) {
+      std::string path = xmp_string_cstr(the_path);
+      props.push_back(tuple2 {{ path, xmp_string_cstr(the_prop) }});
+      if (path == "dc:rights") {
+        BOOST_CHECK(xmp_delete_property(xmp, NS_DC, "rights"));
+      } else if (path == "dc:subject[2]" && props.back()[1] == "ontario") {
+        BOOST_CHECK(xmp_delete_property(xmp, NS_DC, "subject[2]"));
+      }
+    }
+
+    // The schema node comes first, with an empty path.
+    BOOST_CHECK(props.size() == 9);
+    BOOST_CHECK(props[0] == (tuple2{{"", ""}}));
+    BOOST_CHECK(props[2] == (tuple2{{"dc:creator[1]", "unknown"}}));
+    BOOST_CHECK(props[3] == (tuple2{{"dc:rights", ""}}));
+    BOOST_CHECK(props[4] == (tuple2{{"dc:subject", ""}}));
+    BOOST_CHECK(props[6] == (tuple2{{"dc:subject[2]", "ontario"}}));
+    BOOST_CHECK(props[7] == (tuple2{{"dc:subject[2]", "ottawa"}}));
+    BOOST_CHECK(props[8] == (tuple2{{"dc:subject[3]", "parliament of canada"}}));
+
+    BOOST_CHECK(xmp_iterator_free(iter));
+  }
+
+  {
+    // Skipping in an empty iteration is harmless.
+    XmpIteratorPtr iter =
+      xmp_iterator_new(xmp, "http://ns.example.com/none/", NULL,
+                     XMP_ITER_PROPERTIES);
+
+    BOOST_CHECK(iter);
+    BOOST_CHECK(xmp_iterator_skip(iter, XMP_ITER_SKIPSUBTREE));
+    BOOST_CHECK(!xmp_iterator_next(iter, the_schema, the_path, the_prop, &options));
+    BOOST_CHECK(xmp_iterator_free(iter));
+  }
+
+  xmp_string_free(the_prop);
+  xmp_string_free(the_path);
+  xmp_string_free(the_schema);
+  BOOST_CHECK(xmp_free(xmp));
+
+  free(buffer);
+  fclose(f);
+  xmp_terminate();
+
+  BOOST_CHECK(!g_lt->check_leaks());
+  BOOST_CHECK(!g_lt->check_errors());
+}
@@ -0,0 +1,107 @@
+/*
+ * exempi - test-md5.cpp
+ *
+ * Copyright (C) 2026 The exempi contributors
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1 Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2 Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the
+ * distribution.
+ *
+ * 3 Neither the name of the Authors, nor the names of its
+ * contributors may be used to endorse or promote products derived
+ * from this software wit hout specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include "third-party/zuid/interfaces/MD5.h"
+
+using boost::unit_test::test_suite;
+
+static std::string makeBuffer(size_t length, unsigned seed)
+{
+  std::string buffer(length, '\0');
+  for (size_t i = 0; i < length; i++) {
+    buffer[i] = (char)((i * 31 + seed * 17 + (i >> 8)) & 0xFF);
+  }
+  return buffer;
+}
+
+BOOST_AUTO_TEST_SUITE(test_md5)
+
+BOOST_AUTO_TEST_CASE(test_md5Digest)
+{
+  XMP_Uns8 digest[16];
+  char hex[33];
+
+  MD5Digest("", 0, digest);
+  MD5DigestToHex(digest, hex);
+  BOOST_CHECK_EQUAL(std::string(hex), "D41D8CD98F00B204E9800998ECF8427E");
+
+  MD5Digest("abc", 3, digest);
+  MD5DigestToHex(digest, hex);
+  BOOST_CHECK_EQUAL(std::string(hex), "900150983CD24FB0D6963F7D28E17F72");
+
+  const char* quick = "The quick brown fox jumps over the lazy dog";
+  MD5Digest(quick, (XMP_Uns32)strlen(quick), digest);
+  MD5DigestToHex(digest, hex);
+  BOOST_CHECK_EQUAL(std::string(hex), "9E107D9D372BB6826BD81D3542A419D6");
+}
+
+BOOST_AUTO_TEST_CASE(test_md5DigestMatchesUpdates)
+{
+  // The one shot digest against the same bytes fed in small pieces, for
+  // lengths around the block and padding boundaries.
+  static const size_t kLengths[] = { 0, 1, 55, 56, 57, 63, 64, 65, 119, 120,
+                                     127, 128, 129, 1000, 4096 };
+  for (size_t l = 0; l < sizeof(kLengths) / sizeof(kLengths[0]); l++) {
+    const std::string buffer = makeBuffer(kLengths[l], (unsigned)l);
+
+    XMP_Uns8 single[16];
+    MD5Digest(buffer.data(), (XMP_Uns32)buffer.size(), single);
+
+    MD5_CTX context;
+    MD5Init(&context);
+    for (size_t pos = 0; pos < buffer.size(); pos += 7) {
+      const size_t length = std::min<size_t>(7, buffer.size() - pos);
+      MD5Update(&context, (const XMP_Uns8*)buffer.data() + pos, (XMP_Uns32)length);
+    }
+    XMP_Uns8 pieces[16];
+    MD5Final(pieces, &context);
+
+    BOOST_CHECK_MESSAGE(std::string((const char*)single, 16) ==
+                        std::string((const char*)pieces, 16),
+                        "length " << buffer.size());
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -101,3 +101,40 @@ BOOST_AUTO_TEST_CASE(test_serialise)
   BOOST_CHECK(!g_lt->check_leaks());
   BOOST_CHECK(!g_lt->check_errors());
 }
+
+BOOST_AUTO_TEST_CASE(test_serialise_escaping)
+{
+  BOOST_CHECK(xmp_init());
+
+  // Characters to escape before, across and after a 16 byte block.
+  const char *value = "<&\"> 0123456789abcdef\t0123456789a<bcdef\n01234&";
+  const char *element =
+    "&lt;&amp;\"&gt; 0123456789abcdef&#x9;0123456789a&lt;bcdef&#xA;01234&amp;";
+  const char *attribute =
+    "&lt;&amp;&quot;&gt; 0123456789abcdef&#x9;0123456789a&lt;bcdef&#xA;01234&amp;";
+
+  XmpPtr xmp = xmp_new_empty();
+  BOOST_CHECK(xmp_set_property(xmp, NS_XAP, "Label", value, 0));
+
+  XmpStringPtr output = xmp_string_new();
+  BOOST_CHECK(xmp_serialize(xmp, output, XMP_SERIAL_OMITPACKETWRAPPER, 0));
+  std::string packet = xmp_string_cstr(output);
+  BOOST_CHECK(packet.find(element) != std::string::npos);
+
+  BOOST_CHECK(xmp_serialize(xmp, output, XMP_SERIAL_USECOMPACTFORMAT, 0));
+  packet = xmp_string_cstr(output);
+  BOOST_CHECK(packet.find(attribute) != std::string::npos);
+
+  XmpPtr parsed = xmp_new(packet.c_str(), packet.size());
+  BOOST_CHECK(parsed != NULL);
+  XmpStringPtr the_prop = xmp_string_new();
+  BOOST_CHECK(xmp_get_property(parsed, NS_XAP, "Label", the_prop, NULL));
+  BOOST_CHECK_EQUAL(std::string(value), xmp_string_cstr(the_prop));
+
+  xmp_string_free(the_prop);
+  xmp_string_free(output);
+  BOOST_CHECK(xmp_free(parsed));
+  BOOST_CHECK(xmp_free(xmp));
+
+  xmp_terminate();
+}
@@ -117,3 +117,332 @@ BOOST_AUTO_TEST_CASE(test_xmpfiles_write)
   BOOST_CHECK(!g_lt->check_leaks());
   BOOST_CHECK(!g_lt->check_errors());
 }
+
+// Same update with the read buffer on, the handlers seek around a lot
+// while writing in place and must still see the data they wrote.
+BOOST_AUTO_TEST_CASE(test_xmpfiles_write_buffered)
+{
+  BOOST_CHECK(xmp_init());
+
+  for (auto ext : { "jpg", "tif", "mov", "wav" }) {
+    std::string orig = g_src_testdir + "../../samples/testfiles/BlueSquare." + ext;
+    std::string copy = std::string("test-buffered.") + ext;
+    BOOST_CHECK(copy_file(orig, copy));
+    BOOST_CHECK(chmod(copy.c_str(), S_IRUSR | S_IWUSR) == 0);
+
+    XmpFilePtr f = xmp_files_open_new(copy.c_str(),
+      (XmpOpenFileOptions)(XMP_OPEN_FORUPDATE | XMP_OPEN_BUFFEREDREAD));
+    BOOST_CHECK(f != NULL);
+    if (f == NULL) {
+      continue;
+    }
+    XmpPtr xmp = xmp_files_get_new_xmp(f);
+    BOOST_CHECK(xmp != NULL);
+    BOOST_CHECK(xmp_set_property(xmp, NS_PHOTOSHOP, "ICCProfile", ext, 0));
+    BOOST_CHECK(xmp_files_put_xmp(f, xmp));
+    BOOST_CHECK(xmp_free(xmp));
+    BOOST_CHECK(xmp_files_close(f, XMP_CLOSE_NOOPTION));
+    BOOST_CHECK(xmp_files_free(f));
+
+    f = xmp_files_open_new(copy.c_str(), XMP_OPEN_READ);
+    BOOST_CHECK(f != NULL);
+    if (f == NULL) {
+      continue;
+    }
+    xmp = xmp_files_get_new_xmp(f);
+    BOOST_CHECK(xmp != NULL);
+    XmpStringPtr the_prop = xmp_string_new();
+    BOOST_CHECK(
+      xmp_get_property(xmp, NS_PHOTOSHOP, "ICCProfile", the_prop, NULL));
+    BOOST_CHECK(strcmp(ext, xmp_string_cstr(the_prop)) == 0);
+    BOOST_CHECK(xmp_has_property(xmp, NS_DC, "title"));
+    xmp_string_free(the_prop);
+    BOOST_CHECK(xmp_free(xmp));
+    BOOST_CHECK(xmp_files_free(f));
+  }
+
+  xmp_terminate();
+
+  BOOST_CHECK(!g_lt->check_leaks());
+  BOOST_CHECK(!g_lt->check_errors());
+}
+
+// Growing the XMP of a QuickTime file again and again. The XMP lives in
+// the 'moov' box, the padding left after it must keep that box from being
+// moved to the end of the file each time.
+BOOST_AUTO_TEST_CASE(test_xmpfiles_write_mov_growth)
+{
+  BOOST_CHECK(xmp_init());
+
+  std::string orig = g_src_testdir + "../../samples/testfiles/BlueSquare.mov";
+  BOOST_CHECK(copy_file(orig, "test-growth.mov"));
+  BOOST_CHECK(chmod("test-growth.mov", S_IRUSR | S_IWUSR) == 0);
+
+  const int rounds = 10;
+  off_t firstSize = 0;
+  std::string keyword;
+  for (int round = 0; round < rounds; round++) {
+    XmpFilePtr f = xmp_files_open_new("test-growth.mov", XMP_OPEN_FORUPDATE);
+    BOOST_CHECK(f != NULL);
+    if (f == NULL) {
+      return;
+    }
+    XmpPtr xmp = xmp_files_get_new_xmp(f);
+    BOOST_CHECK(xmp != NULL);
+    keyword = "growth keyword " + std::to_string(round) + " "
+      + std::string(200, 'x');
+    BOOST_CHECK(xmp_append_array_item(xmp, NS_DC, "subject",
+                                      XMP_PROP_ARRAY_IS_UNORDERED,
+                                      keyword.c_str(), 0));
+    BOOST_CHECK(xmp_files_put_xmp(f, xmp));
+    BOOST_CHECK(xmp_free(xmp));
+    BOOST_CHECK(xmp_files_close(f, XMP_CLOSE_NOOPTION));
+    BOOST_CHECK(xmp_files_free(f));
+
+    struct stat st;
+    BOOST_CHECK(stat("test-growth.mov", &st) == 0);
+    if (round == 0) {
+      firstSize = st.st_size;
+    } else {
+      BOOST_CHECK_EQUAL(st.st_size, firstSize);
+    }
+  }
+
+  XmpFilePtr f = xmp_files_open_new("test-growth.mov", XMP_OPEN_READ);
+  BOOST_CHECK(f != NULL);
+  if (f == NULL) {
+    return;
+  }
+  XmpPtr xmp = xmp_files_get_new_xmp(f);
+  BOOST_CHECK(xmp != NULL);
+  XmpStringPtr the_prop = xmp_string_new();
+  BOOST_CHECK(xmp_get_property(xmp, NS_DC, "subject[last()]", the_prop, NULL));
+  BOOST_CHECK_EQUAL(keyword, xmp_string_cstr(the_prop));
+  BOOST_CHECK(xmp_has_property(xmp, NS_DC, "title"));
+  xmp_string_free(the_prop);
+  BOOST_CHECK(xmp_free(xmp));
+  BOOST_CHECK(xmp_files_free(f));
+
+  xmp_terminate();
+
+  BOOST_CHECK(!g_lt->check_leaks());
+  BOOST_CHECK(!g_lt->check_errors());
+}
+
+// Adding XMP to a SWF file that has none. The handler streams the tags to
+// a new file, it must put FileAttributes first with the HasMetadata flag
+// set, then the Metadata tag, and keep the other tags as they were.
+BOOST_AUTO_TEST_CASE(test_xmpfiles_write_swf)
+{
+  BOOST_CHECK(xmp_init());
+
+  // Header: "FWS", version 10, the length, a 0 bit RECT, the frame rate
+  // and count. Then SetBackgroundColor, FileAttributes without the
+  // HasMetadata flag, ShowFrame and End.
+  const unsigned char swf[] = {
+    'F', 'W', 'S', 10, 0, 0, 0, 0, 0x00, 0x00, 0x18, 0x01, 0x00,
+    0x43, 0x02, 0xFF, 0x00, 0x00,
+    0x44, 0x11, 0x08, 0x00, 0x00, 0x00,
+    0x40, 0x00,
+    0x00, 0x00
+  };
+  std::string data((const char*)swf, sizeof(swf));
+  data[4] = (char)data.size();
+  FILE* out = fopen("test-write.swf", "wb");
+  BOOST_CHECK(out != NULL);
+  if (out == NULL) {
+    return;
+  }
+  BOOST_CHECK(fwrite(data.data(), 1, data.size(), out) == data.size());
+  fclose(out);
+
+  XmpFilePtr f = xmp_files_open_new("test-write.swf", XMP_OPEN_FORUPDATE);
+  BOOST_CHECK(f != NULL);
+  if (f == NULL) {
+    return;
+  }
+  XmpPtr xmp = xmp_new_empty();
+  BOOST_CHECK(xmp_set_property(xmp, NS_XAP, "CreatorTool", "swf-test", 0));
+  BOOST_CHECK(xmp_files_put_xmp(f, xmp));
+  BOOST_CHECK(xmp_free(xmp));
+  BOOST_CHECK(xmp_files_close(f, XMP_CLOSE_NOOPTION));
+  BOOST_CHECK(xmp_files_free(f));
+
+  FILE* in = fopen("test-write.swf", "rb");
+  BOOST_CHECK(in != NULL);
+  if (in == NULL) {
+    return;
+  }
+  std::string result;
+  char buffer[4096];
+  size_t count;
+  while ((count = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+    result.append(buffer, count);
+  }
+  fclose(in);
+
+  // The length in the header, FileAttributes with the flag, then a long
+  // Metadata tag (code 77).
+  BOOST_CHECK(result.size() > data.size());
+  BOOST_CHECK_EQUAL(result.compare(0, 3, "FWS"), 0);
+  BOOST_CHECK_EQUAL((unsigned char)result[4] + ((unsigned char)result[5] << 8)
+                    + ((unsigned char)result[6] << 16), result.size());
+  BOOST_CHECK_EQUAL(result.compare(13, 6, "\x44\x11\x18\x00\x00\x00", 6), 0);
+  BOOST_CHECK_EQUAL((unsigned char)result[19], 0x7F);
+  BOOST_CHECK_EQUAL((unsigned char)result[20], 0x13);
+  // The remaining tags, unchanged.
+  BOOST_CHECK_EQUAL(result.compare(result.size() - 9, 9,
+                                   "\x43\x02\xFF\x00\x00\x40\x00\x00\x00", 9), 0);
+
+  f = xmp_files_open_new("test-write.swf", XMP_OPEN_READ);
+  BOOST_CHECK(f != NULL);
+  if (f == NULL) {
+    return;
+  }
+  xmp = xmp_files_get_new_xmp(f);
+  BOOST_CHECK(xmp != NULL);
+  XmpStringPtr the_prop = xmp_string_new();
+  BOOST_CHECK(xmp_get_property(xmp, NS_XAP, "CreatorTool", the_prop, NULL));
+  BOOST_CHECK_EQUAL(std::string("swf-test"), xmp_string_cstr(the_prop));
+  xmp_string_free(the_prop);
+  BOOST_CHECK(xmp_free(xmp));
+  BOOST_CHECK(xmp_files_free(f));
+
+  xmp_terminate();
+
+  BOOST_CHECK(!g_lt->check_leaks());
+  BOOST_CHECK(!g_lt->check_errors());
+}
+
+// The PNG handler computes the CRC of the iTXt chunk it writes, check it
+// and the others against a plain bitwise CRC-32. Once with a small packet
+// and once with one large enough for the folding path.
+static unsigned long bitwise_crc32(const std::string& data, size_t offset,
+                                   size_t length)
+{
+  unsigned long c = 0xFFFFFFFFUL;
+  for (size_t i = offset; i < offset + length; i++) {
+    c ^= (unsigned char)data[i];
+    for (int k = 0; k < 8; k++) {
+      c = (c & 1) ? (0xEDB88320UL ^ (c >> 1)) : (c >> 1);
+    }
+  }
+  return c ^ 0xFFFFFFFFUL;
+}
+
+BOOST_AUTO_TEST_CASE(test_xmpfiles_write_png_crc)
+{
+  BOOST_CHECK(xmp_init());
+
+  std::string orig = g_src_testdir + "../../samples/testfiles/BlueSquare.png";
+  for (size_t extra : { 0, 100000 }) {
+    BOOST_CHECK(copy_file(orig, "test-crc.png"));
+    BOOST_CHECK(chmod("test-crc.png", S_IRUSR | S_IWUSR) == 0);
+
+    XmpFilePtr f = xmp_files_open_new("test-crc.png", XMP_OPEN_FORUPDATE);
+    BOOST_CHECK(f != NULL);
+    if (f == NULL) {
+      return;
+    }
+    XmpPtr xmp = xmp_files_get_new_xmp(f);
+    BOOST_CHECK(xmp != NULL);
+    std::string value = "crc " + std::string(extra, 'x');
+    BOOST_CHECK(xmp_set_property(xmp, NS_DC, "source", value.c_str(), 0));
+    BOOST_CHECK(xmp_files_put_xmp(f, xmp));
+    BOOST_CHECK(xmp_free(xmp));
+    BOOST_CHECK(xmp_files_close(f, XMP_CLOSE_NOOPTION));
+    BOOST_CHECK(xmp_files_free(f));
+
+    FILE* in = fopen("test-crc.png", "rb");
+    BOOST_CHECK(in != NULL);
+    if (in == NULL) {
+      return;
+    }
+    std::string data;
+    char buffer[4096];
+    size_t count;
+    while ((count = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+      data.append(buffer, count);
+    }
+    fclose(in);
+
+    // Walk the chunks after the signature.
+    size_t pos = 8;
+    int chunks = 0;
+    bool sawXMP = false;
+    while (pos + 12 <= data.size()) {
+      size_t length = ((unsigned char)data[pos] << 24)
+        | ((unsigned char)data[pos + 1] << 16)
+        | ((unsigned char)data[pos + 2] << 8) | (unsigned char)data[pos + 3];
+      BOOST_REQUIRE(pos + 12 + length <= data.size());
+      size_t crcPos = pos + 8 + length;
+      unsigned long crc = ((unsigned long)(unsigned char)data[crcPos] << 24)
+        | ((unsigned char)data[crcPos + 1] << 16)
+        | ((unsigned char)data[crcPos + 2] << 8)
+        | (unsigned char)data[crcPos + 3];
+      BOOST_CHECK_EQUAL(crc, bitwise_crc32(data, pos + 4, length + 4));
+      if (data.compare(pos + 4, 4, "iTXt") == 0 && length > extra) {
+        sawXMP = true;
+      }
+      pos = crcPos + 4;
+      chunks++;
+    }
+    BOOST_CHECK_EQUAL(pos, data.size());
+    BOOST_CHECK(chunks > 2);
+    BOOST_CHECK(sawXMP);
+  }
+
+  xmp_terminate();
+
+  BOOST_CHECK(!g_lt->check_leaks());
+  BOOST_CHECK(!g_lt->check_errors());
+}
+
+// XMP too large for one APP1 segment is split, the main packet keeps the
+// MD5 digest of the extended part in xmpNote:HasExtendedXMP and the reader
+// must find the extended part again by that digest.
+BOOST_AUTO_TEST_CASE(test_xmpfiles_write_jpeg_extended)
+{
+  BOOST_CHECK(xmp_init());
+
+  BOOST_CHECK(copy_file(g_testfile, "test-extended.jpg"));
+  BOOST_CHECK(chmod("test-extended.jpg", S_IRUSR | S_IWUSR) == 0);
+
+  XmpFilePtr f = xmp_files_open_new("test-extended.jpg", XMP_OPEN_FORUPDATE);
+  BOOST_CHECK(f != NULL);
+  if (f == NULL) {
+    return;
+  }
+  XmpPtr xmp = xmp_files_get_new_xmp(f);
+  BOOST_CHECK(xmp != NULL);
+  std::string big;
+  for (int i = 0; big.size() < 100000; i++) {
+    big += "extended text " + std::to_string(i) + " ";
+  }
+  BOOST_CHECK(xmp_set_property(xmp, NS_DC, "source", big.c_str(), 0));
+  BOOST_CHECK(xmp_files_can_put_xmp(f, xmp));
+  BOOST_CHECK(xmp_files_put_xmp(f, xmp));
+  BOOST_CHECK(xmp_free(xmp));
+  BOOST_CHECK(xmp_files_close(f, XMP_CLOSE_NOOPTION));
+  BOOST_CHECK(xmp_files_free(f));
+
+  f = xmp_files_open_new("test-extended.jpg", XMP_OPEN_READ);
+  BOOST_CHECK(f != NULL);
+  if (f == NULL) {
+    return;
+  }
+  xmp = xmp_files_get_new_xmp(f);
+  BOOST_CHECK(xmp != NULL);
+  XmpStringPtr the_prop = xmp_string_new();
+  BOOST_CHECK(xmp_get_property(xmp, NS_DC, "source", the_prop, NULL));
+  BOOST_CHECK(big == xmp_string_cstr(the_prop));
+  BOOST_CHECK(xmp_get_property(xmp, NS_DC, "title[1]", the_prop, NULL));
+  xmp_string_free(the_prop);
+  BOOST_CHECK(xmp_free(xmp));
+  BOOST_CHECK(xmp_files_free(f));
+
+  xmp_terminate();
+
+  BOOST_CHECK(!g_lt->check_leaks());
+  BOOST_CHECK(!g_lt->check_errors());
+}
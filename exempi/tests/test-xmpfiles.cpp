@@ -38,14 +38,22 @@
 #include <stdio.h>
 #include <string.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <boost/test/included/unit_test.hpp>
 
 #include "utils.h"
 #include "xmp.h"
 #include "xmpconsts.h"
+#include "xmperrors.h"
 
 boost::unit_test::test_suite* init_unit_test_suite(int argc, char * argv[])
 {
@@ -128,3 +136,515 @@ BOOST_AUTO_TEST_CASE(test_xmpfiles)
   BOOST_CHECK(!g_lt->check_leaks());
   BOOST_CHECK(!g_lt->check_errors());
 }
+
+// A JPEG without XMP, its only metadata is an IPTC caption in the image
+// resources.
+static std::string iptcOnlyJpeg()
+{
+  const std::string caption = "IPTC caption";
+  std::string iptc("\x1C\x02\x78", 3);
+  iptc += (char)(caption.size() >> 8);
+  iptc += (char)(caption.size() & 0xFF);
+  iptc += caption;
+  if (iptc.size() & 1) {
+    iptc += '\0';
+  }
+
+  std::string psir("Photoshop 3.0\0" "8BIM\x04\x04\0\0", 22);
+  psir += '\0';
+  psir += '\0';
+  psir += (char)(iptc.size() >> 8);
+  psir += (char)(iptc.size() & 0xFF);
+  psir += iptc;
+
+  std::string jpeg("\xFF\xD8\xFF\xED", 4);
+  jpeg += (char)((psir.size() + 2) >> 8);
+  jpeg += (char)((psir.size() + 2) & 0xFF);
+  jpeg += psir;
+  jpeg += std::string("\xFF\xD9", 2);
+  return jpeg;
+}
+
+static bool hasIptcCaption(const char* path, XmpOpenFileOptions options)
+{
+  bool found = false;
+  XmpFilePtr f = xmp_files_open_new(path, options);
+  BOOST_REQUIRE(f != NULL);
+  XmpPtr xmp = xmp_files_get_new_xmp(f);
+  if (xmp != NULL) {
+    XmpStringPtr value = xmp_string_new();
+    found = xmp_get_property(xmp, NS_DC, "description[1]", value, NULL) &&
+            (strcmp(xmp_string_cstr(value), "IPTC caption") == 0);
+    xmp_string_free(value);
+    xmp_free(xmp);
+  }
+  BOOST_CHECK(xmp_files_free(f));
+  return found;
+}
+
+// The IPTC of a JPEG file is inside the image resources, skipping them skips
+// the IPTC as well.
+BOOST_AUTO_TEST_CASE(test_xmpfiles_skip_psir_jpeg)
+{
+  BOOST_CHECK(xmp_init());
+
+  const char* path = "test-iptc.jpg";
+  FILE* file = fopen(path, "wb");
+  BOOST_REQUIRE(file != NULL);
+  const std::string jpeg = iptcOnlyJpeg();
+  BOOST_CHECK(fwrite(jpeg.data(), 1, jpeg.size(), file) == jpeg.size());
+  fclose(file);
+
+  BOOST_CHECK(hasIptcCaption(path, XMP_OPEN_READ));
+  BOOST_CHECK(!hasIptcCaption(
+    path, (XmpOpenFileOptions)(XMP_OPEN_READ | XMP_OPEN_SKIPPSIR)));
+  BOOST_CHECK(!hasIptcCaption(
+    path, (XmpOpenFileOptions)(XMP_OPEN_READ | XMP_OPEN_SKIPIPTC)));
+
+  BOOST_CHECK(unlink(path) == 0);
+
+  xmp_terminate();
+
+  BOOST_CHECK(!g_lt->check_leaks());
+  BOOST_CHECK(!g_lt->check_errors());
+}
+
+// Skipping the legacy reconciliation still returns the XMP packet, and is only
+// allowed when opening read-only.
+BOOST_AUTO_TEST_CASE(test_xmpfiles_skip_reconcile)
+{
+  BOOST_CHECK(xmp_init());
+
+  XmpFilePtr f = xmp_files_open_new(g_testfile.c_str(),
+                                    (XmpOpenFileOptions)(XMP_OPEN_READ | XMP_OPEN_SKIPRECONCILE));
+  BOOST_CHECK(f != NULL);
+  if (f != NULL) {
+    XmpPtr xmp = xmp_files_get_new_xmp(f);
+    BOOST_CHECK(xmp != NULL);
+
+    XmpStringPtr the_prop = xmp_string_new();
+    BOOST_CHECK(
+      xmp_get_property(xmp, NS_PHOTOSHOP, "ICCProfile", the_prop, NULL));
+    BOOST_CHECK(strcmp("sRGB IEC61966-2.1", xmp_string_cstr(the_prop)) == 0);
+    xmp_string_free(the_prop);
+
+    xmp_free(xmp);
+    BOOST_CHECK(xmp_files_free(f));
+  }
+
+  f = xmp_files_open_new(g_testfile.c_str(),
+                         (XmpOpenFileOptions)(XMP_OPEN_FORUPDATE | XMP_OPEN_SKIPIPTC));
+  BOOST_CHECK(f == NULL);
+  BOOST_CHECK(xmp_get_error() == XMPErr_BadParam);
+  if (f != NULL) {
+    xmp_files_free(f);
+  }
+
+  xmp_terminate();
+
+  BOOST_CHECK(!g_lt->check_leaks());
+  BOOST_CHECK(!g_lt->check_errors());
+}
+
+// Mapping or buffering a file opened read-only must not change what is read.
+static std::string read_serialized(const std::string &file, int options)
+{
+  std::string result;
+  XmpFilePtr f = xmp_files_open_new(file.c_str(), (XmpOpenFileOptions)options);
+  BOOST_CHECK(f != NULL);
+  if (f == NULL) {
+    return result;
+  }
+  XmpPtr xmp = xmp_files_get_new_xmp(f);
+  BOOST_CHECK(xmp != NULL);
+  if (xmp) {
+    XmpStringPtr str = xmp_string_new();
+    BOOST_CHECK(xmp_serialize(xmp, str, XMP_SERIAL_OMITPACKETWRAPPER, 0));
+    result = xmp_string_cstr(str);
+    xmp_string_free(str);
+    xmp_free(xmp);
+  }
+  xmp_files_free(f);
+  return result;
+}
+
+BOOST_AUTO_TEST_CASE(test_xmpfiles_map_file)
+{
+  BOOST_CHECK(xmp_init());
+
+  for (auto ext : { "jpg", "tif", "png", "psd", "mov", "mp3" }) {
+    std::string file = g_src_testdir + "../../samples/testfiles/BlueSquare." + ext;
+    std::string plain = read_serialized(file, XMP_OPEN_READ);
+    BOOST_CHECK(!plain.empty());
+    BOOST_CHECK_EQUAL(read_serialized(file, XMP_OPEN_READ | XMP_OPEN_MAPFILE), plain);
+    BOOST_CHECK_EQUAL(read_serialized(file, XMP_OPEN_READ | XMP_OPEN_BUFFEREDREAD), plain);
+    BOOST_CHECK_EQUAL(read_serialized(file, XMP_OPEN_READ | XMP_OPEN_MAPFILE | XMP_OPEN_BUFFEREDREAD), plain);
+  }
+
+  xmp_terminate();
+
+  BOOST_CHECK(!g_lt->check_leaks());
+  BOOST_CHECK(!g_lt->check_errors());
+}
+
+// Open the same handful of files from many threads at once. Each thread works on
+// its own XmpFilePtr, the handlers and the namespace table are shared.
+static void open_files_loop(const std::vector<std::string> &files, int rounds,
+                            std::atomic<int> *failures)
+{
+  for (int round = 0; round < rounds; round++) {
+    for (auto &file : files) {
+      XmpFilePtr f = xmp_files_open_new(file.c_str(), XMP_OPEN_READ);
+      if (f == NULL) {
+        (*failures)++;
+        continue;
+      }
+      XmpPtr xmp = xmp_files_get_new_xmp(f);
+      if (xmp == NULL || !xmp_has_property(xmp, NS_DC, "title")) {
+        (*failures)++;
+      }
+      if (xmp) {
+        xmp_free(xmp);
+      }
+      xmp_files_free(f);
+    }
+  }
+}
+
+static double open_files_threaded(const std::vector<std::string> &files,
+                                  int thread_count, int rounds,
+                                  std::atomic<int> *failures)
+{
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < thread_count; i++) {
+    threads.push_back(std::thread(open_files_loop, std::cref(files), rounds,
+                                  failures));
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+BOOST_AUTO_TEST_CASE(test_xmpfiles_threads)
+{
+  BOOST_CHECK(xmp_init());
+
+  std::vector<std::string> files;
+  for (auto ext : { "jpg", "tif", "png", "psd", "gif", "mov", "wav", "mp3" }) {
+    files.push_back(g_src_testdir + "../../samples/testfiles/BlueSquare." + ext);
+  }
+
+  int thread_count = std::thread::hardware_concurrency();
+  if (thread_count < 2) {
+    thread_count = 2;
+  } else if (thread_count > 8) {
+    thread_count = 8;
+  }
+  const int rounds = 4;
+
+  std::atomic<int> failures(0);
+  // Same amount of work per thread: the time should stay about the same as
+  // the threads are added, it doubles or worse if the calls are serialized.
+  double one = open_files_threaded(files, 1, rounds, &failures);
+  double many = open_files_threaded(files, thread_count, rounds, &failures);
+  BOOST_CHECK(failures == 0);
+  BOOST_TEST_MESSAGE("1 thread " << one << "s, " << thread_count
+                     << " threads " << many << "s, speedup "
+                     << (one * thread_count) / many);
+
+  xmp_terminate();
+
+  BOOST_CHECK(!g_lt->check_leaks());
+  BOOST_CHECK(!g_lt->check_errors());
+}
+
+// Create, open and free XmpFilePtr from many threads. Every free goes through
+// the reference count wrappers, which must not share any state across objects.
+static void new_free_loop(const std::string &file, int rounds,
+                          std::atomic<int> *failures)
+{
+  for (int round = 0; round < rounds; round++) {
+    XmpFilePtr f = xmp_files_new();
+    if (f == NULL) {
+      (*failures)++;
+      continue;
+    }
+    if (round & 1) {
+      if (!xmp_files_open(f, file.c_str(), XMP_OPEN_READ)) {
+        (*failures)++;
+      }
+      xmp_files_close(f, XMP_CLOSE_NOOPTION);
+    }
+    xmp_files_free(f);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_xmpfiles_threads_new_free)
+{
+  BOOST_CHECK(xmp_init());
+
+  std::string file = g_src_testdir + "../../samples/testfiles/BlueSquare.jpg";
+  std::atomic<int> failures(0);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; i++) {
+    threads.push_back(std::thread(new_free_loop, std::cref(file), 200,
+                                  &failures));
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  BOOST_CHECK(failures == 0);
+
+  xmp_terminate();
+
+  BOOST_CHECK(!g_lt->check_leaks());
+  BOOST_CHECK(!g_lt->check_errors());
+}
+
+struct BatchResults {
+  std::mutex lock;
+  std::vector<int> errors;
+  std::vector<bool> have_title;
+  size_t calls = 0;
+};
+
+static void batch_callback(size_t index, const char * /*path*/, XmpPtr xmp,
+                           int error, void *user_data)
+{
+  auto results = static_cast<BatchResults *>(user_data);
+  std::lock_guard<std::mutex> guard(results->lock);
+  results->calls++;
+  results->errors[index] = error;
+  results->have_title[index] = xmp && xmp_has_property(xmp, NS_DC, "title");
+}
+
+// The batch reads every file once, on the calling thread or on a few threads,
+// and reports a missing file without failing the others.
+static void throwing_batch_callback(size_t /*index*/, const char * /*path*/,
+                                    XmpPtr /*xmp*/, int /*error*/,
+                                    void *user_data)
+{
+  (*static_cast<std::atomic<size_t> *>(user_data))++;
+  throw std::runtime_error("callback failure");
+}
+
+BOOST_AUTO_TEST_CASE(test_xmpfiles_batch)
+{
+  BOOST_CHECK(xmp_init());
+
+  std::vector<std::string> files;
+  for (auto ext : { "jpg", "tif", "png", "psd", "gif", "mov", "wav", "mp3" }) {
+    files.push_back(g_src_testdir + "../../samples/testfiles/BlueSquare." + ext);
+  }
+  files.push_back(g_src_testdir + "../../samples/testfiles/NoSuchFile.jpg");
+  std::vector<const char *> paths;
+  for (auto &file : files) {
+    paths.push_back(file.c_str());
+  }
+
+  for (unsigned int threads : { 0, 3 }) {
+    BatchResults results;
+    results.errors.resize(paths.size(), 1);
+    results.have_title.resize(paths.size(), false);
+    BOOST_CHECK(xmp_files_get_xmp_batch(paths.data(), paths.size(),
+                                        XMP_OPEN_READ, threads,
+                                        batch_callback, &results));
+    BOOST_CHECK(results.calls == paths.size());
+    for (size_t i = 0; i < paths.size() - 1; i++) {
+      BOOST_CHECK(results.errors[i] == 0);
+      BOOST_CHECK(results.have_title[i]);
+    }
+    BOOST_CHECK(results.errors.back() != 0);
+    BOOST_CHECK(!results.have_title.back());
+  }
+
+  BatchResults results;
+  BOOST_CHECK(!xmp_files_get_xmp_batch(paths.data(), paths.size(),
+                                       XMP_OPEN_FORUPDATE, 0,
+                                       batch_callback, &results));
+  BOOST_CHECK(xmp_get_error() == XMPErr_BadOptions);
+  BOOST_CHECK(results.calls == 0);
+
+  // A callback that throws stops the batch, on the calling thread or not.
+  for (unsigned int threads : { 0, 3 }) {
+    std::atomic<size_t> calls(0);
+    BOOST_CHECK(!xmp_files_get_xmp_batch(paths.data(), paths.size(),
+                                         XMP_OPEN_READ, threads,
+                                         throwing_batch_callback, &calls));
+    BOOST_CHECK(xmp_get_error() == XMPErr_UnknownException);
+    BOOST_CHECK(calls >= 1);
+    BOOST_CHECK(calls <= threads + 1);
+  }
+
+  // The directory holds the files above, and a few more.
+  BatchResults dir_results;
+  dir_results.errors.resize(64, 1);
+  dir_results.have_title.resize(64, false);
+  BOOST_CHECK(xmp_files_get_xmp_dir(
+                (g_src_testdir + "../../samples/testfiles").c_str(),
+                XMP_OPEN_READ, 2, batch_callback, &dir_results));
+  BOOST_CHECK(dir_results.calls >= paths.size() - 1);
+  BOOST_CHECK(dir_results.calls <= dir_results.errors.size());
+
+  BOOST_CHECK(!xmp_files_get_xmp_dir(
+                (g_src_testdir + "NoSuchDir").c_str(),
+                XMP_OPEN_READ, 0, batch_callback, &dir_results));
+  BOOST_CHECK(xmp_get_error() == XMPErr_BadParam);
+
+  xmp_terminate();
+
+  BOOST_CHECK(!g_lt->check_leaks());
+  BOOST_CHECK(!g_lt->check_errors());
+}
+
+static std::string read_serialized_xmp(XmpFilePtr f, const std::string &path)
+{
+  std::string result;
+  if (!xmp_files_open(f, path.c_str(), XMP_OPEN_READ)) {
+    return result;
+  }
+  XmpPtr xmp = xmp_files_get_new_xmp(f);
+  if (xmp) {
+    XmpStringPtr buffer = xmp_string_new();
+    if (xmp_serialize(xmp, buffer, XMP_SERIAL_OMITPACKETWRAPPER, 0)) {
+      result = xmp_string_cstr(buffer);
+    }
+    xmp_string_free(buffer);
+    xmp_free(xmp);
+  }
+  xmp_files_close(f, XMP_CLOSE_NOOPTION);
+  return result;
+}
+
+// A file object reused for several files, with the JPEG handler kept between
+// them, reads the same XMP as a new file object for each file.
+BOOST_AUTO_TEST_CASE(test_xmpfiles_reuse)
+{
+  BOOST_CHECK(xmp_init());
+
+  std::vector<std::string> files;
+  for (auto name : { "BlueSquare.jpg", "Image1.jpg", "Image2.jpg",
+                     "BlueSquare.png", "BlueSquare.jpg", "Image1.jpg" }) {
+    files.push_back(g_src_testdir + "../../samples/testfiles/" + name);
+  }
+
+  XmpFilePtr reused = xmp_files_new();
+  BOOST_CHECK(reused != NULL);
+  for (auto &file : files) {
+    XmpFilePtr f = xmp_files_new();
+    std::string expected = read_serialized_xmp(f, file);
+    xmp_files_free(f);
+
+    BOOST_CHECK(!expected.empty());
+    BOOST_CHECK(read_serialized_xmp(reused, file) == expected);
+  }
+  BOOST_CHECK(xmp_files_free(reused));
+
+  xmp_terminate();
+
+  BOOST_CHECK(!g_lt->check_leaks());
+  BOOST_CHECK(!g_lt->check_errors());
+}
+
+static void put_uns32be(std::string &data, size_t offset, uint32_t value)
+{
+  data[offset] = (char)(value >> 24);
+  data[offset + 1] = (char)(value >> 16);
+  data[offset + 2] = (char)(value >> 8);
+  data[offset + 3] = (char)value;
+}
+
+static uint32_t get_uns32be(const std::string &data, size_t offset)
+{
+  return ((uint32_t)(uint8_t)data[offset] << 24) |
+         ((uint32_t)(uint8_t)data[offset + 1] << 16) |
+         ((uint32_t)(uint8_t)data[offset + 2] << 8) |
+         (uint32_t)(uint8_t)data[offset + 3];
+}
+
+// A read-only open doesn't load the big sample tables of the 'moov' box,
+// the XMP and its offset must be the same as when the whole box is read
+// for an update.
+BOOST_AUTO_TEST_CASE(test_xmpfiles_mov_sample_tables)
+{
+  BOOST_CHECK(xmp_init());
+
+  std::string orig = g_src_testdir + "../../samples/testfiles/BlueSquare.mov";
+  FILE *f = fopen(orig.c_str(), "rb");
+  BOOST_CHECK(f != NULL);
+  if (f == NULL) {
+    return;
+  }
+  std::string data;
+  char buffer[4096];
+  size_t len;
+  while ((len = fread(buffer, 1, sizeof(buffer), f)) > 0) {
+    data.append(buffer, len);
+  }
+  fclose(f);
+
+  // Replace moov/trak/mdia/minf/stbl/stsz with a 1 MB table, fixing up the
+  // sizes of the enclosing boxes.
+  const size_t stszOffset = 44450;
+  const size_t parents[] = { 43797, 43913, 44049, 44147, 44268 };
+  BOOST_CHECK(data.compare(stszOffset + 4, 4, "stsz") == 0);
+  BOOST_CHECK(data.compare(parents[0] + 4, 4, "moov") == 0);
+  const uint32_t count = 256 * 1024;
+  std::string stsz(20 + 4 * count, '\x01');
+  put_uns32be(stsz, 0, (uint32_t)stsz.size());
+  stsz.replace(4, 4, "stsz");
+  put_uns32be(stsz, 8, 0);
+  put_uns32be(stsz, 12, 0);
+  put_uns32be(stsz, 16, count);
+  uint32_t oldSize = get_uns32be(data, stszOffset);
+  data.replace(stszOffset, oldSize, stsz);
+  for (auto offset : parents) {
+    put_uns32be(data, offset,
+                get_uns32be(data, offset) + (uint32_t)stsz.size() - oldSize);
+  }
+
+  f = fopen("test-stbl.mov", "wb");
+  BOOST_CHECK(f != NULL);
+  if (f == NULL) {
+    return;
+  }
+  BOOST_CHECK(fwrite(data.data(), 1, data.size(), f) == data.size());
+  fclose(f);
+  BOOST_CHECK(chmod("test-stbl.mov", S_IRUSR | S_IWUSR) == 0);
+
+  XmpPacketInfo info[2];
+  std::string packets[2];
+  const XmpOpenFileOptions modes[2] = { XMP_OPEN_READ, XMP_OPEN_FORUPDATE };
+  for (int i = 0; i < 2; i++) {
+    XmpFilePtr xf = xmp_files_open_new("test-stbl.mov", modes[i]);
+    BOOST_CHECK(xf != NULL);
+    if (xf == NULL) {
+      continue;
+    }
+    XmpStringPtr packet = xmp_string_new();
+    BOOST_CHECK(xmp_files_get_xmp_xmpstring(xf, packet, &info[i]));
+    packets[i] = xmp_string_cstr(packet);
+    xmp_string_free(packet);
+
+    XmpPtr xmp = xmp_files_get_new_xmp(xf);
+    BOOST_CHECK(xmp != NULL);
+    BOOST_CHECK(xmp_has_property(xmp, NS_DC, "title"));
+    xmp_free(xmp);
+    BOOST_CHECK(xmp_files_close(xf, XMP_CLOSE_NOOPTION));
+    BOOST_CHECK(xmp_files_free(xf));
+  }
+  BOOST_CHECK(info[0].offset == info[1].offset);
+  BOOST_CHECK(info[0].offset > (int64_t)(stszOffset + stsz.size()));
+  BOOST_CHECK(info[0].length == info[1].length);
+  BOOST_CHECK(!packets[0].empty());
+  BOOST_CHECK(packets[0] == packets[1]);
+
+  xmp_terminate();
+
+  BOOST_CHECK(!g_lt->check_leaks());
+  BOOST_CHECK(!g_lt->check_errors());
+}
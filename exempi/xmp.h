@@ -76,6 +76,24 @@ typedef enum {
     XMP_OPEN_OPTIMIZEFILELAYOUT =
         0x00000200, /**< Optimize MPEG4 to support stream when updating
                      * This can take some time */
+    XMP_OPEN_BUFFEREDREAD =
+        0x00000800, /**< Buffer reads of a file,
+                     * fewer system calls for small reads and seeks. */
+    XMP_OPEN_MAPFILE =
+        0x00001000, /**< Map a file opened read-only into memory. Only for
+                     * files nothing else changes while open, reading a
+                     * mapping of a truncated file raises SIGBUS. */
+    XMP_OPEN_SKIPEXIF = 0x00010000,    /**< Don't parse or reconcile TIFF/Exif,
+                                        * read-only. */
+    XMP_OPEN_SKIPIPTC = 0x00020000,    /**< Don't parse or reconcile IPTC-IIM,
+                                        * read-only. */
+    XMP_OPEN_SKIPPSIR = 0x00040000,    /**< Don't parse Photoshop image
+                                        * resources, nor the IPTC-IIM of
+                                        * JPEG inside them, read-only. */
+    XMP_OPEN_SKIPDIGESTS = 0x00080000, /**< Don't check the IPTC digest, the
+                                        * XMP is trusted, read-only. */
+    XMP_OPEN_SKIPRECONCILE = 0x000F0000, /**< All of the above, return the XMP
+                                          * as it is in the file. */
     XMP_OPEN_INBACKGROUND = 0x10000000 /**< Set if calling from background
                                         * thread. */
 } XmpOpenFileOptions;
@@ -298,6 +316,17 @@ typedef enum {
 #define XMP_IS_NODE_SCHEMA(opt) (((opt)&XMP_SCHEMA_NODE) != 0)
 #define XMP_IS_PROP_ALIAS(opt) (((opt)&XMP_PROP_IS_ALIAS) != 0)
 
+enum {                                   /* Options for xmp_parse_with_options */
+       XMP_PARSE_REQUIREXMPMETA = 0x0001UL, /**< Require a surrounding
+                                             * x:xmpmeta element. */
+       XMP_PARSE_STRICTALIASING = 0x0004UL, /**< Do not reconcile alias
+                                             * differences, fail instead. */
+       XMP_PARSE_SINGLEPASS = 0x0008UL      /**< Build the XMP tree in a single
+                                             * pass, without an intermediate
+                                             * XML tree. Input it can't handle
+                                             * is parsed again the usual way. */
+};
+
 enum {                                          /* Options for xmp_serialize */
        XMP_SERIAL_OMITPACKETWRAPPER = 0x0010UL, /**< Omit the XML packet
                                                  * wrapper. */
@@ -334,6 +363,7 @@ typedef struct _Xmp *XmpPtr;
 typedef struct _XmpFile *XmpFilePtr;
 typedef struct _XmpString *XmpStringPtr;
 typedef struct _XmpIterator *XmpIteratorPtr;
+typedef struct _XmpAtom *XmpAtomPtr;
 
 typedef struct _XmpDateTime {
     int32_t year;
@@ -379,6 +409,7 @@ enum {
 
 /** Init the library. Must be called before anything else */
 bool xmp_init(void);
+/** Terminate the library. Every XmpPtr must be freed before. */
 void xmp_terminate(void);
 
 /** get the error code that last occurred.
@@ -479,6 +510,47 @@ bool xmp_files_get_format_info(XmpFileType format,
  */
 XmpFileType xmp_files_check_file_format(const char *filePath);
 
+/** Called by %xmp_files_get_xmp_batch once for each file.
+ * @param index the index of the file in the batch.
+ * @param path the file path.
+ * @param xmp the XMP of the file, NULL if it has none or on error. Only valid
+ * during the call, use %xmp_copy to keep it.
+ * @param error 0 or the error code for this file, like %xmp_get_error.
+ * @param user_data the user_data passed to the batch call.
+ */
+typedef void (*XmpFilesBatchCallback)(size_t index, const char *path,
+                                      XmpPtr xmp, int error, void *user_data);
+
+/** Get the XMP of many files. One file object per thread is reused from
+ * one file to the next, instead of one %xmp_files_open_new and
+ * %xmp_files_free per file.
+ * @param paths the file paths.
+ * @param count the number of paths.
+ * @param options open flags. Must not include XMP_OPEN_FORUPDATE.
+ * @param threads the number of threads to read with. 0 or 1 reads in the
+ * calling thread. Otherwise the callback is called from these threads, in
+ * no particular order, and must be thread safe.
+ * @param callback called once for each path.
+ * @param user_data passed to the callback.
+ * @return false if the parameters are invalid, a thread could not be
+ * started, or the callback threw an exception. The files not read yet are
+ * skipped then, call %xmp_get_error to retrieve the error code. Errors for a
+ * file are passed to the callback and don't fail the batch.
+ */
+bool xmp_files_get_xmp_batch(const char *const *paths, size_t count,
+                             XmpOpenFileOptions options, unsigned int threads,
+                             XmpFilesBatchCallback callback, void *user_data);
+
+/** Get the XMP of the regular files in a directory, not recursing in the
+ * subdirectories. See %xmp_files_get_xmp_batch
+ * @param dir the directory path.
+ * @return false if the parameters are invalid or the directory can't be
+ * read.
+ */
+bool xmp_files_get_xmp_dir(const char *dir, XmpOpenFileOptions options,
+                           unsigned int threads,
+                           XmpFilesBatchCallback callback, void *user_data);
+
 /** Register a new namespace to add properties to
  *  This is done automatically when reading the metadata block
  *  @param namespaceURI the namespace URI to register
@@ -539,6 +611,16 @@ bool xmp_free(XmpPtr xmp);
  */
 bool xmp_parse(XmpPtr xmp, const char *buffer, size_t len);
 
+/** Parse the XML passed through the buffer and load it, with options.
+ * xmp_parse() is the same as passing XMP_PARSE_REQUIREXMPMETA.
+ * @param xmp the XMP packet.
+ * @param buffer the buffer.
+ * @param len the length of the buffer.
+ * @param options options on how to parse. See XMP_PARSE_*
+ */
+bool xmp_parse_with_options(XmpPtr xmp, const char *buffer, size_t len,
+                            uint32_t options);
+
 /** Serialize the XMP Packet to the given buffer
  * @param xmp the XMP Packet
  * @param buffer the buffer to write the XMP to
@@ -565,7 +647,7 @@ bool xmp_serialize_and_format(XmpPtr xmp, XmpStringPtr buffer, uint32_t options,
                               uint32_t padding, const char *newline,
                               const char *tab, int32_t indent);
 
-/** Get an XMP property and it option bits from the XMP packet
+/** Get an XMP property and its option bits from the XMP packet
  * @param xmp the XMP packet
  * @param schema
  * @param name
@@ -576,6 +658,73 @@ bool xmp_serialize_and_format(XmpPtr xmp, XmpStringPtr buffer, uint32_t options,
 bool xmp_get_property(XmpPtr xmp, const char *schema, const char *name,
                       XmpStringPtr property, uint32_t *propsBits);
 
+/** Resolve a property ahead of time, for properties read from many packets.
+ * The path is checked and expanded once, and an alias is resolved to its
+ * actual property. The atom is not tied to a packet and must be freed before
+ * xmp_terminate().
+ * @param schema
+ * @param name the property name, can be a path to a struct field or an item
+ * @return the property atom, or NULL on error
+ */
+XmpAtomPtr xmp_atom_new(const char *schema, const char *name);
+
+/** Free a property atom
+ * @param atom the atom to free
+ * @return true if freed
+ */
+bool xmp_atom_free(XmpAtomPtr atom);
+
+/** Get an XMP property and its option bits from the XMP packet, using an atom
+ * returned by xmp_atom_new().
+ * @param xmp the XMP packet
+ * @param atom the property atom
+ * @param property the allocated XmpStringPtr
+ * @param propsBits pointer to the option bits. Pass NULL if not needed
+ * @return true if found
+ */
+bool xmp_get_property_atom(XmpPtr xmp, XmpAtomPtr atom, XmpStringPtr property,
+                           uint32_t *propsBits);
+
+/** Set an XMP property in the XMP packet, using an atom returned by
+ * xmp_atom_new().
+ * @param xmp the XMP packet
+ * @param atom the property atom
+ * @param value 0 terminated string
+ * @param optionBits
+ * @return false if failure
+ */
+bool xmp_set_property_atom(XmpPtr xmp, XmpAtomPtr atom, const char *value,
+                           uint32_t optionBits);
+
+/** Get several XMP properties from several XMP packets, in one call, into
+ * buffers provided by the caller. No string is allocated.
+ * The values are laid out by column: the values of atoms[0] for each packet,
+ * then those of atoms[1], and so on. Value i is the bytes from
+ * bytes[offsets[i]] up to bytes[offsets[i + 1]], not 0 terminated. A missing
+ * property has an empty value. The bytes are copied up to the first value that
+ * does not fit in bytes_size, nothing is written after it.
+ * @param xmps the XMP packets
+ * @param count the number of XMP packets
+ * @param atoms the property atoms, returned by xmp_atom_new()
+ * @param atom_count the number of property atoms
+ * @param offsets an array of count * atom_count + 1 value offsets, one more
+ * than the number of values. The last one is the end of the last value
+ * @param bytes the buffer for the values. Can be NULL if bytes_size is 0
+ * @param bytes_size the size of the bytes buffer
+ * @param props_bits count * atom_count option bits, 0 for a missing property.
+ * Pass NULL if not needed
+ * @param present a bit for each value, set if the property exists. Bit i is
+ * present[i / 8] & (1 << (i % 8)). Pass NULL if not needed
+ * @param bytes_needed the total size of the values. Pass NULL if not needed
+ * @return true if the values fit in bytes. If false with no error, call again
+ * with a buffer of bytes_needed.
+ */
+bool xmp_get_properties_atom(const XmpPtr *xmps, uint32_t count,
+                             const XmpAtomPtr *atoms, uint32_t atom_count,
+                             uint32_t *offsets, char *bytes,
+                             uint32_t bytes_size, uint32_t *props_bits,
+                             uint8_t *present, uint32_t *bytes_needed);
+
 bool xmp_get_property_date(XmpPtr xmp, const char *schema, const char *name,
                            XmpDateTime *property, uint32_t *propsBits);
 bool xmp_get_property_float(XmpPtr xmp, const char *schema, const char *name,
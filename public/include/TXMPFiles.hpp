@@ -140,6 +140,14 @@ public:
     /// name of the plug-ins as a comma separated list to load the file handler plug-ins. 
     /// If plugins == NULL, then all plug-ins present in the plug-in directory will be loaded.
     ///
+    /// What is found in the plug-in directory is kept in a file of the user's cache folder, exempi
+    /// in \c $XDG_CACHE_HOME or \c ~/.cache on UNIX, in \c ~/Library/Caches on Mac and in
+    /// \c %LOCALAPPDATA% on Windows. Nothing is written to the plug-in directory. Later
+    /// initializations use the file instead of reading the plug-ins as long as the directory and
+    /// the plug-ins are unchanged. With \c kXMPFiles_NoPluginScan
+    /// the cache is used without checking the directory. A cache naming a plug-in outside of the
+    /// directory is ignored.
+    ///
     /// The main action is to activate the available smart file handlers. Must be called before
     /// using any methods except \c GetVersionInfo().
     ///
@@ -95,7 +95,8 @@ public:
     // ---------------------------------------------------------------------------------------------
     /// @brief \c Terminate() explicitly terminates usage of the XMP Toolkit.
     ///
-    /// Frees structures created on initialization.
+    /// Frees structures created on initialization. All XMP objects must be destroyed before the
+    /// last call, they share the node name table that is freed here.
     ///
     /// This function is static; make the call directly from the concrete class (\c SXMPMeta).
 
@@ -385,6 +386,127 @@ public:
                        tStringObj *     propValue,
                   	   XMP_OptionBits * options ) const;
 
+    // ---------------------------------------------------------------------------------------------
+    /// @brief \c ResolvePropertyAtom() resolves a property path once, for properties that are
+    /// looked up in many XMP objects.
+    ///
+    /// The namespace and path are checked as for \c GetProperty(), and a top level alias is resolved
+    /// to its actual property, once. Lookups through the returned atom of properties and struct
+    /// fields compare interned names instead of strings. The atom is not tied to any XMP object,
+    /// release it with \c ReleasePropertyAtom(), before \c Terminate().
+    ///
+    /// This function is static; make the call directly from the concrete class (\c SXMPMeta).
+    ///
+    /// @param schemaNS The namespace URI for the property; see \c GetProperty().
+    ///
+    /// @param propName The name of the property; see \c GetProperty().
+    ///
+    /// @return The resolved property atom.
+
+    static XMPPropertyAtomRef ResolvePropertyAtom ( XMP_StringPtr schemaNS,
+                                                    XMP_StringPtr propName );
+
+    // ---------------------------------------------------------------------------------------------
+    /// @brief \c ReleasePropertyAtom() releases an atom returned by \c ResolvePropertyAtom().
+    ///
+    /// This function is static; make the call directly from the concrete class (\c SXMPMeta).
+    ///
+    /// @param propAtom The property atom, can be null.
+
+    static void ReleasePropertyAtom ( XMPPropertyAtomRef propAtom );
+
+    // ---------------------------------------------------------------------------------------------
+    /// @brief \c GetPropertyByAtom() is \c GetProperty() for a property resolved ahead of time.
+    ///
+    /// @param propAtom The property atom returned by \c ResolvePropertyAtom(). Must not be null.
+    ///
+    /// @param propValue [out] A string object in which to return the value of the property; see
+    /// \c GetProperty().
+    ///
+    /// @param options A buffer in which to return option flags describing the property. Can be null
+    /// if the flags are not wanted.
+    ///
+    /// @return True if the property exists.
+
+    bool GetPropertyByAtom ( XMPPropertyAtomRef propAtom,
+                             tStringObj *       propValue,
+                             XMP_OptionBits *   options ) const;
+
+    // ---------------------------------------------------------------------------------------------
+    /// @brief \c SetPropertyByAtom() is \c SetProperty() for a property resolved ahead of time.
+    ///
+    /// @param propAtom The property atom returned by \c ResolvePropertyAtom(). Must not be null.
+    ///
+    /// @param propValue The new value; see \c SetProperty().
+    ///
+    /// @param options Option flags describing the property; see \c SetProperty().
+
+    void SetPropertyByAtom ( XMPPropertyAtomRef propAtom,
+                             XMP_StringPtr      propValue,
+                             XMP_OptionBits     options = 0 );
+
+    // ---------------------------------------------------------------------------------------------
+    /// @brief \c SetPropertyByAtom() sets a property value using a string object.
+    ///
+    /// Overloads the basic form of the function, allowing you to pass a string object for the
+    /// value. It is otherwise identical; see details in the canonical form.
+
+    void SetPropertyByAtom ( XMPPropertyAtomRef propAtom,
+                             const tStringObj & propValue,
+                             XMP_OptionBits     options = 0 );
+
+    // ---------------------------------------------------------------------------------------------
+    /// @brief \c GetPropertiesByAtom() gets the values of several properties from several XMP
+    /// objects, into buffers provided by the caller.
+    ///
+    /// The values are laid out by column: all of the values for the first atom, in the order of the
+    /// XMP objects, then all of the values for the next atom, and so on. Value \c i, for atom
+    /// \c i/metaCount and XMP object \c i%metaCount, is the bytes from \c valueBytes[valueOffsets[i]]
+    /// up to \c valueBytes[valueOffsets[i+1]], with no terminating nul. A missing property has an
+    /// empty value, as do arrays and structs.
+    ///
+    /// The offsets, options and present bits are always filled in. The value bytes are copied up to
+    /// the first value that does not fit in \c bytesSize, nothing is written after it. If the
+    /// returned size is larger than \c bytesSize, call again with a buffer of the returned size.
+    /// The XMP objects are read locked for the whole call.
+    ///
+    /// This function is static; make the call directly from the concrete class (\c SXMPMeta).
+    ///
+    /// @param xmpRefs The XMP objects, from \c GetInternalRef(). Can be null if \c metaCount is 0.
+    ///
+    /// @param metaCount The number of XMP objects.
+    ///
+    /// @param propAtoms The property atoms returned by \c ResolvePropertyAtom(). Can be null if
+    /// \c atomCount is 0.
+    ///
+    /// @param atomCount The number of property atoms.
+    ///
+    /// @param valueOffsets [out] An array of \c metaCount*atomCount+1 value offsets, one more than
+    /// the number of values. The last one is the end of the last value. Must not be null.
+    ///
+    /// @param valueBytes [out] A buffer for the value bytes. Can be null if \c bytesSize is 0.
+    ///
+    /// @param bytesSize The size of the \c valueBytes buffer.
+    ///
+    /// @param options [out] \c metaCount*atomCount option flags, 0 for a missing property. Can be
+    /// null if the flags are not wanted.
+    ///
+    /// @param presentBits [out] A bit for each value, set if the property exists. Bit \c i is
+    /// <tt>presentBits[i/8] & (1 << (i%8))</tt>. Can be null if the bits are not wanted.
+    ///
+    /// @return The total size of the values. The value bytes were filled in if it is not more than
+    /// \c bytesSize.
+
+    static XMP_Uns32 GetPropertiesByAtom ( const XMPMetaRef *         xmpRefs,
+                                           XMP_Uns32                  metaCount,
+                                           const XMPPropertyAtomRef * propAtoms,
+                                           XMP_Uns32                  atomCount,
+                                           XMP_Uns32 *                valueOffsets,
+                                           char *                     valueBytes,
+                                           XMP_Uns32                  bytesSize,
+                                           XMP_OptionBits *           options = 0,
+                                           XMP_Uns8 *                 presentBits = 0 );
+
     // ---------------------------------------------------------------------------------------------
     /// @brief \c GetArrayItem() provides access to items within an array.
     ///
@@ -1423,6 +1545,8 @@ public:
     /// OR of these bit-flag constants:
     ///   \li \c #kXMP_ParseMoreBuffers - This is not the last buffer of input, more calls follow.
     ///   \li \c #kXMP_RequireXMPMeta - The \c x:xmpmeta XML element is required around \c rdf:RDF.
+    ///   \li \c #kXMP_ParseSinglePass - Build the XMP tree in a single pass when the whole packet is
+    ///   in one buffer.
     ///
     /// @see \c TXMPFiles::GetXMP()
 
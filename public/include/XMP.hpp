@@ -45,6 +45,10 @@
 /// values, and is the default encoding for serialized XMP. The string type must also be suitable
 /// for UTF-16 or UTF-32 if those serialization encodings are used. This mainly means tolerating
 /// embedded 0 bytes, which \c std::string does.
+///
+/// Every \c TXMPMeta object, and every \c TXMPIterator over one, must be destroyed before the last
+/// call to \c TXMPMeta::Terminate(). The node names of all XMP objects share one table that
+/// \c Terminate() frees, an XMP object that outlives it is left pointing at freed memory.
 //  ================================================================================================
 
 /// /c XMP_Environment.h must be the first included header.
@@ -143,6 +143,10 @@ typedef struct __XMPMeta__ *        XMPMetaRef;
 /// iteration object across client DLL boundaries. See \c TXMPIterator.
 typedef struct __XMPIterator__ *    XMPIteratorRef;
 
+/// @brief An "ABI safe" pointer to a property path resolved ahead of time. See
+/// \c TXMPMeta::ResolvePropertyAtom().
+typedef struct __XMPPropertyAtom__ *    XMPPropertyAtomRef;
+
 /// @brief An "ABI safe" pointer to the internal part of an XMP document operations object. Use to pass an
 /// XMP document operations object across client DLL boundaries. See \c TXMPDocOps.
 typedef struct __XMPDocOps__ *    XMPDocOpsRef;
@@ -715,7 +719,12 @@ enum {
     kXMP_ParseMoreBuffers = 0x0002UL,
 
 	/// Do not reconcile alias differences, throw an exception.
-    kXMP_StrictAliasing   = 0x0004UL
+    kXMP_StrictAliasing   = 0x0004UL,
+
+	/// Build the XMP tree in a single pass, without an intermediate XML tree. Used only when the
+	/// whole packet is passed in one call. Input the single pass parser can't handle, including
+	/// XML or RDF errors, is quietly parsed again the usual way.
+    kXMP_ParseSinglePass  = 0x0008UL
 
 };
 
@@ -1118,6 +1127,9 @@ enum {
 enum {
     /// Ignore non-XMP text that uses an undefined "local" encoding.
     kXMPFiles_IgnoreLocalText = 0x0002,
+    /// Load the file handler plug-ins recorded in the user's plug-in cache without looking at the
+    /// folder or at the plug-ins. No plug-in is loaded if there is no cache.
+    kXMPFiles_NoPluginScan    = 0x0004,
     /// Combination of flags necessary for server products using XMPFiles.
     kXMPFiles_ServerMode      = kXMPFiles_IgnoreLocalText
 };
@@ -1206,7 +1218,36 @@ enum {
     kXMPFiles_OptimizeFileLayout    = 0x00000200,
 
 	/// When updating a PDF preserve state of document
-    kXMPFiles_PreservePDFState    =  0x00000400
+    kXMPFiles_PreservePDFState    =  0x00000400,
+
+	/// Buffer reads of a file, small reads and nearby seeks are then served from memory. Ignored for
+	/// a file that is mapped with \c #kXMPFiles_OpenMapFile.
+    kXMPFiles_OpenBufferedRead      = 0x00000800,
+
+	/// Map a file opened read-only into memory, reads then need no system calls. Only use this for
+	/// files that nothing else changes while they are open. If another process truncates the file,
+	/// reading the lost part of the mapping raises SIGBUS on POSIX systems, or an in-page error on
+	/// Windows, which XMPFiles cannot catch.
+    kXMPFiles_OpenMapFile           = 0x00001000,
+
+	/// Do not parse the TIFF/Exif of a JPEG, TIFF, Photoshop, or WebP file, or reconcile it with the
+	/// XMP. The tiff: and exif: properties are left as they are in the packet. Read-only opens only.
+    kXMPFiles_OpenSkipExif          = 0x00010000,
+
+	/// Do not parse the IPTC-IIM of a JPEG, TIFF, or Photoshop file, or reconcile it with the XMP.
+	/// Read-only opens only.
+    kXMPFiles_OpenSkipIPTC          = 0x00020000,
+
+	/// Do not parse the Photoshop image resources of a JPEG or TIFF file, or import them. The IPTC of
+	/// a JPEG file is inside the image resources and is skipped as well. Read-only opens only.
+    kXMPFiles_OpenSkipPSIR          = 0x00040000,
+
+	/// Do not compute the digest of the IPTC-IIM to check it against the XMP. If the file has XMP it
+	/// is taken to be in sync with the IPTC. Read-only opens only.
+    kXMPFiles_OpenSkipDigests       = 0x00080000,
+
+	/// All of the above, the XMP is returned as it is in the file.
+    kXMPFiles_OpenSkipReconcile     = 0x000F0000
 
 };
 
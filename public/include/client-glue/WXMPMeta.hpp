@@ -65,6 +65,21 @@ static inline XMP_Bool WrapErrorNotify ( XMPMeta_ErrorCallbackProc proc, void *
 #define zXMPMeta_GetProperty_1(schemaNS,propName,propValue,options,SetClientString) \
     WXMPMeta_GetProperty_1 ( this->xmpRef, schemaNS, propName, propValue, options, SetClientString, &wResult )
 
+#define zXMPMeta_ResolvePropertyAtom_1(schemaNS,propName) \
+    WXMPMeta_ResolvePropertyAtom_1 ( schemaNS, propName, &wResult )
+
+#define zXMPMeta_ReleasePropertyAtom_1(propAtom) \
+    WXMPMeta_ReleasePropertyAtom_1 ( propAtom, &wResult )
+
+#define zXMPMeta_GetPropertyByAtom_1(propAtom,propValue,options,SetClientString) \
+    WXMPMeta_GetPropertyByAtom_1 ( this->xmpRef, propAtom, propValue, options, SetClientString, &wResult )
+
+#define zXMPMeta_SetPropertyByAtom_1(propAtom,propValue,options) \
+    WXMPMeta_SetPropertyByAtom_1 ( this->xmpRef, propAtom, propValue, options, &wResult )
+
+#define zXMPMeta_GetPropertiesByAtom_1(xmpRefs,metaCount,propAtoms,atomCount,valueOffsets,valueBytes,bytesSize,options,presentBits) \
+    WXMPMeta_GetPropertiesByAtom_1 ( xmpRefs, metaCount, propAtoms, atomCount, valueOffsets, valueBytes, bytesSize, options, presentBits, &wResult )
+
 #define zXMPMeta_GetArrayItem_1(schemaNS,arrayName,itemIndex,itemValue,options,SetClientString) \
     WXMPMeta_GetArrayItem_1 ( this->xmpRef, schemaNS, arrayName, itemIndex, itemValue, options, SetClientString, &wResult )
 
@@ -264,6 +279,42 @@ XMP_PUBLIC WXMPMeta_GetProperty_1 ( XMPMetaRef       xmpRef,
                          SetClientStringProc SetClientString,
                          WXMP_Result *    wResult ) /* const */ ;
 
+extern void
+XMP_PUBLIC WXMPMeta_ResolvePropertyAtom_1 ( XMP_StringPtr schemaNS,
+                                 XMP_StringPtr propName,
+                                 WXMP_Result * wResult );
+
+extern void
+XMP_PUBLIC WXMPMeta_ReleasePropertyAtom_1 ( XMPPropertyAtomRef propAtom,
+                                 WXMP_Result *      wResult );
+
+extern void
+XMP_PUBLIC WXMPMeta_GetPropertyByAtom_1 ( XMPMetaRef         xmpRef,
+                               XMPPropertyAtomRef propAtom,
+                               void *             propValue,
+                               XMP_OptionBits *   options,
+                               SetClientStringProc SetClientString,
+                               WXMP_Result *      wResult ) /* const */ ;
+
+extern void
+XMP_PUBLIC WXMPMeta_SetPropertyByAtom_1 ( XMPMetaRef         xmpRef,
+                               XMPPropertyAtomRef propAtom,
+                               XMP_StringPtr      propValue,
+                               XMP_OptionBits     options,
+                               WXMP_Result *      wResult );
+
+extern void
+XMP_PUBLIC WXMPMeta_GetPropertiesByAtom_1 ( const XMPMetaRef *         xmpRefs,
+                                 XMP_Uns32                  metaCount,
+                                 const XMPPropertyAtomRef * propAtoms,
+                                 XMP_Uns32                  atomCount,
+                                 XMP_Uns32 *                valueOffsets,
+                                 char *                     valueBytes,
+                                 XMP_Uns32                  bytesSize,
+                                 XMP_OptionBits *           options,
+                                 XMP_Uns8 *                 presentBits,
+                                 WXMP_Result *              wResult );
+
 extern void
 XMP_PUBLIC WXMPMeta_GetArrayItem_1 ( XMPMetaRef       xmpRef,
                           XMP_StringPtr    schemaNS,
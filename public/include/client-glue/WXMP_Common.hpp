@@ -112,6 +112,10 @@ extern "C" {
     InvokeCheck(WCallProto);                  \
     XMPDocOpsRef result = XMPDocOpsRef(wResult.ptrResult)
 
+#define WrapCheckPropertyAtomRef(result,WCallProto) \
+    InvokeCheck(WCallProto);                        \
+    XMPPropertyAtomRef result = XMPPropertyAtomRef(wResult.ptrResult)
+
 #define  WrapCheckNewMetadata(result,WCallProto) \
     InvokeCheck(WCallProto);                  \
     void * result = wResult.ptrResult
@@ -140,6 +144,10 @@ extern "C" {
     InvokeCheck(WCallProto);              \
     XMP_Int32 result = wResult.int32Result
 
+#define WrapCheckUns32(result,WCallProto) \
+    InvokeCheck(WCallProto);              \
+    XMP_Uns32 result = wResult.int32Result
+
 #define WrapCheckInt64(result,WCallProto) \
     InvokeCheck(WCallProto);              \
     XMP_Int64 result = wResult.int64Result
@@ -0,0 +1,124 @@
+/*
+ * exempi - CRC32Benchmark.cpp
+ *
+ * Copyright (C) 2026 The exempi contributors
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1 Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2 Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the
+ * distribution.
+ *
+ * 3 Neither the name of the Authors, nor the names of its
+ * contributors may be used to endorse or promote products derived
+ * from this software wit hout specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+* Measures the throughput of the CRC-32 used for PNG chunks and ZIP entries. Each form that this
+* CPU can run is timed on chunk sized buffers and on one large buffer, and checked against zlib.
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+
+#include "public/include/XMP_Environment.h"
+#include "public/include/XMP_Const.h"
+
+#include "source/CRC32.hpp"
+
+#include <zlib.h>
+
+using namespace std;
+
+// =================================================================================================
+
+static XMP_Uns32
+Update_zlib ( XMP_Uns32 crc, const XMP_Uns8 * data, size_t length )
+{
+	return (XMP_Uns32) crc32 ( crc, data, (uInt)length );
+}
+
+// =================================================================================================
+
+static void
+TimeCRC ( const char * name, CRC32::UpdateProc proc, const vector<XMP_Uns8> & data, size_t blockSize, size_t megabytes )
+{
+	size_t rounds = (megabytes * 1024 * 1024) / data.size();
+	if ( rounds == 0 ) rounds = 1;
+
+	XMP_Uns32 crc = 0;
+	clock_t start = clock();
+	for ( size_t r = 0; r < rounds; ++r ) {
+		for ( size_t offset = 0; offset < data.size(); offset += blockSize ) {
+			size_t length = data.size() - offset;
+			if ( length > blockSize ) length = blockSize;
+			crc = proc ( 0, &data[offset], length );
+		}
+	}
+	double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	XMP_Uns32 check = proc ( 0, &data[0], data.size() );
+	bool ok = (check == Update_zlib ( 0, &data[0], data.size() ));
+
+	double total = ((double)data.size() * rounds) / (1024.0 * 1024.0);
+	printf ( "%-10s %8zu byte blocks %9.1f MB/s%s\n", name, blockSize, (total / seconds), (ok ? "" : ", WRONG") );
+	(void)crc;
+
+}	// TimeCRC
+
+// =================================================================================================
+
+extern "C" int
+main ( int argc, const char * argv [] )
+{
+	size_t megabytes = 256;
+	if ( argc > 1 ) megabytes = (size_t) atoi ( argv[1] );
+	if ( megabytes == 0 ) {
+		printf ( "usage: CRC32Benchmark [megabytes]\n" );
+		return 0;
+	}
+
+	vector<XMP_Uns8> data ( 4*1024*1024 );
+	XMP_Uns32 seed = 1;
+	for ( size_t i = 0; i < data.size(); ++i ) {
+		seed = (seed * 1103515245) + 12345;
+		data[i] = (XMP_Uns8) (seed >> 16);
+	}
+
+	printf ( "Computing CRC-32 over %zu MB per form\n", megabytes );
+
+	const size_t blockSizes[] = { 64, 4*1024, data.size() };
+	for ( size_t b = 0; b < (sizeof(blockSizes) / sizeof(blockSizes[0])); ++b ) {
+		size_t blockSize = blockSizes[b];
+		TimeCRC ( "bytewise", CRC32::Update_Bytewise, data, blockSize, megabytes );
+		TimeCRC ( "slice8", CRC32::Update_Slice8, data, blockSize, megabytes );
+		if ( CRC32::HasCLMUL() ) TimeCRC ( "CLMUL", CRC32::Update_CLMUL, data, blockSize, megabytes );
+		if ( CRC32::HasARMv8() ) TimeCRC ( "ARMv8", CRC32::Update_ARMv8, data, blockSize, megabytes );
+		TimeCRC ( "zlib", Update_zlib, data, blockSize, megabytes );
+	}
+
+	return 0;
+
+}
@@ -0,0 +1,159 @@
+/*
+ * exempi - InitBenchmark.cpp
+ *
+ * Copyright (C) 2026 The exempi contributors
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1 Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2 Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the
+ * distribution.
+ *
+ * 3 Neither the name of the Authors, nor the names of its
+ * contributors may be used to endorse or promote products derived
+ * from this software wit hout specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+* Measures the library startup cost of a short-lived process. XMPCore and XMPFiles are initialized
+* and terminated repeatedly, each on its own and then together.
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+
+// Must be defined to instantiate template classes
+#define TXMP_STRING_TYPE std::string
+
+// Must be defined to give access to XMPFiles
+#define XMP_INCLUDE_XMPFILES 1
+
+// Ensure XMP templates are instantiated
+#include "public/include/XMP.incl_cpp"
+
+// Provide access to the API
+#include "public/include/XMP.hpp"
+
+using namespace std;
+
+// =================================================================================================
+
+static XMP_OptionBits
+FilesOptions()
+{
+	XMP_OptionBits options = 0;
+	#if UNIX_ENV
+		options |= kXMPFiles_ServerMode;
+	#endif
+	return options;
+
+}	// FilesOptions
+
+// =================================================================================================
+
+static bool
+TimeCore ( int rounds )
+{
+	clock_t start = clock();
+	for ( int r = 0; r < rounds; ++r ) {
+		if ( ! SXMPMeta::Initialize() ) return false;
+		SXMPMeta::Terminate();
+	}
+	double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	printf ( "  %-12s %8.1f us/init\n", "XMPCore", (seconds * 1e6 / rounds) );
+	return true;
+
+}	// TimeCore
+
+// =================================================================================================
+
+static bool
+TimeFiles ( int rounds )
+{
+	if ( ! SXMPMeta::Initialize() ) return false;
+
+	clock_t start = clock();
+	for ( int r = 0; r < rounds; ++r ) {
+		if ( ! SXMPFiles::Initialize ( FilesOptions() ) ) {
+			SXMPMeta::Terminate();
+			return false;
+		}
+		SXMPFiles::Terminate();
+	}
+	double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	SXMPMeta::Terminate();
+
+	printf ( "  %-12s %8.1f us/init\n", "XMPFiles", (seconds * 1e6 / rounds) );
+	return true;
+
+}	// TimeFiles
+
+// =================================================================================================
+
+static bool
+TimeBoth ( int rounds )
+{
+	clock_t start = clock();
+	for ( int r = 0; r < rounds; ++r ) {
+		if ( ! SXMPMeta::Initialize() ) return false;
+		if ( ! SXMPFiles::Initialize ( FilesOptions() ) ) {
+			SXMPMeta::Terminate();
+			return false;
+		}
+		SXMPFiles::Terminate();
+		SXMPMeta::Terminate();
+	}
+	double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	printf ( "  %-12s %8.1f us/init\n", "both", (seconds * 1e6 / rounds) );
+	return true;
+
+}	// TimeBoth
+
+// =================================================================================================
+
+extern "C" int
+main ( int argc, const char * argv [] )
+{
+	int rounds = 1000;
+	if ( (argc > 2) && (string ( argv[1] ) == "-rounds") ) rounds = atoi ( argv[2] );
+	if ( rounds <= 0 ) rounds = 1;
+
+	printf ( "Initialize and Terminate, %d rounds\n", rounds );
+
+	try {
+		if ( ! (TimeCore ( rounds ) && TimeFiles ( rounds ) && TimeBoth ( rounds )) ) {
+			printf ( "Could not initialize toolkit!\n" );
+			return -1;
+		}
+	} catch ( XMP_Error & e ) {
+		printf ( "XMP error %d: %s\n", e.GetID(), e.GetErrMsg() );
+		return -1;
+	}
+
+	return 0;
+
+}
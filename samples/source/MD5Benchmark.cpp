@@ -0,0 +1,115 @@
+/*
+ * exempi - MD5Benchmark.cpp
+ *
+ * Copyright (C) 2026 The exempi contributors
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1 Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2 Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the
+ * distribution.
+ *
+ * 3 Neither the name of the Authors, nor the names of its
+ * contributors may be used to endorse or promote products derived
+ * from this software wit hout specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+* Measures the per file cost of the MD5 digests that XMPFiles computes: the IPTC and legacy digests
+* used for reconciliation, and the GUID of JPEG extended XMP. A batch of buffers of each size is
+* hashed one at a time with MD5Digest.
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+#include "public/include/XMP_Environment.h"
+#include "public/include/XMP_Const.h"
+
+#include "third-party/zuid/interfaces/MD5.h"
+
+using namespace std;
+
+// =================================================================================================
+
+static void
+TimeDigests ( const char * name, XMP_Uns32 length, XMP_Uns32 fileCount, size_t megabytes )
+{
+	vector<XMP_Uns8> data ( (size_t)length * fileCount + 1 );
+	XMP_Uns32 seed = length;
+	for ( size_t i = 0; i < data.size(); ++i ) {
+		seed = (seed * 1103515245) + 12345;
+		data[i] = (XMP_Uns8) (seed >> 16);
+	}
+
+	vector<const void *> inputs ( fileCount );
+	vector<XMP_Uns8> digests ( 16 * fileCount );
+	for ( XMP_Uns32 f = 0; f < fileCount; ++f ) inputs[f] = &data[(size_t)f * length];
+
+	size_t rounds = (megabytes * 1024 * 1024) / ((size_t)length * fileCount);
+	if ( rounds == 0 ) rounds = 1;
+
+	clock_t start = clock();
+	for ( size_t r = 0; r < rounds; ++r ) {
+		for ( XMP_Uns32 f = 0; f < fileCount; ++f ) MD5Digest ( inputs[f], length, &digests[16*f] );
+	}
+	double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	MD5_CTX context;	// Check the last digest against the streaming form.
+	XMP_Uns8 streamed[16];
+	MD5Init ( &context );
+	MD5Update ( &context, (const XMP_Uns8*) inputs[fileCount-1], length );
+	MD5Final ( streamed, &context );
+	bool ok = (memcmp ( streamed, &digests[16*(fileCount-1)], 16 ) == 0);
+	double digestCount = (double)rounds * fileCount;
+
+	printf ( "%-14s %8u bytes: %8.2f us/file %7.1f MB/s%s\n",
+			 name, length,
+			 (seconds * 1e6 / digestCount), ((digestCount * length) / (1024.0 * 1024.0) / seconds),
+			 (ok ? "" : ", MISMATCH") );
+
+}	// TimeDigests
+
+// =================================================================================================
+
+extern "C" int
+main ( int argc, const char * argv [] )
+{
+	size_t megabytes = 128;
+	if ( argc > 1 ) megabytes = (size_t) atoi ( argv[1] );
+	if ( megabytes == 0 ) {
+		printf ( "usage: MD5Benchmark [megabytes]\n" );
+		return 0;
+	}
+
+	printf ( "Hashing %zu MB per size, 64 files per batch\n", megabytes );
+
+	TimeDigests ( "IPTC", 2*1024, 64, megabytes );
+	TimeDigests ( "legacy video", 16*1024, 64, megabytes );
+	TimeDigests ( "extended XMP", 128*1024, 64, megabytes );
+
+	return 0;
+
+}
@@ -0,0 +1,200 @@
+/*
+ * exempi - MP4UpdateBenchmark.cpp
+ *
+ * Copyright (C) 2026 The exempi contributors
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1 Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2 Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the
+ * distribution.
+ *
+ * 3 Neither the name of the Authors, nor the names of its
+ * contributors may be used to endorse or promote products derived
+ * from this software wit hout specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+* Measures the cost of repeated XMP updates to an MPEG-4 or QuickTime file. A copy of the file is
+* opened for update a number of times, each time a keyword is added so the XMP keeps growing. The
+* bytes written by each update are taken from the process I/O counters, an update that rewrites or
+* moves the 'moov' box shows up as roughly the size of that box.
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <fstream>
+
+// Must be defined to instantiate template classes
+#define TXMP_STRING_TYPE std::string
+
+// Must be defined to give access to XMPFiles
+#define XMP_INCLUDE_XMPFILES 1
+
+// Ensure XMP templates are instantiated
+#include "public/include/XMP.incl_cpp"
+
+// Provide access to the API
+#include "public/include/XMP.hpp"
+
+using namespace std;
+
+// =================================================================================================
+
+static long long
+GetBytesWritten()
+{
+	// The Linux per process counter of bytes passed to write calls, -1 if not available.
+
+	FILE * ioFile = fopen ( "/proc/self/io", "r" );
+	if ( ioFile == 0 ) return -1;
+
+	long long wchar = -1;
+	char line [128];
+	while ( fgets ( line, sizeof(line), ioFile ) != 0 ) {
+		if ( strncmp ( line, "wchar:", 6 ) == 0 ) wchar = atoll ( &line[6] );
+	}
+
+	fclose ( ioFile );
+	return wchar;
+
+}	// GetBytesWritten
+
+// =================================================================================================
+
+static bool
+CopyFile ( const string & from, const string & to )
+{
+	ifstream in ( from.c_str(), ios::binary );
+	ofstream out ( to.c_str(), ios::binary | ios::trunc );
+	if ( (! in) || (! out) ) return false;
+	out << in.rdbuf();
+	return (bool) out;
+
+}	// CopyFile
+
+// =================================================================================================
+
+static bool
+UpdateOnce ( const string & filename, int round )
+{
+	SXMPFiles file;
+	if ( ! file.OpenFile ( filename, kXMP_UnknownFile, (kXMPFiles_OpenForUpdate | kXMPFiles_OpenUseSmartHandler) ) ) {
+		return false;
+	}
+
+	SXMPMeta meta;
+	file.GetXMP ( &meta );
+
+	char keyword [256];
+	snprintf ( keyword, sizeof(keyword), "Keyword %d, long enough to make each update grow the XMP by a "
+			   "noticeable amount so the padding is used up after a few rounds", round );
+	meta.AppendArrayItem ( kXMP_NS_DC, "subject", kXMP_PropArrayIsUnordered, keyword );
+
+	bool ok = file.CanPutXMP ( meta );
+	if ( ok ) file.PutXMP ( meta );
+	file.CloseFile();
+	return ok;
+
+}	// UpdateOnce
+
+// =================================================================================================
+
+extern "C" int
+main ( int argc, const char * argv [] )
+{
+	if ( (argc < 2) || (argc > 3) ) {
+		printf ( "usage: MP4UpdateBenchmark (filename) [updates]\n" );
+		return 0;
+	}
+
+	string original = argv[1];
+	string filename = original + ".bench";
+	int updates = (argc > 2) ? atoi ( argv[2] ) : 50;
+
+	if ( ! CopyFile ( original, filename ) ) {
+		printf ( "Can't copy %s to %s\n", original.c_str(), filename.c_str() );
+		return -1;
+	}
+
+	if ( ! SXMPMeta::Initialize() ) {
+		printf ( "Could not initialize toolkit!\n" );
+		return -1;
+	}
+
+	XMP_OptionBits options = 0;
+	#if UNIX_ENV
+		options |= kXMPFiles_ServerMode;
+	#endif
+
+	if ( ! SXMPFiles::Initialize ( options ) ) {
+		printf ( "Could not initialize SXMPFiles.\n" );
+		SXMPMeta::Terminate();
+		return -1;
+	}
+
+	long long totalBytes = 0, maxBytes = 0;
+	clock_t start = clock();
+
+	try {
+
+		for ( int round = 1; round <= updates; ++round ) {
+
+			long long before = GetBytesWritten();
+			if ( ! UpdateOnce ( filename, round ) ) {
+				printf ( "Update %d failed\n", round );
+				break;
+			}
+			long long bytes = GetBytesWritten() - before;
+
+			if ( before < 0 ) {
+				printf ( "update %3d\n", round );
+			} else {
+				printf ( "update %3d: %10lld bytes written\n", round, bytes );
+				totalBytes += bytes;
+				if ( bytes > maxBytes ) maxBytes = bytes;
+			}
+
+		}
+
+	} catch ( XMP_Error & e ) {
+		printf ( "ERROR: %s\n", e.GetErrMsg() );
+	}
+
+	double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	SXMPFiles::Terminate();
+	SXMPMeta::Terminate();
+
+	if ( updates > 0 ) {
+		printf ( "%d updates, %.2f ms each", updates, (seconds * 1000.0) / updates );
+		if ( maxBytes > 0 ) printf ( ", %lld bytes written on average, %lld at most", (totalBytes / updates), maxBytes );
+		printf ( "\n" );
+	}
+
+	remove ( filename.c_str() );
+	return 0;
+
+}
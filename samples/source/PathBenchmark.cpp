@@ -0,0 +1,198 @@
+/*
+ * exempi - PathBenchmark.cpp
+ *
+ * Copyright (C) 2026 The exempi contributors
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1 Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2 Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the
+ * distribution.
+ *
+ * 3 Neither the name of the Authors, nor the names of its
+ * contributors may be used to endorse or promote products derived
+ * from this software wit hout specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+* Measures repeated property access with string paths against property atoms resolved once. The
+* same paths, top level properties, struct fields, an alias and array items, are read and then set
+* over and over in one XMP object.
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <vector>
+
+// Must be defined to instantiate template classes
+#define TXMP_STRING_TYPE std::string
+
+// Ensure XMP templates are instantiated
+#include "public/include/XMP.incl_cpp"
+
+// Provide access to the API
+#include "public/include/XMP.hpp"
+
+using namespace std;
+
+// =================================================================================================
+
+struct PathInfo {
+	XMP_StringPtr schemaNS;
+	XMP_StringPtr propName;
+	XMP_StringPtr propValue;
+};
+
+static const PathInfo kPaths[] = {
+	{ kXMP_NS_TIFF, "Make", "Canon" },
+	{ kXMP_NS_TIFF, "Model", "Canon EOS 20D" },
+	{ kXMP_NS_TIFF, "Orientation", "1" },
+	{ kXMP_NS_TIFF, "ImageWidth", "3504" },
+	{ kXMP_NS_TIFF, "ImageLength", "2336" },
+	{ kXMP_NS_EXIF, "ExposureTime", "1/125" },
+	{ kXMP_NS_EXIF, "FNumber", "8/1" },
+	{ kXMP_NS_EXIF, "Flash/exif:Fired", "False" },
+	{ kXMP_NS_EXIF, "Flash/exif:Mode", "2" },
+	{ kXMP_NS_EXIF, "Flash/exif:Return", "0" },
+	{ kXMP_NS_XMP, "CreatorTool", "Adobe Photoshop Camera Raw 3.1" },
+	{ kXMP_NS_XMP, "Author", "unknown" },	// An alias to dc:creator[1].
+	{ kXMP_NS_DC, "subject[1]", "night" },
+	{ kXMP_NS_DC, "subject[2]", "city" },
+};
+
+static const size_t kPathCount = sizeof ( kPaths ) / sizeof ( kPaths[0] );
+
+// =================================================================================================
+
+static double
+Elapsed ( clock_t start, int rounds )
+{
+	double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	return (seconds * 1e9 / ((double)rounds * kPathCount));
+
+}	// Elapsed
+
+// =================================================================================================
+
+static void
+TimePaths ( SXMPMeta & meta, int rounds )
+{
+	string value;
+	size_t found = 0;
+
+	clock_t start = clock();
+	for ( int r = 0; r < rounds; ++r ) {
+		for ( size_t p = 0; p < kPathCount; ++p ) {
+			found += meta.GetProperty ( kPaths[p].schemaNS, kPaths[p].propName, &value, 0 );
+		}
+	}
+	double getTime = Elapsed ( start, rounds );
+
+	start = clock();
+	for ( int r = 0; r < rounds; ++r ) {
+		for ( size_t p = 0; p < kPathCount; ++p ) {
+			meta.SetProperty ( kPaths[p].schemaNS, kPaths[p].propName, kPaths[p].propValue );
+		}
+	}
+	double setTime = Elapsed ( start, rounds );
+
+	printf ( "  %-8s %8.1f ns/get %8.1f ns/set  (%lu found)\n", "strings", getTime, setTime, (unsigned long)found );
+
+}	// TimePaths
+
+// =================================================================================================
+
+static void
+TimeAtoms ( SXMPMeta & meta, int rounds )
+{
+	vector<XMPPropertyAtomRef> atoms;
+	for ( size_t p = 0; p < kPathCount; ++p ) {
+		atoms.push_back ( SXMPMeta::ResolvePropertyAtom ( kPaths[p].schemaNS, kPaths[p].propName ) );
+	}
+
+	string value;
+	size_t found = 0;
+
+	clock_t start = clock();
+	for ( int r = 0; r < rounds; ++r ) {
+		for ( size_t p = 0; p < kPathCount; ++p ) {
+			found += meta.GetPropertyByAtom ( atoms[p], &value, 0 );
+		}
+	}
+	double getTime = Elapsed ( start, rounds );
+
+	start = clock();
+	for ( int r = 0; r < rounds; ++r ) {
+		for ( size_t p = 0; p < kPathCount; ++p ) {
+			meta.SetPropertyByAtom ( atoms[p], kPaths[p].propValue );
+		}
+	}
+	double setTime = Elapsed ( start, rounds );
+
+	for ( size_t p = 0; p < kPathCount; ++p ) SXMPMeta::ReleasePropertyAtom ( atoms[p] );
+
+	printf ( "  %-8s %8.1f ns/get %8.1f ns/set  (%lu found)\n", "atoms", getTime, setTime, (unsigned long)found );
+
+}	// TimeAtoms
+
+// =================================================================================================
+
+extern "C" int
+main ( int argc, const char * argv [] )
+{
+	int rounds = 100000;
+	if ( (argc > 2) && (string ( argv[1] ) == "-rounds") ) rounds = atoi ( argv[2] );
+	if ( rounds <= 0 ) rounds = 1;
+
+	if ( ! SXMPMeta::Initialize() ) {
+		printf ( "Could not initialize toolkit!\n" );
+		return -1;
+	}
+
+	int status = 0;
+
+	try {
+
+		SXMPMeta meta;
+		meta.SetProperty ( kXMP_NS_EXIF, "Flash", 0, kXMP_PropValueIsStruct );
+		meta.AppendArrayItem ( kXMP_NS_DC, "creator", kXMP_PropArrayIsOrdered, "unknown" );
+		meta.AppendArrayItem ( kXMP_NS_DC, "subject", kXMP_PropArrayIsUnordered, "night" );
+		meta.AppendArrayItem ( kXMP_NS_DC, "subject", kXMP_PropArrayIsUnordered, "city" );
+		for ( size_t p = 0; p < kPathCount; ++p ) {
+			meta.SetProperty ( kPaths[p].schemaNS, kPaths[p].propName, kPaths[p].propValue );
+		}
+
+		printf ( "%lu paths, %d rounds\n", (unsigned long)kPathCount, rounds );
+		TimePaths ( meta, rounds );
+		TimeAtoms ( meta, rounds );
+
+	} catch ( XMP_Error & e ) {
+		printf ( "XMP error %d: %s\n", e.GetID(), e.GetErrMsg() );
+		status = -1;
+	}
+
+	SXMPMeta::Terminate();
+	return status;
+
+}
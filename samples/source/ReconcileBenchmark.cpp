@@ -0,0 +1,142 @@
+/*
+ * exempi - ReconcileBenchmark.cpp
+ *
+ * Copyright (C) 2026 The exempi contributors
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1 Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2 Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the
+ * distribution.
+ *
+ * 3 Neither the name of the Authors, nor the names of its
+ * contributors may be used to endorse or promote products derived
+ * from this software wit hout specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+* Measures what the legacy reconciliation costs a read-only open. Each file is opened and its XMP
+* fetched repeatedly, with the full reconciliation and with each of the kXMPFiles_OpenSkip options.
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+
+// Must be defined to instantiate template classes
+#define TXMP_STRING_TYPE std::string
+
+// Must be defined to give access to XMPFiles
+#define XMP_INCLUDE_XMPFILES 1
+
+// Ensure XMP templates are instantiated
+#include "public/include/XMP.incl_cpp"
+
+// Provide access to the API
+#include "public/include/XMP.hpp"
+
+using namespace std;
+
+// =================================================================================================
+
+static void
+TimeOpens ( const char * path, const char * name, XMP_OptionBits skipOptions, int rounds )
+{
+	XMP_OptionBits openFlags = kXMPFiles_OpenForRead | kXMPFiles_OpenUseSmartHandler | skipOptions;
+	size_t propCount = 0;
+
+	clock_t start = clock();
+	for ( int r = 0; r < rounds; ++r ) {
+		SXMPFiles file;
+		if ( ! file.OpenFile ( path, kXMP_UnknownFile, openFlags ) ) {
+			printf ( "%s: can't open\n", path );
+			return;
+		}
+		SXMPMeta xmp;
+		file.GetXMP ( &xmp );
+		file.CloseFile();
+		if ( r == 0 ) {
+			SXMPIterator iter ( xmp, kXMP_IterJustLeafNodes );
+			while ( iter.Next() ) ++propCount;
+		}
+	}
+	double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	printf ( "  %-12s %8.1f us/open, %zu properties\n", name, (seconds * 1e6 / rounds), propCount );
+
+}	// TimeOpens
+
+// =================================================================================================
+
+extern "C" int
+main ( int argc, const char * argv [] )
+{
+	if ( argc < 2 ) {
+		printf ( "usage: ReconcileBenchmark [-rounds N] file ...\n" );
+		return 0;
+	}
+
+	int rounds = 1000;
+	int firstFile = 1;
+	if ( (argc > 3) && (string ( argv[1] ) == "-rounds") ) {
+		rounds = atoi ( argv[2] );
+		firstFile = 3;
+	}
+	if ( rounds <= 0 ) rounds = 1;
+
+	if ( ! SXMPMeta::Initialize() ) {
+		printf ( "Could not initialize toolkit!\n" );
+		return -1;
+	}
+
+	XMP_OptionBits options = 0;
+	#if UNIX_ENV
+		options |= kXMPFiles_ServerMode;
+	#endif
+
+	if ( ! SXMPFiles::Initialize ( options ) ) {
+		printf ( "Could not initialize SXMPFiles.\n" );
+		SXMPMeta::Terminate();
+		return -1;
+	}
+
+	try {
+		for ( int i = firstFile; i < argc; ++i ) {
+			printf ( "%s, %d rounds\n", argv[i], rounds );
+			TimeOpens ( argv[i], "reconcile", 0, rounds );
+			TimeOpens ( argv[i], "no digests", kXMPFiles_OpenSkipDigests, rounds );
+			TimeOpens ( argv[i], "no Exif", kXMPFiles_OpenSkipExif, rounds );
+			TimeOpens ( argv[i], "no IPTC", kXMPFiles_OpenSkipIPTC, rounds );
+			TimeOpens ( argv[i], "no PSIR", kXMPFiles_OpenSkipPSIR, rounds );
+			TimeOpens ( argv[i], "raw XMP", kXMPFiles_OpenSkipReconcile, rounds );
+		}
+	} catch ( XMP_Error & e ) {
+		printf ( "XMP error %d: %s\n", e.GetID(), e.GetErrMsg() );
+	}
+
+	SXMPFiles::Terminate();
+	SXMPMeta::Terminate();
+
+	return 0;
+
+}
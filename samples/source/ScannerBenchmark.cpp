@@ -0,0 +1,206 @@
+/*
+ * exempi - ScannerBenchmark.cpp
+ *
+ * Copyright (C) 2026 The exempi contributors
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1 Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2 Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the
+ * distribution.
+ *
+ * 3 Neither the name of the Authors, nor the names of its
+ * contributors may be used to endorse or promote products derived
+ * from this software wit hout specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+* Measures the throughput of the XMP packet scanner. A synthetic input of noisy binary data with
+* packets in the 8, 16, and 32 bit forms is scanned in 64 KB blocks, once with each form of the
+* header prefilter that this CPU can run, and once with the old byte at a time search.
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#define TestRunnerBuild 1
+
+#include "public/include/XMP_Environment.h"
+#include "public/include/XMP_Const.h"
+
+#include "XMPFiles/source/FormatSupport/XMPScanner.hpp"
+#include "XMPFiles/source/FormatSupport/XMPScanner.cpp"
+
+using namespace std;
+
+// =================================================================================================
+
+static const XMP_Uns8 *
+FindHeadCandidate_Bytewise ( const XMP_Uns8 * ptr, const XMP_Uns8 * limit )
+{
+	while ( (ptr < limit) && (*ptr != '<') ) ++ptr;	// What FindLessThan did before the prefilter.
+	return ptr;
+}
+
+// =================================================================================================
+
+static void
+AppendPacket ( vector<XMP_Uns8> * data, size_t bytesPerChar, bool bigEndian )
+{
+	static const char * kHeadStart = "<?xpacket begin='";
+	static const char * kHeadRest  = "' id='W5M0MpCehiHzreSzNTczkc9d'?>"
+									 "<x:xmpmeta xmlns:x='adobe:ns:meta/'/>"
+									 "<?xpacket end='w'?>";
+
+	vector<XMP_Uns32> chars;
+	for ( const char * ch = kHeadStart; *ch != 0; ++ch ) chars.push_back ( (XMP_Uns8)*ch );
+	chars.push_back ( 0xFEFF );	// The byte order mark, UTF-8 for the 8 bit form.
+	for ( const char * ch = kHeadRest; *ch != 0; ++ch ) chars.push_back ( (XMP_Uns8)*ch );
+
+	for ( size_t i = 0; i < chars.size(); ++i ) {
+		XMP_Uns32 ch = chars[i];
+		if ( bytesPerChar == 1 ) {
+			if ( ch == 0xFEFF ) {
+				data->push_back ( 0xEF ); data->push_back ( 0xBB ); data->push_back ( 0xBF );
+			} else {
+				data->push_back ( (XMP_Uns8)ch );
+			}
+		} else {
+			for ( size_t b = 0; b < bytesPerChar; ++b ) {
+				size_t shift = bigEndian ? (8 * (bytesPerChar - 1 - b)) : (8 * b);
+				data->push_back ( (XMP_Uns8) (ch >> shift) );
+			}
+		}
+	}
+
+}	// AppendPacket
+
+// =================================================================================================
+
+static void
+AppendNoise ( vector<XMP_Uns8> * data, size_t length, XMP_Uns32 * seed )
+{
+	// Compressed media is close to random bytes, plus some runs of nulls. Both matter, a '<'
+	// followed by a null passes the prefilter.
+
+	for ( size_t i = 0; i < length; ++i ) {
+		*seed = (*seed * 1103515245) + 12345;
+		XMP_Uns8 byte = (XMP_Uns8) (*seed >> 16);
+		if ( (*seed & 0x0F000000) == 0 ) byte = 0;
+		data->push_back ( byte );
+	}
+
+}	// AppendNoise
+
+// =================================================================================================
+
+static size_t
+ScanAll ( const vector<XMP_Uns8> & data )
+{
+	const size_t kBlockSize = 64*1024;
+	XMPScanner scanner ( (XMP_Int64)data.size() );
+
+	for ( size_t offset = 0; offset < data.size(); offset += kBlockSize ) {
+		size_t length = data.size() - offset;
+		if ( length > kBlockSize ) length = kBlockSize;
+		scanner.Scan ( &data[offset], (XMP_Int64)offset, (XMP_Int64)length );
+	}
+
+	long snipCount = scanner.GetSnipCount();
+	XMPScanner::SnipInfoVector snips ( snipCount );
+	scanner.Report ( snips );
+
+	size_t packetCount = 0;
+	for ( long s = 0; s < snipCount; ++s ) {
+		if ( snips[s].fState == XMPScanner::eValidPacketSnip ) ++packetCount;
+	}
+	return packetCount;
+
+}	// ScanAll
+
+// =================================================================================================
+
+static void
+TimeScan ( const char * name, FindHeadCandidateProc proc, const vector<XMP_Uns8> & data, int rounds )
+{
+	sFindHeadCandidate = proc;
+
+	size_t packetCount = 0;
+	clock_t start = clock();
+	for ( int r = 0; r < rounds; ++r ) packetCount = ScanAll ( data );
+	double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	double megabytes = ((double)data.size() * rounds) / (1024.0 * 1024.0);
+	printf ( "%-10s %8.1f MB/s, %zu packets\n", name, (megabytes / seconds), packetCount );
+
+}	// TimeScan
+
+// =================================================================================================
+
+extern "C" int
+main ( int argc, const char * argv [] )
+{
+	size_t megabytes = 64;
+	if ( argc > 1 ) megabytes = (size_t) atoi ( argv[1] );
+	if ( megabytes == 0 ) {
+		printf ( "usage: ScannerBenchmark [megabytes]\n" );
+		return 0;
+	}
+
+	// Scatter the 5 packet forms through the input, the packets must be found by all searches.
+
+	vector<XMP_Uns8> data;
+	data.reserve ( megabytes*1024*1024 + 4096 );
+	XMP_Uns32 seed = 1;
+	size_t chunk = (megabytes*1024*1024) / 6;
+
+	AppendNoise ( &data, chunk, &seed );
+	AppendPacket ( &data, 1, false );
+	AppendNoise ( &data, chunk, &seed );
+	AppendPacket ( &data, 2, true );
+	AppendNoise ( &data, chunk, &seed );
+	AppendPacket ( &data, 2, false );
+	AppendNoise ( &data, chunk, &seed );
+	AppendPacket ( &data, 4, true );
+	AppendNoise ( &data, chunk, &seed );
+	AppendPacket ( &data, 4, false );
+	AppendNoise ( &data, chunk, &seed );
+
+	const int rounds = 4;
+	printf ( "Scanning %zu MB, %d rounds\n", (data.size() / (1024*1024)), rounds );
+
+	TimeScan ( "bytewise", FindHeadCandidate_Bytewise, data, rounds );
+	TimeScan ( "scalar", FindHeadCandidate_Scalar, data, rounds );
+	#if ScannerHasSSE2
+		TimeScan ( "SSE2", FindHeadCandidate_SSE2, data, rounds );
+	#endif
+	#if ScannerHasAVX2
+		if ( __builtin_cpu_supports ( "avx2" ) ) TimeScan ( "AVX2", FindHeadCandidate_AVX2, data, rounds );
+	#endif
+
+	return 0;
+
+}
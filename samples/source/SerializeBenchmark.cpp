@@ -0,0 +1,143 @@
+/*
+ * exempi - SerializeBenchmark.cpp
+ *
+ * Copyright (C) 2026 The exempi contributors
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1 Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2 Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the
+ * distribution.
+ *
+ * 3 Neither the name of the Authors, nor the names of its
+ * contributors may be used to endorse or promote products derived
+ * from this software wit hout specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+* Measures serialization of a large packet. The packet has a few thousand properties, values with
+* characters to escape, and a base 64 thumbnail with a newline every 76 characters. It is
+* serialized repeatedly with the default, compact and canonical formats.
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+
+// Must be defined to instantiate template classes
+#define TXMP_STRING_TYPE std::string
+
+// Ensure XMP templates are instantiated
+#include "public/include/XMP.incl_cpp"
+
+// Provide access to the API
+#include "public/include/XMP.hpp"
+
+using namespace std;
+
+// =================================================================================================
+
+static void
+BuildPacket ( SXMPMeta * meta, int thumbnailSize )
+{
+	char name [64];
+	char value [128];
+
+	for ( int i = 0; i < 2000; ++i ) {
+		snprintf ( name, sizeof ( name ), "Prop%d", i );
+		snprintf ( value, sizeof ( value ), "Value %d with \"quotes\" & <brackets> and a longer tail of text", i );
+		meta->SetProperty ( kXMP_NS_XMP, name, value );
+	}
+
+	for ( int i = 0; i < 500; ++i ) {
+		snprintf ( value, sizeof ( value ), "keyword %d", i );
+		meta->AppendArrayItem ( kXMP_NS_DC, "subject", kXMP_PropArrayIsUnordered, value );
+	}
+
+	static const char kBase64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	string thumbnail;
+	thumbnail.reserve ( thumbnailSize + (thumbnailSize / 76) );
+	for ( int i = 0; i < thumbnailSize; ++i ) {
+		thumbnail += kBase64[(i * 7) & 63];
+		if ( (i % 76) == 75 ) thumbnail += '\n';
+	}
+	meta->SetProperty ( kXMP_NS_XMP_Image, "image", thumbnail );
+
+}	// BuildPacket
+
+// =================================================================================================
+
+static void
+TimeSerialize ( const SXMPMeta & meta, XMP_OptionBits options, const char * label, int rounds )
+{
+	string packet;
+
+	clock_t start = clock();
+	for ( int r = 0; r < rounds; ++r ) {
+		packet.clear();
+		meta.SerializeToBuffer ( &packet, options );
+	}
+	double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	printf ( "  %-16s %8lu bytes %10.1f us/serialize %8.1f MB/s\n", label, (unsigned long)packet.size(),
+			 (seconds * 1e6 / rounds), ((double)packet.size() * rounds / seconds / 1e6) );
+
+}	// TimeSerialize
+
+// =================================================================================================
+
+extern "C" int
+main ( int argc, const char * argv [] )
+{
+	int rounds = 200;
+	if ( (argc > 2) && (string ( argv[1] ) == "-rounds") ) rounds = atoi ( argv[2] );
+	if ( rounds <= 0 ) rounds = 1;
+
+	if ( ! SXMPMeta::Initialize() ) {
+		printf ( "Could not initialize toolkit!\n" );
+		return -1;
+	}
+
+	int status = 0;
+
+	try {
+
+		SXMPMeta meta;
+		BuildPacket ( &meta, 256 * 1024 );
+
+		printf ( "SerializeToBuffer, %d rounds\n", rounds );
+		TimeSerialize ( meta, 0, "default", rounds );
+		TimeSerialize ( meta, kXMP_UseCompactFormat, "compact", rounds );
+		TimeSerialize ( meta, kXMP_UseCanonicalFormat, "canonical", rounds );
+		TimeSerialize ( meta, kXMP_IncludeRDFHash, "rdfhash", rounds );
+		TimeSerialize ( meta, kXMP_EncodeUTF16Big, "utf16", rounds );
+
+	} catch ( XMP_Error & e ) {
+		printf ( "XMP error %d: %s\n", e.GetID(), e.GetErrMsg() );
+		status = -1;
+	}
+
+	SXMPMeta::Terminate();
+	return status;
+
+}
@@ -0,0 +1,295 @@
+/*
+ * exempi - CRC32.cpp
+ *
+ * Copyright (C) 2026 The exempi contributors
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1 Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2 Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the
+ * distribution.
+ *
+ * 3 Neither the name of the Authors, nor the names of its
+ * contributors may be used to endorse or promote products derived
+ * from this software wit hout specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "source/CRC32.hpp"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+	#define CRC32HasCLMUL	1	// Compiled with a target attribute, used if the CPU has it.
+	#include <immintrin.h>
+#else
+	#define CRC32HasCLMUL	0
+#endif
+
+#if defined(__ARM_FEATURE_CRC32) && defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+	#define CRC32HasARMv8	1	// Only when the build targets a CPU that has it.
+	#include <arm_acle.h>
+#else
+	#define CRC32HasARMv8	0
+#endif
+
+namespace CRC32 {
+
+// =================================================================================================
+// Tables
+// ======
+//
+// Table 0 is the usual byte at a time table for the reflected polynomial 0xEDB88320. Table k gives
+// the CRC of a byte followed by k zero bytes, the slicing-by-8 loop looks up 8 bytes at once.
+
+struct Tables {
+	XMP_Uns32 slice [8] [256];
+	Tables();
+};
+
+Tables::Tables()
+{
+
+	for ( XMP_Uns32 n = 0; n < 256; ++n ) {
+		XMP_Uns32 c = n;
+		for ( int k = 0; k < 8; ++k ) c = (c & 1) ? (0xEDB88320UL ^ (c >> 1)) : (c >> 1);
+		this->slice[0][n] = c;
+	}
+
+	for ( XMP_Uns32 n = 0; n < 256; ++n ) {
+		XMP_Uns32 c = this->slice[0][n];
+		for ( int k = 1; k < 8; ++k ) {
+			c = this->slice[0][c & 0xFF] ^ (c >> 8);
+			this->slice[k][n] = c;
+		}
+	}
+
+}	// Tables::Tables
+
+static const Tables & GetTables()
+{
+	static const Tables sTables;	// ! Built once, on first use, even with several threads.
+	return sTables;
+}
+
+// =================================================================================================
+// Update_Bytewise
+// ===============
+
+XMP_Uns32 Update_Bytewise ( XMP_Uns32 crc, const XMP_Uns8 * data, size_t length )
+{
+	const XMP_Uns32 * table = GetTables().slice[0];
+
+	XMP_Uns32 c = ~crc;
+	for ( ; length > 0; --length, ++data ) c = table[(c ^ *data) & 0xFF] ^ (c >> 8);
+	return ~c;
+
+}	// Update_Bytewise
+
+// =================================================================================================
+// Update_Slice8
+// =============
+//
+// The bytes are put together explicitly so the loop does not depend on alignment or byte order,
+// compilers turn this into plain loads on little endian CPUs.
+
+XMP_Uns32 Update_Slice8 ( XMP_Uns32 crc, const XMP_Uns8 * data, size_t length )
+{
+	const Tables & tables = GetTables();
+	const XMP_Uns32 (* t) [256] = tables.slice;
+
+	XMP_Uns32 c = ~crc;
+
+	for ( ; length >= 8; length -= 8, data += 8 ) {
+		XMP_Uns32 lo = c ^ ((XMP_Uns32)data[0] | ((XMP_Uns32)data[1] << 8) |
+						   ((XMP_Uns32)data[2] << 16) | ((XMP_Uns32)data[3] << 24));
+		XMP_Uns32 hi = (XMP_Uns32)data[4] | ((XMP_Uns32)data[5] << 8) |
+					   ((XMP_Uns32)data[6] << 16) | ((XMP_Uns32)data[7] << 24);
+		c = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+			t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+	}
+
+	for ( ; length > 0; --length, ++data ) c = t[0][(c ^ *data) & 0xFF] ^ (c >> 8);
+	return ~c;
+
+}	// Update_Slice8
+
+// =================================================================================================
+// Update_CLMUL
+// ============
+//
+// Folding with carry-less multiplication, as in Intel's "Fast CRC Computation for Generic
+// Polynomials Using PCLMULQDQ Instruction". Four 128 bit lanes are folded 64 bytes at a time, then
+// into one lane, then reduced to 32 bits with a Barrett reduction. The constants are powers of x
+// modulo the bit reflected polynomial. Less than 64 bytes, and the last partial lane, go through
+// Update_Slice8.
+
+#if CRC32HasCLMUL
+
+__attribute__ (( target ( "pclmul,sse2" ) ))
+static XMP_Uns32 FoldCLMUL ( XMP_Uns32 c, const XMP_Uns8 * data, size_t length )
+{
+	// The length is at least 64 and a multiple of 16, c is the raw (inverted) CRC.
+
+	const __m128i k1k2 = _mm_set_epi64x ( 0x01C6E41596LL, 0x0154442BD4LL );
+	const __m128i k3k4 = _mm_set_epi64x ( 0x00CCAA009ELL, 0x01751997D0LL );
+	const __m128i k5k0 = _mm_set_epi64x ( 0, 0x0163CD6124LL );
+	const __m128i poly = _mm_set_epi64x ( 0x01F7011641LL, 0x01DB710641LL );
+	const __m128i mask32 = _mm_setr_epi32 ( ~0, 0, ~0, 0 );
+
+	__m128i x1 = _mm_loadu_si128 ( (const __m128i*)(data + 0x00) );
+	__m128i x2 = _mm_loadu_si128 ( (const __m128i*)(data + 0x10) );
+	__m128i x3 = _mm_loadu_si128 ( (const __m128i*)(data + 0x20) );
+	__m128i x4 = _mm_loadu_si128 ( (const __m128i*)(data + 0x30) );
+	x1 = _mm_xor_si128 ( x1, _mm_cvtsi32_si128 ( (int)c ) );
+	data += 64;
+	length -= 64;
+
+	for ( ; length >= 64; length -= 64, data += 64 ) {
+		__m128i x5 = _mm_clmulepi64_si128 ( x1, k1k2, 0x00 );
+		__m128i x6 = _mm_clmulepi64_si128 ( x2, k1k2, 0x00 );
+		__m128i x7 = _mm_clmulepi64_si128 ( x3, k1k2, 0x00 );
+		__m128i x8 = _mm_clmulepi64_si128 ( x4, k1k2, 0x00 );
+		x1 = _mm_clmulepi64_si128 ( x1, k1k2, 0x11 );
+		x2 = _mm_clmulepi64_si128 ( x2, k1k2, 0x11 );
+		x3 = _mm_clmulepi64_si128 ( x3, k1k2, 0x11 );
+		x4 = _mm_clmulepi64_si128 ( x4, k1k2, 0x11 );
+		x1 = _mm_xor_si128 ( _mm_xor_si128 ( x1, x5 ), _mm_loadu_si128 ( (const __m128i*)(data + 0x00) ) );
+		x2 = _mm_xor_si128 ( _mm_xor_si128 ( x2, x6 ), _mm_loadu_si128 ( (const __m128i*)(data + 0x10) ) );
+		x3 = _mm_xor_si128 ( _mm_xor_si128 ( x3, x7 ), _mm_loadu_si128 ( (const __m128i*)(data + 0x20) ) );
+		x4 = _mm_xor_si128 ( _mm_xor_si128 ( x4, x8 ), _mm_loadu_si128 ( (const __m128i*)(data + 0x30) ) );
+	}
+
+	// Fold the 4 lanes into one, then any remaining 16 byte blocks.
+
+	__m128i x5 = _mm_clmulepi64_si128 ( x1, k3k4, 0x00 );
+	x1 = _mm_clmulepi64_si128 ( x1, k3k4, 0x11 );
+	x1 = _mm_xor_si128 ( _mm_xor_si128 ( x1, x2 ), x5 );
+	x5 = _mm_clmulepi64_si128 ( x1, k3k4, 0x00 );
+	x1 = _mm_clmulepi64_si128 ( x1, k3k4, 0x11 );
+	x1 = _mm_xor_si128 ( _mm_xor_si128 ( x1, x3 ), x5 );
+	x5 = _mm_clmulepi64_si128 ( x1, k3k4, 0x00 );
+	x1 = _mm_clmulepi64_si128 ( x1, k3k4, 0x11 );
+	x1 = _mm_xor_si128 ( _mm_xor_si128 ( x1, x4 ), x5 );
+
+	for ( ; length >= 16; length -= 16, data += 16 ) {
+		x5 = _mm_clmulepi64_si128 ( x1, k3k4, 0x00 );
+		x1 = _mm_clmulepi64_si128 ( x1, k3k4, 0x11 );
+		x1 = _mm_xor_si128 ( _mm_xor_si128 ( x1, _mm_loadu_si128 ( (const __m128i*)data ) ), x5 );
+	}
+
+	// Fold 128 bits to 64, then the Barrett reduction to 32.
+
+	x2 = _mm_clmulepi64_si128 ( x1, k3k4, 0x10 );
+	x1 = _mm_xor_si128 ( _mm_srli_si128 ( x1, 8 ), x2 );
+
+	x2 = _mm_srli_si128 ( x1, 4 );
+	x1 = _mm_and_si128 ( x1, mask32 );
+	x1 = _mm_clmulepi64_si128 ( x1, k5k0, 0x00 );
+	x1 = _mm_xor_si128 ( x1, x2 );
+
+	x2 = _mm_and_si128 ( x1, mask32 );
+	x2 = _mm_clmulepi64_si128 ( x2, poly, 0x10 );
+	x2 = _mm_and_si128 ( x2, mask32 );
+	x2 = _mm_clmulepi64_si128 ( x2, poly, 0x00 );
+	x1 = _mm_xor_si128 ( x1, x2 );
+
+	return (XMP_Uns32) _mm_cvtsi128_si32 ( _mm_srli_si128 ( x1, 4 ) );
+
+}	// FoldCLMUL
+
+bool HasCLMUL()
+{
+	__builtin_cpu_init();	// ! Needed when called from a static initializer.
+	return __builtin_cpu_supports ( "pclmul" ) && __builtin_cpu_supports ( "sse2" );
+}
+
+XMP_Uns32 Update_CLMUL ( XMP_Uns32 crc, const XMP_Uns8 * data, size_t length )
+{
+	if ( length < 64 ) return Update_Slice8 ( crc, data, length );
+
+	size_t folded = length & ~(size_t)15;
+	crc = ~FoldCLMUL ( ~crc, data, folded );
+	return Update_Slice8 ( crc, data + folded, length - folded );
+
+}	// Update_CLMUL
+
+#else
+
+bool HasCLMUL() { return false; }
+
+XMP_Uns32 Update_CLMUL ( XMP_Uns32 crc, const XMP_Uns8 * data, size_t length )
+{
+	return Update_Slice8 ( crc, data, length );
+}
+
+#endif
+
+// =================================================================================================
+// Update_ARMv8
+// ============
+
+#if CRC32HasARMv8
+
+bool HasARMv8() { return true; }
+
+XMP_Uns32 Update_ARMv8 ( XMP_Uns32 crc, const XMP_Uns8 * data, size_t length )
+{
+	XMP_Uns32 c = ~crc;
+
+	for ( ; (length > 0) && ((((size_t)data) & 7) != 0); --length, ++data ) c = __crc32b ( c, *data );
+
+	for ( ; length >= 8; length -= 8, data += 8 ) c = __crc32d ( c, *((const XMP_Uns64*)data) );
+
+	for ( ; length > 0; --length, ++data ) c = __crc32b ( c, *data );
+	return ~c;
+
+}	// Update_ARMv8
+
+#else
+
+bool HasARMv8() { return false; }
+
+XMP_Uns32 Update_ARMv8 ( XMP_Uns32 crc, const XMP_Uns8 * data, size_t length )
+{
+	return Update_Slice8 ( crc, data, length );
+}
+
+#endif
+
+// =================================================================================================
+// Update
+// ======
+
+static UpdateProc SelectUpdate()
+{
+	if ( HasARMv8() ) return Update_ARMv8;
+	if ( HasCLMUL() ) return Update_CLMUL;
+	return Update_Slice8;
+
+}	// SelectUpdate
+
+XMP_Uns32 Update ( XMP_Uns32 crc, const void * data, size_t length )
+{
+	static const UpdateProc sUpdate = SelectUpdate();
+	return sUpdate ( crc, (const XMP_Uns8*)data, length );
+
+}	// Update
+
+}	// namespace CRC32
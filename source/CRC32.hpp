@@ -0,0 +1,80 @@
+#ifndef __CRC32_hpp__
+#define __CRC32_hpp__	1
+
+/*
+ * exempi - CRC32.hpp
+ *
+ * Copyright (C) 2026 The exempi contributors
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1 Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2 Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the
+ * distribution.
+ *
+ * 3 Neither the name of the Authors, nor the names of its
+ * contributors may be used to endorse or promote products derived
+ * from this software wit hout specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "public/include/XMP_Environment.h"
+#include "public/include/XMP_Const.h"
+
+#include <stddef.h>
+
+// =================================================================================================
+// CRC32 - The CRC-32 of ISO 3309, ITU-T V.42, Ethernet, ZIP, and PNG.
+// ====================================================================
+//
+// The values are the ones zlib's crc32 gives, a running CRC starts at 0 and the result of one
+// Update is passed as the crc of the next:
+//
+//	XMP_Uns32 crc = CRC32::Update ( 0, type, 4 );
+//	crc = CRC32::Update ( crc, data, length );
+//
+// The implementation is picked once, by what the CPU can do. Carry-less multiplication on x86 with
+// PCLMULQDQ, the CRC32 instructions on ARMv8 builds that have them, and slicing-by-8 otherwise. The
+// tables are built on first use, Update is safe to call from any thread.
+
+namespace CRC32 {
+
+	XMP_Uns32 Update ( XMP_Uns32 crc, const void * data, size_t length );
+
+	inline XMP_Uns32 Compute ( const void * data, size_t length ) { return Update ( 0, data, length ); }
+
+	// The forms that Update chooses from, for tests and benchmarks. The crc is the pre and post
+	// conditioned value, as for Update. The CLMUL and ARMv8 forms must only be called if available.
+
+	typedef XMP_Uns32 (*UpdateProc) ( XMP_Uns32 crc, const XMP_Uns8 * data, size_t length );
+
+	XMP_Uns32 Update_Bytewise ( XMP_Uns32 crc, const XMP_Uns8 * data, size_t length );
+	XMP_Uns32 Update_Slice8 ( XMP_Uns32 crc, const XMP_Uns8 * data, size_t length );
+
+	bool HasCLMUL();
+	XMP_Uns32 Update_CLMUL ( XMP_Uns32 crc, const XMP_Uns8 * data, size_t length );
+
+	bool HasARMv8();
+	XMP_Uns32 Update_ARMv8 ( XMP_Uns32 crc, const XMP_Uns8 * data, size_t length );
+
+}	// namespace CRC32
+
+#endif	// __CRC32_hpp__
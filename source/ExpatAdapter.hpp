@@ -28,6 +28,7 @@ public:
 
 	XML_Parser parser;
 	XMP_NamespaceTable * registeredNamespaces;
+	XML_NodeVector freeNodes;	// Recycled element and attribute nodes, used with an event sink.
 	
 	#if BanAllEntityUsage
 		bool isAborted;
@@ -19,6 +19,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 
@@ -161,6 +162,28 @@ bool Host_IO::GetModifyDate ( const char* filePath, XMP_DateTime* modifyDate )
 
 }	// Host_IO::GetModifyDate
 
+// =================================================================================================
+// Host_IO::GetStamp
+// =================
+
+bool Host_IO::GetStamp ( const char* path, XMP_Int64* modifyTime, XMP_Int64* length )
+{
+	struct stat info;
+	int err = stat ( path, &info );
+	if ( err != 0 ) return false;
+
+	#if XMP_MacBuild | XMP_iOSBuild
+		XMP_Int64 nanoSeconds = info.st_mtimespec.tv_nsec;
+	#else
+		XMP_Int64 nanoSeconds = info.st_mtim.tv_nsec;
+	#endif
+
+	*modifyTime = ((XMP_Int64)info.st_mtime * 1000*1000*1000) + nanoSeconds;
+	*length = info.st_size;
+	return true;
+
+}	// Host_IO::GetStamp
+
 // =================================================================================================
 // ConjureDerivedPath
 // ==================
@@ -409,6 +432,32 @@ void Host_IO::SetEOF ( Host_IO::FileRef refNum, XMP_Int64 length )
 
 }	// Host_IO::SetEOF
 
+// =================================================================================================
+// Host_IO::MapReadOnly
+// ====================
+
+const XMP_Uns8 * Host_IO::MapReadOnly ( Host_IO::FileRef refNum, XMP_Int64 length )
+{
+	if ( (length <= 0) || ((XMP_Uns64)length > (XMP_Uns64)((size_t)(-1))) ) return 0;
+
+	void * data = mmap ( 0, (size_t)length, PROT_READ, MAP_PRIVATE, refNum, 0 );
+	if ( data == MAP_FAILED ) return 0;
+
+	return (const XMP_Uns8 *) data;
+
+}	// Host_IO::MapReadOnly
+
+// =================================================================================================
+// Host_IO::Unmap
+// ==============
+
+void Host_IO::Unmap ( const XMP_Uns8 * data, XMP_Int64 length )
+{
+	if ( data == 0 ) return;
+	(void) munmap ( (void*)data, (size_t)length );
+
+}	// Host_IO::Unmap
+
 // =================================================================================================
 // =====================================   Folder operations   =====================================
 // =================================================================================================
@@ -449,6 +498,26 @@ Host_IO::FileMode Host_IO::GetChildMode ( const char * parentPath, const char *
 
 }	// Host_IO::GetChildMode
 
+// =================================================================================================
+// Host_IO::CreateFolder
+// =====================
+
+bool Host_IO::CreateFolder ( const char * folderPath )
+{
+	Host_IO::FileMode mode = Host_IO::GetFileMode ( folderPath );
+	if ( mode == kFMode_IsFolder ) return false;
+	if ( mode != kFMode_DoesNotExist ) XMP_Throw ( "Host_IO::CreateFolder, path exists but is not a folder", kXMPErr_InternalFailure );
+
+	int err = mkdir ( folderPath, (S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH) );
+	if ( err != 0 ) {
+		int osCode = errno;	// Capture ASAP and once, might not be thread safe.
+		if ( (osCode == EEXIST) && (Host_IO::GetFileMode ( folderPath ) == kFMode_IsFolder) ) return false;	// Created meanwhile.
+		XMP_Throw ( "Host_IO::CreateFolder, cannot create folder", kXMPErr_ExternalFailure );
+	}
+	return true;
+
+}	// Host_IO::CreateFolder
+
 // =================================================================================================
 // Host_IO::OpenFolder
 // ===================
@@ -203,6 +203,25 @@ bool Host_IO::GetModifyDate ( const char* filePath, XMP_DateTime * modifyDate )
 
 }	// Host_IO::GetModifyDate
 
+// =================================================================================================
+// Host_IO::GetStamp
+// =================
+
+bool Host_IO::GetStamp ( const char* path, XMP_Int64* modifyTime, XMP_Int64* length )
+{
+	std::string widePath;
+	if ( ! GetWidePath ( path, widePath ) || widePath.length() == 0 ) return false;
+
+	WIN32_FILE_ATTRIBUTE_DATA info;
+	BOOL ok = GetFileAttributesExW ( (LPCWSTR)widePath.data(), GetFileExInfoStandard, &info );
+	if ( ! ok ) return false;
+
+	*modifyTime = ((XMP_Int64)info.ftLastWriteTime.dwHighDateTime << 32) | info.ftLastWriteTime.dwLowDateTime;
+	*length = ((XMP_Int64)info.nFileSizeHigh << 32) | info.nFileSizeLow;
+	return true;
+
+}	// Host_IO::GetStamp
+
 // =================================================================================================
 // ConjureDerivedPath
 // ==================
@@ -450,6 +469,35 @@ void Host_IO::SetEOF ( Host_IO::FileRef fileHandle, XMP_Int64 length )
 
 }	// Host_IO::SetEOF
 
+// =================================================================================================
+// Host_IO::MapReadOnly
+// ====================
+
+const XMP_Uns8 * Host_IO::MapReadOnly ( Host_IO::FileRef fileHandle, XMP_Int64 length )
+{
+	if ( (length <= 0) || ((XMP_Uns64)length > (XMP_Uns64)((SIZE_T)(-1))) ) return 0;
+
+	HANDLE mapHandle = CreateFileMappingW ( fileHandle, 0, PAGE_READONLY, 0, 0, 0 );
+	if ( mapHandle == 0 ) return 0;
+
+	void * data = MapViewOfFile ( mapHandle, FILE_MAP_READ, 0, 0, (SIZE_T)length );
+	CloseHandle ( mapHandle );	// ! The view keeps the mapping alive.
+
+	return (const XMP_Uns8 *) data;
+
+}	// Host_IO::MapReadOnly
+
+// =================================================================================================
+// Host_IO::Unmap
+// ==============
+
+void Host_IO::Unmap ( const XMP_Uns8 * data, XMP_Int64 /* length */ )
+{
+	if ( data == 0 ) return;
+	(void) UnmapViewOfFile ( data );
+
+}	// Host_IO::Unmap
+
 // =================================================================================================
 // Folder operations
 // =================================================================================================
@@ -485,6 +533,29 @@ Host_IO::FileMode Host_IO::GetChildMode ( const char * parentPath, const char *
 
 }	// Host_IO::GetChildMode
 
+// =================================================================================================
+// Host_IO::CreateFolder
+// =====================
+
+bool Host_IO::CreateFolder ( const char * folderPath )
+{
+	std::string wideName;
+	if ( !GetWidePath ( folderPath, wideName ) || wideName.length() == 0 )
+		XMP_Throw ( "Host_IO::CreateFolder, cannot convert path", kXMPErr_ExternalFailure );
+
+	Host_IO::FileMode mode = ::GetFileMode ( wideName );
+	if ( mode == kFMode_IsFolder ) return false;
+	if ( mode != kFMode_DoesNotExist ) XMP_Throw ( "Host_IO::CreateFolder, path exists but is not a folder", kXMPErr_InternalFailure );
+
+	if ( ! CreateDirectoryW ( (LPCWSTR)wideName.data(), 0 ) ) {
+		DWORD osCode = GetLastError();
+		if ( (osCode == ERROR_ALREADY_EXISTS) && (::GetFileMode ( wideName ) == kFMode_IsFolder) ) return false;	// Created meanwhile.
+		XMP_Throw ( "Host_IO::CreateFolder, cannot create folder", kXMPErr_ExternalFailure );
+	}
+	return true;
+
+}	// Host_IO::CreateFolder
+
 // =================================================================================================
 // Host_IO::OpenFolder
 // ===================
@@ -95,6 +95,13 @@ namespace Host_IO {
 	//
 	// SetEOF - Sets a new EOF offset. The I/O position may be changed. Throws an XMP_Error
 	// exception for any errors.
+	//
+	// MapReadOnly - Map the first length bytes of a file opened for read-only access into memory.
+	// Returns 0 if the file cannot be mapped, e.g. it is empty or does not fit in the address
+	// space, the caller then uses Read. The I/O position is not changed. Never throws. Reading the
+	// mapping past the end of a file that was truncated since raises SIGBUS on POSIX systems.
+	//
+	// Unmap - Release a mapping made by MapReadOnly. Does nothing for a null pointer. Never throws.
 
 	#if XMP_WinBuild
 		typedef HANDLE FileRef;
@@ -117,6 +124,10 @@ namespace Host_IO {
 	
 	bool GetModifyDate ( const char* filePath, XMP_DateTime* modifyDate );
 
+	// Returns an opaque modification time and the length of a file or folder, for cache checks.
+	// The time is only meant to be compared with an earlier one for the same path.
+	bool GetStamp ( const char* path, XMP_Int64* modifyTime, XMP_Int64* length );
+
 	std::string CreateTemp ( const char* sourcePath );
 
 	enum { openReadOnly = true, openReadWrite = false };
@@ -134,6 +145,9 @@ namespace Host_IO {
 	XMP_Int64	Length   ( FileRef file );
 	void		SetEOF   ( FileRef file, XMP_Int64 length );
 
+	const XMP_Uns8 * MapReadOnly ( FileRef file, XMP_Int64 length );
+	void             Unmap       ( const XMP_Uns8 * data, XMP_Int64 length );
+
 	inline XMP_Int64 Offset ( FileRef file ) { return Host_IO::Seek ( file, 0, kXMP_SeekFromCurrent ); };
 	inline XMP_Int64 Rewind ( FileRef file ) { return Host_IO::Seek ( file, 0, kXMP_SeekFromStart ); };	// Always returns 0.
 	inline XMP_Int64 ToEOF  ( FileRef file ) { return Host_IO::Seek ( file, 0, kXMP_SeekFromEnd ); };
@@ -149,6 +163,10 @@ namespace Host_IO {
 	//
 	// GetChildMode - Same as GetFileMode, but has separate parent path and child name parameters.
 	//
+	// CreateFolder - Create a folder, the parent folder must exist. Returns true if it was created,
+	// false if the folder already exists. Throws an XMP_Error exception if the folder cannot be
+	// created or if the path already exists but is not a folder.
+	//
 	// OpenFolder - Initializes the iteration of a folder.
 	//
 	// CloseFolder - Terminates the iteration of a folder.
@@ -164,6 +182,8 @@ namespace Host_IO {
 	FileMode GetFileMode  ( const char * path );
 	FileMode GetChildMode ( const char * parentPath, const char * childName );
 
+	bool CreateFolder ( const char * folderPath );
+
 	#if XMP_WinBuild
 		typedef HANDLE FolderRef;
 		static const FolderRef noFolderRef = INVALID_HANDLE_VALUE;
@@ -0,0 +1,72 @@
+#ifndef __SIMDUtils_hpp__
+#define __SIMDUtils_hpp__	1
+
+/*
+ * exempi - SIMDUtils.hpp
+ *
+ * Copyright (C) 2026 The exempi contributors
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1 Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2 Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the
+ * distribution.
+ *
+ * 3 Neither the name of the Authors, nor the names of its
+ * contributors may be used to endorse or promote products derived
+ * from this software wit hout specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "public/include/XMP_Environment.h"
+#include "public/include/XMP_Const.h"
+
+// =================================================================================================
+// Helpers for the byte scanning loops that use SSE2. XMP_HasSSE2 is 1 when the build targets a CPU
+// that always has SSE2, e.g. any x86-64, the loops are then compiled in without a runtime check.
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+	#define XMP_HasSSE2	1
+	#include <emmintrin.h>
+#else
+	#define XMP_HasSSE2	0
+#endif
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+// -------------------------------------------------------------------------------------------------
+// FirstSetBit returns the position of the lowest set bit, e.g. the first match in a byte mask from
+// _mm_movemask_epi8. The mask must not be 0.
+
+static inline int FirstSetBit ( XMP_Uns32 mask )
+{
+	#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_ctz ( mask );
+	#else
+		unsigned long index;
+		_BitScanForward ( &index, mask );
+		return (int)index;
+	#endif
+}
+
+#endif	// __SIMDUtils_hpp__
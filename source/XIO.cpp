@@ -14,6 +14,7 @@
 
 #include "source/XIO.hpp"
 #include "source/XMP_LibUtils.hpp"
+#include "source/XMPFiles_IO.hpp"
 #include "source/UnicodeConversions.hpp"
 
 #if XMP_WinBuild
@@ -146,6 +147,23 @@ void XIO::ReplaceTextFile ( XMP_IO* textFile, const std::string & newContent, bo
 
 }	// XIO::ReplaceTextFile
 
+// =================================================================================================
+// XIO::ReadSpan
+// =============
+
+const XMP_Uns8 * XIO::ReadSpan ( XMP_IO* file, XMP_Uns32 count, void* buffer )
+{
+	XMPFiles_IO * hostFile = dynamic_cast<XMPFiles_IO*> ( file );	// ! Clients can pass their own XMP_IO.
+	if ( (hostFile != 0) && hostFile->IsMapped() ) {
+		const XMP_Uns8 * span = hostFile->ReadSpan ( count );
+		if ( span != 0 ) return span;	// ! Can be 0 if an error callback absorbed a failure.
+	}
+
+	file->ReadAll ( buffer, count );
+	return (const XMP_Uns8 *) buffer;
+
+}	// XIO::ReadSpan
+
 // =================================================================================================
 // XIO::Copy
 // =========
@@ -165,8 +183,8 @@ void XIO::Copy ( XMP_IO* sourceFile, XMP_IO* destFile, XMP_Int64 length,
 		XMP_Int32 ioCount = sizeof(buffer);
 		if ( length < ioCount ) ioCount = (XMP_Int32)length;
 
-		sourceFile->Read ( buffer, ioCount, XMP_IO::kReadAll );
-		destFile->Write ( buffer, ioCount );
+		const XMP_Uns8 * ioData = XIO::ReadSpan ( sourceFile, ioCount, buffer );
+		destFile->Write ( ioData, ioCount );
 		length -= ioCount;
 
 	}
@@ -47,6 +47,11 @@ namespace XIO {
 		XMP_Int64 remaining = file->Length() - file->Offset();
 		return (length <= remaining);
 	}
+
+	// ReadSpan reads count bytes and returns a pointer to them. The pointer is into the mapping of
+	// a mapped XMPFiles_IO, nothing is copied then. Otherwise the bytes are read into the buffer,
+	// which must have room for count bytes. Throws if fewer than count bytes are left.
+	extern const XMP_Uns8 * ReadSpan ( XMP_IO* file, XMP_Uns32 count, void* buffer );
 	
 	// *** Need to absorb more of the utilities like FolderInfo, GetFileMode.
 
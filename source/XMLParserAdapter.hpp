@@ -103,6 +103,31 @@ private:
 
 };
 
+// =================================================================================================
+// Receiver of XML parsing events, for clients that recognize the XML on the fly instead of walking
+// the finished XML tree. When an adapter has an event sink it does not build the XML tree. The
+// element nodes passed to StartElement hold the element's name and attributes, but no content. They
+// stay valid until the matching EndElement call returns. Character data and processing instructions
+// are passed as they arrive.
+//
+// A sink sets the aborted flag when it can't handle the input. The adapter then stops parsing and
+// does not report XML errors, the client is expected to start over without the sink.
+
+class XMLEventSink {
+public:
+
+	bool aborted;
+
+	virtual void StartElement ( const XML_Node & elemNode ) = 0;
+	virtual void EndElement ( const XML_Node & elemNode ) = 0;
+	virtual void CharacterData ( XMP_StringPtr cData, size_t len ) = 0;
+	virtual void ProcessingInstruction ( XMP_StringPtr target, XMP_StringPtr data ) = 0;
+
+	XMLEventSink() : aborted(false) {};
+	virtual ~XMLEventSink() {};
+
+};
+
 // =================================================================================================
 // Abstract base class for XML parser adapters used by the XMP toolkit.
 
@@ -113,7 +138,7 @@ public:
 
 	XMLParserAdapter() : tree(0,"",kRootNode), rootNode(0), rootCount(0),
 	                     charEncoding(XMP_OptionBits(-1)), pendingCount(0),
-	                     errorCallback(0)
+	                     errorCallback(0), eventSink(0)
 	{
 		#if XMP_DebugBuild
 			parseLog = 0;
@@ -143,6 +168,7 @@ public:
 	unsigned char	pendingInput[kXMLPendingInputMax];	// Buffered input for character encoding checks.
 
 	GenericErrorCallback * errorCallback;	// Set if the relevant XMPCore or XMPFiles object has one.
+	XMLEventSink * eventSink;	// Set for single pass parsing, the XML tree is not built.
 
 	#if XMP_DebugBuild
 		FILE * parseLog;
@@ -16,6 +16,8 @@
 #include "source/XMPFiles_IO.hpp"
 #include "source/XIO.hpp"
 
+#include <cstring>
+
 
 #define EMPTY_FILE_PATH ""
 #define XMP_FILESIO_STATIC_START try { /* int a;*/
@@ -96,6 +98,12 @@ XMPFiles_IO::XMPFiles_IO (
 	, filePath(_filePath)
 	, fileRef(hostFile)
 	, currOffset(0)
+	, mappedData(0)
+	, readBuffer(0)
+	, readBufferSize(0)
+	, bufferLength(0)
+	, bufferStart(0)
+	, hostOffset(0)
 	, isTemp(false)
 	, derivedTemp(0)
 	, progressTracker(_progressTracker)
@@ -117,6 +125,8 @@ XMPFiles_IO::~XMPFiles_IO()
 	try {
 		XMP_FILESIO_START
 		if ( this->derivedTemp != 0 ) this->DeleteTemp();
+		Host_IO::Unmap ( this->mappedData, this->currLength );
+		delete [] this->readBuffer;
 		if ( this->fileRef != Host_IO::noFileRef ) Host_IO::Close ( this->fileRef );
 		if ( this->isTemp && (! this->filePath.empty()) ) Host_IO::Delete ( this->filePath.c_str() );
 		XMP_FILESIO_END1 ( kXMPErrSev_Recoverable )
@@ -145,7 +155,7 @@ XMP_Uns32 XMPFiles_IO::Read ( void * buffer, XMP_Uns32 count, bool readAll /* =
 {
 	XMP_FILESIO_START
 	XMP_Assert ( this->fileRef != Host_IO::noFileRef );
-	XMP_Assert ( this->currOffset == Host_IO::Offset ( this->fileRef ) );
+	XMP_Assert ( this->HostOffsetIsValid() );
 	XMP_Assert ( this->currLength == Host_IO::Length ( this->fileRef ) );
 	XMP_Assert ( this->currOffset <= this->currLength );
 
@@ -154,16 +164,153 @@ XMP_Uns32 XMPFiles_IO::Read ( void * buffer, XMP_Uns32 count, bool readAll /* =
 		count = (XMP_Uns32) (this->currLength - this->currOffset);
 	}
 
-	XMP_Uns32 amountRead = Host_IO::Read ( this->fileRef, buffer, count );
-	XMP_Enforce ( amountRead == count );
+	XMP_Uns32 amountRead = count;
+	if ( this->mappedData != 0 ) {
+		memcpy ( buffer, (this->mappedData + this->currOffset), count );
+		this->currOffset += count;
+	} else if ( this->readBuffer == 0 ) {
+		amountRead = Host_IO::Read ( this->fileRef, buffer, count );
+		XMP_Enforce ( amountRead == count );
+		this->currOffset += amountRead;
+	} else {
+		XMP_Uns8 * destPtr = (XMP_Uns8*)buffer;
+		while ( count > 0 ) {
+			XMP_Int64 bufferEnd = this->bufferStart + this->bufferLength;
+			if ( (this->bufferStart <= this->currOffset) && (this->currOffset < bufferEnd) ) {
+				// Copy what the buffer has, the rest comes from the next pass.
+				XMP_Uns32 bufferPos = (XMP_Uns32) (this->currOffset - this->bufferStart);
+				XMP_Uns32 ioCount = this->bufferLength - bufferPos;
+				if ( ioCount > count ) ioCount = count;
+				memcpy ( destPtr, (this->readBuffer + bufferPos), ioCount );
+				destPtr += ioCount;
+				count -= ioCount;
+				this->currOffset += ioCount;
+			} else if ( count >= this->readBufferSize ) {
+				// Large reads bypass the buffer, copying them twice would not save any calls.
+				this->SyncHostOffset();
+				XMP_Uns32 ioCount = Host_IO::Read ( this->fileRef, destPtr, count );
+				XMP_Enforce ( ioCount == count );
+				this->hostOffset += ioCount;
+				this->currOffset += ioCount;
+				count = 0;
+			} else {
+				XMP_Int64 fileLeft = this->currLength - this->currOffset;
+				XMP_Uns32 fillCount = this->readBufferSize;
+				if ( (XMP_Int64)fillCount > fileLeft ) fillCount = (XMP_Uns32)fileLeft;
+				this->SyncHostOffset();
+				this->bufferLength = 0;	// ! Keep the buffer invalid if the read throws.
+				XMP_Uns32 ioCount = Host_IO::Read ( this->fileRef, this->readBuffer, fillCount );
+				XMP_Enforce ( ioCount == fillCount );
+				this->hostOffset += ioCount;
+				this->bufferStart = this->currOffset;
+				this->bufferLength = ioCount;
+			}
+		}
+	}
 
-	this->currOffset += amountRead;
 	return amountRead;
 	XMP_FILESIO_END1 ( kXMPErrSev_FileFatal )
 	return 0;
 
 }	// XMPFiles_IO::Read
 
+// =================================================================================================
+// XMPFiles_IO::MapFile
+// ====================
+
+void XMPFiles_IO::MapFile()
+{
+	if ( (! this->readOnly) || (this->mappedData != 0) ) return;
+
+	XMP_FILESIO_START
+	XMP_Assert ( this->fileRef != Host_IO::noFileRef );
+	XMP_Assert ( this->currLength == Host_IO::Length ( this->fileRef ) );
+
+	this->SetReadBuffer ( 0 );	// ! Leaves the host offset current.
+	this->mappedData = Host_IO::MapReadOnly ( this->fileRef, this->currLength );
+	XMP_FILESIO_END1 ( kXMPErrSev_FileFatal )
+
+}	// XMPFiles_IO::MapFile
+
+// =================================================================================================
+// XMPFiles_IO::ReadSpan
+// =====================
+
+const XMP_Uns8 * XMPFiles_IO::ReadSpan ( XMP_Uns32 count )
+{
+	if ( this->mappedData == 0 ) return 0;
+
+	XMP_FILESIO_START
+	XMP_Assert ( this->currOffset <= this->currLength );
+
+	if ( count > (this->currLength - this->currOffset) ) {
+		XMP_Throw ( "XMPFiles_IO::ReadSpan, not enough data", kXMPErr_EnforceFailure );
+	}
+
+	const XMP_Uns8 * span = this->mappedData + this->currOffset;
+	this->currOffset += count;
+	return span;
+	XMP_FILESIO_END1 ( kXMPErrSev_FileFatal )
+	return 0;
+
+}	// XMPFiles_IO::ReadSpan
+
+// =================================================================================================
+// XMPFiles_IO::SetReadBuffer
+// ==========================
+
+void XMPFiles_IO::SetReadBuffer ( XMP_Uns32 size )
+{
+	if ( this->mappedData != 0 ) return;	// A mapping is better than any buffer.
+
+	XMP_FILESIO_START
+	XMP_Assert ( this->fileRef != Host_IO::noFileRef );
+	XMP_Assert ( this->HostOffsetIsValid() );
+
+	this->SyncHostOffset();	// ! Unbuffered I/O expects the host offset to be current.
+
+	delete [] this->readBuffer;
+	this->readBuffer = 0;
+	this->readBufferSize = 0;
+	this->bufferLength = 0;
+
+	if ( size > 0 ) {
+		this->readBuffer = new XMP_Uns8 [size];
+		this->readBufferSize = size;
+	}
+	this->hostOffset = this->currOffset;
+	XMP_FILESIO_END1 ( kXMPErrSev_FileFatal )
+
+}	// XMPFiles_IO::SetReadBuffer
+
+// =================================================================================================
+// XMPFiles_IO::SyncHostOffset
+// ===========================
+//
+// Move the host file offset to currOffset before a host read or write of a buffered file.
+
+void XMPFiles_IO::SyncHostOffset()
+{
+	if ( this->readBuffer == 0 ) return;	// The host offset is always current when unbuffered.
+	if ( this->hostOffset == this->currOffset ) return;
+
+	Host_IO::Seek ( this->fileRef, this->currOffset, kXMP_SeekFromStart );
+	this->hostOffset = this->currOffset;
+
+}	// XMPFiles_IO::SyncHostOffset
+
+// =================================================================================================
+// XMPFiles_IO::HostOffsetIsValid
+// ==============================
+
+bool XMPFiles_IO::HostOffsetIsValid()
+{
+	if ( this->mappedData != 0 ) return true;	// The host offset is not used with a mapping.
+	XMP_Int64 expected = (this->readBuffer != 0) ? this->hostOffset : this->currOffset;
+	return (expected == Host_IO::Offset ( this->fileRef ));
+
+}	// XMPFiles_IO::HostOffsetIsValid
+
 // =================================================================================================
 // XMPFiles_IO::Write
 // ==================
@@ -172,13 +319,15 @@ void XMPFiles_IO::Write ( const void * buffer, XMP_Uns32 count )
 {
 	XMP_FILESIO_START
 	XMP_Assert ( this->fileRef != Host_IO::noFileRef );
-	XMP_Assert ( this->currOffset == Host_IO::Offset ( this->fileRef ) );
+	XMP_Assert ( this->HostOffsetIsValid() );
 	XMP_Assert ( this->currLength == Host_IO::Length ( this->fileRef ) );
 	XMP_Assert ( this->currOffset <= this->currLength );
 
 	try {
 		if ( this->readOnly )
 			XMP_Throw ( "New_XMPFiles_IO, write not permitted on read only file", kXMPErr_FilePermission );
+		this->SyncHostOffset();
+		this->bufferLength = 0;	// ! Simpler than patching the buffer, writes are rare.
 		Host_IO::Write ( this->fileRef, buffer, count );
 		if ( this->progressTracker != 0 ) this->progressTracker->AddWorkDone ( (float) count );
 	} catch ( ... ) {
@@ -188,6 +337,7 @@ void XMPFiles_IO::Write ( const void * buffer, XMP_Uns32 count )
 			// Make sure the internal state reflects partial writes.
 			this->currOffset = Host_IO::Offset ( this->fileRef );
 			this->currLength = Host_IO::Length ( this->fileRef );
+			this->hostOffset = this->currOffset;
 		} catch ( ... ) {
 			// don't do anything
 		}
@@ -195,6 +345,7 @@ void XMPFiles_IO::Write ( const void * buffer, XMP_Uns32 count )
 	}
 
 	this->currOffset += count;
+	this->hostOffset = this->currOffset;
 	if ( this->currOffset > this->currLength ) this->currLength = this->currOffset;
 	XMP_FILESIO_END1 ( kXMPErrSev_FileFatal )
 
@@ -208,7 +359,7 @@ XMP_Int64 XMPFiles_IO::Seek ( XMP_Int64 offset, SeekMode mode )
 {
 	XMP_FILESIO_START
 	XMP_Assert ( this->fileRef != Host_IO::noFileRef );
-	XMP_Assert ( this->currOffset == Host_IO::Offset ( this->fileRef ) );
+	XMP_Assert ( this->HostOffsetIsValid() );
 	XMP_Assert ( this->currLength == Host_IO::Length ( this->fileRef ) );
 
 	XMP_Int64 newOffset = offset;
@@ -219,7 +370,9 @@ XMP_Int64 XMPFiles_IO::Seek ( XMP_Int64 offset, SeekMode mode )
 	}
 	XMP_Enforce ( newOffset >= 0 );
 
-	if ( newOffset <= this->currLength ) {
+	if ( (newOffset <= this->currLength) && ((this->mappedData != 0) || (this->readBuffer != 0)) ) {
+		this->currOffset = newOffset;	// ! The host file offset is set lazily when buffered or mapped.
+	} else if ( newOffset <= this->currLength ) {
 		this->currOffset = Host_IO::Seek ( this->fileRef, offset, mode );
 	} else if ( this->readOnly ) {
 		XMP_Throw ( "XMPFiles_IO::Seek, read-only seek beyond EOF", kXMPErr_EnforceFailure );
@@ -227,6 +380,7 @@ XMP_Int64 XMPFiles_IO::Seek ( XMP_Int64 offset, SeekMode mode )
 		Host_IO::SetEOF ( this->fileRef, newOffset );	// Extend a file open for writing.
 		this->currLength = newOffset;
 		this->currOffset = Host_IO::Seek ( this->fileRef, 0, kXMP_SeekFromEnd );
+		this->hostOffset = this->currOffset;
 	}
 
 	XMP_Assert ( this->currOffset == newOffset );
@@ -244,7 +398,7 @@ XMP_Int64 XMPFiles_IO::Length()
 {
 	XMP_FILESIO_START
 	XMP_Assert ( this->fileRef != Host_IO::noFileRef );
-	XMP_Assert ( this->currOffset == Host_IO::Offset ( this->fileRef ) );
+	XMP_Assert ( this->HostOffsetIsValid() );
 	XMP_Assert ( this->currLength == Host_IO::Length ( this->fileRef ) );
 	XMP_FILESIO_END1 ( kXMPErrSev_FileFatal )
 	return this->currLength;
@@ -259,7 +413,7 @@ void XMPFiles_IO::Truncate ( XMP_Int64 length )
 {
 	XMP_FILESIO_START
 	XMP_Assert ( this->fileRef != Host_IO::noFileRef );
-	XMP_Assert ( this->currOffset == Host_IO::Offset ( this->fileRef ) );
+	XMP_Assert ( this->HostOffsetIsValid() );
 	XMP_Assert ( this->currLength == Host_IO::Length ( this->fileRef ) );
 
 	if ( this->readOnly )
@@ -273,7 +427,9 @@ void XMPFiles_IO::Truncate ( XMP_Int64 length )
 
 	// ! Seek to the expected offset, some versions of Host_IO::SetEOF implicitly seek to EOF.
 	Host_IO::Seek ( this->fileRef, this->currOffset, kXMP_SeekFromStart );
-	XMP_Assert ( this->currOffset == Host_IO::Offset ( this->fileRef ) );
+	this->hostOffset = this->currOffset;
+	this->bufferLength = 0;
+	XMP_Assert ( this->HostOffsetIsValid() );
 	XMP_FILESIO_END1 ( kXMPErrSev_FileFatal )
 
 }	// XMPFiles_IO::Truncate
@@ -337,6 +493,8 @@ void XMPFiles_IO::AbsorbTemp()
 	this->fileRef = Host_IO::Open ( this->filePath.c_str(), Host_IO::openReadWrite );
 	this->currLength = Host_IO::Length ( this->fileRef );
 	this->currOffset = 0;
+	this->hostOffset = 0;
+	this->bufferLength = 0;
 	XMP_FILESIO_END1 ( kXMPErrSev_FileFatal )
 
 }	// XMPFiles_IO::AbsorbTemp
@@ -377,6 +535,10 @@ void XMPFiles_IO::DeleteTemp()
 void XMPFiles_IO::Close()
 {
 	XMP_FILESIO_START
+	if ( this->mappedData != 0 ) {
+		Host_IO::Unmap ( this->mappedData, this->currLength );
+		this->mappedData = 0;
+	}
 	if ( this->fileRef != Host_IO::noFileRef ) {
 		Host_IO::Close ( this->fileRef );
 		this->fileRef = Host_IO::noFileRef;
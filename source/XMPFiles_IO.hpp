@@ -66,21 +66,55 @@ public:
 
 	void Close();	// Not part of XMP_IO, added here to let errors propagate.
 
+	// Not part of XMP_IO. MapFile maps a file opened read-only into memory, reads are then copies
+	// from the mapping without any system calls. Does nothing for a file open for update or one that
+	// cannot be mapped. Only map files that nothing else changes while they are open: if another
+	// process truncates the file, touching the lost pages raises SIGBUS on POSIX systems, or an
+	// in-page error on Windows, and that cannot be turned into an XMP_Error.
+	//
+	// ReadSpan returns a pointer into the mapping for count bytes at the current offset and moves
+	// past them, or 0 if the file is not mapped. Throws if there are fewer than count bytes left.
+	// The pointer is valid until Close. Use XIO::ReadSpan to also handle other XMP_IO implementations.
+	void MapFile();
+	const XMP_Uns8 * ReadSpan ( XMP_Uns32 count );
+	bool IsMapped() const { return (this->mappedData != 0); };
+
+	// Not part of XMP_IO. Reads of unmapped files go through a buffer of the given size, small
+	// reads and seeks within the buffered range then need no system calls. The host file offset is
+	// only moved when the buffer is refilled or on writes. A size of 0 removes the buffer. Ignored
+	// for mapped files.
+	void SetReadBuffer ( XMP_Uns32 size );
+
 private:
 	bool					readOnly;
 	std::string				filePath;
 	Host_IO::FileRef		fileRef;
 	XMP_Int64				currOffset;
 	XMP_Int64				currLength;
+	const XMP_Uns8 *		mappedData;	// The whole file, see MapFile.
+	XMP_Uns8 *				readBuffer;	// Optional read buffer, see SetReadBuffer.
+	XMP_Uns32				readBufferSize;
+	XMP_Uns32				bufferLength;	// The buffer holds bufferLength bytes from bufferStart.
+	XMP_Int64				bufferStart;
+	XMP_Int64				hostOffset;	// The host file offset, only tracked when buffered.
 	bool					isTemp;
 	XMPFiles_IO *			derivedTemp;
 	
 	XMP_ProgressTracker *	progressTracker;	// ! Owned by the XMPFiles object!
 	GenericErrorCallback *	errorCallback;		// ! Owned by the XMPFiles object!
 
+	void SyncHostOffset();
+	bool HostOffsetIsValid();	// For assertions.
+
 	// Hidden on purpose.
 	XMPFiles_IO()
 		: fileRef(Host_IO::noFileRef)
+		, mappedData(0)
+		, readBuffer(0)
+		, readBufferSize(0)
+		, bufferLength(0)
+		, bufferStart(0)
+		, hostOffset(0)
 		, isTemp(false)
 		, derivedTemp(0)
 		, progressTracker(0) {};
@@ -427,26 +427,274 @@ DumpStringMap ( const XMP_StringMap & map, XMP_StringPtr label, XMP_TextOutputPr
 
 }	// DumpStringMap
 
+// =================================================================================================
+// Intern Tables
+// =================================================================================================
+
+enum { kXMP_InternTableMinSlots = 64 };
+
+XMP_InternTable::XMP_InternTable()
+{
+	InitializeBasicMutex ( this->mutex );
+	this->slotTable.store ( NewSlotTable ( kXMP_InternTableMinSlots ), std::memory_order_relaxed );
+}	// XMP_InternTable::XMP_InternTable
+
+// =================================================================================================
+
+XMP_InternTable::~XMP_InternTable()
+{
+
+	this->oldSlotTables.push_back ( this->slotTable.load ( std::memory_order_relaxed ) );
+	for ( size_t i = 0, limit = this->oldSlotTables.size(); i < limit; ++i ) {
+		delete [] this->oldSlotTables[i]->slots;
+		delete this->oldSlotTables[i];
+	}
+
+	for ( size_t i = 0, limit = this->entries.size(); i < limit; ++i ) delete this->entries[i];
+
+	TerminateBasicMutex ( this->mutex );
+
+}	// XMP_InternTable::~XMP_InternTable
+
+// =================================================================================================
+
+size_t XMP_InternTable::Hash ( XMP_StringPtr key, size_t keyLen )
+{
+	XMP_Uns32 hash = 2166136261UL;	// The 32 bit FNV-1a hash.
+	for ( size_t i = 0; i < keyLen; ++i ) {
+		hash = (hash ^ (XMP_Uns8)key[i]) * 16777619UL;
+	}
+	return hash;
+}	// XMP_InternTable::Hash
+
+// =================================================================================================
+
+XMP_InternTable::SlotTable * XMP_InternTable::NewSlotTable ( size_t slotCount )
+{
+	XMP_Assert ( (slotCount & (slotCount - 1)) == 0 );	// Must be a power of 2.
+
+	SlotTable * table = new SlotTable;
+	table->mask = slotCount - 1;
+	try {
+		table->slots = new std::atomic < const Entry * > [slotCount];
+	} catch ( ... ) {
+		delete table;
+		throw;
+	}
+	for ( size_t i = 0; i < slotCount; ++i ) table->slots[i].store ( 0, std::memory_order_relaxed );
+
+	return table;
+
+}	// XMP_InternTable::NewSlotTable
+
+// =================================================================================================
+
+void XMP_InternTable::PutEntry ( SlotTable * table, const Entry * entry )
+{
+	size_t index = entry->hash & table->mask;
+	while ( table->slots[index].load ( std::memory_order_relaxed ) != 0 ) index = (index + 1) & table->mask;
+	table->slots[index].store ( entry, std::memory_order_release );	// ! Publish a complete entry.
+}	// XMP_InternTable::PutEntry
+
+// =================================================================================================
+
+const XMP_InternTable::Entry * XMP_InternTable::Find ( XMP_StringPtr key, size_t keyLen ) const
+{
+	return this->Find ( key, keyLen, Hash ( key, keyLen ) );
+}	// XMP_InternTable::Find
+
+// =================================================================================================
+
+const XMP_InternTable::Entry * XMP_InternTable::Find ( XMP_StringPtr key, size_t keyLen, size_t hash ) const
+{
+	XMP_Assert ( hash == Hash ( key, keyLen ) );
+	const SlotTable * table = this->slotTable.load ( std::memory_order_acquire );
+
+	for ( size_t index = hash & table->mask; ; index = (index + 1) & table->mask ) {
+		const Entry * entry = table->slots[index].load ( std::memory_order_acquire );
+		if ( entry == 0 ) return 0;
+		if ( (entry->hash == hash) && (entry->key.size() == keyLen) &&
+		     (memcmp ( entry->key.data(), key, keyLen ) == 0) ) return entry;
+	}
+
+}	// XMP_InternTable::Find
+
+// =================================================================================================
+
+const XMP_InternTable::Entry * XMP_InternTable::Add ( XMP_StringPtr key, size_t keyLen,
+													  XMP_StringPtr value, size_t valueLen )
+{
+	XMP_AutoMutex tableLock ( &this->mutex );
+
+	const Entry * oldEntry = this->Find ( key, keyLen );	// ! Under the lock, nothing can be missed.
+	if ( oldEntry != 0 ) return oldEntry;
+
+	SlotTable * table = this->slotTable.load ( std::memory_order_relaxed );
+	const size_t slotCount = table->mask + 1;
+
+	this->entries.reserve ( this->entries.size() + 1 );	// ! Don't leak the entry if this throws.
+	this->oldSlotTables.reserve ( this->oldSlotTables.size() + 1 );
+
+	Entry * newEntry = new Entry;
+	newEntry->key.assign ( key, keyLen );
+	newEntry->value.assign ( value, valueLen );
+	newEntry->hash = Hash ( key, keyLen );
+	this->entries.push_back ( newEntry );
+
+	if ( (this->entries.size() * 2) > slotCount ) {
+		SlotTable * newTable = NewSlotTable ( slotCount * 2 );
+		for ( size_t i = 0, limit = this->entries.size(); i < limit; ++i ) PutEntry ( newTable, this->entries[i] );
+		this->slotTable.store ( newTable, std::memory_order_release );
+		this->oldSlotTables.push_back ( table );
+	} else {
+		PutEntry ( table, newEntry );
+	}
+
+	return newEntry;
+
+}	// XMP_InternTable::Add
+
+// =================================================================================================
+
+void XMP_InternTable::GetEntries ( std::vector < const Entry * > * outEntries ) const
+{
+	XMP_AutoMutex tableLock ( &this->mutex );
+	outEntries->assign ( this->entries.begin(), this->entries.end() );
+}	// XMP_InternTable::GetEntries
+
 // =================================================================================================
 // Namespace Tables
 // =================================================================================================
 
-XMP_NamespaceTable::XMP_NamespaceTable ( const XMP_NamespaceTable & presets )
+XMP_StaticNamespaceIndex::XMP_StaticNamespaceIndex ( const XMP_StaticNamespace * _namespaces, size_t _count )
+	: namespaces(_namespaces), count(_count)
+{
+	XMP_Assert ( (count * 2) <= kSlotCount );
+
+	for ( size_t i = 0; i < kSlotCount; ++i ) {
+		this->uriSlots[i] = 0;
+		this->prefixSlots[i] = 0;
+	}
+
+	for ( size_t i = 0; i < count; ++i ) {
+
+		const XMP_StaticNamespace * ns = &namespaces[i];
+		XMP_Assert ( ns->uriHash == XMP_InternTable::Hash ( ns->uri, ns->uriLen ) );
+		XMP_Assert ( ns->prefixHash == XMP_InternTable::Hash ( ns->prefix, ns->prefixLen ) );
+		XMP_Assert ( (this->FindURI ( ns->uri, ns->uriLen, ns->uriHash ) == 0) &&
+					 (this->FindPrefix ( ns->prefix, ns->prefixLen, ns->prefixHash ) == 0) );	// ! No duplicates.
+
+		size_t index = ns->uriHash & (kSlotCount - 1);
+		while ( this->uriSlots[index] != 0 ) index = (index + 1) & (kSlotCount - 1);
+		this->uriSlots[index] = ns;
+
+		index = ns->prefixHash & (kSlotCount - 1);
+		while ( this->prefixSlots[index] != 0 ) index = (index + 1) & (kSlotCount - 1);
+		this->prefixSlots[index] = ns;
+
+	}
+
+}	// XMP_StaticNamespaceIndex::XMP_StaticNamespaceIndex
+
+// =================================================================================================
+
+const XMP_StaticNamespace * XMP_StaticNamespaceIndex::FindURI ( XMP_StringPtr uri, size_t uriLen, size_t hash ) const
+{
+	for ( size_t index = hash & (kSlotCount - 1); ; index = (index + 1) & (kSlotCount - 1) ) {
+		const XMP_StaticNamespace * ns = this->uriSlots[index];
+		if ( ns == 0 ) return 0;
+		if ( (ns->uriHash == hash) && (ns->uriLen == uriLen) && (memcmp ( ns->uri, uri, uriLen ) == 0) ) return ns;
+	}
+}	// XMP_StaticNamespaceIndex::FindURI
+
+// =================================================================================================
+
+const XMP_StaticNamespace * XMP_StaticNamespaceIndex::FindPrefix ( XMP_StringPtr prefix, size_t prefixLen, size_t hash ) const
+{
+	for ( size_t index = hash & (kSlotCount - 1); ; index = (index + 1) & (kSlotCount - 1) ) {
+		const XMP_StaticNamespace * ns = this->prefixSlots[index];
+		if ( ns == 0 ) return 0;
+		if ( (ns->prefixHash == hash) && (ns->prefixLen == prefixLen) && (memcmp ( ns->prefix, prefix, prefixLen ) == 0) ) return ns;
+	}
+}	// XMP_StaticNamespaceIndex::FindPrefix
+
+// =================================================================================================
+
+XMP_NamespaceTable::XMP_NamespaceTable ( const XMP_NamespaceTable & presets ) : staticIndex(presets.staticIndex)
 {
-	XMP_AutoLock presetLock ( &presets.lock, kXMP_ReadLock );
+	XMP_AutoLock presetLock ( &presets.lock, kXMP_WriteLock );	// ! Keep the two tables in step.
+	std::vector < const XMP_InternTable::Entry * > presetEntries;
+
+	presets.uriToPrefixTable.GetEntries ( &presetEntries );
+	for ( size_t i = 0, limit = presetEntries.size(); i < limit; ++i ) {
+		const XMP_InternTable::Entry * entry = presetEntries[i];
+		this->uriToPrefixTable.Add ( entry->key.c_str(), entry->key.size(), entry->value.c_str(), entry->value.size() );
+	}
 
-	this->uriToPrefixMap = presets.uriToPrefixMap;
-	this->prefixToURIMap = presets.prefixToURIMap;
+	presets.prefixToURITable.GetEntries ( &presetEntries );
+	for ( size_t i = 0, limit = presetEntries.size(); i < limit; ++i ) {
+		const XMP_InternTable::Entry * entry = presetEntries[i];
+		this->prefixToURITable.Add ( entry->key.c_str(), entry->key.size(), entry->value.c_str(), entry->value.size() );
+	}
 
 }	// XMP_NamespaceTable::XMP_NamespaceTable
 
 // =================================================================================================
 
+bool XMP_NamespaceTable::FindPrefix ( XMP_StringPtr uri, size_t uriLen,
+									  XMP_StringPtr * prefixPtr, XMP_StringLen * prefixLen ) const
+{
+	const size_t hash = XMP_InternTable::Hash ( uri, uriLen );
+
+	if ( this->staticIndex != 0 ) {
+		const XMP_StaticNamespace * ns = this->staticIndex->FindURI ( uri, uriLen, hash );
+		if ( ns != 0 ) {
+			if ( prefixPtr != 0 ) *prefixPtr = ns->prefix;
+			if ( prefixLen != 0 ) *prefixLen = ns->prefixLen;
+			return true;
+		}
+	}
+
+	const XMP_InternTable::Entry * uriEntry = this->uriToPrefixTable.Find ( uri, uriLen, hash );
+	if ( uriEntry == 0 ) return false;
+
+	if ( prefixPtr != 0 ) *prefixPtr = uriEntry->value.c_str();
+	if ( prefixLen != 0 ) *prefixLen = (XMP_StringLen)uriEntry->value.size();
+	return true;
+
+}	// XMP_NamespaceTable::FindPrefix
+
+// =================================================================================================
+
+bool XMP_NamespaceTable::FindURI ( XMP_StringPtr prefix, size_t prefixLen,
+								   XMP_StringPtr * uriPtr, XMP_StringLen * uriLen ) const
+{
+	const size_t hash = XMP_InternTable::Hash ( prefix, prefixLen );
+
+	if ( this->staticIndex != 0 ) {
+		const XMP_StaticNamespace * ns = this->staticIndex->FindPrefix ( prefix, prefixLen, hash );
+		if ( ns != 0 ) {
+			if ( uriPtr != 0 ) *uriPtr = ns->uri;
+			if ( uriLen != 0 ) *uriLen = ns->uriLen;
+			return true;
+		}
+	}
+
+	const XMP_InternTable::Entry * prefixEntry = this->prefixToURITable.Find ( prefix, prefixLen, hash );
+	if ( prefixEntry == 0 ) return false;
+
+	if ( uriPtr != 0 ) *uriPtr = prefixEntry->value.c_str();
+	if ( uriLen != 0 ) *uriLen = (XMP_StringLen)prefixEntry->value.size();
+	return true;
+
+}	// XMP_NamespaceTable::FindURI
+
+// =================================================================================================
+
 bool XMP_NamespaceTable::Define ( XMP_StringPtr _uri, XMP_StringPtr _suggPrefix,
 								  XMP_StringPtr * prefixPtr, XMP_StringLen * prefixLen )
 {
 	XMP_AutoLock tableLock ( &this->lock, kXMP_WriteLock );
-	bool prefixMatches = false;
 
 	XMP_Assert ( (_uri != 0) && (*_uri != 0) && (_suggPrefix != 0) && (*_suggPrefix != 0) );
 
@@ -455,9 +703,10 @@ bool XMP_NamespaceTable::Define ( XMP_StringPtr _uri, XMP_StringPtr _suggPrefix,
 	if ( suggPrefix[suggPrefix.size()-1] != ':' ) suggPrefix += ':';
 	VerifySimpleXMLName ( _suggPrefix, _suggPrefix+suggPrefix.size()-1 );	// Exclude the colon.
 
-	XMP_StringMapPos uriPos = this->uriToPrefixMap.find ( uri );
+	XMP_StringPtr actualPrefix;
+	XMP_StringLen actualLen;
 
-	if ( uriPos == this->uriToPrefixMap.end() ) {
+	if ( ! this->FindPrefix ( uri.c_str(), uri.size(), &actualPrefix, &actualLen ) ) {
 
 		// The URI is not yet registered, make sure we use a unique prefix.
 
@@ -466,7 +715,7 @@ bool XMP_NamespaceTable::Define ( XMP_StringPtr _uri, XMP_StringPtr _suggPrefix,
 		char buffer [32];	// AUDIT: Plenty of room for the "_%d_" suffix.
 
 		while ( true ) {
-			if ( this->prefixToURIMap.find ( uniqPrefix ) == this->prefixToURIMap.end() ) break;
+			if ( ! this->FindURI ( uniqPrefix.c_str(), uniqPrefix.size(), 0, 0 ) ) break;
 			++suffix;
 			snprintf ( buffer, sizeof(buffer), "_%d_:", suffix );	// AUDIT: Using sizeof for snprintf length is safe.
 			uniqPrefix = suggPrefix;
@@ -474,23 +723,24 @@ bool XMP_NamespaceTable::Define ( XMP_StringPtr _uri, XMP_StringPtr _suggPrefix,
 			uniqPrefix += buffer;
 		}
 
-		// Add the new namespace to both maps.
+		// Add the new namespace to both tables. The prefix goes first, a reader that finds the URI
+		// can then also find the prefix.
 
-		XMP_StringPair newNS ( uri, uniqPrefix );
-		uriPos = this->uriToPrefixMap.insert ( this->uriToPrefixMap.end(), newNS );
+		(void) this->prefixToURITable.Add ( uniqPrefix.c_str(), uniqPrefix.size(), uri.c_str(), uri.size() );
+		const XMP_InternTable::Entry * uriEntry =
+			this->uriToPrefixTable.Add ( uri.c_str(), uri.size(), uniqPrefix.c_str(), uniqPrefix.size() );
 
-		newNS.first.swap ( newNS.second );
-		(void) this->prefixToURIMap.insert ( this->prefixToURIMap.end(), newNS );
+		actualPrefix = uriEntry->value.c_str();
+		actualLen = (XMP_StringLen)uriEntry->value.size();
 
 	}
 
 	// Return the actual prefix and see if it matches the suggested prefix.
 
-	if ( prefixPtr != 0 ) *prefixPtr = uriPos->second.c_str();
-	if ( prefixLen != 0 ) *prefixLen = (XMP_StringLen)uriPos->second.size();
+	if ( prefixPtr != 0 ) *prefixPtr = actualPrefix;
+	if ( prefixLen != 0 ) *prefixLen = actualLen;
 
-	prefixMatches = ( uriPos->second == suggPrefix );
-	return prefixMatches;
+	return ( (actualLen == suggPrefix.size()) && (memcmp ( actualPrefix, suggPrefix.c_str(), actualLen ) == 0) );
 
 }	// XMP_NamespaceTable::Define
 
@@ -498,68 +748,69 @@ bool XMP_NamespaceTable::Define ( XMP_StringPtr _uri, XMP_StringPtr _suggPrefix,
 
 bool XMP_NamespaceTable::GetPrefix ( XMP_StringPtr _uri, XMP_StringPtr * prefixPtr, XMP_StringLen * prefixLen ) const
 {
-	XMP_AutoLock tableLock ( &this->lock, kXMP_ReadLock );
-	bool found = false;
-
 	XMP_Assert ( (_uri != 0) && (*_uri != 0) );
-
-	XMP_VarString uri ( _uri );
-	XMP_cStringMapPos uriPos = this->uriToPrefixMap.find ( uri );
-
-	if ( uriPos != this->uriToPrefixMap.end() ) {
-		if ( prefixPtr != 0 ) *prefixPtr = uriPos->second.c_str();
-		if ( prefixLen != 0 ) *prefixLen = (XMP_StringLen)uriPos->second.size();
-		found = true;
-	}
-
-	return found;
-
+	return this->FindPrefix ( _uri, strlen ( _uri ), prefixPtr, prefixLen );
 }	// XMP_NamespaceTable::GetPrefix
 
 // =================================================================================================
 
 bool XMP_NamespaceTable::GetURI ( XMP_StringPtr _prefix, XMP_StringPtr * uriPtr, XMP_StringLen * uriLen ) const
 {
-	XMP_AutoLock tableLock ( &this->lock, kXMP_ReadLock );
-
-	bool found = false;
-
 	XMP_Assert ( (_prefix != 0) && (*_prefix != 0) );
 
-	XMP_VarString prefix ( _prefix );
-	if ( prefix[prefix.size()-1] != ':' ) prefix += ':';
-	XMP_cStringMapPos prefixPos = this->prefixToURIMap.find ( prefix );
+	const size_t prefixSize = strlen ( _prefix );
 
-	if ( prefixPos != this->prefixToURIMap.end() ) {
-		if ( uriPtr != 0 ) *uriPtr = prefixPos->second.c_str();
-		if ( uriLen != 0 ) *uriLen = (XMP_StringLen)prefixPos->second.size();
-		found = true;
+	if ( _prefix[prefixSize-1] == ':' ) {
+		return this->FindURI ( _prefix, prefixSize, uriPtr, uriLen );
+	} else {
+		XMP_VarString prefix ( _prefix, prefixSize );
+		prefix += ':';
+		return this->FindURI ( prefix.c_str(), prefix.size(), uriPtr, uriLen );
 	}
 
-	return found;
-
 }	// XMP_NamespaceTable::GetURI
 
 // =================================================================================================
 
 void XMP_NamespaceTable::Dump ( XMP_TextOutputProc outProc, void * refCon ) const
 {
-	XMP_AutoLock tableLock ( &this->lock, kXMP_ReadLock );
+	XMP_AutoLock tableLock ( &this->lock, kXMP_WriteLock );	// ! Keep the two tables in step.
+
+	XMP_StringMap uriToPrefixMap, prefixToURIMap;	// Sorted copies, for the output and the checks.
+	std::vector < const XMP_InternTable::Entry * > tableEntries;
+
+	if ( this->staticIndex != 0 ) {
+		for ( size_t i = 0; i < this->staticIndex->count; ++i ) {
+			const XMP_StaticNamespace & ns = this->staticIndex->namespaces[i];
+			uriToPrefixMap.insert ( XMP_StringPair ( ns.uri, ns.prefix ) );
+			prefixToURIMap.insert ( XMP_StringPair ( ns.prefix, ns.uri ) );
+		}
+	}
+
+	this->uriToPrefixTable.GetEntries ( &tableEntries );
+	for ( size_t i = 0, limit = tableEntries.size(); i < limit; ++i ) {
+		uriToPrefixMap.insert ( XMP_StringPair ( tableEntries[i]->key, tableEntries[i]->value ) );
+	}
+
+	this->prefixToURITable.GetEntries ( &tableEntries );
+	for ( size_t i = 0, limit = tableEntries.size(); i < limit; ++i ) {
+		prefixToURIMap.insert ( XMP_StringPair ( tableEntries[i]->key, tableEntries[i]->value ) );
+	}
 
-	XMP_cStringMapPos p2uEnd = this->prefixToURIMap.end();	// ! Move up to avoid gcc complaints.
-	XMP_cStringMapPos u2pEnd = this->uriToPrefixMap.end();
+	XMP_cStringMapPos p2uEnd = prefixToURIMap.end();	// ! Move up to avoid gcc complaints.
+	XMP_cStringMapPos u2pEnd = uriToPrefixMap.end();
 
-	DumpStringMap ( this->prefixToURIMap, "Dumping namespace prefix to URI map", outProc, refCon );
+	DumpStringMap ( prefixToURIMap, "Dumping namespace prefix to URI map", outProc, refCon );
 
-	if ( this->prefixToURIMap.size() != this->uriToPrefixMap.size() ) {
+	if ( prefixToURIMap.size() != uriToPrefixMap.size() ) {
 		OutProcLiteral ( "** bad namespace map sizes **" );
 		XMP_Throw ( "Fatal namespace map problem", kXMPErr_InternalFailure );
 	}
 
-	for ( XMP_cStringMapPos nsLeft = this->prefixToURIMap.begin(); nsLeft != p2uEnd; ++nsLeft ) {
+	for ( XMP_cStringMapPos nsLeft = prefixToURIMap.begin(); nsLeft != p2uEnd; ++nsLeft ) {
 
-		XMP_cStringMapPos nsOther = this->uriToPrefixMap.find ( nsLeft->second );
-		if ( (nsOther == u2pEnd) || (nsLeft != this->prefixToURIMap.find ( nsOther->second )) ) {
+		XMP_cStringMapPos nsOther = uriToPrefixMap.find ( nsLeft->second );
+		if ( (nsOther == u2pEnd) || (nsLeft != prefixToURIMap.find ( nsOther->second )) ) {
 			OutProcLiteral ( "  ** bad namespace URI **  " );
 			DumpClearString ( nsLeft->second, outProc, refCon );
 			break;
@@ -576,10 +827,10 @@ void XMP_NamespaceTable::Dump ( XMP_TextOutputProc outProc, void * refCon ) cons
 
 	}
 
-	for ( XMP_cStringMapPos nsLeft = this->uriToPrefixMap.begin(); nsLeft != u2pEnd; ++nsLeft ) {
+	for ( XMP_cStringMapPos nsLeft = uriToPrefixMap.begin(); nsLeft != u2pEnd; ++nsLeft ) {
 
-		XMP_cStringMapPos nsOther = this->prefixToURIMap.find ( nsLeft->second );
-		if ( (nsOther == p2uEnd) || (nsLeft != this->uriToPrefixMap.find ( nsOther->second )) ) {
+		XMP_cStringMapPos nsOther = prefixToURIMap.find ( nsLeft->second );
+		if ( (nsOther == p2uEnd) || (nsLeft != uriToPrefixMap.find ( nsOther->second )) ) {
 			OutProcLiteral ( "  ** bad namespace prefix **  " );
 			DumpClearString ( nsLeft->second, outProc, refCon );
 			break;
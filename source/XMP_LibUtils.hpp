@@ -12,6 +12,7 @@
 #include "public/include/XMP_Environment.h"	// ! Must be the first include.
 #include "public/include/XMP_Const.h"
 
+#include <atomic>
 #include <map>
 #include <string>
 #include <vector>
@@ -613,10 +614,108 @@ typedef std::map < XMP_VarString, XMP_VarString > XMP_StringMap;
 typedef XMP_StringMap::iterator       XMP_StringMapPos;
 typedef XMP_StringMap::const_iterator XMP_cStringMapPos;
 
+// -------------------------------------------------------------------------------------------------
+// XMP_InternTable holds strings that are never removed, each with an associated value string. The
+// lookups do not lock, they can run while another thread is adding. The entries stay put until the
+// table is deleted, so pointers to them and to their strings can be handed out.
+
+class XMP_InternTable {
+public:
+
+	struct Entry {
+		XMP_VarString key, value;
+		size_t hash;
+	};
+
+	XMP_InternTable();
+	~XMP_InternTable();
+
+	const Entry * Find ( XMP_StringPtr key, size_t keyLen ) const;
+	const Entry * Find ( XMP_StringPtr key, size_t keyLen, size_t hash ) const;	// The hash is from Hash.
+
+	// Returns the existing entry if the key is already known, the value is then left alone.
+	const Entry * Add ( XMP_StringPtr key, size_t keyLen, XMP_StringPtr value = "", size_t valueLen = 0 );
+
+	void GetEntries ( std::vector < const Entry * > * outEntries ) const;	// In the order they were added.
+
+	static size_t Hash ( XMP_StringPtr key, size_t keyLen );
+
+private:
+
+	struct SlotTable {	// Open addressing with linear probing, replaced by a larger one when half full.
+		size_t mask;
+		std::atomic < const Entry * > * slots;
+	};
+
+	std::atomic < SlotTable * > slotTable;
+	std::vector < SlotTable * > oldSlotTables;	// ! Readers might still be looking at these.
+	std::vector < Entry * > entries;
+	mutable XMP_BasicMutex mutex;	// Serializes the writers.
+
+	static SlotTable * NewSlotTable ( size_t slotCount );
+	static void PutEntry ( SlotTable * table, const Entry * entry );
+
+	XMP_InternTable ( const XMP_InternTable & );	// ! Hidden on purpose.
+	XMP_InternTable & operator= ( const XMP_InternTable & );
+
+};
+
+// -------------------------------------------------------------------------------------------------
+// XMP_StaticNamespace is a namespace known at build time. Make the entries with XMP_StaticNamespaceEntry
+// from string literals, the lengths and hashes are then computed by the compiler. The hashes are the
+// same as from XMP_InternTable::Hash.
+
+constexpr XMP_Uns32 XMP_ConstHash ( XMP_StringPtr str, XMP_Uns32 hash = 2166136261UL )
+{
+	return (*str == 0) ? hash : XMP_ConstHash ( str + 1, (XMP_Uns32) ((hash ^ (XMP_Uns8)*str) * 16777619UL) );
+}
+
+struct XMP_StaticNamespace {
+	XMP_StringPtr uri, prefix;	// ! The prefix includes the colon.
+	XMP_StringLen uriLen, prefixLen;
+	XMP_Uns32 uriHash, prefixHash;
+};
+
+#define XMP_StaticNamespaceEntry(uri,prefix)									\
+	{ uri, prefix ":", (XMP_StringLen)(sizeof(uri) - 1), (XMP_StringLen)sizeof(prefix),	\
+	  XMP_ConstHash ( uri ), XMP_ConstHash ( prefix ":" ) }
+
+// XMP_StaticNamespaceIndex finds the entries of a static namespace array by URI or by prefix. The
+// slots are part of the object, making one does not allocate. It never changes once made, so the
+// lookups do not lock.
+
+class XMP_StaticNamespaceIndex {
+public:
+
+	XMP_StaticNamespaceIndex ( const XMP_StaticNamespace * namespaces, size_t count );
+
+	const XMP_StaticNamespace * FindURI ( XMP_StringPtr uri, size_t uriLen, size_t hash ) const;
+	const XMP_StaticNamespace * FindPrefix ( XMP_StringPtr prefix, size_t prefixLen, size_t hash ) const;
+
+	const XMP_StaticNamespace * const namespaces;
+	const size_t count;
+
+private:
+
+	enum { kSlotCount = 256 };	// ! A power of 2, at least twice the number of namespaces.
+
+	const XMP_StaticNamespace * uriSlots [kSlotCount];
+	const XMP_StaticNamespace * prefixSlots [kSlotCount];
+
+	XMP_StaticNamespaceIndex ( const XMP_StaticNamespaceIndex & );	// ! Hidden on purpose.
+	XMP_StaticNamespaceIndex & operator= ( const XMP_StaticNamespaceIndex & );
+
+};
+
+// -------------------------------------------------------------------------------------------------
+// XMP_NamespaceTable maps between namespace URIs and prefixes. The lookups do not lock, defining a
+// namespace is serialized. The optional static index holds namespaces that are always there, the
+// intern tables only hold those defined later. A copy shares the static index.
+
 class XMP_NamespaceTable {
 public:
 
-	XMP_NamespaceTable() {};
+	XMP_NamespaceTable ( const XMP_StaticNamespaceIndex * _staticIndex = 0 ) : staticIndex(_staticIndex) {};
 	XMP_NamespaceTable ( const XMP_NamespaceTable & presets );
 	virtual ~XMP_NamespaceTable() {};
 
@@ -630,8 +729,12 @@ public:
 
 private:
 
-	XMP_ReadWriteLock lock;
-	XMP_StringMap uriToPrefixMap, prefixToURIMap;
+	XMP_ReadWriteLock lock;	// Only taken by the writers.
+	const XMP_StaticNamespaceIndex * staticIndex;
+	XMP_InternTable uriToPrefixTable, prefixToURITable;
+
+	bool FindPrefix ( XMP_StringPtr uri, size_t uriLen, XMP_StringPtr * prefixPtr, XMP_StringLen * prefixLen ) const;
+	bool FindURI ( XMP_StringPtr prefix, size_t prefixLen, XMP_StringPtr * uriPtr, XMP_StringLen * uriLen ) const;
 
 };
 
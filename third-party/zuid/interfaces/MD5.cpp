@@ -52,11 +52,11 @@ using namespace std;
 #define S43 15
 #define S44 21
 
-static void MD5Transform (XMP_Uns32 [4], XMP_Uns8 [64]);
+static void MD5Transform (XMP_Uns32 [4], const XMP_Uns8 [64]);
 static void Encode (XMP_Uns8 *, XMP_Uns32 *, XMP_Uns32);
-static void Decode (XMP_Uns32 *, XMP_Uns8 *, XMP_Uns32);
+static void Decode (XMP_Uns32 *, const XMP_Uns8 *, XMP_Uns32);
 
-static XMP_Uns8 PADDING[64] =
+static const XMP_Uns8 PADDING[64] =
 	{
      0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
@@ -127,7 +127,7 @@ void MD5Init (MD5_CTX * context)
       */
 
 void MD5Update (	MD5_CTX *context, /* context */
-					XMP_Uns8 *input, /* input block */
+					const XMP_Uns8 *input, /* input block */
 					XMP_Uns32 inputLen) /* length of input block */
 {
 	using namespace std;
@@ -203,7 +203,7 @@ void MD5Final (	XMP_Uns8 digest[16], /* message digest */
       */
 
 static void MD5Transform (	XMP_Uns32 state[4],
-							XMP_Uns8 block[64])
+							const XMP_Uns8 block[64])
 {
      XMP_Uns32 a = state[0], b = state[1], c = state[2], d = state[3], x[16];
 
@@ -316,7 +316,7 @@ static void Encode (	XMP_Uns8 *output,
       */
 
 static void Decode (	XMP_Uns32 *output,
-						XMP_Uns8 *input,
+						const XMP_Uns8 *input,
 						XMP_Uns32 len)
 {
      XMP_Uns32 i, j;
@@ -325,3 +325,32 @@ static void Decode (	XMP_Uns32 *output,
      output[i] = ((XMP_Uns32)input[j]) | (((XMP_Uns32)input[j+1]) << 8) |
      (((XMP_Uns32)input[j+2]) << 16) | (((XMP_Uns32)input[j+3]) << 24);
 }
+
+/******************************************************************************/
+
+/* One shot digest of a single buffer. */
+
+void MD5Digest (	const void * input,
+					XMP_Uns32 inputLen,
+					XMP_Uns8 digest[16])
+{
+	MD5_CTX context;
+	MD5Init ( &context );
+	MD5Update ( &context, (const XMP_Uns8*)input, inputLen );
+	MD5Final ( digest, &context );
+}
+
+/* The hex form of a digest, as written into XMP. */
+
+void MD5DigestToHex (	const XMP_Uns8 digest[16],
+						char hex[33])
+{
+	static const char * kDigits = "0123456789ABCDEF";
+
+	for ( int in = 0, out = 0; in < 16; in += 1, out += 2 ) {
+		XMP_Uns8 byte = digest[in];
+		hex[out]   = kDigits [ byte >> 4 ];
+		hex[out+1] = kDigits [ byte & 0xF ];
+	}
+	hex[32] = 0;
+}
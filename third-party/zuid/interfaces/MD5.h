@@ -40,9 +40,15 @@ struct MD5_CTX
 	};
 
 extern void MD5Init (MD5_CTX *);
-extern void MD5Update (MD5_CTX *, XMP_Uns8 *, XMP_Uns32);
+extern void MD5Update (MD5_CTX *, const XMP_Uns8 *, XMP_Uns32);
 extern void MD5Final(XMP_Uns8 [16], MD5_CTX *);
 
+/* One shot digest of a single buffer. */
+extern void MD5Digest (const void *, XMP_Uns32, XMP_Uns8 [16]);
+
+/* The 32 character form used in XMP, capital A-F, and a terminating nul. */
+extern void MD5DigestToHex (const XMP_Uns8 [16], char [33]);
+
 /******************************************************************************/
 
 #endif